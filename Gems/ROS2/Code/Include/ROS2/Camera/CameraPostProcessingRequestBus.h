@@ -21,12 +21,17 @@ namespace ROS2
     //! Do not use connects / disconnects to this bus during event dispatch, as they are not allowed for this concurrency model.
     //! Those constraints allow for processing multiple camera frames in the same time.
     //! Bus implementations should allow for asynchronous execution of provided functions.
+    //! Post-processing runs on job threads, with several frames of a camera processed at once. Handlers of an entity form an
+    //! ordered pipeline: each frame passes through them one after another, by descending priority.
     class CameraPostProcessingRequests : public AZ::EBusSharedDispatchTraits<CameraPostProcessingRequests>
     {
     public:
         using BusIdType = AZ::EntityId;
         static constexpr AZ::EBusAddressPolicy AddressPolicy = AZ::EBusAddressPolicy::ById;
-        static constexpr AZ::EBusHandlerPolicy HandlerPolicy = AZ::EBusHandlerPolicy::Multiple;
+        static constexpr AZ::EBusHandlerPolicy HandlerPolicy = AZ::EBusHandlerPolicy::MultipleAndOrdered;
+
+        //! Priority of handlers which do not override GetPriority.
+        static constexpr AZ::u8 DefaultPriority = 127;
 
         //! Apply post-processing function, if any implementations to the bus are in the entity.
         //! @param image standard image message passed as a reference. It will be changed through post-processing.
@@ -37,6 +42,41 @@ namespace ROS2
         //! @param encodingFormat name of the format.
         virtual bool SupportsFormat(const AZStd::string& encodingFormat) = 0;
 
+        //! Returns the priority of the handler, which must not change while it is connected. Handlers with a higher priority
+        //! process images first, e.g. lens distortion before sensor noise.
+        virtual AZ::u8 GetPriority() const
+        {
+            return DefaultPriority;
+        }
+
+        //! Query whether rows of an image can be post-processed independently, with ApplyPostProcessingToTile called on several
+        //! threads at once instead of ApplyPostProcessing.
+        virtual bool SupportsTiles() const
+        {
+            return false;
+        }
+
+        //! Apply post-processing to a tile of an image, which is a band of rows.
+        //! @param source image before this post-processing, which must not be changed.
+        //! @param target image after this post-processing, with the same size and encoding as the source, of which rows in the
+        //! range [firstRow, lastRow) must be written.
+        //! @param frameSeed Number of the frame, which all tiles of a frame share, and which differs between frames of a camera
+        //! channel even when their stamps repeat. Used e.g. to seed noise.
+        virtual void ApplyPostProcessingToTile(
+            [[maybe_unused]] const sensor_msgs::msg::Image& source,
+            [[maybe_unused]] sensor_msgs::msg::Image& target,
+            [[maybe_unused]] AZ::u32 firstRow,
+            [[maybe_unused]] AZ::u32 lastRow,
+            [[maybe_unused]] AZ::u64 frameSeed)
+        {
+        }
+
+        //! Orders handlers by descending priority.
+        bool Compare(const CameraPostProcessingRequests* other) const
+        {
+            return GetPriority() > other->GetPriority();
+        }
+
     protected:
         ~CameraPostProcessingRequests() = default;
     };
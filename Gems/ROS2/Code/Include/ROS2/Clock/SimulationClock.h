@@ -8,8 +8,9 @@
 #pragma once
 
 #include <AzCore/std/chrono/chrono.h>
-#include <AzCore/std/containers/deque.h>
+#include <ROS2/Utilities/P2QuantileEstimator.h>
 #include <builtin_interfaces/msg/time.hpp>
+#include <diagnostic_msgs/msg/diagnostic_array.hpp>
 #include <rclcpp/publisher.hpp>
 #include <rosgraph_msgs/msg/clock.hpp>
 
@@ -18,9 +19,24 @@ namespace ROS2
     //! Simulation clock which can tick and serve time stamps.
     class SimulationClock
     {
-        static constexpr size_t FramesNumberForStats = 60;
+        //! Frame time statistics are estimated over windows of this many frames, so that they follow changes of the load.
+        static constexpr AZ::u64 FramesNumberForStats = 1000;
+        //! Minimum number of frames in the current window for its statistics to be reported instead of the previous window.
+        static constexpr AZ::u64 MinFramesNumberForStats = 60;
 
     public:
+        //! Statistics of the simulation time elapsed between ticks of the clock, as reported by the time system.
+        struct FrameTimeStatistics
+        {
+            float m_medianFrameTime = 0.0f; //!< In seconds.
+            float m_95thPercentileFrameTime = 0.0f; //!< In seconds.
+            float m_99thPercentileFrameTime = 0.0f; //!< In seconds.
+            //! Simulation time elapsed per wall clock time elapsed.
+            float m_realTimeFactor = 0.0f;
+            //! Number of frames the statistics are estimated from.
+            AZ::u64 m_frameCount = 0;
+        };
+
         virtual void Activate(){};
         virtual void Deactivate(){};
 
@@ -29,21 +45,55 @@ namespace ROS2
         virtual builtin_interfaces::msg::Time GetROSTimestamp() const;
 
         //! Update time in the ROS 2 ecosystem.
-        //! This will publish current time to the ROS 2 `/clock` topic.
+        //! This will publish current time to the ROS 2 `/clock` topic, and frame time statistics to `/diagnostics`.
         virtual void Tick();
 
         //! Returns an expected loop time of simulation. It is an estimation from past frames.
         AZStd::chrono::duration<float, AZStd::chrono::seconds::period> GetExpectedSimulationLoopTime() const;
+
+        //! Returns statistics of recent frame times. Computing them takes constant time per frame.
+        FrameTimeStatistics GetFrameTimeStatistics() const;
+
+        //! Sets how often the `/clock` topic is published.
+        //! @param rate Rate in Hz of simulation time. Zero publishes on every tick.
+        void SetClockPublishRate(double rate);
+
         virtual ~SimulationClock() = default;
 
     private:
+        //! Frame time quantiles, in microseconds, and the elapsed times of a window of frames.
+        struct FrameTimeWindow
+        {
+            void Add(AZ::s64 frameTime, AZ::s64 wallTime, double simulationTime);
+            void Reset();
+
+            P2QuantileEstimator m_median{ 0.5 };
+            P2QuantileEstimator m_95thPercentile{ 0.95 };
+            P2QuantileEstimator m_99thPercentile{ 0.99 };
+            //! Wall clock time of the window, in microseconds.
+            AZ::s64 m_wallTime = 0;
+            //! Simulation time of the window, in seconds.
+            double m_simulationTime = 0.0;
+        };
+
         //! Get the time since start of sim, scaled with t_simulationTickScale
         int64_t GetElapsedTimeMicroseconds() const;
 
+        void PublishDiagnostics();
+
         AZ::s64 m_lastExecutionTime{ 0 };
+        AZStd::chrono::steady_clock::time_point m_lastWallTime;
+        double m_lastSimulationTime{ 0.0 };
 
         rclcpp::Publisher<rosgraph_msgs::msg::Clock>::SharedPtr m_clockPublisher;
-        AZ::s64 m_currentMedian{ 0 };
-        AZStd::deque<AZ::s64> m_frameTimes;
+        double m_clockPublishPeriod = 0.0;
+        double m_nextClockPublishTime = 0.0;
+
+        rclcpp::Publisher<diagnostic_msgs::msg::DiagnosticArray>::SharedPtr m_diagnosticsPublisher;
+        AZStd::chrono::steady_clock::time_point m_nextDiagnosticsPublishTime;
+
+        //! The current window collects frames, while the previous one is reported until the current one has enough frames.
+        FrameTimeWindow m_frameTimeWindows[2];
+        size_t m_currentWindow = 0;
     };
-} // namespace ROS2
\ No newline at end of file
+} // namespace ROS2
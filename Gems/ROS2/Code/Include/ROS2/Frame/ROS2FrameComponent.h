@@ -17,13 +17,11 @@
 namespace ROS2
 {
     //! This component marks an interesting reference frame for ROS2 ecosystem.
-    //! It serves as sensor data frame of reference and is responsible, through ROS2Transform, for publishing
-    //! ros2 static and dynamic transforms (/tf_static, /tf). It also facilitates namespace handling.
+    //! It serves as sensor data frame of reference and is responsible for publishing ros2 static transforms (/tf_static)
+    //! through ROS2Transform, and dynamic transforms (/tf) through the central publisher. It also facilitates namespace handling.
     //! An entity can only have a single ROS2Frame on each level. Many ROS2 Components require this component.
     //! @note A robot should have this component on every level of entity hierarchy (for each joint, fixed or dynamic)
-    class ROS2FrameComponent
-        : public AZ::Component
-        , public AZ::TickBus::Handler
+    class ROS2FrameComponent : public AZ::Component
     {
     public:
         AZ_COMPONENT(ROS2FrameComponent, "{EE743472-3E25-41EA-961B-14096AC1D66F}");
@@ -80,11 +78,6 @@ namespace ROS2
         void UpdateNamespaceConfiguration(const AZStd::string& ns, NamespaceConfiguration::NamespaceStrategy strategy);
 
     private:
-        //////////////////////////////////////////////////////////////////////////
-        // AZ::TickBus::Handler overrides
-        void OnTick(float deltaTime, AZ::ScriptTimePoint time) override;
-        //////////////////////////////////////////////////////////////////////////
-
         bool IsTopLevel() const; //!< True if this entity does not have a parent entity with ROS2.
 
         //! Whether transformation to parent frame can change during the simulation, or is fixed.
@@ -105,5 +98,7 @@ namespace ROS2
         bool m_publishTransform = true;
         bool m_isDynamic = false;
         AZStd::unique_ptr<ROS2Transform> m_ros2Transform;
+        //! Namespace the robot node was acquired with on activation, released with on deactivation.
+        AZStd::string m_robotNodeNamespace;
     };
 } // namespace ROS2
@@ -12,6 +12,7 @@
 #include <AzCore/Math/Transform.h>
 #include <AzCore/Math/Vector3.h>
 #include <ROS2/Communication/QoS.h>
+#include <sensor_msgs/msg/point_cloud2.hpp>
 
 namespace ROS2
 {
@@ -96,9 +97,19 @@ namespace ROS2
     struct RaycastResult
     {
         AZStd::vector<AZ::Vector3> m_points;
+        //! Range of every ray. For organized point clouds (see ConfigureOrganizedPointCloud) it is a dense range image
+        //! of layers x increments, stored row by row, with NaN for rays that do not produce a point.
         AZStd::vector<float> m_ranges;
     };
 
+    //! Ray counts of a lidar, accumulated over its lifetime.
+    struct RaycastStatistics
+    {
+        AZ::u64 m_castCount = 0; //!< number of raycasts (scans or their parts)
+        AZ::u64 m_castRayCount = 0; //!< rays cast into the scene
+        AZ::u64 m_savedRayCount = 0; //!< rays of the ray pattern left out by adaptive density
+    };
+
     //! Interface class that allows for communication with a single Lidar instance.
     class LidarRaycasterRequests
     {
@@ -134,6 +145,45 @@ namespace ROS2
         //! @return Results of the raycast in the requested form including 3D space coordinates and/or ranges.
         virtual RaycastResult PerformRaycast(const AZ::Transform& lidarTransform) = 0;
 
+        //! Schedules a raycast that originates from the point described by the lidarTransform and stores its results in place.
+        //! Unlike PerformRaycast, buffers of the provided results are reused, which lets implementations avoid allocating on every scan.
+        //! @param lidarTransform Current transform from global to lidar reference frame.
+        //! @param results Results of the raycast in the requested form. Previous contents are overwritten.
+        virtual void PerformRaycastInPlace(const AZ::Transform& lidarTransform, RaycastResult& results)
+        {
+            results = PerformRaycast(lidarTransform);
+        }
+
+        //! Schedules a raycast and writes the resulting points directly into a PointCloud2 message.
+        //! Points are written in the lidar reference frame as packed float32 x, y, z fields (12 bytes per point, no padding).
+        //! Fields, dimensions and data of the message are set; the header is left to the caller.
+        //! The data buffer is resized in place, so reusing the same message across scans avoids allocation.
+        //! @param lidarTransform Current transform from global to lidar reference frame.
+        //! @param message Message receiving the point cloud.
+        //! @return False if this result mode is not supported by the implementation, in which case the message is not modified.
+        virtual bool PerformRaycastToPointCloud(
+            [[maybe_unused]] const AZ::Transform& lidarTransform, [[maybe_unused]] sensor_msgs::msg::PointCloud2& message)
+        {
+            return false;
+        }
+
+        //! Schedules a raycast of a contiguous range of the configured rays and appends the resulting points to a PointCloud2 message.
+        //! This allows emulating spinning lidars, which sweep their ray pattern over time instead of casting it at a single instant.
+        //! Points are written in the layout of PerformRaycastToPointCloud, in the lidar reference frame at the time of the cast.
+        //! @param lidarTransform Current transform from global to lidar reference frame.
+        //! @param firstRay Index of the first cast ray, in the order of the configured ray orientations.
+        //! @param rayCount Number of consecutive rays to cast.
+        //! @param message Message the point cloud is appended to.
+        //! @return False if this result mode is not supported by the implementation, in which case the message is not modified.
+        virtual bool AppendRaycastToPointCloud(
+            [[maybe_unused]] const AZ::Transform& lidarTransform,
+            [[maybe_unused]] size_t firstRay,
+            [[maybe_unused]] size_t rayCount,
+            [[maybe_unused]] sensor_msgs::msg::PointCloud2& message)
+        {
+            return false;
+        }
+
         //! Configures ray Gaussian Noise parameters.
         //! Each call overrides the previous configuration.
         //! This type of noise is especially useful when trying to simulate real-life lidars, since its noise mimics
@@ -189,6 +239,20 @@ namespace ROS2
             AZ_Assert(false, "This Lidar Implementation does not support PointCloud publishing!");
         }
 
+        //! Enables and configures raycaster-side Point Cloud Publisher on the node of the robot the lidar belongs to.
+        //! Implementations which do not use robot nodes publish as configured by ConfigurePointCloudPublisher.
+        //! @param robotNamespace Namespace of the lidar, as returned by ROS2FrameComponent::GetNamespace.
+        //! @see ConfigurePointCloudPublisher
+        //! @see ROS2Requests::GetRobotNode
+        virtual void ConfigureRobotPointCloudPublisher(
+            [[maybe_unused]] const AZStd::string& robotNamespace,
+            const AZStd::string& topicName,
+            const AZStd::string& frameId,
+            const QoS& qoSPolicy)
+        {
+            ConfigurePointCloudPublisher(topicName, frameId, qoSPolicy);
+        }
+
         //! Updates the timestamp of the messages published by the raycaster.
         //! @param timestampNanoseconds timestamp in nanoseconds
         //! (Time.msg: sec = timestampNanoseconds / 10^9; nanosec = timestampNanoseconds mod 10^9).
@@ -207,6 +271,50 @@ namespace ROS2
             return false;
         }
 
+        //! Configures the layout of point clouds written by the raycaster.
+        //! Organized point clouds hold a point for every ray, in rows of layers and columns of increments
+        //! (height = layerCount, width = ray count / layerCount), with NaN coordinates for rays that do not produce a point.
+        //! Rays are expected in the increment-major order of LidarTemplateUtils::PopulateRayRotations.
+        //! @param layerCount Number of lidar layers, or 0 for unorganized point clouds (the default).
+        virtual void ConfigureOrganizedPointCloud([[maybe_unused]] AZ::u32 layerCount)
+        {
+            AZ_Assert(false, "This Lidar Implementation does not support organized point clouds!");
+        }
+
+        //! Configures adaptive ray density, which leaves out rays in azimuth where the scene is far away.
+        //! The decimation of each ray follows its range in previous scans: rays closer than fullDensityRange are always cast,
+        //! rays in [fullDensityRange, 2 * fullDensityRange) in every second increment, rays further away in every fourth and
+        //! so on, up to maxDecimation. The cast increments rotate between scans, so that every ray is refreshed regularly.
+        //! @param layerCount Number of lidar layers; rays are expected in the increment-major order of
+        //! LidarTemplateUtils::PopulateRayRotations.
+        //! @param fullDensityRange Range in meters below which all rays are cast.
+        //! @param maxDecimation Largest decimation factor. Values of 0 or 1 disable adaptive density.
+        //! @param rayBudget Maximum number of rays cast per scan, enforced by thinning the selected rays uniformly. 0 for no limit.
+        virtual void ConfigureAdaptiveDensity(
+            [[maybe_unused]] AZ::u32 layerCount,
+            [[maybe_unused]] float fullDensityRange,
+            [[maybe_unused]] AZ::u32 maxDecimation,
+            [[maybe_unused]] AZ::u32 rayBudget)
+        {
+            AZ_Assert(false, "This Lidar Implementation does not support adaptive ray density!");
+        }
+
+        //! Returns the ray counts of the lidar, accumulated since it was created.
+        virtual RaycastStatistics GetRaycastStatistics()
+        {
+            return {};
+        }
+
+        //! Schedules a raycast to be performed later, batched with the raycasts of other lidars of the same lidar system.
+        //! Only available when the raycaster handles publishing: the scan is published with the timestamp set by the last
+        //! UpdatePublisherTimestamp call, and no results are returned.
+        //! @param lidarTransform Current transform from global to lidar reference frame.
+        //! @return False if the raycaster cannot schedule raycasts, in which case PerformRaycast should be called instead.
+        virtual bool ScheduleRaycast([[maybe_unused]] const AZ::Transform& lidarTransform)
+        {
+            return false;
+        }
+
     protected:
         ~LidarRaycasterRequests() = default;
 
@@ -22,6 +22,8 @@ namespace ROS2
         EntityExclusion         = 1 << 2,
         MaxRangePoints          = 1 << 3,
         PointcloudPublishing    = 1 << 4,
+        OrganizedPointCloud     = 1 << 5,
+        AdaptiveDensity         = 1 << 6,
         All                     = 0b1111111111111111,
     };
 
@@ -7,8 +7,10 @@
  */
 #pragma once
 
+#include <AzCore/Component/EntityId.h>
 #include <AzCore/EBus/EBus.h>
 #include <AzCore/Interface/Interface.h>
+#include <AzCore/std/string/string.h>
 #include <builtin_interfaces/msg/time.hpp>
 #include <geometry_msgs/msg/transform_stamped.hpp>
 #include <ROS2/Clock/SimulationClock.h>
@@ -16,6 +18,15 @@
 
 namespace ROS2
 {
+    //! Latency of ROS 2 callbacks of the central node, measured from the moment an event (a message, a service request or
+    //! response, a timer) is taken from the middleware to the moment its callback starts.
+    struct CallbackLatencyStatistics
+    {
+        AZ::u64 m_callbackCount = 0;
+        AZ::u64 m_totalLatencyNanoseconds = 0;
+        AZ::u64 m_maxLatencyNanoseconds = 0;
+    };
+
     //! Interface to the central ROS2SystemComponent.
     //! Use this API through ROS2Interface, for example:
     //! @code
@@ -33,6 +44,21 @@ namespace ROS2
         //! @note Alternatively, you can use your own node along with an executor.
         virtual std::shared_ptr<rclcpp::Node> GetNode() const = 0;
 
+        //! Get the node for publishers, subscriptions, services and actions of a robot.
+        //! With per-robot nodes enabled by the "/O3DE/ROS2/RobotNodes/Enabled" setting, each robot, identified by the first segment of
+        //! its namespace, gets its own node. Otherwise, and for an empty namespace, this is the central node.
+        //! @param ns Namespace of an entity of the robot, as returned by ROS2FrameComponent::GetNamespace.
+        //! @note Names are resolved as on the central node, so topic names still need the namespace.
+        virtual std::shared_ptr<rclcpp::Node> GetRobotNode(const AZStd::string& ns) = 0;
+
+        //! Keeps the node of a robot while an entity of the robot is active. Called by ROS2FrameComponent.
+        //! @param ns Namespace of the entity, as returned by ROS2FrameComponent::GetNamespace.
+        virtual void AcquireRobotNode(const AZStd::string& ns) = 0;
+
+        //! Releases the node of a robot acquired with AcquireRobotNode. The node is removed once all entities of the robot released
+        //! it, e.g. when the robot is despawned, and a new one is created if the robot comes back.
+        virtual void ReleaseRobotNode(const AZStd::string& ns) = 0;
+
         //! Acquire current time as ROS2 timestamp.
         //! Timestamps provide temporal context for messages such as sensor data.
         //! @code
@@ -52,10 +78,60 @@ namespace ROS2
         //! Use this function directly only when default behavior of ROS2FrameComponent is not sufficient.
         virtual void BroadcastTransform(const geometry_msgs::msg::TransformStamped& t, bool isDynamic) = 0;
 
+        //! Register a dynamic frame, whose transform to its parent frame is published to /tf on every tick.
+        //! All registered frames are published as a single message with one timestamp, and their transforms are computed
+        //! from the world transforms of the entities, which are read once per tick.
+        //! @param frameEntityId entity of the frame.
+        //! @param parentEntityId entity of the parent frame, or an invalid id when the parent is the global frame.
+        //! @param parentFrameId namespaced id of the parent frame.
+        //! @param frameId namespaced id of the frame.
+        //! @note Dynamic frames are already registered by each ROS2FrameComponent.
+        virtual void RegisterDynamicFrame(
+            AZ::EntityId frameEntityId, AZ::EntityId parentEntityId, const AZStd::string& parentFrameId, const AZStd::string& frameId) = 0;
+
+        //! Stop publishing a frame registered with RegisterDynamicFrame.
+        virtual void UnregisterDynamicFrame(AZ::EntityId frameEntityId) = 0;
+
         //! Obtains a simulation clock that is used across simulation.
         //! @returns constant reference to currently running clock.
         virtual const SimulationClock& GetSimulationClock() const = 0;
 
+        //! Obtains latency statistics of callbacks handled by the executor of the central node since its activation.
+        //! Callbacks run on the game thread by default. Setting "/O3DE/ROS2/Executor/Mode" to "Background" runs them
+        //! on the executor thread instead, which removes waiting for the frame but requires thread-safe callbacks.
+        virtual CallbackLatencyStatistics GetCallbackLatencyStatistics() const = 0;
+
+        //! Whether sensor publishers hand messages over to subscriptions in the simulator process without serialization.
+        //! Enabled with the "/O3DE/ROS2/IntraProcess/Enabled" setting. Subscriptions take part if their nodes are created with
+        //! GetComposedNodeOptions.
+        virtual bool IsIntraProcessEnabled() const = 0;
+
+        //! Returns options for nodes composed into the simulator process, which use intra-process communication when enabled.
+        virtual rclcpp::NodeOptions GetComposedNodeOptions() const = 0;
+
+        //! Composes a node into the simulator process. Its callbacks are handled by the executor of the central node, on the game
+        //! thread unless the executor runs callbacks in the background.
+        //! @param node Base interface of the node, e.g. from rclcpp::Node::get_node_base_interface.
+        virtual void AddComposedNode(const rclcpp::node_interfaces::NodeBaseInterface::SharedPtr& node) = 0;
+
+        //! Removes a node added with AddComposedNode from the executor.
+        virtual void RemoveComposedNode(const rclcpp::node_interfaces::NodeBaseInterface::SharedPtr& node) = 0;
+
+        //! Loads a node from a component library and composes it into the simulator process, like a component container.
+        //! @param libraryPath Path of the shared library registering the component with RCLCPP_COMPONENTS_REGISTER_NODE.
+        //! @param className Name of the component class, e.g. "composition::Talker".
+        //! @param nodeName Name of the node, or empty to keep the default name of the component.
+        //! @param nodeNamespace Namespace of the node, or empty to keep the default namespace.
+        //! @return Id of the composed node, or 0 if the library or the class could not be found.
+        virtual AZ::u64 LoadComposedNode(
+            const AZStd::string& libraryPath,
+            const AZStd::string& className,
+            const AZStd::string& nodeName,
+            const AZStd::string& nodeNamespace) = 0;
+
+        //! Removes and destroys a node loaded with LoadComposedNode.
+        //! @return Whether a node with the id was loaded.
+        virtual bool UnloadComposedNode(AZ::u64 nodeId) = 0;
     };
 
     class ROS2BusTraits : public AZ::EBusTraits
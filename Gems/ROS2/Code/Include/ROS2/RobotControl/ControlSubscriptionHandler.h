@@ -44,7 +44,7 @@ namespace ROS2
                 auto ros2Frame = entity->FindComponent<ROS2FrameComponent>();
                 AZStd::string namespacedTopic = ROS2Names::GetNamespacedName(ros2Frame->GetNamespace(), subscriberConfiguration.m_topic);
 
-                auto ros2Node = ROS2Interface::Get()->GetNode();
+                auto ros2Node = ROS2Interface::Get()->GetRobotNode(ros2Frame->GetNamespace());
                 m_controlSubscription = ros2Node->create_subscription<T>(
                     namespacedTopic.data(),
                     subscriberConfiguration.GetQoS(),
@@ -9,8 +9,10 @@
 #pragma once
 
 #include <AzCore/Serialization/EditContext.h>
+#include <AzCore/std/chrono/chrono.h>
 #include <ROS2/ROS2Bus.h>
 #include <ROS2/Sensor/Events/SensorEventSource.h>
+#include <ROS2/Sensor/Events/SensorPhaseSchedulerBus.h>
 #include <ROS2/Sensor/SensorConfiguration.h>
 
 namespace ROS2
@@ -54,8 +56,10 @@ namespace ROS2
     //! User can connect to this event using ROS2::EventSourceAdapter::ConnectToAdaptedEvent method. This class should be used, instead
     //! of using directly a class derived from SensorEventSource, when specific working frequency is required. Following this path, user can
     //! still use source event - ROS2::EventSourceAdapter::ConnectToSourceEvent. This template has to be resolved using a class derived from
-    //! SensorEventSource specialization.
+    //! SensorEventSource specialization. When a phase scheduler is available, adapted events of adapters sharing an event source and a
+    //! frequency are spread over source ticks, instead of all being signalled on the same tick.
     //! @see ROS2::SensorEventSource
+    //! @see ROS2::SensorPhaseSchedulerRequests
     template<class EventSourceT>
     class EventSourceAdapter
     {
@@ -107,8 +111,10 @@ namespace ROS2
                         return;
                     }
 
+                    const auto signalStart = AZStd::chrono::steady_clock::now();
                     m_sensorAdaptedEvent.Signal(m_adaptedDeltaTime, AZStd::forward<decltype(args)>(args)...);
                     m_adaptedDeltaTime = 0.0f;
+                    ReportCost(AZStd::chrono::steady_clock::now() - signalStart);
                 });
             m_eventSource.ConnectToSourceEvent(m_sourceAdaptingEventHandler);
             m_eventSource.Start();
@@ -121,6 +127,8 @@ namespace ROS2
         {
             m_eventSource.Stop();
             m_sourceAdaptingEventHandler.Disconnect();
+            ReleasePhase();
+            m_tickCounter = 0;
         }
 
         //! Sets adapter working frequency. By design, adapter will not work correctly, if this frequency will be greater than used event
@@ -159,7 +167,8 @@ namespace ROS2
         //!  - last delta time of event source and
         //!  - frequency set for adapter
         //! to support managing calls from event source. In other words, uses delta time of event source to calculate average number of
-        //! source event calls per adapted event call.
+        //! source event calls per adapted event call. A deadline is postponed once to the phase assigned by the phase scheduler, which
+        //! happens for the first deadline and after phases were rebalanced.
         //! @param sourceDeltaTime Delta time of event source.
         //! @return Whether it is time to signal adapted event.
         [[nodiscard]] bool IsPublicationDeadline(float sourceDeltaTime)
@@ -172,10 +181,73 @@ namespace ROS2
             const float sourceFrequencyEstimation = 1.0f / sourceDeltaTime;
             const float numberOfFrames =
                 m_adaptedFrequency <= sourceFrequencyEstimation ? (sourceFrequencyEstimation / m_adaptedFrequency) : 1.0f;
-            m_tickCounter = aznumeric_cast<int>(AZStd::round(numberOfFrames));
+            const int numberOfFramesRounded = aznumeric_cast<int>(AZStd::round(numberOfFrames));
+
+            if (!m_isPostponed)
+            {
+                const int phaseDelay = GetPhaseDelay(numberOfFrames, numberOfFramesRounded);
+                if (phaseDelay > 0)
+                {
+                    m_tickCounter = phaseDelay;
+                    m_isPostponed = true;
+                    return false;
+                }
+            }
+
+            // With a phase, deadlines follow its period, so that they stay in phase while the estimation fluctuates.
+            m_isPostponed = false;
+            m_tickCounter = m_phaseHandle != SensorPhaseSchedulerRequests::InvalidPhaseHandle ? aznumeric_cast<int>(m_phasePeriod)
+                                                                                                : numberOfFramesRounded;
             return true;
         }
 
+        //! Returns the number of source ticks to the phase of this adapter, acquiring the phase from the scheduler when the number of
+        //! source ticks per adapted event changes. The number is kept while the estimation stays close, since it varies with frame time.
+        [[nodiscard]] int GetPhaseDelay(float numberOfFrames, int numberOfFramesRounded)
+        {
+            auto* phaseScheduler = SensorPhaseSchedulerInterface::Get();
+            if (!phaseScheduler || numberOfFramesRounded <= 1)
+            {
+                ReleasePhase();
+                return 0;
+            }
+
+            if (m_phaseHandle == SensorPhaseSchedulerRequests::InvalidPhaseHandle ||
+                AZStd::abs(numberOfFrames - aznumeric_cast<float>(m_phasePeriod)) >= 1.0f)
+            {
+                ReleasePhase();
+                m_phasePeriod = aznumeric_cast<AZ::u32>(numberOfFramesRounded);
+                m_phaseHandle = phaseScheduler->AcquirePhase(azrtti_typeid<EventSourceT>(), m_phasePeriod);
+            }
+            return aznumeric_cast<int>(phaseScheduler->GetPhaseDelay(m_phaseHandle));
+        }
+
+        void ReleasePhase()
+        {
+            if (m_phaseHandle == SensorPhaseSchedulerRequests::InvalidPhaseHandle)
+            {
+                return;
+            }
+            if (auto* phaseScheduler = SensorPhaseSchedulerInterface::Get())
+            {
+                phaseScheduler->ReleasePhase(m_phaseHandle);
+            }
+            m_phaseHandle = SensorPhaseSchedulerRequests::InvalidPhaseHandle;
+        }
+
+        //! Reports the duration of adapted event handlers, with which the scheduler may weight phases.
+        void ReportCost(AZStd::chrono::steady_clock::duration duration)
+        {
+            if (m_phaseHandle == SensorPhaseSchedulerRequests::InvalidPhaseHandle)
+            {
+                return;
+            }
+            if (auto* phaseScheduler = SensorPhaseSchedulerInterface::Get())
+            {
+                phaseScheduler->ReportCost(m_phaseHandle, AZStd::chrono::duration<float>(duration).count());
+            }
+        }
+
         EventSourceT m_eventSource{}; ///< Event source managed by this adapter.
 
         //! Event handler for adapting event source to specific frequency.
@@ -187,6 +259,9 @@ namespace ROS2
         float m_adaptedFrequency{ 30.0f }; ///< Adapted frequency value.
         float m_adaptedDeltaTime{ 0.0f }; ///< Accumulator for calculating adapted delta time.
         int m_tickCounter{ 0 }; ///< Internal counter for controlling adapter frequency.
+        bool m_isPostponed{ false }; ///< Whether the current deadline was postponed to the phase of the adapter.
+        SensorPhaseSchedulerRequests::PhaseHandle m_phaseHandle{ SensorPhaseSchedulerRequests::InvalidPhaseHandle }; ///< Assigned phase.
+        AZ::u32 m_phasePeriod{ 0 }; ///< Number of source ticks per adapted event of the assigned phase.
     };
 
     AZ_TYPE_INFO_TEMPLATE(EventSourceAdapter, "{DC8BB5F7-8E0E-42A1-BD82-5FCD9D31B9DD}", AZ_TYPE_INFO_CLASS)
@@ -0,0 +1,49 @@
+/*
+ * Copyright (c) Contributors to the Open 3D Engine Project.
+ * For complete copyright and license terms please see the LICENSE at the root of this distribution.
+ *
+ * SPDX-License-Identifier: Apache-2.0 OR MIT
+ *
+ */
+
+#pragma once
+
+#include <AzCore/Interface/Interface.h>
+#include <AzCore/RTTI/RTTI.h>
+#include <AzCore/std/limits.h>
+
+namespace ROS2
+{
+    //! Spreads the work of sensors over ticks of their event source. Sensors working with the same frequency on the same event source
+    //! fire every N source ticks. Without a schedule, they would all fire on the same tick. The scheduler assigns each of them a phase
+    //! in range [0, N), so that the number of sensors firing on each tick, or their total measured cost, is even.
+    //! Phases only delay the first publication of a sensor, or shift it once when costs are rebalanced, so sensor rates do not change.
+    //! @see ROS2::EventSourceAdapter
+    class SensorPhaseSchedulerRequests
+    {
+    public:
+        AZ_RTTI(SensorPhaseSchedulerRequests, "{3C6F0B85-2E4D-4F8A-9A71-5B2D8C1E6F43}");
+
+        using PhaseHandle = AZ::u32;
+        static constexpr PhaseHandle InvalidPhaseHandle = AZStd::numeric_limits<PhaseHandle>::max();
+
+        virtual ~SensorPhaseSchedulerRequests() = default;
+
+        //! Assigns a phase to a sensor firing every given number of source ticks.
+        //! @param sourceType Type of the event source, e.g. ROS2::TickBasedSource.
+        //! @param period Number of source ticks between sensor events.
+        //! @return Handle of the phase, or InvalidPhaseHandle if ticks of the source type are not counted.
+        virtual PhaseHandle AcquirePhase(const AZ::TypeId& sourceType, AZ::u32 period) = 0;
+
+        virtual void ReleasePhase(PhaseHandle handle) = 0;
+
+        //! Returns the number of source ticks until the phase, 0 if the current tick is in phase.
+        //! Must be called from the source event, after the current tick was counted.
+        virtual AZ::u32 GetPhaseDelay(PhaseHandle handle) const = 0;
+
+        //! Reports the duration of a sensor event, in seconds. Used to weight phases when cost weighting is enabled.
+        virtual void ReportCost(PhaseHandle handle, float duration) = 0;
+    };
+
+    using SensorPhaseSchedulerInterface = AZ::Interface<SensorPhaseSchedulerRequests>;
+} // namespace ROS2
@@ -11,9 +11,11 @@
 #include <AzCore/Component/Component.h>
 #include <AzCore/Serialization/EditContext.h>
 #include <ROS2/Frame/ROS2FrameComponent.h>
+#include <ROS2/ROS2Bus.h>
 #include <ROS2/ROS2GemUtilities.h>
 #include <ROS2/Sensor/Events/EventSourceAdapter.h>
 #include <ROS2/Sensor/SensorConfiguration.h>
+#include <ROS2/Sensor/SensorProfiler.h>
 
 namespace ROS2
 {
@@ -26,6 +28,9 @@ namespace ROS2
     //!  - adapted event callback - what should be done in sensor logic processing.
     //! Optionally, user can pass third parameter, which is source event callback - this will be called with source event frequency (check
     //! chosen event source implementation).
+    //! When sensor profiling is enabled, execution times of both callbacks are recorded in a profile registered for the sensor.
+    //! Derived implementations should pass the profile to their sensor publishers with SensorPublisher::SetSensorProfile, which
+    //! records published messages on the publishing thread, or report the size of their data with RecordPublishedBytes.
     //! @see ROS2::TickBasedSource
     //! @see ROS2::PhysicsBasedSource
     template<class EventSourceT>
@@ -84,6 +89,18 @@ namespace ROS2
         {
             m_eventSourceAdapter.SetFrequency(sensorFrequency);
 
+            ReleaseSensorProfile();
+            if (auto* sensorProfiler = SensorProfilerInterface::Get())
+            {
+                const AZStd::string sensorName = AZStd::string::format("%s (%s)", GetFrameID().c_str(), RTTI_GetTypeName());
+                m_sensorProfile = sensorProfiler->RegisterSensor(sensorName);
+                adaptedCallback = ProfileCallback<typename EventSourceT::AdaptedCallbackType>(adaptedCallback, SensorCallbackType::Adapted);
+                if (sourceCallback)
+                {
+                    sourceCallback = ProfileCallback<typename EventSourceT::SourceCallbackType>(sourceCallback, SensorCallbackType::Source);
+                }
+            }
+
             m_adaptedEventHandler.Disconnect();
             m_adaptedEventHandler = decltype(m_adaptedEventHandler)(adaptedCallback);
             m_eventSourceAdapter.ConnectToAdaptedEvent(m_adaptedEventHandler);
@@ -104,6 +121,22 @@ namespace ROS2
             m_eventSourceAdapter.Stop();
             m_sourceEventHandler.Disconnect();
             m_adaptedEventHandler.Disconnect();
+            ReleaseSensorProfile();
+        }
+
+        //! Records the size of data published by the sensor. Does nothing unless sensor profiling is enabled.
+        void RecordPublishedBytes(size_t byteCount)
+        {
+            if (m_sensorProfile)
+            {
+                m_sensorProfile->RecordPublishedBytes(byteCount);
+            }
+        }
+
+        //! Returns the profile of the running sensor, or nullptr unless sensor profiling is enabled.
+        [[nodiscard]] AZStd::shared_ptr<SensorProfile> GetSensorProfile() const
+        {
+            return m_sensorProfile;
         }
 
         //! Returns a complete namespace for this sensor topics and frame ids.
@@ -113,6 +146,12 @@ namespace ROS2
             return ros2Frame->GetNamespace();
         }
 
+        //! Returns the node to create publishers of this sensor on.
+        [[nodiscard]] std::shared_ptr<rclcpp::Node> GetRobotNode() const
+        {
+            return ROS2Interface::Get()->GetRobotNode(GetNamespace());
+        }
+
         //! Returns this sensor frame ID. The ID contains namespace.
         [[nodiscard]] AZStd::string GetFrameID() const
         {
@@ -128,6 +167,34 @@ namespace ROS2
 
         //! Handler for adapted event. Requires manual assignment and connecting to adapted event in derived class.
         typename EventSourceT::AdaptedEventHandlerType m_adaptedEventHandler;
+
+    private:
+        //! Wraps a callback with a timer of its execution. The wrapper shares the profile, so it stays valid until the wrapper is
+        //! destroyed with its event handler.
+        template<class CallbackT>
+        CallbackT ProfileCallback(CallbackT callback, SensorCallbackType type) const
+        {
+            return [profile = m_sensorProfile, callback = AZStd::move(callback), type](auto&&... args)
+            {
+                SensorProfileScope scope(profile.get(), type);
+                callback(AZStd::forward<decltype(args)>(args)...);
+            };
+        }
+
+        void ReleaseSensorProfile()
+        {
+            if (!m_sensorProfile)
+            {
+                return;
+            }
+            if (auto* sensorProfiler = SensorProfilerInterface::Get())
+            {
+                sensorProfiler->UnregisterSensor(m_sensorProfile);
+            }
+            m_sensorProfile.reset();
+        }
+
+        AZStd::shared_ptr<SensorProfile> m_sensorProfile;
     };
 
     AZ_COMPONENT_IMPL_INLINE(
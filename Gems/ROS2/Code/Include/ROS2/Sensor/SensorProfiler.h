@@ -0,0 +1,195 @@
+/*
+ * Copyright (c) Contributors to the Open 3D Engine Project.
+ * For complete copyright and license terms please see the LICENSE at the root of this distribution.
+ *
+ * SPDX-License-Identifier: Apache-2.0 OR MIT
+ *
+ */
+#pragma once
+
+#include <AzCore/Interface/Interface.h>
+#include <AzCore/RTTI/RTTI.h>
+#include <AzCore/std/chrono/chrono.h>
+#include <AzCore/std/containers/vector.h>
+#include <AzCore/std/parallel/atomic.h>
+#include <AzCore/std/parallel/mutex.h>
+#include <AzCore/std/smart_ptr/shared_ptr.h>
+#include <AzCore/std/string/string.h>
+#include <AzCore/std/typetraits/typetraits.h>
+#include <AzCore/std/utils.h>
+#include <ROS2/Utilities/P2QuantileEstimator.h>
+#include <rclcpp/serialization.hpp>
+#include <rclcpp/serialized_message.hpp>
+
+namespace ROS2
+{
+    namespace Internal
+    {
+        //! Whether a message keeps its payload in a `data` buffer, which dominates its serialized size.
+        template<class MessageT, class = void>
+        struct HasDataBuffer : AZStd::false_type
+        {
+        };
+
+        template<class MessageT>
+        struct HasDataBuffer<MessageT, AZStd::void_t<decltype(AZStd::declval<const MessageT&>().data.size())>> : AZStd::true_type
+        {
+        };
+    } // namespace Internal
+
+    //! Callbacks of a sensor, as started with ROS2SensorComponentBase::StartSensor.
+    enum class SensorCallbackType : AZ::u8
+    {
+        Source, //!< Called with the frequency of the event source.
+        Adapted, //!< Called with the frequency of the sensor.
+        Count
+    };
+
+    //! Execution time statistics of one callback of a sensor. Durations are in milliseconds.
+    struct SensorCallbackStatistics
+    {
+        AZ::u64 m_callCount = 0;
+        double m_meanDuration = 0.0;
+        double m_99thPercentileDuration = 0.0;
+        double m_maxDuration = 0.0;
+    };
+
+    //! Statistics of one sensor since it was started.
+    struct SensorStatistics
+    {
+        AZStd::string m_sensorName;
+        SensorCallbackStatistics m_callbacks[static_cast<size_t>(SensorCallbackType::Count)];
+        //! Serialized size of published messages. Large messages count the size of their data buffers only.
+        AZ::u64 m_publishedBytes = 0;
+    };
+
+    //! Records execution times of callbacks of a single sensor, and the amount of data it publishes.
+    //! Recent callbacks are also kept as trace events, to be exported in the Chrome trace format.
+    //! Callbacks may be recorded and statistics read from different threads.
+    class SensorProfile
+    {
+    public:
+        using Clock = AZStd::chrono::steady_clock;
+
+        //! Number of most recent callbacks kept as trace events.
+        static constexpr size_t TraceEventCapacity = 4096;
+
+        explicit SensorProfile(AZStd::string sensorName);
+
+        void RecordCallback(SensorCallbackType type, Clock::time_point start, Clock::time_point end);
+
+        //! Records data published by the sensor. May be called from any thread, e.g. a publisher thread.
+        void RecordPublishedBytes(size_t byteCount);
+
+        //! Records the size of a message published by the sensor. Messages with a data buffer, such as images and point clouds,
+        //! record the size of the buffer. Other messages are serialized once more to measure their size as sent by the middleware,
+        //! so this should be called on the thread which publishes them, rather than in a sensor callback.
+        template<class MessageT>
+        void RecordPublishedMessage(const MessageT& message)
+        {
+            if constexpr (Internal::HasDataBuffer<MessageT>::value)
+            {
+                RecordPublishedBytes(message.data.size());
+            }
+            else
+            {
+                static const rclcpp::Serialization<MessageT> serialization;
+                // Reuses the buffer between messages of the same thread.
+                thread_local rclcpp::SerializedMessage serializedMessage;
+                serialization.serialize_message(&message, &serializedMessage);
+                RecordPublishedBytes(serializedMessage.size());
+            }
+        }
+
+        const AZStd::string& GetSensorName() const;
+
+        SensorStatistics GetStatistics() const;
+
+        //! Appends recent callbacks as complete ("X") events of the Chrome trace event format.
+        //! @param traceEvents JSON array contents to append to, with events separated by commas.
+        //! @param epoch Time which trace timestamps are relative to.
+        //! @param threadId Trace thread id, which puts the events of the sensor on a separate track.
+        void AppendTraceEvents(AZStd::string& traceEvents, Clock::time_point epoch, size_t threadId) const;
+
+    private:
+        struct CallbackRecord
+        {
+            AZ::u64 m_callCount = 0;
+            AZ::u64 m_totalDurationNanoseconds = 0;
+            AZ::u64 m_maxDurationNanoseconds = 0;
+            P2QuantileEstimator m_99thPercentileDuration{ 0.99 };
+        };
+
+        struct TraceEvent
+        {
+            Clock::time_point m_start;
+            Clock::duration m_duration;
+            SensorCallbackType m_type;
+        };
+
+        AZStd::string m_sensorName;
+        mutable AZStd::mutex m_mutex;
+        CallbackRecord m_callbacks[static_cast<size_t>(SensorCallbackType::Count)];
+        //! Ring buffer of recent callbacks, filled up to its capacity.
+        AZStd::vector<TraceEvent> m_traceEvents;
+        size_t m_nextTraceEvent = 0;
+        AZStd::atomic<AZ::u64> m_publishedBytes{ 0 };
+    };
+
+    //! Times the enclosing scope as a callback of a sensor. Does nothing without a profile.
+    class SensorProfileScope
+    {
+    public:
+        SensorProfileScope(SensorProfile* profile, SensorCallbackType type)
+            : m_profile(profile)
+            , m_type(type)
+        {
+            if (m_profile)
+            {
+                m_start = SensorProfile::Clock::now();
+            }
+        }
+
+        ~SensorProfileScope()
+        {
+            if (m_profile)
+            {
+                m_profile->RecordCallback(m_type, m_start, SensorProfile::Clock::now());
+            }
+        }
+
+        SensorProfileScope(const SensorProfileScope&) = delete;
+        SensorProfileScope& operator=(const SensorProfileScope&) = delete;
+
+    private:
+        SensorProfile* m_profile;
+        SensorCallbackType m_type;
+        SensorProfile::Clock::time_point m_start;
+    };
+
+    //! Registry of profiles of all running sensors. Available only when sensor profiling is enabled with the
+    //! "/O3DE/ROS2/SensorProfiler/Enabled" setting, in which case statistics are also published on the `/o3de/sensor_stats`
+    //! topic and served by the `/o3de/get_sensor_stats` and `/o3de/export_sensor_trace` services.
+    class SensorProfilerRequests
+    {
+    public:
+        AZ_RTTI(SensorProfilerRequests, "{6B0D3A57-7C86-4C3E-9E0B-4E2B3A8F1D29}");
+        virtual ~SensorProfilerRequests() = default;
+
+        //! Creates a profile for a starting sensor.
+        virtual AZStd::shared_ptr<SensorProfile> RegisterSensor(const AZStd::string& sensorName) = 0;
+
+        //! Removes the profile of a stopped sensor from the registry.
+        virtual void UnregisterSensor(const AZStd::shared_ptr<SensorProfile>& profile) = 0;
+
+        //! Returns statistics of all registered sensors.
+        virtual AZStd::vector<SensorStatistics> GetSensorStatistics() const = 0;
+
+        //! Writes recent callbacks of all registered sensors to a file in the Chrome trace event format,
+        //! which can be opened with chrome://tracing or Perfetto.
+        //! @return Whether the file was written.
+        virtual bool ExportChromeTrace(const AZStd::string& filePath) const = 0;
+    };
+
+    using SensorProfilerInterface = AZ::Interface<SensorProfilerRequests>;
+} // namespace ROS2
@@ -0,0 +1,300 @@
+/*
+ * Copyright (c) Contributors to the Open 3D Engine Project.
+ * For complete copyright and license terms please see the LICENSE at the root of this distribution.
+ *
+ * SPDX-License-Identifier: Apache-2.0 OR MIT
+ *
+ */
+
+#pragma once
+
+#include <AzCore/Interface/Interface.h>
+#include <AzCore/RTTI/RTTI.h>
+#include <AzCore/std/containers/vector.h>
+#include <AzCore/std/parallel/atomic.h>
+#include <AzCore/std/parallel/mutex.h>
+#include <AzCore/std/smart_ptr/shared_ptr.h>
+#include <AzCore/std/smart_ptr/unique_ptr.h>
+#include <AzCore/std/string/string.h>
+#include <ROS2/ROS2Bus.h>
+#include <ROS2/Sensor/SensorProfiler.h>
+#include <ROS2/Utilities/SpscRingBuffer.h>
+#include <memory>
+#include <rclcpp/node.hpp>
+#include <rclcpp/publisher.hpp>
+
+namespace ROS2
+{
+    //! Backpressure statistics of a sensor publisher.
+    struct SensorPublisherStatistics
+    {
+        AZStd::string m_topicName;
+        AZ::u64 m_publishedCount = 0;
+        //! Messages dropped because all pooled messages were waiting for publication.
+        AZ::u64 m_droppedCount = 0;
+        //! Highest number of messages waiting for publication at once.
+        AZ::u64 m_maxQueueDepth = 0;
+    };
+
+    //! Source of messages published on the sensor publishing thread.
+    class SensorPublicationChannel
+    {
+    public:
+        virtual ~SensorPublicationChannel() = default;
+
+        //! Publishes all queued messages. Called on the publishing thread.
+        virtual void PublishPending() = 0;
+
+        virtual SensorPublisherStatistics GetStatistics() const = 0;
+    };
+
+    //! Thread which serializes and publishes sensor messages, so that sensors do not spend time in the middleware on the thread of
+    //! their event source. Available unless disabled with the "/O3DE/ROS2/SensorPublishing/Threaded" setting, in which case sensor
+    //! publishers publish in place.
+    class SensorPublishingRequests
+    {
+    public:
+        AZ_RTTI(SensorPublishingRequests, "{A4E9C3D2-5B17-4F6A-8E0D-2C7B9F1A6E35}");
+        virtual ~SensorPublishingRequests() = default;
+
+        virtual void RegisterChannel(SensorPublicationChannel* channel) = 0;
+
+        //! Unregisters a channel. Once this returns, the publishing thread does not use the channel anymore.
+        virtual void UnregisterChannel(SensorPublicationChannel* channel) = 0;
+
+        //! Wakes the publishing thread up to publish queued messages.
+        virtual void NotifyPending() = 0;
+
+        //! Returns statistics of all registered channels.
+        virtual AZStd::vector<SensorPublisherStatistics> GetStatistics() const = 0;
+    };
+
+    using SensorPublishingInterface = AZ::Interface<SensorPublishingRequests>;
+
+    //! Returns options for a publisher of sensor messages. When intra-process communication is enabled, the publisher hands messages
+    //! over to subscriptions in the simulator process without serialization. rclcpp supports this only for volatile publishers
+    //! with a bounded history, so other publishers keep the setting of the node.
+    inline rclcpp::PublisherOptions GetSensorPublisherOptions(const rclcpp::QoS& qos)
+    {
+        rclcpp::PublisherOptions options;
+        auto* ros2 = ROS2Interface::Get();
+        if (ros2 && ros2->IsIntraProcessEnabled() && qos.durability() == rclcpp::DurabilityPolicy::Volatile &&
+            qos.history() == rclcpp::HistoryPolicy::KeepLast && qos.depth() > 0)
+        {
+            options.use_intra_process_comm = rclcpp::IntraProcessSetting::Enable;
+        }
+        return options;
+    }
+
+    //! Publishes messages of a sensor on the sensor publishing thread. Messages come from a fixed pool, so publishing does not
+    //! allocate on the thread of the sensor: a sensor either acquires a message, fills it and submits it, or copies its own message
+    //! with Publish. The publishing thread returns messages to the pool once they are published. When the pool runs out, messages
+    //! are dropped and counted. A sensor publisher must be used from a single thread, the one of the sensor event source.
+    //! Pooled messages keep their buffers across publications, so filling a message with as much data as before does not allocate.
+    //! Subscriptions in this process take ownership of what they receive. Messages with a data buffer, such as images and point
+    //! clouds, are moved to them without a copy, and the publishing thread replaces the moved message in the pool with a new one,
+    //! which reserves as much data as the moved message. Other messages are small, so subscriptions get a copy of them, while the
+    //! pooled message stays with the pool.
+    //! @tparam MessageT Type of the ROS 2 message.
+    template<typename MessageT>
+    class SensorPublisher : public SensorPublicationChannel
+    {
+    public:
+        //! Default number of pooled messages, which bounds messages waiting for publication.
+        static constexpr size_t DefaultPoolSize = 4;
+
+        //! @param publisher Publisher used on the publishing thread.
+        //! @param poolSize Number of pooled messages.
+        explicit SensorPublisher(typename rclcpp::Publisher<MessageT>::SharedPtr publisher, size_t poolSize = DefaultPoolSize)
+            : m_publisher(AZStd::move(publisher))
+            , m_freeMessages(poolSize)
+            , m_pendingMessages(poolSize)
+        {
+            for (size_t i = 0; i < poolSize; ++i)
+            {
+                m_freeMessages.Push(std::make_unique<MessageT>());
+            }
+            m_acquiredMessages.reserve(poolSize);
+            if (auto* publishingThread = SensorPublishingInterface::Get())
+            {
+                publishingThread->RegisterChannel(this);
+                m_isThreaded = true;
+            }
+        }
+
+        ~SensorPublisher() override
+        {
+            if (auto* publishingThread = SensorPublishingInterface::Get(); publishingThread && m_isThreaded)
+            {
+                publishingThread->UnregisterChannel(this);
+            }
+        }
+
+        SensorPublisher(const SensorPublisher&) = delete;
+        SensorPublisher& operator=(const SensorPublisher&) = delete;
+
+        //! Creates a publisher on a node, with options from GetSensorPublisherOptions.
+        //! @param node Node to create the publisher on.
+        //! @param topicName Name of the ROS 2 topic.
+        //! @param qos QoS policy of published messages.
+        //! @param poolSize Number of pooled messages.
+        static AZStd::unique_ptr<SensorPublisher> Create(
+            const rclcpp::Node::SharedPtr& node, const AZStd::string& topicName, const rclcpp::QoS& qos, size_t poolSize = DefaultPoolSize)
+        {
+            return AZStd::make_unique<SensorPublisher>(
+                node->create_publisher<MessageT>(topicName.data(), qos, GetSensorPublisherOptions(qos)), poolSize);
+        }
+
+        //! Takes a free message from the pool. The message may keep content from previous use, so all fields must be set.
+        //! @return Message to fill, or nullptr if all messages are waiting for publication, in which case the message is dropped.
+        MessageT* AcquireMessage()
+        {
+            std::unique_ptr<MessageT> message;
+            if (!m_freeMessages.Pop(message))
+            {
+                ++m_droppedCount;
+                return nullptr;
+            }
+            m_acquiredMessages.push_back(AZStd::move(message));
+            return m_acquiredMessages.back().get();
+        }
+
+        //! Queues a message acquired with AcquireMessage for publication.
+        void Submit(MessageT* message)
+        {
+            std::unique_ptr<MessageT> pooledMessage = TakeAcquiredMessage(message);
+            if (!pooledMessage)
+            {
+                AZ_Assert(false, "Submitted a message that does not come from the pool.");
+                return;
+            }
+
+            if (!m_isThreaded)
+            {
+                PublishMessage(AZStd::move(pooledMessage));
+                return;
+            }
+
+            // Cannot fail, since there are never more messages in flight than the pool size.
+            m_pendingMessages.Push(AZStd::move(pooledMessage));
+            const AZ::u64 queueDepth = m_pendingMessages.Size();
+            if (queueDepth > m_maxQueueDepth.load(AZStd::memory_order_relaxed))
+            {
+                m_maxQueueDepth.store(queueDepth, AZStd::memory_order_relaxed);
+            }
+            if (auto* publishingThread = SensorPublishingInterface::Get())
+            {
+                publishingThread->NotifyPending();
+            }
+        }
+
+        //! Copies a message to a pooled message and queues it for publication.
+        //! @return Whether the message was queued, false if it was dropped.
+        bool Publish(const MessageT& message)
+        {
+            MessageT* pooledMessage = AcquireMessage();
+            if (!pooledMessage)
+            {
+                return false;
+            }
+            // Assignment reuses the storage of strings and sequences of the pooled message.
+            *pooledMessage = message;
+            Submit(pooledMessage);
+            return true;
+        }
+
+        //! Records published messages in a profile of the sensor, with SensorProfile::RecordPublishedMessage. Sizes are measured
+        //! where messages are published, which is the publishing thread unless sensor publishers publish in place.
+        //! @param sensorProfile Profile of the sensor, or nullptr to stop recording.
+        void SetSensorProfile(AZStd::shared_ptr<SensorProfile> sensorProfile)
+        {
+            AZStd::scoped_lock lock(m_sensorProfileMutex);
+            m_sensorProfile = AZStd::move(sensorProfile);
+        }
+
+        // SensorPublicationChannel overrides
+        void PublishPending() override
+        {
+            std::unique_ptr<MessageT> message;
+            while (m_pendingMessages.Pop(message))
+            {
+                PublishMessage(AZStd::move(message));
+            }
+        }
+
+        SensorPublisherStatistics GetStatistics() const override
+        {
+            SensorPublisherStatistics statistics;
+            statistics.m_topicName = m_publisher->get_topic_name();
+            statistics.m_publishedCount = m_publishedCount.load(AZStd::memory_order_relaxed);
+            statistics.m_droppedCount = m_droppedCount.load(AZStd::memory_order_relaxed);
+            statistics.m_maxQueueDepth = m_maxQueueDepth.load(AZStd::memory_order_relaxed);
+            return statistics;
+        }
+
+    private:
+        //! Removes a message from the messages acquired by the sensor, which are at most as many as pooled messages.
+        std::unique_ptr<MessageT> TakeAcquiredMessage(MessageT* message)
+        {
+            for (size_t i = 0; i < m_acquiredMessages.size(); ++i)
+            {
+                if (m_acquiredMessages[i].get() == message)
+                {
+                    std::unique_ptr<MessageT> acquiredMessage = AZStd::move(m_acquiredMessages[i]);
+                    m_acquiredMessages[i] = AZStd::move(m_acquiredMessages.back());
+                    m_acquiredMessages.pop_back();
+                    return acquiredMessage;
+                }
+            }
+            return nullptr;
+        }
+
+        //! Publishes a message and returns it, or the message which replaces it, to the pool.
+        void PublishMessage(std::unique_ptr<MessageT> message)
+        {
+            {
+                AZStd::scoped_lock lock(m_sensorProfileMutex);
+                if (m_sensorProfile)
+                {
+                    m_sensorProfile->RecordPublishedMessage(*message);
+                }
+            }
+
+            if constexpr (Internal::HasDataBuffer<MessageT>::value)
+            {
+                if (m_publisher->get_intra_process_subscription_count() > 0)
+                {
+                    // Moving saves the copy of the data for intra-process subscriptions. Publishing by reference would copy it.
+                    auto replacement = std::make_unique<MessageT>();
+                    replacement->data.reserve(message->data.capacity());
+                    m_publisher->publish(std::move(message));
+                    ++m_publishedCount;
+                    m_freeMessages.Push(AZStd::move(replacement));
+                    return;
+                }
+            }
+
+            // Publishing by reference serializes the message for subscriptions in other processes, and copies it for intra-process
+            // subscriptions only, so the pooled message keeps its buffers.
+            m_publisher->publish(*message);
+            ++m_publishedCount;
+            m_freeMessages.Push(AZStd::move(message));
+        }
+
+        typename rclcpp::Publisher<MessageT>::SharedPtr m_publisher;
+        //! Messages returned by the publishing thread, ready to be filled.
+        SpscRingBuffer<std::unique_ptr<MessageT>> m_freeMessages;
+        //! Filled messages waiting for the publishing thread.
+        SpscRingBuffer<std::unique_ptr<MessageT>> m_pendingMessages;
+        //! Messages acquired by the sensor, but not submitted yet. Used only by the thread of the sensor.
+        AZStd::vector<std::unique_ptr<MessageT>> m_acquiredMessages;
+        bool m_isThreaded = false;
+
+        AZStd::mutex m_sensorProfileMutex;
+        AZStd::shared_ptr<SensorProfile> m_sensorProfile;
+
+        AZStd::atomic<AZ::u64> m_publishedCount{ 0 };
+        AZStd::atomic<AZ::u64> m_droppedCount{ 0 };
+        AZStd::atomic<AZ::u64> m_maxQueueDepth{ 0 };
+    };
+} // namespace ROS2
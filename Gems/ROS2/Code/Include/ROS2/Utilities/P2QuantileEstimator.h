@@ -0,0 +1,153 @@
+/*
+ * Copyright (c) Contributors to the Open 3D Engine Project.
+ * For complete copyright and license terms please see the LICENSE at the root of this distribution.
+ *
+ * SPDX-License-Identifier: Apache-2.0 OR MIT
+ *
+ */
+#pragma once
+
+#include <AzCore/base.h>
+#include <AzCore/std/containers/array.h>
+#include <AzCore/std/sort.h>
+
+namespace ROS2
+{
+    //! Streaming estimator of a single quantile, using the P-square algorithm (Jain and Chlamtac, 1985).
+    //! Keeps five markers instead of the observations, so adding an observation and reading the estimate are constant time
+    //! and constant memory. Estimates are exact for the first five observations.
+    class P2QuantileEstimator
+    {
+    public:
+        //! @param quantile Estimated quantile, in range (0, 1), e.g. 0.5 for the median.
+        explicit P2QuantileEstimator(double quantile)
+            : m_quantile(quantile)
+        {
+            AZ_Assert(quantile > 0.0 && quantile < 1.0, "Quantile %f is out of range (0, 1).", quantile);
+            Reset();
+        }
+
+        //! Forgets all observations.
+        void Reset()
+        {
+            m_count = 0;
+            m_increments = { 0.0, m_quantile / 2.0, m_quantile, (1.0 + m_quantile) / 2.0, 1.0 };
+            m_desiredPositions = { 0.0, 2.0 * m_quantile, 4.0 * m_quantile, 2.0 + 2.0 * m_quantile, 4.0 };
+            m_positions = { 0, 1, 2, 3, 4 };
+        }
+
+        void Add(double value)
+        {
+            if (m_count < MarkerCount)
+            {
+                m_heights[m_count++] = value;
+                if (m_count == MarkerCount)
+                {
+                    AZStd::sort(m_heights.begin(), m_heights.end());
+                }
+                return;
+            }
+            ++m_count;
+
+            // Find the cell of the value, extending the extreme markers if it falls outside of them.
+            size_t cell = 0;
+            if (value < m_heights[0])
+            {
+                m_heights[0] = value;
+            }
+            else if (value >= m_heights[4])
+            {
+                m_heights[4] = value;
+                cell = 3;
+            }
+            else
+            {
+                while (value >= m_heights[cell + 1])
+                {
+                    ++cell;
+                }
+            }
+
+            for (size_t i = cell + 1; i < MarkerCount; ++i)
+            {
+                ++m_positions[i];
+            }
+            for (size_t i = 0; i < MarkerCount; ++i)
+            {
+                m_desiredPositions[i] += m_increments[i];
+            }
+
+            // Move the middle markers towards their desired positions, by at most one position each.
+            for (size_t i = 1; i < MarkerCount - 1; ++i)
+            {
+                const double offset = m_desiredPositions[i] - m_positions[i];
+                const bool canMoveRight = offset >= 1.0 && m_positions[i + 1] - m_positions[i] > 1;
+                const bool canMoveLeft = offset <= -1.0 && m_positions[i - 1] - m_positions[i] < -1;
+                if (canMoveRight || canMoveLeft)
+                {
+                    const AZ::s64 step = offset > 0.0 ? 1 : -1;
+                    const double height = Parabolic(i, step);
+                    if (m_heights[i - 1] < height && height < m_heights[i + 1])
+                    {
+                        m_heights[i] = height;
+                    }
+                    else
+                    {
+                        m_heights[i] = Linear(i, step);
+                    }
+                    m_positions[i] += step;
+                }
+            }
+        }
+
+        //! @return Estimated quantile of all observations since the last reset, or 0 if there are none.
+        double GetEstimate() const
+        {
+            if (m_count == 0)
+            {
+                return 0.0;
+            }
+            if (m_count < MarkerCount)
+            {
+                AZStd::array<double, MarkerCount> sorted = m_heights;
+                AZStd::sort(sorted.begin(), sorted.begin() + m_count);
+                return sorted[static_cast<size_t>(m_quantile * (m_count - 1) + 0.5)];
+            }
+            return m_heights[2];
+        }
+
+        AZ::u64 GetCount() const
+        {
+            return m_count;
+        }
+
+    private:
+        static constexpr size_t MarkerCount = 5;
+
+        double Parabolic(size_t i, AZ::s64 step) const
+        {
+            const double d = static_cast<double>(step);
+            const double left = static_cast<double>(m_positions[i] - m_positions[i - 1]);
+            const double right = static_cast<double>(m_positions[i + 1] - m_positions[i]);
+            return m_heights[i] +
+                d / (left + right) *
+                ((left + d) * (m_heights[i + 1] - m_heights[i]) / right + (right - d) * (m_heights[i] - m_heights[i - 1]) / left);
+        }
+
+        double Linear(size_t i, AZ::s64 step) const
+        {
+            const size_t neighbor = step > 0 ? i + 1 : i - 1;
+            const double distance = static_cast<double>(m_positions[neighbor] - m_positions[i]);
+            return m_heights[i] + static_cast<double>(step) * (m_heights[neighbor] - m_heights[i]) / distance;
+        }
+
+        double m_quantile;
+        AZ::u64 m_count = 0;
+        //! Marker heights, which estimate the minimum, the quantile halfway to it, the quantile and so on up to the maximum.
+        AZStd::array<double, MarkerCount> m_heights{};
+        //! Actual positions of the markers, as ranks of observations.
+        AZStd::array<AZ::s64, MarkerCount> m_positions{};
+        AZStd::array<double, MarkerCount> m_desiredPositions{};
+        AZStd::array<double, MarkerCount> m_increments{};
+    };
+} // namespace ROS2
@@ -0,0 +1,93 @@
+/*
+ * Copyright (c) Contributors to the Open 3D Engine Project.
+ * For complete copyright and license terms please see the LICENSE at the root of this distribution.
+ *
+ * SPDX-License-Identifier: Apache-2.0 OR MIT
+ *
+ */
+#pragma once
+
+#include <AzCore/std/containers/vector.h>
+#include <AzCore/std/parallel/atomic.h>
+
+namespace ROS2
+{
+    //! Bounded lock-free queue for exactly one producer thread and one consumer thread.
+    //! Slots are allocated once, at construction, so pushing and popping never allocates.
+    //! @tparam T Type of queued elements. Should be cheap to move (e.g. a pointer to a pooled object).
+    template<typename T>
+    class SpscRingBuffer
+    {
+    public:
+        //! @param capacity Maximum number of elements the queue holds at once.
+        explicit SpscRingBuffer(size_t capacity)
+            : m_slots(capacity + 1) // One slot stays empty to tell a full queue from an empty one.
+        {
+        }
+
+        SpscRingBuffer(const SpscRingBuffer&) = delete;
+        SpscRingBuffer& operator=(const SpscRingBuffer&) = delete;
+
+        //! Adds an element at the back of the queue. Must only be called from the producer thread.
+        //! @return false if the queue is full, in which case the element is left untouched.
+        bool Push(T&& value)
+        {
+            const size_t tail = m_tail.load(AZStd::memory_order_relaxed);
+            const size_t nextTail = Next(tail);
+            if (nextTail == m_head.load(AZStd::memory_order_acquire))
+            {
+                return false;
+            }
+
+            m_slots[tail] = AZStd::move(value);
+            m_tail.store(nextTail, AZStd::memory_order_release);
+            return true;
+        }
+
+        bool Push(const T& value)
+        {
+            T copy = value;
+            return Push(AZStd::move(copy));
+        }
+
+        //! Removes the element at the front of the queue. Must only be called from the consumer thread.
+        //! @return false if the queue is empty.
+        bool Pop(T& value)
+        {
+            const size_t head = m_head.load(AZStd::memory_order_relaxed);
+            if (head == m_tail.load(AZStd::memory_order_acquire))
+            {
+                return false;
+            }
+
+            value = AZStd::move(m_slots[head]);
+            m_head.store(Next(head), AZStd::memory_order_release);
+            return true;
+        }
+
+        //! Number of queued elements. Exact only when called from the producer or the consumer thread.
+        size_t Size() const
+        {
+            const size_t head = m_head.load(AZStd::memory_order_acquire);
+            const size_t tail = m_tail.load(AZStd::memory_order_acquire);
+            return tail >= head ? tail - head : tail + m_slots.size() - head;
+        }
+
+        size_t Capacity() const
+        {
+            return m_slots.size() - 1;
+        }
+
+    private:
+        size_t Next(size_t index) const
+        {
+            return index + 1 == m_slots.size() ? 0 : index + 1;
+        }
+
+        AZStd::vector<T> m_slots;
+        //! Index of the next element to pop, written only by the consumer.
+        alignas(64) AZStd::atomic<size_t> m_head{ 0 };
+        //! Index of the next slot to push into, written only by the producer.
+        alignas(64) AZStd::atomic<size_t> m_tail{ 0 };
+    };
+} // namespace ROS2
@@ -0,0 +1,135 @@
+/*
+ * Copyright (c) Contributors to the Open 3D Engine Project.
+ * For complete copyright and license terms please see the LICENSE at the root of this distribution.
+ *
+ * SPDX-License-Identifier: Apache-2.0 OR MIT
+ *
+ */
+
+#include "CameraAtlas.h"
+#include "CameraPostProcessingPipeline.h"
+
+#include <AzCore/std/algorithm.h>
+#include <cmath>
+
+namespace ROS2
+{
+    bool CameraAtlasLayout::AreCompatible(const CameraSensorConfiguration& first, const CameraSensorConfiguration& second)
+    {
+        return first.m_atlasReadback && second.m_atlasReadback && first.m_width == second.m_width && first.m_height == second.m_height &&
+            first.m_colorCamera == second.m_colorCamera && first.m_depthCamera == second.m_depthCamera;
+    }
+
+    AZ::u32 CameraAtlasLayout::GetMaxTileCount(AZ::u32 tileWidth, AZ::u32 tileHeight)
+    {
+        if (tileWidth == 0 || tileHeight == 0)
+        {
+            return 0;
+        }
+        return (MaxAtlasSize / tileWidth) * (MaxAtlasSize / tileHeight);
+    }
+
+    CameraAtlasLayout::CameraAtlasLayout(AZ::u32 tileWidth, AZ::u32 tileHeight, AZ::u32 tileCount)
+        : m_tileWidth(tileWidth)
+        , m_tileHeight(tileHeight)
+        , m_tileCount(tileCount)
+    {
+        AZ_Assert(
+            tileCount >= 1 && tileCount <= GetMaxTileCount(tileWidth, tileHeight),
+            "%u tiles of %ux%u do not fit in an atlas.",
+            tileCount,
+            tileWidth,
+            tileHeight);
+
+        // Columns are bounded by the atlas width, and by the atlas height through the rows which they need.
+        const AZ::u32 count = AZStd::max<AZ::u32>(tileCount, 1);
+        const AZ::u32 maxColumnCount = AZStd::max<AZ::u32>(MaxAtlasSize / AZStd::max<AZ::u32>(tileWidth, 1), 1);
+        const AZ::u32 maxRowCount = AZStd::max<AZ::u32>(MaxAtlasSize / AZStd::max<AZ::u32>(tileHeight, 1), 1);
+        const AZ::u32 minColumnCount = (count + maxRowCount - 1) / maxRowCount;
+        const auto squareColumnCount = static_cast<AZ::u32>(std::ceil(std::sqrt(static_cast<double>(count))));
+        m_columnCount = AZStd::min(AZStd::max(squareColumnCount, minColumnCount), maxColumnCount);
+        m_rowCount = (count + m_columnCount - 1) / m_columnCount;
+    }
+
+    AZ::u32 CameraAtlasLayout::GetTileWidth() const
+    {
+        return m_tileWidth;
+    }
+
+    AZ::u32 CameraAtlasLayout::GetTileHeight() const
+    {
+        return m_tileHeight;
+    }
+
+    AZ::u32 CameraAtlasLayout::GetTileCount() const
+    {
+        return m_tileCount;
+    }
+
+    AZ::u32 CameraAtlasLayout::GetColumnCount() const
+    {
+        return m_columnCount;
+    }
+
+    AZ::u32 CameraAtlasLayout::GetAtlasWidth() const
+    {
+        return m_columnCount * m_tileWidth;
+    }
+
+    AZ::u32 CameraAtlasLayout::GetAtlasHeight() const
+    {
+        return m_rowCount * m_tileHeight;
+    }
+
+    AZStd::pair<AZ::u32, AZ::u32> CameraAtlasLayout::GetTileOrigin(AZ::u32 tileIndex) const
+    {
+        AZ_Assert(tileIndex < m_tileCount, "Tile %u is not in the atlas of %u tiles.", tileIndex, m_tileCount);
+        return { (tileIndex % m_columnCount) * m_tileWidth, (tileIndex / m_columnCount) * m_tileHeight };
+    }
+
+    CameraUtils::ImageView CameraAtlasLayout::GetTileView(const CameraUtils::ImageView& atlas, AZ::u32 tileIndex) const
+    {
+        AZ_Assert(
+            atlas.m_width == GetAtlasWidth() && atlas.m_height == GetAtlasHeight(), "Atlas image does not have the size of the layout.");
+        const auto [x, y] = GetTileOrigin(tileIndex);
+        CameraUtils::ImageView tile;
+        tile.m_data = atlas.m_data + y * atlas.m_step + size_t{ x } * CameraUtils::GetPixelSize(atlas.m_format);
+        tile.m_width = m_tileWidth;
+        tile.m_height = m_tileHeight;
+        tile.m_step = atlas.m_step;
+        tile.m_format = atlas.m_format;
+        return tile;
+    }
+
+    bool SubmitAtlasTiles(
+        const CameraAtlasLayout& layout,
+        const AZ::RPI::AttachmentReadback::ReadbackResult& result,
+        AZStd::span<const CameraAtlasRequest> requests)
+    {
+        const CameraUtils::ImageView atlas = CameraUtils::GetImageView(result);
+        if (atlas.m_width != layout.GetAtlasWidth() || atlas.m_height != layout.GetAtlasHeight() || !atlas.m_data)
+        {
+            AZ_Error(
+                "CameraAtlas",
+                false,
+                "Atlas readback of %ux%u does not match the layout of %ux%u.",
+                atlas.m_width,
+                atlas.m_height,
+                layout.GetAtlasWidth(),
+                layout.GetAtlasHeight());
+            return false;
+        }
+
+        AZ_Assert(requests.size() <= layout.GetTileCount(), "More atlas requests than tiles.");
+        const AZ::u32 requestCount = AZStd::min(static_cast<AZ::u32>(requests.size()), layout.GetTileCount());
+        for (AZ::u32 tileIndex = 0; tileIndex < requestCount; ++tileIndex)
+        {
+            const CameraAtlasRequest& request = requests[tileIndex];
+            if (request.m_pipeline)
+            {
+                request.m_pipeline->Submit(layout.GetTileView(atlas, tileIndex), request.m_header, request.m_infoMessage);
+            }
+        }
+        return true;
+    }
+} // namespace ROS2
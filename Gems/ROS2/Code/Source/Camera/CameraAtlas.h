@@ -0,0 +1,79 @@
+/*
+ * Copyright (c) Contributors to the Open 3D Engine Project.
+ * For complete copyright and license terms please see the LICENSE at the root of this distribution.
+ *
+ * SPDX-License-Identifier: Apache-2.0 OR MIT
+ *
+ */
+#pragma once
+
+#include "CameraSensorConfiguration.h"
+#include "CameraUtilities.h"
+
+#include <AzCore/std/containers/span.h>
+#include <AzCore/std/smart_ptr/shared_ptr.h>
+#include <AzCore/std/utils.h>
+#include <sensor_msgs/msg/camera_info.hpp>
+
+namespace ROS2
+{
+    class CameraPostProcessingPipeline;
+
+    //! Layout of an atlas, an image with the images of several cameras of the same size as tiles, which is read back at once.
+    //! Tiles fill a grid row by row, and the grid is as close to square as the largest atlas size allows, which keeps the atlas
+    //! without unused tiles for common camera counts (e.g. 6 tiles of 320x240 make a 960x480 atlas).
+    class CameraAtlasLayout
+    {
+    public:
+        //! Largest width and height of an atlas, which every renderer supports for render targets.
+        static constexpr AZ::u32 MaxAtlasSize = 4096;
+
+        //! Query whether images of two cameras can be tiles of the same atlas: both need to opt in to atlas readback, and they need
+        //! the same size and the same channels. Projections may differ, since every tile is rendered with the view of its camera.
+        static bool AreCompatible(const CameraSensorConfiguration& first, const CameraSensorConfiguration& second);
+
+        //! Returns how many tiles of a size fit in an atlas.
+        static AZ::u32 GetMaxTileCount(AZ::u32 tileWidth, AZ::u32 tileHeight);
+
+        //! Lays out tiles of a size, of which there are at least 1 and at most GetMaxTileCount.
+        CameraAtlasLayout(AZ::u32 tileWidth, AZ::u32 tileHeight, AZ::u32 tileCount);
+
+        AZ::u32 GetTileWidth() const;
+        AZ::u32 GetTileHeight() const;
+        AZ::u32 GetTileCount() const;
+        AZ::u32 GetColumnCount() const;
+        AZ::u32 GetAtlasWidth() const;
+        AZ::u32 GetAtlasHeight() const;
+
+        //! Returns the position of the top left pixel of a tile in the atlas.
+        AZStd::pair<AZ::u32, AZ::u32> GetTileOrigin(AZ::u32 tileIndex) const;
+
+        //! Returns a view of a tile of an atlas image, which points into the atlas data without copying it.
+        //! @param atlas View of the whole atlas, which has the size of the layout.
+        CameraUtils::ImageView GetTileView(const CameraUtils::ImageView& atlas, AZ::u32 tileIndex) const;
+
+    private:
+        AZ::u32 m_tileWidth = 0;
+        AZ::u32 m_tileHeight = 0;
+        AZ::u32 m_tileCount = 0;
+        AZ::u32 m_columnCount = 0;
+        AZ::u32 m_rowCount = 0;
+    };
+
+    //! Request of a camera for its tile of an atlas frame, with everything needed to publish the tile.
+    struct CameraAtlasRequest
+    {
+        AZStd::shared_ptr<CameraPostProcessingPipeline> m_pipeline; //!< Pipeline of the channel, or nullptr to skip the tile.
+        std_msgs::msg::Header m_header;
+        sensor_msgs::msg::CameraInfo m_infoMessage;
+    };
+
+    //! Hands the tiles of an atlas readback over to the post-processing pipelines of their cameras, with the request of each tile
+    //! at its index. Each pipeline copies its tile straight from the readback into its message, so an atlas costs the same copies as
+    //! separate readbacks of the cameras.
+    //! @return Whether the readback had the size of the layout, without which no tile is submitted.
+    bool SubmitAtlasTiles(
+        const CameraAtlasLayout& layout,
+        const AZ::RPI::AttachmentReadback::ReadbackResult& result,
+        AZStd::span<const CameraAtlasRequest> requests);
+} // namespace ROS2
@@ -0,0 +1,173 @@
+/*
+ * Copyright (c) Contributors to the Open 3D Engine Project.
+ * For complete copyright and license terms please see the LICENSE at the root of this distribution.
+ *
+ * SPDX-License-Identifier: Apache-2.0 OR MIT
+ *
+ */
+
+#include "CameraImageNoise.h"
+
+#include <AzCore/Math/Simd.h>
+#include <AzCore/std/algorithm.h>
+#include <AzCore/std/limits.h>
+#include <cmath>
+
+namespace ROS2
+{
+    namespace Internal
+    {
+        //! Quantile function of the standard normal distribution, from the rational approximation of P. J. Acklam, with a relative
+        //! error below 1.2e-9.
+        double GetNormalQuantile(double probability)
+        {
+            static constexpr double A[] = { -3.969683028665376e+01, 2.209460984245205e+02, -2.759285104469687e+02,
+                                            1.383577518672690e+02,  -3.066479806614716e+01, 2.506628277459239e+00 };
+            static constexpr double B[] = { -5.447609879822406e+01, 1.615858368580409e+02, -1.556989798598866e+02,
+                                            6.680131188771972e+01,  -1.328068155288572e+01 };
+            static constexpr double C[] = { -7.784894002430293e-03, -3.223964580411365e-01, -2.400758277161838e+00,
+                                            -2.549732539343734e+00, 4.374664141464968e+00,  2.938163982698783e+00 };
+            static constexpr double D[] = { 7.784695709041462e-03, 3.224671290700398e-01, 2.445134137142996e+00, 3.754408661907416e+00 };
+            constexpr double Low = 0.02425;
+
+            if (probability < Low)
+            {
+                const double q = std::sqrt(-2.0 * std::log(probability));
+                return (((((C[0] * q + C[1]) * q + C[2]) * q + C[3]) * q + C[4]) * q + C[5]) /
+                    ((((D[0] * q + D[1]) * q + D[2]) * q + D[3]) * q + 1.0);
+            }
+            if (probability > 1.0 - Low)
+            {
+                return -GetNormalQuantile(1.0 - probability);
+            }
+            const double q = probability - 0.5;
+            const double r = q * q;
+            return (((((A[0] * r + A[1]) * r + A[2]) * r + A[3]) * r + A[4]) * r + A[5]) * q /
+                (((((B[0] * r + B[1]) * r + B[2]) * r + B[3]) * r + B[4]) * r + 1.0);
+        }
+
+        //! Generators of a row: four lanes of linear congruential generators, advanced together with SIMD. The lanes are seeded by
+        //! mixing the frame seed, the row and the lane with the SplitMix64 finalizer.
+        class RowGenerator
+        {
+        public:
+            using Vec4 = AZ::Simd::Vec4;
+
+            RowGenerator(AZ::u64 seed, AZ::u32 row)
+            {
+                int32_t laneSeeds[4];
+                for (AZ::u64 lane = 0; lane < 4; ++lane)
+                {
+                    AZ::u64 z = seed + (AZ::u64{ row } * 4 + lane + 1) * 0x9E3779B97F4A7C15ull;
+                    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+                    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+                    laneSeeds[lane] = static_cast<int32_t>(z ^ (z >> 31));
+                }
+                m_state = Vec4::LoadUnaligned(laneSeeds);
+            }
+
+            //! Advances the lanes and returns four Gaussian samples from the table, indexed by the 12 high bits of each lane.
+            Vec4::FloatType NextSamples(const float* gaussianSamples)
+            {
+                m_state = Vec4::Add(Vec4::Mul(m_state, Vec4::Splat(1664525)), Vec4::Splat(1013904223));
+                int32_t indices[4];
+                Vec4::StoreUnaligned(indices, Vec4::And(Vec4::ShiftRight(m_state, 20), Vec4::Splat(0xFFF)));
+                const float samples[4] = {
+                    gaussianSamples[indices[0]], gaussianSamples[indices[1]], gaussianSamples[indices[2]], gaussianSamples[indices[3]]
+                };
+                return Vec4::LoadUnaligned(samples);
+            }
+
+        private:
+            Vec4::IntType m_state;
+        };
+        static_assert(ImageNoise::GaussianTableSize == 1 << 12, "Indices of the Gaussian table have 12 bits.");
+    } // namespace Internal
+
+    bool ImageNoiseParameters::IsZero() const
+    {
+        return m_colorStdDev <= 0.0f && m_colorShotNoiseGain <= 0.0f && m_depthStdDevAtOneMeter <= 0.0f;
+    }
+
+    ImageNoise::ImageNoise(const ImageNoiseParameters& parameters)
+        : m_parameters(parameters)
+    {
+        // Quantiles at the middle of equally probable intervals, so that the table follows the distribution without sampling error.
+        m_gaussianSamples.resize(GaussianTableSize);
+        for (size_t i = 0; i < GaussianTableSize; ++i)
+        {
+            m_gaussianSamples[i] = static_cast<float>(Internal::GetNormalQuantile((i + 0.5) / GaussianTableSize));
+        }
+    }
+
+    void ImageNoise::ApplyRgba8(uint8_t* data, size_t step, AZ::u32 width, AZ::u32 firstRow, AZ::u32 lastRow, AZ::u64 seed) const
+    {
+        if (m_parameters.m_colorStdDev <= 0.0f && m_parameters.m_colorShotNoiseGain <= 0.0f)
+        {
+            return;
+        }
+
+        using Vec4 = AZ::Simd::Vec4;
+        // The channels of a pixel are processed as the lanes of a vector. The alpha lane gets no noise, so it keeps its value.
+        const Vec4::FloatType variance = Vec4::Splat(m_parameters.m_colorStdDev * m_parameters.m_colorStdDev);
+        const Vec4::FloatType shotNoiseGain = Vec4::Splat(m_parameters.m_colorShotNoiseGain);
+        const int32_t colorLanes[4] = { -1, -1, -1, 0 };
+        const Vec4::FloatType colorMask = Vec4::CastToFloat(Vec4::LoadUnaligned(colorLanes));
+        const Vec4::FloatType minIntensity = Vec4::Splat(0.0f);
+        const Vec4::FloatType maxIntensity = Vec4::Splat(255.0f);
+        for (AZ::u32 y = firstRow; y < lastRow; ++y)
+        {
+            Internal::RowGenerator generator(seed, y);
+            uint8_t* row = data + y * step;
+            for (AZ::u32 x = 0; x < width; ++x)
+            {
+                uint8_t* pixel = row + size_t{ x } * 4;
+                const float intensities[4] = {
+                    static_cast<float>(pixel[0]), static_cast<float>(pixel[1]), static_cast<float>(pixel[2]), static_cast<float>(pixel[3])
+                };
+                const Vec4::FloatType intensity = Vec4::LoadUnaligned(intensities);
+                const Vec4::FloatType stdDev = Vec4::Sqrt(Vec4::Madd(shotNoiseGain, intensity, variance));
+                const Vec4::FloatType noise = Vec4::And(Vec4::Mul(generator.NextSamples(m_gaussianSamples.data()), stdDev), colorMask);
+                const Vec4::FloatType value = Vec4::Min(Vec4::Max(Vec4::Add(intensity, noise), minIntensity), maxIntensity);
+                int32_t values[4];
+                Vec4::StoreUnaligned(values, Vec4::ConvertToIntNearest(value));
+                pixel[0] = static_cast<uint8_t>(values[0]);
+                pixel[1] = static_cast<uint8_t>(values[1]);
+                pixel[2] = static_cast<uint8_t>(values[2]);
+            }
+        }
+    }
+
+    void ImageNoise::ApplyDepth(uint8_t* data, size_t step, AZ::u32 width, AZ::u32 firstRow, AZ::u32 lastRow, AZ::u64 seed) const
+    {
+        if (m_parameters.m_depthStdDevAtOneMeter <= 0.0f)
+        {
+            return;
+        }
+
+        using Vec4 = AZ::Simd::Vec4;
+        const Vec4::FloatType stdDevAtOneMeter = Vec4::Splat(m_parameters.m_depthStdDevAtOneMeter);
+        const Vec4::FloatType minDepth = Vec4::Splat(0.0f);
+        const Vec4::FloatType maxDepth = Vec4::Splat(AZStd::numeric_limits<float>::infinity());
+        for (AZ::u32 y = firstRow; y < lastRow; ++y)
+        {
+            Internal::RowGenerator generator(seed, y);
+            float* row = reinterpret_cast<float*>(data + y * step);
+            for (AZ::u32 x = 0; x < width; x += 4)
+            {
+                // The last pixels of a row are padded to a full vector.
+                const AZ::u32 count = AZStd::min(width - x, 4u);
+                float depths[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+                AZStd::copy(row + x, row + x + count, depths);
+                const Vec4::FloatType depth = Vec4::LoadUnaligned(depths);
+
+                // Comparisons with NaN are false, so pixels without a valid depth get no noise and keep their value.
+                const Vec4::FloatType isValid = Vec4::And(Vec4::CmpGt(depth, minDepth), Vec4::CmpLt(depth, maxDepth));
+                const Vec4::FloatType stdDev = Vec4::Mul(stdDevAtOneMeter, Vec4::Mul(depth, depth));
+                const Vec4::FloatType noise = Vec4::And(Vec4::Mul(generator.NextSamples(m_gaussianSamples.data()), stdDev), isValid);
+                Vec4::StoreUnaligned(depths, Vec4::Add(depth, noise));
+                AZStd::copy(depths, depths + count, row + x);
+            }
+        }
+    }
+} // namespace ROS2
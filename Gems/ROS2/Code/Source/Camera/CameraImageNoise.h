@@ -0,0 +1,53 @@
+/*
+ * Copyright (c) Contributors to the Open 3D Engine Project.
+ * For complete copyright and license terms please see the LICENSE at the root of this distribution.
+ *
+ * SPDX-License-Identifier: Apache-2.0 OR MIT
+ *
+ */
+#pragma once
+
+#include <AzCore/base.h>
+#include <AzCore/std/containers/vector.h>
+
+namespace ROS2
+{
+    //! Parameters of the noise of camera images.
+    struct ImageNoiseParameters
+    {
+        //! Standard deviation of Gaussian noise of color channels, in intensity levels from 0 to 255.
+        float m_colorStdDev = 0.0f;
+        //! Variance of shot noise per intensity level, so that noise grows with the square root of the intensity.
+        float m_colorShotNoiseGain = 0.0f;
+        //! Standard deviation of depth noise at 1 meter, in meters. It grows with the square of the distance, as in stereo and
+        //! structured light cameras.
+        float m_depthStdDevAtOneMeter = 0.0f;
+
+        bool IsZero() const;
+    };
+
+    //! Adds noise to camera images. Gaussian samples come from a table of quantiles of the normal distribution, picked by four
+    //! generators advanced together with SIMD, so noise costs a table lookup per sample. Noise of color is computed for the
+    //! channels of a pixel at once, and noise of depth for four pixels at once. Each row has its own generators seeded from
+    //! the frame seed and the row, which makes noise independent of how rows are split between threads.
+    class ImageNoise
+    {
+    public:
+        //! Number of Gaussian samples in the table.
+        static constexpr size_t GaussianTableSize = 4096;
+
+        explicit ImageNoise(const ImageNoiseParameters& parameters);
+
+        //! Adds noise to the color channels of rows [firstRow, lastRow) of an RGBA8 image, keeping alpha.
+        //! @param seed Seed of the frame, which differs between frames and cameras.
+        void ApplyRgba8(uint8_t* data, size_t step, AZ::u32 width, AZ::u32 firstRow, AZ::u32 lastRow, AZ::u64 seed) const;
+
+        //! Adds noise to rows [firstRow, lastRow) of a 32-bit float depth image. Pixels without a valid depth are kept.
+        //! @param seed Seed of the frame, which differs between frames and cameras.
+        void ApplyDepth(uint8_t* data, size_t step, AZ::u32 width, AZ::u32 firstRow, AZ::u32 lastRow, AZ::u64 seed) const;
+
+    private:
+        ImageNoiseParameters m_parameters;
+        AZStd::vector<float> m_gaussianSamples;
+    };
+} // namespace ROS2
@@ -0,0 +1,168 @@
+/*
+ * Copyright (c) Contributors to the Open 3D Engine Project.
+ * For complete copyright and license terms please see the LICENSE at the root of this distribution.
+ *
+ * SPDX-License-Identifier: Apache-2.0 OR MIT
+ *
+ */
+
+#include "CameraLensDistortion.h"
+
+#include <AzCore/std/algorithm.h>
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+namespace ROS2
+{
+    namespace Internal
+    {
+        //! Iterations of the undistortion, which converges well within them for distortion of real lenses.
+        constexpr int UndistortionIterations = 20;
+
+        //! Interpolates between two RGBA8 pixels, with all four channels in two multiplications: red and blue in one 32-bit word,
+        //! green and alpha in another, each channel in a 16-bit lane which holds its product with an 8-bit weight.
+        //! @param weight Weight of the second pixel, from 0 to 256.
+        inline AZ::u32 LerpRgba8(AZ::u32 first, AZ::u32 second, AZ::u32 weight)
+        {
+            const AZ::u32 firstWeight = 256 - weight;
+            const AZ::u32 redBlue = (((first & 0x00FF00FF) * firstWeight + (second & 0x00FF00FF) * weight + 0x00800080) >> 8) & 0x00FF00FF;
+            const AZ::u32 greenAlpha =
+                (((first >> 8) & 0x00FF00FF) * firstWeight + ((second >> 8) & 0x00FF00FF) * weight + 0x00800080) & 0xFF00FF00;
+            return redBlue | greenAlpha;
+        }
+
+        inline AZ::u32 LoadPixel(const uint8_t* row, AZ::u32 x)
+        {
+            AZ::u32 pixel;
+            std::memcpy(&pixel, row + size_t{ x } * sizeof(pixel), sizeof(pixel));
+            return pixel;
+        }
+    } // namespace Internal
+
+    bool LensDistortionCoefficients::IsZero() const
+    {
+        return m_k1 == 0.0f && m_k2 == 0.0f && m_k3 == 0.0f && m_p1 == 0.0f && m_p2 == 0.0f;
+    }
+
+    LensDistortionMap::LensDistortionMap(
+        AZ::u32 width, AZ::u32 height, const AZ::Matrix3x3& intrinsics, const LensDistortionCoefficients& coefficients)
+        : m_width(width)
+        , m_height(height)
+    {
+        AZ_Assert(width >= 2 && height >= 2 && width < InvalidSample && height < InvalidSample, "Unsupported image size for distortion.");
+
+        const float fx = intrinsics.GetElement(0, 0);
+        const float fy = intrinsics.GetElement(1, 1);
+        const float cx = intrinsics.GetElement(0, 2);
+        const float cy = intrinsics.GetElement(1, 2);
+        m_bilinearSamples.resize(size_t{ width } * height);
+        m_nearestSamples.resize(size_t{ width } * height);
+        for (AZ::u32 y = 0; y < height; ++y)
+        {
+            for (AZ::u32 x = 0; x < width; ++x)
+            {
+                // Pixel of the distorted image, to the point of the pinhole image which the lens projects onto it.
+                const AZ::Vector2 distortedPoint((x - cx) / fx, (y - cy) / fy);
+                const AZ::Vector2 point = UndistortPoint(distortedPoint, coefficients);
+                const float sourceX = point.GetX() * fx + cx;
+                const float sourceY = point.GetY() * fy + cy;
+                if (!(sourceX >= 0.0f && sourceY >= 0.0f && sourceX <= width - 1.0f && sourceY <= height - 1.0f))
+                {
+                    continue;
+                }
+
+                const size_t index = size_t{ y } * width + x;
+                const AZ::u32 left = AZStd::min(static_cast<AZ::u32>(sourceX), width - 2);
+                const AZ::u32 top = AZStd::min(static_cast<AZ::u32>(sourceY), height - 2);
+                m_bilinearSamples[index] = { static_cast<AZ::u16>(left),
+                                             static_cast<AZ::u16>(top),
+                                             static_cast<AZ::u16>(std::lround((sourceX - left) * 256.0f)),
+                                             static_cast<AZ::u16>(std::lround((sourceY - top) * 256.0f)) };
+                m_nearestSamples[index] = { static_cast<AZ::u16>(std::lround(sourceX)), static_cast<AZ::u16>(std::lround(sourceY)) };
+            }
+        }
+    }
+
+    AZ::Vector2 LensDistortionMap::DistortPoint(const AZ::Vector2& point, const LensDistortionCoefficients& coefficients)
+    {
+        const float x = point.GetX();
+        const float y = point.GetY();
+        const float r2 = x * x + y * y;
+        const float radial = 1.0f + r2 * (coefficients.m_k1 + r2 * (coefficients.m_k2 + r2 * coefficients.m_k3));
+        const float tangentialX = 2.0f * coefficients.m_p1 * x * y + coefficients.m_p2 * (r2 + 2.0f * x * x);
+        const float tangentialY = coefficients.m_p1 * (r2 + 2.0f * y * y) + 2.0f * coefficients.m_p2 * x * y;
+        return AZ::Vector2(x * radial + tangentialX, y * radial + tangentialY);
+    }
+
+    AZ::Vector2 LensDistortionMap::UndistortPoint(const AZ::Vector2& distortedPoint, const LensDistortionCoefficients& coefficients)
+    {
+        float x = distortedPoint.GetX();
+        float y = distortedPoint.GetY();
+        for (int i = 0; i < Internal::UndistortionIterations; ++i)
+        {
+            const float r2 = x * x + y * y;
+            const float radial = 1.0f + r2 * (coefficients.m_k1 + r2 * (coefficients.m_k2 + r2 * coefficients.m_k3));
+            const float tangentialX = 2.0f * coefficients.m_p1 * x * y + coefficients.m_p2 * (r2 + 2.0f * x * x);
+            const float tangentialY = coefficients.m_p1 * (r2 + 2.0f * y * y) + 2.0f * coefficients.m_p2 * x * y;
+            x = (distortedPoint.GetX() - tangentialX) / radial;
+            y = (distortedPoint.GetY() - tangentialY) / radial;
+        }
+        return AZ::Vector2(x, y);
+    }
+
+    void LensDistortionMap::RemapRgba8(
+        const uint8_t* source, size_t sourceStep, uint8_t* target, size_t targetStep, AZ::u32 firstRow, AZ::u32 lastRow) const
+    {
+        for (AZ::u32 y = firstRow; y < lastRow; ++y)
+        {
+            const Sample* samples = m_bilinearSamples.data() + size_t{ y } * m_width;
+            AZ::u32* targetRow = reinterpret_cast<AZ::u32*>(target + y * targetStep);
+            for (AZ::u32 x = 0; x < m_width; ++x)
+            {
+                const Sample& sample = samples[x];
+                if (sample.m_x == InvalidSample)
+                {
+                    targetRow[x] = 0;
+                    continue;
+                }
+                const uint8_t* topRow = source + sample.m_y * sourceStep;
+                const uint8_t* bottomRow = topRow + sourceStep;
+                const AZ::u32 top = Internal::LerpRgba8(
+                    Internal::LoadPixel(topRow, sample.m_x), Internal::LoadPixel(topRow, sample.m_x + 1), sample.m_weightX);
+                const AZ::u32 bottom = Internal::LerpRgba8(
+                    Internal::LoadPixel(bottomRow, sample.m_x), Internal::LoadPixel(bottomRow, sample.m_x + 1), sample.m_weightX);
+                targetRow[x] = Internal::LerpRgba8(top, bottom, sample.m_weightY);
+            }
+        }
+    }
+
+    void LensDistortionMap::RemapDepth(
+        const uint8_t* source, size_t sourceStep, uint8_t* target, size_t targetStep, AZ::u32 firstRow, AZ::u32 lastRow) const
+    {
+        // Pixels are copied as 32-bit words, which keeps the bits of the floats as they are.
+        AZ::u32 noReturn;
+        const float nan = std::numeric_limits<float>::quiet_NaN();
+        std::memcpy(&noReturn, &nan, sizeof(noReturn));
+        for (AZ::u32 y = firstRow; y < lastRow; ++y)
+        {
+            const Sample* samples = m_nearestSamples.data() + size_t{ y } * m_width;
+            AZ::u32* targetRow = reinterpret_cast<AZ::u32*>(target + y * targetStep);
+            for (AZ::u32 x = 0; x < m_width; ++x)
+            {
+                const Sample& sample = samples[x];
+                targetRow[x] = sample.m_x == InvalidSample ? noReturn : Internal::LoadPixel(source + sample.m_y * sourceStep, sample.m_x);
+            }
+        }
+    }
+
+    AZ::u32 LensDistortionMap::GetWidth() const
+    {
+        return m_width;
+    }
+
+    AZ::u32 LensDistortionMap::GetHeight() const
+    {
+        return m_height;
+    }
+} // namespace ROS2
@@ -0,0 +1,77 @@
+/*
+ * Copyright (c) Contributors to the Open 3D Engine Project.
+ * For complete copyright and license terms please see the LICENSE at the root of this distribution.
+ *
+ * SPDX-License-Identifier: Apache-2.0 OR MIT
+ *
+ */
+#pragma once
+
+#include <AzCore/Math/Matrix3x3.h>
+#include <AzCore/Math/Vector2.h>
+#include <AzCore/std/containers/vector.h>
+
+namespace ROS2
+{
+    //! Coefficients of the plumb bob distortion model, with radial (k) and tangential (p) terms, as used by OpenCV.
+    struct LensDistortionCoefficients
+    {
+        float m_k1 = 0.0f;
+        float m_k2 = 0.0f;
+        float m_k3 = 0.0f;
+        float m_p1 = 0.0f;
+        float m_p2 = 0.0f;
+
+        bool IsZero() const;
+    };
+
+    //! Remaps rendered pinhole images to images of a distorted lens.
+    //! For each pixel of the distorted image, the map holds where it samples the rendered image, so that distorting a frame is a
+    //! lookup and an interpolation per pixel, instead of inverting the distortion model per pixel. Color is interpolated bilinearly;
+    //! depth takes the nearest sample, since interpolating across object edges would create depth between them.
+    //! Pixels which sample outside of the rendered image are black in color images and NaN (no return) in depth images.
+    class LensDistortionMap
+    {
+    public:
+        //! Builds the map of images of the given size, which must be at least 2x2 and at most 65535x65535 pixels.
+        //! @param intrinsics Camera matrix shared by the rendered and the distorted image.
+        LensDistortionMap(AZ::u32 width, AZ::u32 height, const AZ::Matrix3x3& intrinsics, const LensDistortionCoefficients& coefficients);
+
+        //! Applies the distortion model to a point in normalized image coordinates.
+        static AZ::Vector2 DistortPoint(const AZ::Vector2& point, const LensDistortionCoefficients& coefficients);
+
+        //! Inverts the distortion model iteratively, the way OpenCV undistorts points.
+        static AZ::Vector2 UndistortPoint(const AZ::Vector2& distortedPoint, const LensDistortionCoefficients& coefficients);
+
+        //! Writes rows [firstRow, lastRow) of a distorted RGBA8 image, sampling the source image.
+        //! Source and target have the size of the map, with rows of the given sizes in bytes.
+        void RemapRgba8(const uint8_t* source, size_t sourceStep, uint8_t* target, size_t targetStep, AZ::u32 firstRow, AZ::u32 lastRow)
+            const;
+
+        //! Writes rows [firstRow, lastRow) of a distorted 32-bit float depth image, sampling the source image.
+        void RemapDepth(const uint8_t* source, size_t sourceStep, uint8_t* target, size_t targetStep, AZ::u32 firstRow, AZ::u32 lastRow)
+            const;
+
+        AZ::u32 GetWidth() const;
+        AZ::u32 GetHeight() const;
+
+    private:
+        //! Marks samples outside of the rendered image.
+        static constexpr AZ::u16 InvalidSample = 0xFFFF;
+
+        //! Sample of the rendered image, at the top left pixel of its 2x2 neighborhood, with weights of the right and bottom pixels
+        //! in 1/256. Nearest samples use the pixel alone.
+        struct Sample
+        {
+            AZ::u16 m_x = InvalidSample;
+            AZ::u16 m_y = 0;
+            AZ::u16 m_weightX = 0;
+            AZ::u16 m_weightY = 0;
+        };
+
+        AZ::u32 m_width = 0;
+        AZ::u32 m_height = 0;
+        AZStd::vector<Sample> m_bilinearSamples;
+        AZStd::vector<Sample> m_nearestSamples;
+    };
+} // namespace ROS2
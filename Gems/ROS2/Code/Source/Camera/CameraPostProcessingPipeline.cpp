@@ -0,0 +1,240 @@
+/*
+ * Copyright (c) Contributors to the Open 3D Engine Project.
+ * For complete copyright and license terms please see the LICENSE at the root of this distribution.
+ *
+ * SPDX-License-Identifier: Apache-2.0 OR MIT
+ *
+ */
+
+#include "CameraPostProcessingPipeline.h"
+#include "CameraUtilities.h"
+
+#include <AzCore/Jobs/JobCompletion.h>
+#include <AzCore/Jobs/JobFunction.h>
+#include <AzCore/std/algorithm.h>
+#include <AzCore/std/parallel/thread.h>
+#include <ROS2/Camera/CameraPostProcessingRequestBus.h>
+
+namespace ROS2
+{
+    CameraPostProcessingPipeline::CameraPostProcessingPipeline(
+        const AZ::EntityId& entityId,
+        CameraPublishers::ImagePublisherPtrType imagePublisher,
+        CameraPublishers::CameraInfoPublisherPtrType infoPublisher,
+        CameraPublishers::CompressedImagePublisherPtrType compressedImagePublisher)
+        : m_entityId(entityId)
+        , m_imagePublisher(AZStd::move(imagePublisher))
+        , m_infoPublisher(AZStd::move(infoPublisher))
+        , m_compressedImagePublisher(AZStd::move(compressedImagePublisher))
+        , m_maxTileCount(AZStd::max<size_t>(AZStd::thread::hardware_concurrency(), 1))
+    {
+    }
+
+    void CameraPostProcessingPipeline::Submit(
+        const AZ::RPI::AttachmentReadback::ReadbackResult& result,
+        const std_msgs::msg::Header& header,
+        const sensor_msgs::msg::CameraInfo& infoMessage)
+    {
+        Submit(CameraUtils::GetImageView(result), header, infoMessage);
+    }
+
+    void CameraPostProcessingPipeline::Submit(
+        const CameraUtils::ImageView& image, const std_msgs::msg::Header& header, const sensor_msgs::msg::CameraInfo& infoMessage)
+    {
+        Frame* frame = nullptr;
+        {
+            AZStd::lock_guard<AZStd::mutex> lock(m_mutex);
+            for (Frame& candidate : m_frames)
+            {
+                if (candidate.m_state == FrameState::Free)
+                {
+                    frame = &candidate;
+                    break;
+                }
+            }
+            if (!frame)
+            {
+                // Drop the oldest frame which is not being processed yet, so that published frames stay as recent as possible.
+                for (auto it = m_frameOrder.begin(); it != m_frameOrder.end(); ++it)
+                {
+                    if ((*it)->m_state == FrameState::Waiting)
+                    {
+                        frame = *it;
+                        m_frameOrder.erase(it);
+                        break;
+                    }
+                }
+            }
+            if (!frame)
+            {
+                AZ_WarningOnce("CameraSensor", false, "Image post-processing falls behind the camera, dropping frames.");
+                return;
+            }
+            frame->m_state = FrameState::Filling;
+            frame->m_seed = ++m_frameCount;
+            m_frameOrder.push_back(frame);
+        }
+
+        // The frame is filled without the lock, since no other thread uses frames in the Filling state.
+        if (!CameraUtils::FillImageMessage(image, header, frame->m_image))
+        {
+            // The format is not supported, which is reported by FillImageMessage. Frames submitted earlier may be done already.
+            AZStd::lock_guard<AZStd::mutex> lock(m_mutex);
+            m_frameOrder.erase(AZStd::find(m_frameOrder.begin(), m_frameOrder.end(), frame));
+            frame->m_state = FrameState::Free;
+            PublishDoneFrames();
+            return;
+        }
+        frame->m_infoMessage = infoMessage;
+        const bool needsProcessing = HasPostProcessing(m_entityId, AZStd::string(frame->m_image.encoding.c_str()));
+
+        AZStd::lock_guard<AZStd::mutex> lock(m_mutex);
+        if (needsProcessing)
+        {
+            frame->m_state = FrameState::Waiting;
+            StartWaitingFrames();
+        }
+        else
+        {
+            frame->m_state = FrameState::Done;
+            PublishDoneFrames();
+        }
+    }
+
+    void CameraPostProcessingPipeline::ApplyPostProcessing(
+        const AZ::EntityId& entityId,
+        sensor_msgs::msg::Image& image,
+        sensor_msgs::msg::Image& scratch,
+        size_t maxTileCount,
+        AZ::u64 frameSeed)
+    {
+        const AZStd::string encoding(image.encoding.c_str());
+        CameraPostProcessingRequestBus::EnumerateHandlersId(
+            entityId,
+            [&](CameraPostProcessingRequests* handler)
+            {
+                if (!handler->SupportsFormat(encoding))
+                {
+                    return true;
+                }
+                if (!handler->SupportsTiles())
+                {
+                    handler->ApplyPostProcessing(image);
+                    return true;
+                }
+
+                // Tiles read from the image and write to the scratch image, which then becomes the image.
+                scratch.header = image.header;
+                scratch.width = image.width;
+                scratch.height = image.height;
+                scratch.encoding = image.encoding;
+                scratch.is_bigendian = image.is_bigendian;
+                scratch.step = image.step;
+                scratch.data.resize(image.data.size());
+
+                const AZ::u32 tileCount =
+                    static_cast<AZ::u32>(AZStd::min<size_t>(maxTileCount, AZStd::max<AZ::u32>(image.height / MinRowsPerTile, 1)));
+                const AZ::u32 rowsPerTile = (image.height + tileCount - 1) / tileCount;
+                AZ::JobCompletion completion;
+                for (AZ::u32 firstRow = rowsPerTile; firstRow < image.height; firstRow += rowsPerTile)
+                {
+                    const AZ::u32 lastRow = AZStd::min(firstRow + rowsPerTile, image.height);
+                    AZ::Job* job = AZ::CreateJobFunction(
+                        [handler, &image, &scratch, firstRow, lastRow, frameSeed]()
+                        {
+                            handler->ApplyPostProcessingToTile(image, scratch, firstRow, lastRow, frameSeed);
+                        },
+                        true);
+                    job->SetDependent(&completion);
+                    job->Start();
+                }
+
+                // The calling thread handles the first tile instead of idling.
+                handler->ApplyPostProcessingToTile(image, scratch, 0, AZStd::min(rowsPerTile, image.height), frameSeed);
+                completion.StartAndWaitForCompletion();
+                image.data.swap(scratch.data);
+                return true;
+            });
+    }
+
+    bool CameraPostProcessingPipeline::HasPostProcessing(const AZ::EntityId& entityId, const AZStd::string& encoding)
+    {
+        bool isSupported = false;
+        CameraPostProcessingRequestBus::EnumerateHandlersId(
+            entityId,
+            [&](CameraPostProcessingRequests* handler)
+            {
+                isSupported = handler->SupportsFormat(encoding);
+                return !isSupported;
+            });
+        return isSupported;
+    }
+
+    void CameraPostProcessingPipeline::Process(Frame* frame)
+    {
+        ApplyPostProcessing(m_entityId, frame->m_image, frame->m_scratch, m_maxTileCount, frame->m_seed);
+
+        AZStd::lock_guard<AZStd::mutex> lock(m_mutex);
+        frame->m_state = FrameState::Done;
+        --m_processingCount;
+        PublishDoneFrames();
+        StartWaitingFrames();
+    }
+
+    void CameraPostProcessingPipeline::StartWaitingFrames()
+    {
+        for (Frame* frame : m_frameOrder)
+        {
+            if (m_processingCount >= MaxParallelFrames)
+            {
+                return;
+            }
+            if (frame->m_state != FrameState::Waiting)
+            {
+                continue;
+            }
+
+            frame->m_state = FrameState::Processing;
+            ++m_processingCount;
+            AZ::CreateJobFunction(
+                [self = shared_from_this(), frame]()
+                {
+                    self->Process(frame);
+                },
+                true)
+                ->Start();
+        }
+    }
+
+    void CameraPostProcessingPipeline::PublishDoneFrames()
+    {
+        while (!m_frameOrder.empty() && m_frameOrder.front()->m_state == FrameState::Done)
+        {
+            Frame* frame = m_frameOrder.front();
+            m_frameOrder.erase(m_frameOrder.begin());
+            PublishFrame(*frame);
+            frame->m_state = FrameState::Free;
+        }
+    }
+
+    void CameraPostProcessingPipeline::PublishFrame(Frame& frame)
+    {
+        // The compressed image is copied before the image is handed over to the publishing thread.
+        if (m_compressedImagePublisher && !m_compressedImagePublisher->Publish(frame.m_image))
+        {
+            AZ_WarningOnce("CameraSensor", false, "Image compression falls behind the camera, dropping compressed frames.");
+        }
+
+        sensor_msgs::msg::Image* imageMessage = m_imagePublisher->AcquireMessage();
+        if (!imageMessage)
+        {
+            AZ_WarningOnce("CameraSensor", false, "Image publishing falls behind the camera, dropping frames.");
+            return;
+        }
+
+        // Swapping hands the frame's buffers over to the pooled message, and the message's buffers over to the frame for reuse.
+        AZStd::swap(*imageMessage, frame.m_image);
+        m_imagePublisher->Submit(imageMessage);
+        m_infoPublisher->Publish(frame.m_infoMessage);
+    }
+} // namespace ROS2
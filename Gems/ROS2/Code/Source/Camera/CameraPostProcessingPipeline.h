@@ -0,0 +1,118 @@
+/*
+ * Copyright (c) Contributors to the Open 3D Engine Project.
+ * For complete copyright and license terms please see the LICENSE at the root of this distribution.
+ *
+ * SPDX-License-Identifier: Apache-2.0 OR MIT
+ *
+ */
+#pragma once
+
+#include "CameraPublishers.h"
+#include "CameraUtilities.h"
+
+#include <Atom/RPI.Public/Pass/AttachmentReadback.h>
+#include <AzCore/Component/EntityId.h>
+#include <AzCore/std/containers/array.h>
+#include <AzCore/std/containers/fixed_vector.h>
+#include <AzCore/std/parallel/mutex.h>
+#include <AzCore/std/smart_ptr/enable_shared_from_this.h>
+
+namespace ROS2
+{
+    //! Post-processes and publishes frames of a camera channel.
+    //! Frames are post-processed by jobs, so post-processing does not hold up readbacks of the next frames. Up to MaxParallelFrames
+    //! frames are processed at once, and handlers which support tiles also process bands of rows of a frame in parallel.
+    //! Frames are published in the order in which they were submitted. When all frames are in flight, the oldest frame waiting for
+    //! processing is dropped in favor of the new one; frames which are being processed are never dropped.
+    //! Publishers of the channel are only used by one thread at a time, under the lock of the pipeline.
+    class CameraPostProcessingPipeline : public AZStd::enable_shared_from_this<CameraPostProcessingPipeline>
+    {
+    public:
+        //! Number of frames which are post-processed at once.
+        static constexpr size_t MaxParallelFrames = 2;
+
+        //! Number of frames which are processed or wait for processing or publication.
+        static constexpr size_t MaxFramesInFlight = MaxParallelFrames + 1;
+
+        //! Smallest number of rows of a tile, which keeps tiles of small images from costing more in scheduling than they save.
+        static constexpr AZ::u32 MinRowsPerTile = 32;
+
+        //! @param entityId Entity of the camera, which has the post-processing handlers.
+        //! @param compressedImagePublisher Publisher of compressed images, or nullptr.
+        CameraPostProcessingPipeline(
+            const AZ::EntityId& entityId,
+            CameraPublishers::ImagePublisherPtrType imagePublisher,
+            CameraPublishers::CameraInfoPublisherPtrType infoPublisher,
+            CameraPublishers::CompressedImagePublisherPtrType compressedImagePublisher);
+
+        //! Copies a readback result to a frame and starts its post-processing. Called on the thread handling readbacks.
+        //! @param header Header of the image message.
+        //! @param infoMessage Camera info, published together with the image.
+        void Submit(
+            const AZ::RPI::AttachmentReadback::ReadbackResult& result,
+            const std_msgs::msg::Header& header,
+            const sensor_msgs::msg::CameraInfo& infoMessage);
+
+        //! Copies a viewed image, such as a tile of an atlas, to a frame and starts its post-processing.
+        //! The viewed data is only used during the call.
+        void Submit(
+            const CameraUtils::ImageView& image, const std_msgs::msg::Header& header, const sensor_msgs::msg::CameraInfo& infoMessage);
+
+        //! Applies post-processing handlers of an entity which support the encoding of an image, in order.
+        //! @param scratch Image used as the target of tiled post-processing, which keeps its buffer between calls.
+        //! @param maxTileCount Largest number of tiles, processed by parallel jobs.
+        //! @param frameSeed Seed of the frame, passed to all of its tiles.
+        static void ApplyPostProcessing(
+            const AZ::EntityId& entityId,
+            sensor_msgs::msg::Image& image,
+            sensor_msgs::msg::Image& scratch,
+            size_t maxTileCount,
+            AZ::u64 frameSeed);
+
+        //! Query whether any post-processing handler of an entity supports an image encoding.
+        static bool HasPostProcessing(const AZ::EntityId& entityId, const AZStd::string& encoding);
+
+    private:
+        enum class FrameState
+        {
+            Free,
+            Filling,
+            Waiting,
+            Processing,
+            Done,
+        };
+
+        struct Frame
+        {
+            FrameState m_state = FrameState::Free;
+            sensor_msgs::msg::Image m_image;
+            sensor_msgs::msg::Image m_scratch;
+            sensor_msgs::msg::CameraInfo m_infoMessage;
+            AZ::u64 m_seed = 0; //!< Seed of the frame, assigned when it is submitted.
+        };
+
+        //! Post-processes a frame on a job thread.
+        void Process(Frame* frame);
+
+        //! Starts jobs of the oldest waiting frames, while fewer than MaxParallelFrames frames are processed.
+        void StartWaitingFrames();
+
+        //! Publishes processed frames from the oldest one, up to the first frame which is not processed yet.
+        void PublishDoneFrames();
+
+        void PublishFrame(Frame& frame);
+
+        AZ::EntityId m_entityId;
+        CameraPublishers::ImagePublisherPtrType m_imagePublisher;
+        CameraPublishers::CameraInfoPublisherPtrType m_infoPublisher;
+        CameraPublishers::CompressedImagePublisherPtrType m_compressedImagePublisher;
+        size_t m_maxTileCount = 1;
+
+        AZStd::array<Frame, MaxFramesInFlight> m_frames;
+        AZStd::mutex m_mutex;
+        //! Frames in flight in the order of submission, guarded by m_mutex.
+        AZStd::fixed_vector<Frame*, MaxFramesInFlight> m_frameOrder;
+        size_t m_processingCount = 0; //!< Guarded by m_mutex.
+        AZ::u64 m_frameCount = 0; //!< Number of submitted frames, which seeds them; guarded by m_mutex.
+    };
+} // namespace ROS2
@@ -74,14 +74,14 @@ namespace ROS2
         void AddPublishersFromConfiguration(
             const AZStd::string& cameraNamespace,
             const TopicConfigurations configurations,
-            AZStd::unordered_map<CameraSensorDescription::CameraChannelType, std::shared_ptr<rclcpp::Publisher<PublishedData>>>& publishers)
+            AZStd::unordered_map<CameraSensorDescription::CameraChannelType, AZStd::shared_ptr<SensorPublisher<PublishedData>>>& publishers)
         {
             for (const auto& [channel, configuration] : configurations)
             {
                 AZStd::string fullTopic = ROS2Names::GetNamespacedName(cameraNamespace, configuration.m_topic);
-                auto ros2Node = ROS2Interface::Get()->GetNode();
-                auto publisher = ros2Node->create_publisher<PublishedData>(fullTopic.data(), configuration.GetQoS());
-                publishers[channel] = publisher;
+                auto ros2Node = ROS2Interface::Get()->GetRobotNode(cameraNamespace);
+                publishers[channel] = SensorPublisher<PublishedData>::Create(
+                    ros2Node, fullTopic, configuration.GetQoS(), CameraPublishers::ImagePoolSize);
             }
         }
 
@@ -101,6 +101,39 @@ namespace ROS2
             const auto cameraInfoPublisherConfigs = GetCameraInfoTopicConfiguration<CameraType>(cameraDescription.m_sensorConfiguration);
             AddPublishersFromConfiguration(cameraDescription.m_cameraNamespace, cameraInfoPublisherConfigs, infoPublishers);
         }
+
+        //! Helper that adds publishers of compressed images next to the image publishers of a camera type.
+        //! @param format format of compressed images, or None to publish raw images only.
+        template<typename CameraType>
+        void AddCompressedImagePublishers(
+            const CameraSensorDescription& cameraDescription,
+            CameraSensorConfiguration::CompressedImageFormat format,
+            AZStd::unordered_map<CameraSensorDescription::CameraChannelType, CameraPublishers::CompressedImagePublisherPtrType>&
+                compressedImagePublishers)
+        {
+            if (format == CameraSensorConfiguration::CompressedImageFormat::None)
+            {
+                return;
+            }
+
+            const auto& cameraConfiguration = cameraDescription.m_cameraConfiguration;
+            CompressedImagePublisher::Settings settings;
+            settings.m_format = format;
+            settings.m_jpegQuality = cameraConfiguration.m_jpegQuality;
+            settings.m_pngCompressionLevel = cameraConfiguration.m_pngCompressionLevel;
+            settings.m_maxDepth = cameraConfiguration.m_farClipDistance;
+            settings.m_isLosslessDepth = cameraConfiguration.m_losslessDepthCompression;
+            for (const auto& [channel, configuration] : GetCameraTopicConfiguration<CameraType>(cameraDescription.m_sensorConfiguration))
+            {
+                const AZStd::string& cameraNamespace = cameraDescription.m_cameraNamespace;
+                compressedImagePublishers[channel] = AZStd::make_shared<CompressedImagePublisher>(
+                    ROS2Interface::Get()->GetRobotNode(cameraNamespace),
+                    ROS2Names::GetNamespacedName(cameraNamespace, configuration.m_topic),
+                    configuration.GetQoS(),
+                    channel == CameraSensorDescription::CameraChannelType::DEPTH,
+                    settings);
+            }
+        }
     } // namespace Internal
 
     CameraPublishers::CameraPublishers(const CameraSensorDescription& cameraDescription)
@@ -108,11 +141,15 @@ namespace ROS2
         if (cameraDescription.m_cameraConfiguration.m_colorCamera)
         {
             Internal::AddCameraPublishers<CameraColorSensor>(cameraDescription, m_imagePublishers, m_infoPublishers);
+            Internal::AddCompressedImagePublishers<CameraColorSensor>(
+                cameraDescription, cameraDescription.m_cameraConfiguration.m_colorCompression, m_compressedImagePublishers);
         }
 
         if (cameraDescription.m_cameraConfiguration.m_depthCamera)
         {
             Internal::AddCameraPublishers<CameraDepthSensor>(cameraDescription, m_imagePublishers, m_infoPublishers);
+            Internal::AddCompressedImagePublishers<CameraDepthSensor>(
+                cameraDescription, cameraDescription.m_cameraConfiguration.m_depthCompression, m_compressedImagePublishers);
         }
     }
 
@@ -127,4 +164,23 @@ namespace ROS2
         AZ_Error("GetInfoPublisher", m_infoPublishers.count(type) == 1, "No publisher of this type, logic error!");
         return m_infoPublishers.at(type);
     }
+
+    CameraPublishers::CompressedImagePublisherPtrType CameraPublishers::GetCompressedImagePublisher(
+        CameraSensorDescription::CameraChannelType type)
+    {
+        auto it = m_compressedImagePublishers.find(type);
+        return it != m_compressedImagePublishers.end() ? it->second : nullptr;
+    }
+
+    void CameraPublishers::SetSensorProfile(const AZStd::shared_ptr<SensorProfile>& sensorProfile)
+    {
+        for (auto& [channel, publisher] : m_imagePublishers)
+        {
+            publisher->SetSensorProfile(sensorProfile);
+        }
+        for (auto& [channel, publisher] : m_infoPublishers)
+        {
+            publisher->SetSensorProfile(sensorProfile);
+        }
+    }
 } // namespace ROS2
@@ -8,8 +8,11 @@
 #pragma once
 
 #include "CameraSensorDescription.h"
+#include "CompressedImagePublisher.h"
 
 #include <AzCore/std/containers/unordered_map.h>
+#include <AzCore/std/smart_ptr/shared_ptr.h>
+#include <ROS2/Sensor/SensorPublisher.h>
 
 #include <rclcpp/publisher.hpp>
 #include <sensor_msgs/msg/camera_info.hpp>
@@ -20,22 +23,37 @@ namespace ROS2
 {
     //! Handles all the ROS publishing related to a single camera.
     //! This includes 1-2 CameraInfo topics as well as 1-2 Image topics.
+    //! Images are filled in place in pooled messages, which keep their data buffers between frames. Each publisher must only be used
+    //! from the thread which handles readbacks of its camera.
     class CameraPublishers
     {
     public:
+        //! Number of pooled image messages of each image topic, which bounds the frames waiting for publication.
+        static constexpr size_t ImagePoolSize = 3;
+
         //! ROS2 image publisher type.
-        using ImagePublisherPtrType = std::shared_ptr<rclcpp::Publisher<sensor_msgs::msg::Image>>;
+        using ImagePublisherPtrType = AZStd::shared_ptr<SensorPublisher<sensor_msgs::msg::Image>>;
 
         //! ROS2 camera sensor publisher type.
-        using CameraInfoPublisherPtrType = std::shared_ptr<rclcpp::Publisher<sensor_msgs::msg::CameraInfo>>;
+        using CameraInfoPublisherPtrType = AZStd::shared_ptr<SensorPublisher<sensor_msgs::msg::CameraInfo>>;
+
+        //! Publisher of compressed images of a channel.
+        using CompressedImagePublisherPtrType = AZStd::shared_ptr<CompressedImagePublisher>;
 
         CameraPublishers(const CameraSensorDescription& cameraDescription);
 
         ImagePublisherPtrType GetImagePublisher(CameraSensorDescription::CameraChannelType type);
         CameraInfoPublisherPtrType GetInfoPublisher(CameraSensorDescription::CameraChannelType type);
 
+        //! Returns the compressed image publisher of a channel, or nullptr if compression of the channel is disabled.
+        CompressedImagePublisherPtrType GetCompressedImagePublisher(CameraSensorDescription::CameraChannelType type);
+
+        //! Sets the profile which records published images and camera info of all channels, or nullptr to stop recording.
+        void SetSensorProfile(const AZStd::shared_ptr<SensorProfile>& sensorProfile);
+
     private:
         AZStd::unordered_map<CameraSensorDescription::CameraChannelType, ImagePublisherPtrType> m_imagePublishers;
         AZStd::unordered_map<CameraSensorDescription::CameraChannelType, CameraInfoPublisherPtrType> m_infoPublishers;
+        AZStd::unordered_map<CameraSensorDescription::CameraChannelType, CompressedImagePublisherPtrType> m_compressedImagePublishers;
     };
 } // namespace ROS2
@@ -6,7 +6,7 @@
  *
  */
 #include "CameraSensor.h"
-#include <ROS2/Camera/CameraPostProcessingRequestBus.h>
+#include "CameraPostProcessingPipeline.h"
 
 #include <Atom/RPI.Public/Base.h>
 #include <Atom/RPI.Public/FeatureProcessorFactory.h>
@@ -27,55 +27,6 @@ namespace ROS2
 {
     namespace Internal
     {
-        /// @FormatMappings - contains the mapping from RHI to ROS image encodings. List of supported
-        /// ROS image encodings lives in `sensor_msgs/image_encodings.hpp`
-        /// We are not including `image_encodings.hpp` since it uses exceptions.
-        AZStd::unordered_map<AZ::RHI::Format, const char*> FormatMappings{
-            { AZ::RHI::Format::R8G8B8A8_UNORM, "rgba8" },     { AZ::RHI::Format::R16G16B16A16_UNORM, "rgba16" },
-            { AZ::RHI::Format::R32G32B32A32_FLOAT, "32FC4" }, // Unsupported by RVIZ2
-            { AZ::RHI::Format::R8_UNORM, "mono8" },           { AZ::RHI::Format::R16_UNORM, "mono16" },
-            { AZ::RHI::Format::R32_FLOAT, "32FC1" },
-        };
-
-        /// @BitDepth - contains the mapping from RHI to size used in `step` size computation.
-        /// It is some equivalent to `bitDepth()` function from `sensor_msgs/image_encodings.hpp`
-        AZStd::unordered_map<AZ::RHI::Format, int> BitDepth{
-            { AZ::RHI::Format::R8G8B8A8_UNORM, 4 * sizeof(uint8_t) },
-            { AZ::RHI::Format::R16G16B16A16_UNORM, 4 * sizeof(uint16_t) },
-            { AZ::RHI::Format::R32G32B32A32_FLOAT, 4 * sizeof(float) }, // Unsupported by RVIZ2
-            { AZ::RHI::Format::R8_UNORM, sizeof(uint8_t) },
-            { AZ::RHI::Format::R16_UNORM, sizeof(uint16_t) },
-            { AZ::RHI::Format::R32_FLOAT, sizeof(float) },
-        };
-
-        //! Create a CameraImage message from the read-back result and a header.
-        sensor_msgs::msg::Image CreateImageMessageFromReadBackResult(
-            const AZ::EntityId& entityId, const AZ::RPI::AttachmentReadback::ReadbackResult& result, const std_msgs::msg::Header& header)
-        {
-            const AZ::RHI::ImageDescriptor& descriptor = result.m_imageDescriptor;
-            const auto format = descriptor.m_format;
-            AZ_Assert(Internal::FormatMappings.contains(format), "Unknown format in result %u", static_cast<uint32_t>(format));
-            sensor_msgs::msg::Image imageMessage;
-            imageMessage.encoding = Internal::FormatMappings.at(format);
-            imageMessage.width = descriptor.m_size.m_width;
-            imageMessage.height = descriptor.m_size.m_height;
-            imageMessage.step = imageMessage.width * Internal::BitDepth.at(format);
-            imageMessage.data =
-                std::vector<uint8_t>(result.m_dataBuffer->data(), result.m_dataBuffer->data() + result.m_dataBuffer->size());
-            imageMessage.header = header;
-            bool registeredPostProcessingSupportsEncoding = false;
-            CameraPostProcessingRequestBus::EventResult(
-                registeredPostProcessingSupportsEncoding,
-                entityId,
-                &CameraPostProcessingRequests::SupportsFormat,
-                AZStd::string(Internal::FormatMappings.at(format)));
-            if (registeredPostProcessingSupportsEncoding)
-            {
-                CameraPostProcessingRequestBus::Event(entityId, &CameraPostProcessingRequests::ApplyPostProcessing, imageMessage);
-            }
-            return imageMessage;
-        }
-
         //! Prepare a CameraInfo message from sensor description and a header.
         sensor_msgs::msg::CameraInfo CreateCameraInfoMessage(
             const CameraSensorDescription& cameraDescription, const std_msgs::msg::Header& header)
@@ -85,6 +36,9 @@ namespace ROS2
             cameraInfo.width = cameraDescription.m_cameraConfiguration.m_width;
             cameraInfo.height = cameraDescription.m_cameraConfiguration.m_height;
             cameraInfo.distortion_model = sensor_msgs::distortion_models::PLUMB_BOB;
+            // Images are distorted with these coefficients by the built-in post-processing, see CameraSensorEffects.
+            const auto distortion = cameraDescription.m_cameraConfiguration.GetDistortionCoefficients();
+            cameraInfo.d = { distortion.m_k1, distortion.m_k2, distortion.m_p1, distortion.m_p2, distortion.m_k3 };
 
             [[maybe_unused]] constexpr size_t expectedMatrixSize = 9;
             AZ_Assert(cameraInfo.k.size() == expectedMatrixSize, "camera matrix should have %d elements", expectedMatrixSize);
@@ -212,11 +166,15 @@ namespace ROS2
         return m_cameraSensorDescription;
     }
 
+    void CameraSensor::SetSensorProfile(AZStd::shared_ptr<SensorProfile> sensorProfile)
+    {
+        m_cameraPublishers.SetSensorProfile(sensorProfile);
+    }
+
     void CameraSensor::RequestMessagePublication(const AZ::Transform& cameraPose, const std_msgs::msg::Header& header)
     {
-        auto imagePublisher = m_cameraPublishers.GetImagePublisher(GetChannelType());
-        auto infoPublisher = m_cameraPublishers.GetInfoPublisher(GetChannelType());
-        if (!imagePublisher || !infoPublisher)
+        auto pipeline = GetPostProcessingPipeline(GetChannelType());
+        if (!pipeline)
         {
             AZ_Error("CameraSensor::RequestMessagePublication", false, "Missing publisher for the Camera sensor");
             return;
@@ -225,20 +183,35 @@ namespace ROS2
         auto infoMessage = Internal::CreateCameraInfoMessage(m_cameraSensorDescription, header);
         RequestFrame(
             cameraPose,
-            [header, imagePublisher, infoPublisher, infoMessage, entityId = m_entityId](
-                const AZ::RPI::AttachmentReadback::ReadbackResult& result)
+            [header, pipeline, infoMessage](const AZ::RPI::AttachmentReadback::ReadbackResult& result)
             {
                 if (result.m_state != AZ::RPI::AttachmentReadback::ReadbackState::Success)
                 {
                     return;
                 }
 
-                auto imageMessage = Internal::CreateImageMessageFromReadBackResult(entityId, result, header);
-                imagePublisher->publish(imageMessage);
-                infoPublisher->publish(infoMessage);
+                pipeline->Submit(result, header, infoMessage);
             });
     }
 
+    AZStd::shared_ptr<CameraPostProcessingPipeline> CameraSensor::GetPostProcessingPipeline(
+        CameraSensorDescription::CameraChannelType channel)
+    {
+        auto& pipeline = m_postProcessingPipelines[channel];
+        if (!pipeline)
+        {
+            auto imagePublisher = m_cameraPublishers.GetImagePublisher(channel);
+            auto infoPublisher = m_cameraPublishers.GetInfoPublisher(channel);
+            if (!imagePublisher || !infoPublisher)
+            {
+                return nullptr;
+            }
+            pipeline = AZStd::make_shared<CameraPostProcessingPipeline>(
+                m_entityId, imagePublisher, infoPublisher, m_cameraPublishers.GetCompressedImagePublisher(channel));
+        }
+        return pipeline;
+    }
+
     CameraDepthSensor::CameraDepthSensor(const CameraSensorDescription& cameraSensorDescription, const AZ::EntityId& entityId)
         : CameraSensor(cameraSensorDescription, entityId)
     {
@@ -291,9 +264,8 @@ namespace ROS2
 
     void CameraRGBDSensor::RequestMessagePublication(const AZ::Transform& cameraPose, const std_msgs::msg::Header& header)
     {
-        auto imagePublisher = m_cameraPublishers.GetImagePublisher(CameraSensorDescription::CameraChannelType::DEPTH);
-        auto infoPublisher = m_cameraPublishers.GetInfoPublisher(CameraSensorDescription::CameraChannelType::DEPTH);
-        if (!imagePublisher || !infoPublisher)
+        auto pipeline = GetPostProcessingPipeline(CameraSensorDescription::CameraChannelType::DEPTH);
+        if (!pipeline)
         {
             AZ_Error("CameraRGBDSensor::RequestMessagePublication", false, "Missing publisher for the Camera sensor");
             return;
@@ -302,16 +274,13 @@ namespace ROS2
         auto infoMessage = Internal::CreateCameraInfoMessage(m_cameraSensorDescription, header);
         // Process the Depth part.
         ReadBackDepth(
-            [header, imagePublisher, infoPublisher, infoMessage, entityId = m_entityId](
-                const AZ::RPI::AttachmentReadback::ReadbackResult& result)
+            [header, pipeline, infoMessage](const AZ::RPI::AttachmentReadback::ReadbackResult& result)
             {
                 if (result.m_state != AZ::RPI::AttachmentReadback::ReadbackState::Success)
                 {
                     return;
                 }
-                auto imageMessage = Internal::CreateImageMessageFromReadBackResult(entityId, result, header);
-                imagePublisher->publish(imageMessage);
-                infoPublisher->publish(infoMessage);
+                pipeline->Submit(result, header, infoMessage);
             });
 
         // Process the Color part.
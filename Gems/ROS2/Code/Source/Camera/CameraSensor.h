@@ -12,6 +12,7 @@
 
 #include "CameraPublishers.h"
 #include <ROS2/ROS2GemUtilities.h>
+#include <ROS2/Sensor/SensorProfiler.h>
 
 #include <chrono>
 #include <rclcpp/publisher.hpp>
@@ -21,6 +22,8 @@
 
 namespace ROS2
 {
+    class CameraPostProcessingPipeline;
+
     //! Class to create camera sensor using Atom renderer
     //! It creates dedicated rendering pipeline for each camera
     class CameraSensor
@@ -42,6 +45,9 @@ namespace ROS2
         //! Get the camera sensor description
         [[nodiscard]] const CameraSensorDescription& GetCameraSensorDescription() const;
 
+        //! Set the profile which records the size of published images, or nullptr to stop recording.
+        void SetSensorProfile(AZStd::shared_ptr<SensorProfile> sensorProfile);
+
     private:
         AZStd::vector<AZStd::string> m_passHierarchy;
         AZ::RPI::ViewPtr m_view;
@@ -56,6 +62,8 @@ namespace ROS2
         CameraSensorDescription m_cameraSensorDescription;
         CameraPublishers m_cameraPublishers;
         AZ::EntityId m_entityId;
+        AZStd::unordered_map<CameraSensorDescription::CameraChannelType, AZStd::shared_ptr<CameraPostProcessingPipeline>>
+            m_postProcessingPipelines;
         AZ::RPI::RenderPipelinePtr m_pipeline;
         AZStd::string m_pipelineName;
 
@@ -68,6 +76,10 @@ namespace ROS2
 
         //! Read and setup Atom Passes
         void SetupPasses();
+
+        //! Returns the pipeline which post-processes and publishes images of a channel, creating it on first use.
+        //! @return Pipeline of the channel, or nullptr if the channel has no publishers.
+        AZStd::shared_ptr<CameraPostProcessingPipeline> GetPostProcessingPipeline(CameraSensorDescription::CameraChannelType channel);
     };
 
     //! Implementation of camera sensors that runs pipeline which produces depth image
@@ -12,19 +12,43 @@
 
 namespace ROS2
 {
+    LensDistortionCoefficients CameraSensorConfiguration::GetDistortionCoefficients() const
+    {
+        return { m_distortionK1, m_distortionK2, m_distortionK3, m_distortionP1, m_distortionP2 };
+    }
+
+    ImageNoiseParameters CameraSensorConfiguration::GetNoiseParameters() const
+    {
+        return { m_colorNoiseStdDev, m_colorShotNoiseGain, m_depthNoiseStdDev };
+    }
+
     void CameraSensorConfiguration::Reflect(AZ::ReflectContext* context)
     {
         if (auto serializeContext = azrtti_cast<AZ::SerializeContext*>(context))
         {
             serializeContext->Class<CameraSensorConfiguration>()
-                ->Version(2)
+                ->Version(4)
                 ->Field("VerticalFieldOfViewDeg", &CameraSensorConfiguration::m_verticalFieldOfViewDeg)
                 ->Field("Width", &CameraSensorConfiguration::m_width)
                 ->Field("Height", &CameraSensorConfiguration::m_height)
                 ->Field("Depth", &CameraSensorConfiguration::m_depthCamera)
                 ->Field("Color", &CameraSensorConfiguration::m_colorCamera)
+                ->Field("AtlasReadback", &CameraSensorConfiguration::m_atlasReadback)
                 ->Field("ClipNear", &CameraSensorConfiguration::m_nearClipDistance)
-                ->Field("ClipFar", &CameraSensorConfiguration::m_farClipDistance);
+                ->Field("ClipFar", &CameraSensorConfiguration::m_farClipDistance)
+                ->Field("ColorCompression", &CameraSensorConfiguration::m_colorCompression)
+                ->Field("DepthCompression", &CameraSensorConfiguration::m_depthCompression)
+                ->Field("LosslessDepthCompression", &CameraSensorConfiguration::m_losslessDepthCompression)
+                ->Field("JpegQuality", &CameraSensorConfiguration::m_jpegQuality)
+                ->Field("PngCompressionLevel", &CameraSensorConfiguration::m_pngCompressionLevel)
+                ->Field("DistortionK1", &CameraSensorConfiguration::m_distortionK1)
+                ->Field("DistortionK2", &CameraSensorConfiguration::m_distortionK2)
+                ->Field("DistortionK3", &CameraSensorConfiguration::m_distortionK3)
+                ->Field("DistortionP1", &CameraSensorConfiguration::m_distortionP1)
+                ->Field("DistortionP2", &CameraSensorConfiguration::m_distortionP2)
+                ->Field("ColorNoiseStdDev", &CameraSensorConfiguration::m_colorNoiseStdDev)
+                ->Field("ColorShotNoiseGain", &CameraSensorConfiguration::m_colorShotNoiseGain)
+                ->Field("DepthNoiseStdDev", &CameraSensorConfiguration::m_depthNoiseStdDev);
 
             if (AZ::EditContext* ec = serializeContext->GetEditContext())
             {
@@ -42,6 +66,13 @@ namespace ROS2
                     ->Attribute(AZ::Edit::Attributes::Min, CameraSensorConfiguration::m_minHeight)
                     ->DataElement(AZ::Edit::UIHandlers::Default, &CameraSensorConfiguration::m_colorCamera, "Color Camera", "Color Camera")
                     ->DataElement(AZ::Edit::UIHandlers::Default, &CameraSensorConfiguration::m_depthCamera, "Depth Camera", "Depth Camera")
+                    ->DataElement(
+                        AZ::Edit::UIHandlers::Default,
+                        &CameraSensorConfiguration::m_atlasReadback,
+                        "Atlas readback",
+                        "Allow the images of this camera to be tiles of an atlas, which is read back once for all cameras with this "
+                        "option and the same image size and channels, and sliced into the messages of each camera. Cameras keep "
+                        "their own readbacks unless a renderer draws their views into an atlas.")
                     ->DataElement(
                         AZ::Edit::UIHandlers::Default,
                         &CameraSensorConfiguration::m_nearClipDistance,
@@ -51,7 +82,87 @@ namespace ROS2
                         AZ::Edit::UIHandlers::Default,
                         &CameraSensorConfiguration::m_farClipDistance,
                         "Far clip distance",
-                        "Maximum distance to detect objects");
+                        "Maximum distance to detect objects")
+                    ->DataElement(
+                        AZ::Edit::UIHandlers::ComboBox,
+                        &CameraSensorConfiguration::m_colorCompression,
+                        "Color compression",
+                        "Format of the compressed color image, published on the image topic with the '/compressed' suffix.")
+                    ->EnumAttribute(CompressedImageFormat::None, "None")
+                    ->EnumAttribute(CompressedImageFormat::Jpeg, "JPEG")
+                    ->EnumAttribute(CompressedImageFormat::Png, "PNG")
+                    ->EnumAttribute(CompressedImageFormat::Qoi, "QOI")
+                    ->DataElement(
+                        AZ::Edit::UIHandlers::ComboBox,
+                        &CameraSensorConfiguration::m_depthCompression,
+                        "Depth compression",
+                        "Format of the compressed depth image, published on the image topic with the '/compressedDepth' suffix. "
+                        "Depth up to the far clip distance is quantized as inverse depth, as the compressed depth transport does. "
+                        "QOI is available for lossless depth only, and falls back to PNG otherwise.")
+                    ->EnumAttribute(CompressedImageFormat::None, "None")
+                    ->EnumAttribute(CompressedImageFormat::Png, "PNG")
+                    ->EnumAttribute(CompressedImageFormat::Qoi, "QOI")
+                    ->DataElement(
+                        AZ::Edit::UIHandlers::Default,
+                        &CameraSensorConfiguration::m_losslessDepthCompression,
+                        "Lossless depth",
+                        "Publish compressed depth on the image topic with the '/compressed' suffix instead, with the bytes of each "
+                        "32-bit float stored as an RGBA8 pixel, which decoders reinterpret as the original depth. "
+                        "Image transport plugins cannot decode it, unlike the quantized '/compressedDepth' format.")
+                    ->DataElement(
+                        AZ::Edit::UIHandlers::Slider, &CameraSensorConfiguration::m_jpegQuality, "JPEG quality", "Quality of JPEG images.")
+                    ->Attribute(AZ::Edit::Attributes::Min, 1)
+                    ->Attribute(AZ::Edit::Attributes::Max, 100)
+                    ->DataElement(
+                        AZ::Edit::UIHandlers::Slider,
+                        &CameraSensorConfiguration::m_pngCompressionLevel,
+                        "PNG compression level",
+                        "Compression level of PNG images, from 1 (fastest) to 9 (smallest).")
+                    ->Attribute(AZ::Edit::Attributes::Min, 1)
+                    ->Attribute(AZ::Edit::Attributes::Max, 9)
+                    ->DataElement(
+                        AZ::Edit::UIHandlers::Default,
+                        &CameraSensorConfiguration::m_distortionK1,
+                        "Distortion k1",
+                        "First radial distortion coefficient of the plumb bob model, applied to images and reported in camera info.")
+                    ->DataElement(
+                        AZ::Edit::UIHandlers::Default,
+                        &CameraSensorConfiguration::m_distortionK2,
+                        "Distortion k2",
+                        "Second radial distortion coefficient of the plumb bob model.")
+                    ->DataElement(
+                        AZ::Edit::UIHandlers::Default,
+                        &CameraSensorConfiguration::m_distortionK3,
+                        "Distortion k3",
+                        "Third radial distortion coefficient of the plumb bob model.")
+                    ->DataElement(
+                        AZ::Edit::UIHandlers::Default,
+                        &CameraSensorConfiguration::m_distortionP1,
+                        "Distortion p1",
+                        "First tangential distortion coefficient of the plumb bob model.")
+                    ->DataElement(
+                        AZ::Edit::UIHandlers::Default,
+                        &CameraSensorConfiguration::m_distortionP2,
+                        "Distortion p2",
+                        "Second tangential distortion coefficient of the plumb bob model.")
+                    ->DataElement(
+                        AZ::Edit::UIHandlers::Default,
+                        &CameraSensorConfiguration::m_colorNoiseStdDev,
+                        "Color noise",
+                        "Standard deviation of Gaussian noise of color channels, in intensity levels from 0 to 255.")
+                    ->Attribute(AZ::Edit::Attributes::Min, 0.0f)
+                    ->DataElement(
+                        AZ::Edit::UIHandlers::Default,
+                        &CameraSensorConfiguration::m_colorShotNoiseGain,
+                        "Color shot noise gain",
+                        "Variance of shot noise of color channels per intensity level, so that brighter pixels are noisier.")
+                    ->Attribute(AZ::Edit::Attributes::Min, 0.0f)
+                    ->DataElement(
+                        AZ::Edit::UIHandlers::Default,
+                        &CameraSensorConfiguration::m_depthNoiseStdDev,
+                        "Depth noise",
+                        "Standard deviation of depth noise at 1 meter, in meters. It grows with the square of the distance.")
+                    ->Attribute(AZ::Edit::Attributes::Min, 0.0f);
             }
         }
     }
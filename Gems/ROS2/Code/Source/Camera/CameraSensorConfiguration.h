@@ -7,6 +7,9 @@
  */
 #pragma once
 
+#include "CameraImageNoise.h"
+#include "CameraLensDistortion.h"
+
 #include <AzCore/RTTI/RTTI.h>
 #include <AzCore/Serialization/SerializeContext.h>
 #include <AzCore/std/string/string.h>
@@ -19,6 +22,15 @@ namespace ROS2
         AZ_TYPE_INFO(CameraSensorConfiguration, "{386A2640-442B-473D-BC2A-665D049D7EF5}");
         static void Reflect(AZ::ReflectContext* context);
 
+        //! Format of the compressed image topic of an image channel, published next to the raw image topic.
+        enum class CompressedImageFormat
+        {
+            None, //!< Raw images only.
+            Jpeg, //!< Lossy, smallest; not offered for depth.
+            Png, //!< Lossless; depth is published in the compressed depth format, which quantizes it, unless lossless depth is set.
+            Qoi, //!< Lossless and faster to encode than PNG, with larger images; offered for depth with lossless depth only.
+        };
+
         static constexpr int m_minWidth = 1;
         static constexpr int m_minHeight = 1;
 
@@ -29,7 +41,28 @@ namespace ROS2
         int m_height = 480; //!< Camera image height in pixels.
         bool m_colorCamera = true; //!< Use color camera?
         bool m_depthCamera = true; //!< Use depth camera?
+        //! Allow the camera to be rendered as a tile of an atlas shared with compatible cameras, which is read back at once and
+        //! sliced with SubmitAtlasTiles. Opt-in, since the camera keeps its own readback unless a renderer draws the atlas.
+        //! @see CameraAtlasLayout::AreCompatible
+        bool m_atlasReadback = false;
         float m_nearClipDistance = 0.1f; //!< Near clip distance of the camera.
         float m_farClipDistance = 100.0f; //!< Far clip distance of the camera.
+        CompressedImageFormat m_colorCompression = CompressedImageFormat::None; //!< Compressed topic of the color image.
+        CompressedImageFormat m_depthCompression = CompressedImageFormat::None; //!< Compressed topic of the depth image.
+        //! Publish compressed depth losslessly, as 32-bit floats packed into RGBA8 pixels, instead of the compressed depth format.
+        bool m_losslessDepthCompression = false;
+        int m_jpegQuality = 90; //!< JPEG quality, from 1 to 100.
+        int m_pngCompressionLevel = 1; //!< PNG compression level, from 1 (fastest) to 9 (smallest).
+        float m_distortionK1 = 0.0f; //!< First radial distortion coefficient of the plumb bob model.
+        float m_distortionK2 = 0.0f; //!< Second radial distortion coefficient of the plumb bob model.
+        float m_distortionK3 = 0.0f; //!< Third radial distortion coefficient of the plumb bob model.
+        float m_distortionP1 = 0.0f; //!< First tangential distortion coefficient of the plumb bob model.
+        float m_distortionP2 = 0.0f; //!< Second tangential distortion coefficient of the plumb bob model.
+        float m_colorNoiseStdDev = 0.0f; //!< Standard deviation of Gaussian noise of color channels, in intensity levels.
+        float m_colorShotNoiseGain = 0.0f; //!< Variance of shot noise of color channels per intensity level.
+        float m_depthNoiseStdDev = 0.0f; //!< Standard deviation of depth noise at 1 meter, growing with the square of distance.
+
+        LensDistortionCoefficients GetDistortionCoefficients() const;
+        ImageNoiseParameters GetNoiseParameters() const;
     };
 } // namespace ROS2
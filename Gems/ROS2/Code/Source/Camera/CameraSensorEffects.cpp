@@ -0,0 +1,133 @@
+/*
+ * Copyright (c) Contributors to the Open 3D Engine Project.
+ * For complete copyright and license terms please see the LICENSE at the root of this distribution.
+ *
+ * SPDX-License-Identifier: Apache-2.0 OR MIT
+ *
+ */
+
+#include "CameraSensorEffects.h"
+
+#include <cstring>
+
+namespace ROS2
+{
+    namespace Internal
+    {
+        constexpr const char* ColorEncoding = "rgba8";
+        constexpr const char* DepthEncoding = "32FC1";
+
+        //! SplitMix64 finalizer, which spreads small differences of its input over all bits.
+        AZ::u64 MixBits(AZ::u64 value)
+        {
+            value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ull;
+            value = (value ^ (value >> 27)) * 0x94D049BB133111EBull;
+            return value ^ (value >> 31);
+        }
+    } // namespace Internal
+
+    CameraSensorEffects::CameraSensorEffects(const CameraSensorConfiguration& configuration, const AZ::Matrix3x3& intrinsics)
+        : m_noise(configuration.GetNoiseParameters())
+    {
+        const auto coefficients = configuration.GetDistortionCoefficients();
+        if (!coefficients.IsZero())
+        {
+            m_distortionMap.emplace(
+                static_cast<AZ::u32>(configuration.m_width), static_cast<AZ::u32>(configuration.m_height), intrinsics, coefficients);
+        }
+    }
+
+    CameraSensorEffects::~CameraSensorEffects()
+    {
+        Disconnect();
+    }
+
+    bool CameraSensorEffects::HasEffects(const CameraSensorConfiguration& configuration)
+    {
+        return !configuration.GetDistortionCoefficients().IsZero() || !configuration.GetNoiseParameters().IsZero();
+    }
+
+    void CameraSensorEffects::Connect(const AZ::EntityId& entityId)
+    {
+        // Cameras of other entities get different noise for frames of the same time and number.
+        m_sensorSeed = Internal::MixBits(static_cast<AZ::u64>(entityId));
+        CameraPostProcessingRequestBus::Handler::BusConnect(entityId);
+    }
+
+    void CameraSensorEffects::Disconnect()
+    {
+        CameraPostProcessingRequestBus::Handler::BusDisconnect();
+    }
+
+    void CameraSensorEffects::ApplyPostProcessing(sensor_msgs::msg::Image& image)
+    {
+        // Used only when the image is not processed by tiles, in which case each call is a new frame.
+        m_scratch.header = image.header;
+        m_scratch.width = image.width;
+        m_scratch.height = image.height;
+        m_scratch.encoding = image.encoding;
+        m_scratch.is_bigendian = image.is_bigendian;
+        m_scratch.step = image.step;
+        m_scratch.data.resize(image.data.size());
+        ApplyPostProcessingToTile(image, m_scratch, 0, image.height, ++m_frameCount);
+        image.data.swap(m_scratch.data);
+    }
+
+    bool CameraSensorEffects::SupportsFormat(const AZStd::string& encodingFormat)
+    {
+        return encodingFormat == Internal::ColorEncoding || encodingFormat == Internal::DepthEncoding;
+    }
+
+    AZ::u8 CameraSensorEffects::GetPriority() const
+    {
+        return Priority;
+    }
+
+    bool CameraSensorEffects::SupportsTiles() const
+    {
+        return true;
+    }
+
+    void CameraSensorEffects::ApplyPostProcessingToTile(
+        const sensor_msgs::msg::Image& source,
+        sensor_msgs::msg::Image& target,
+        AZ::u32 firstRow,
+        AZ::u32 lastRow,
+        AZ::u64 frameSeed)
+    {
+        const bool isDepth = source.encoding == Internal::DepthEncoding;
+        const bool hasDistortion =
+            m_distortionMap && m_distortionMap->GetWidth() == source.width && m_distortionMap->GetHeight() == source.height;
+        AZ_WarningOnce("CameraSensorEffects", !m_distortionMap || hasDistortion, "Image size differs from the camera configuration.");
+
+        if (hasDistortion && isDepth)
+        {
+            m_distortionMap->RemapDepth(source.data.data(), source.step, target.data.data(), target.step, firstRow, lastRow);
+        }
+        else if (hasDistortion)
+        {
+            m_distortionMap->RemapRgba8(source.data.data(), source.step, target.data.data(), target.step, firstRow, lastRow);
+        }
+        else
+        {
+            const size_t first = size_t{ firstRow } * source.step;
+            std::memcpy(target.data.data() + first, source.data.data() + first, size_t{ lastRow - firstRow } * source.step);
+        }
+
+        const AZ::u64 seed = GetNoiseSeed(source, frameSeed);
+        if (isDepth)
+        {
+            m_noise.ApplyDepth(target.data.data(), target.step, target.width, firstRow, lastRow, seed);
+        }
+        else
+        {
+            m_noise.ApplyRgba8(target.data.data(), target.step, target.width, firstRow, lastRow, seed);
+        }
+    }
+
+    AZ::u64 CameraSensorEffects::GetNoiseSeed(const sensor_msgs::msg::Image& image, AZ::u64 frameSeed) const
+    {
+        const bool isDepth = image.encoding == Internal::DepthEncoding;
+        return Internal::MixBits(m_sensorSeed + Internal::MixBits(frameSeed << 1 | (isDepth ? 1 : 0)));
+    }
+} // namespace ROS2
@@ -0,0 +1,64 @@
+/*
+ * Copyright (c) Contributors to the Open 3D Engine Project.
+ * For complete copyright and license terms please see the LICENSE at the root of this distribution.
+ *
+ * SPDX-License-Identifier: Apache-2.0 OR MIT
+ *
+ */
+#pragma once
+
+#include "CameraImageNoise.h"
+#include "CameraLensDistortion.h"
+#include "CameraSensorConfiguration.h"
+
+#include <AzCore/Component/EntityId.h>
+#include <AzCore/std/optional.h>
+#include <AzCore/std/parallel/atomic.h>
+#include <ROS2/Camera/CameraPostProcessingRequestBus.h>
+
+namespace ROS2
+{
+    //! Built-in post-processing of camera sensors, which applies lens distortion and sensor noise of the camera configuration to
+    //! color (rgba8) and depth (32FC1) images. Distortion coefficients match those reported in camera info, so that downstream
+    //! undistortion recovers the pinhole image. Rows are processed independently, as tiles of the post-processing pipeline.
+    class CameraSensorEffects : public CameraPostProcessingRequestBus::Handler
+    {
+    public:
+        //! Lens and sensor effects run before other post-processing, the way they happen before image processing in a camera.
+        static constexpr AZ::u8 Priority = 200;
+
+        //! @param intrinsics Camera matrix of the images.
+        CameraSensorEffects(const CameraSensorConfiguration& configuration, const AZ::Matrix3x3& intrinsics);
+        ~CameraSensorEffects() override;
+
+        //! Query whether a configuration has any effects, without which a handler is not needed.
+        static bool HasEffects(const CameraSensorConfiguration& configuration);
+
+        //! Connects to post-processing of the camera of an entity.
+        void Connect(const AZ::EntityId& entityId);
+        void Disconnect();
+
+        // CameraPostProcessingRequestBus::Handler overrides
+        void ApplyPostProcessing(sensor_msgs::msg::Image& image) override;
+        bool SupportsFormat(const AZStd::string& encodingFormat) override;
+        AZ::u8 GetPriority() const override;
+        bool SupportsTiles() const override;
+        void ApplyPostProcessingToTile(
+            const sensor_msgs::msg::Image& source,
+            sensor_msgs::msg::Image& target,
+            AZ::u32 firstRow,
+            AZ::u32 lastRow,
+            AZ::u64 frameSeed) override;
+
+    private:
+        //! Returns the noise seed of an image of a frame, which differs between cameras, and between color and depth.
+        AZ::u64 GetNoiseSeed(const sensor_msgs::msg::Image& image, AZ::u64 frameSeed) const;
+
+        AZStd::optional<LensDistortionMap> m_distortionMap;
+        ImageNoise m_noise;
+        sensor_msgs::msg::Image m_scratch; //!< Target of distortion of whole images.
+
+        AZ::u64 m_sensorSeed = 0;
+        AZStd::atomic<AZ::u64> m_frameCount{ 0 }; //!< Number of whole images processed, which seeds them.
+    };
+} // namespace ROS2
@@ -6,11 +6,34 @@
  *
  */
 
+#include "CameraUtilities.h"
+
 #include <AzCore/Math/Matrix3x3.h>
 #include <AzCore/Math/MatrixUtils.h>
+#include <AzCore/std/containers/unordered_map.h>
 
 namespace ROS2::CameraUtils
 {
+    namespace Internal
+    {
+        //! Mapping from RHI formats to ROS image encodings and to their pixel sizes, used to compute the row size.
+        //! `sensor_msgs/image_encodings.hpp` is not included, since it uses exceptions.
+        struct ImageFormat
+        {
+            const char* m_encoding;
+            AZ::u32 m_pixelSize;
+        };
+
+        const AZStd::unordered_map<AZ::RHI::Format, ImageFormat> ImageFormats{
+            { AZ::RHI::Format::R8G8B8A8_UNORM, { "rgba8", 4 * sizeof(uint8_t) } },
+            { AZ::RHI::Format::R16G16B16A16_UNORM, { "rgba16", 4 * sizeof(uint16_t) } },
+            { AZ::RHI::Format::R32G32B32A32_FLOAT, { "32FC4", 4 * sizeof(float) } }, // Unsupported by RVIZ2
+            { AZ::RHI::Format::R8_UNORM, { "mono8", sizeof(uint8_t) } },
+            { AZ::RHI::Format::R16_UNORM, { "mono16", sizeof(uint16_t) } },
+            { AZ::RHI::Format::R32_FLOAT, { "32FC1", sizeof(float) } },
+        };
+    } // namespace Internal
+
     float GetAspectRatio(float width, float height)
     {
         return width / height;
@@ -40,4 +63,69 @@ namespace ROS2::CameraUtils
         return localViewToClipMatrix;
     }
 
-} // namespace ROS2::CameraUtils
\ No newline at end of file
+    const char* GetImageEncoding(AZ::RHI::Format format)
+    {
+        auto it = Internal::ImageFormats.find(format);
+        return it != Internal::ImageFormats.end() ? it->second.m_encoding : nullptr;
+    }
+
+    AZ::u32 GetPixelSize(AZ::RHI::Format format)
+    {
+        auto it = Internal::ImageFormats.find(format);
+        return it != Internal::ImageFormats.end() ? it->second.m_pixelSize : 0;
+    }
+
+    ImageView GetImageView(const AZ::RPI::AttachmentReadback::ReadbackResult& result)
+    {
+        const AZ::RHI::ImageDescriptor& descriptor = result.m_imageDescriptor;
+        ImageView image;
+        image.m_data = result.m_dataBuffer ? result.m_dataBuffer->data() : nullptr;
+        image.m_width = descriptor.m_size.m_width;
+        image.m_height = descriptor.m_size.m_height;
+        image.m_step = size_t{ image.m_width } * GetPixelSize(descriptor.m_format);
+        image.m_format = descriptor.m_format;
+        return image;
+    }
+
+    bool FillImageMessage(
+        const AZ::RPI::AttachmentReadback::ReadbackResult& result,
+        const std_msgs::msg::Header& header,
+        sensor_msgs::msg::Image& imageMessage)
+    {
+        return FillImageMessage(GetImageView(result), header, imageMessage);
+    }
+
+    bool FillImageMessage(const ImageView& image, const std_msgs::msg::Header& header, sensor_msgs::msg::Image& imageMessage)
+    {
+        auto it = Internal::ImageFormats.find(image.m_format);
+        if (it == Internal::ImageFormats.end())
+        {
+            AZ_Error("CameraUtils", false, "Unknown format in result %u", static_cast<uint32_t>(image.m_format));
+            return false;
+        }
+
+        imageMessage.header = header;
+        imageMessage.encoding = it->second.m_encoding;
+        imageMessage.width = image.m_width;
+        imageMessage.height = image.m_height;
+        imageMessage.step = imageMessage.width * it->second.m_pixelSize;
+        imageMessage.is_bigendian = false;
+        const size_t size = size_t{ imageMessage.step } * image.m_height;
+        // Resizing to the size of the previous frame neither allocates nor clears the buffer, which is overwritten right away.
+        imageMessage.data.resize(size);
+        if (size == 0)
+        {
+            return true;
+        }
+        if (image.m_step == imageMessage.step)
+        {
+            memcpy(imageMessage.data.data(), image.m_data, size);
+            return true;
+        }
+        for (AZ::u32 y = 0; y < image.m_height; ++y)
+        {
+            memcpy(imageMessage.data.data() + size_t{ y } * imageMessage.step, image.m_data + y * image.m_step, imageMessage.step);
+        }
+        return true;
+    }
+} // namespace ROS2::CameraUtils
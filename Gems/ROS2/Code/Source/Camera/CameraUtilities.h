@@ -7,7 +7,10 @@
  */
 #pragma once
 
+#include <Atom/RPI.Public/Pass/AttachmentReadback.h>
 #include <AzCore/Math/Matrix3x3.h>
+#include <sensor_msgs/msg/image.hpp>
+#include <std_msgs/msg/header.hpp>
 
 //! Namespace contains utility functions for camera.
 namespace ROS2::CameraUtils
@@ -33,4 +36,40 @@ namespace ROS2::CameraUtils
     //! @param nearDist Near clipping plane distance in meters.
     //! @return projection matrix for the rendering.
     AZ::Matrix4x4 MakeClipMatrix(int width, int height, float verticalFieldOfViewDeg, float nearDist = 0.1f, float farDist = 100.0f);
+
+    //! Image in memory which is not owned by the view, such as a readback result or a region of one.
+    //! Rows may be longer than the image, so that regions of an image are viewed without copying.
+    struct ImageView
+    {
+        const uint8_t* m_data = nullptr;
+        AZ::u32 m_width = 0;
+        AZ::u32 m_height = 0;
+        size_t m_step = 0; //!< Distance between the starts of rows, in bytes.
+        AZ::RHI::Format m_format = AZ::RHI::Format::Unknown;
+    };
+
+    //! Returns the ROS 2 image encoding of a readback format, or nullptr if the format is not supported.
+    //! @see `sensor_msgs/image_encodings.hpp` for the list of ROS 2 image encodings.
+    const char* GetImageEncoding(AZ::RHI::Format format);
+
+    //! Returns the size of a pixel of a readback format in bytes, or 0 if the format is not supported.
+    AZ::u32 GetPixelSize(AZ::RHI::Format format);
+
+    //! Returns a view of the image of a successful readback result, with tightly packed rows.
+    ImageView GetImageView(const AZ::RPI::AttachmentReadback::ReadbackResult& result);
+
+    //! Fills an image message with a readback result and a header. The data of the readback is copied into the existing buffer of
+    //! the message, which only allocates when the buffer grows, so a reused message does not allocate for frames of the same size.
+    //! @param result Successful readback result of an image.
+    //! @param header Header of the message.
+    //! @param imageMessage Message to fill.
+    //! @return Whether the format of the image is supported.
+    bool FillImageMessage(
+        const AZ::RPI::AttachmentReadback::ReadbackResult& result,
+        const std_msgs::msg::Header& header,
+        sensor_msgs::msg::Image& imageMessage);
+
+    //! Fills an image message with a viewed image, in the same way. Rows are copied one by one if the rows of the view are longer
+    //! than the image, and the message always has tightly packed rows.
+    bool FillImageMessage(const ImageView& image, const std_msgs::msg::Header& header, sensor_msgs::msg::Image& imageMessage);
 } // namespace ROS2::CameraUtils
@@ -0,0 +1,195 @@
+/*
+ * Copyright (c) Contributors to the Open 3D Engine Project.
+ * For complete copyright and license terms please see the LICENSE at the root of this distribution.
+ *
+ * SPDX-License-Identifier: Apache-2.0 OR MIT
+ *
+ */
+
+#include "CompressedImagePublisher.h"
+#include <AzCore/Jobs/JobFunction.h>
+#include <ROS2/Sensor/SensorPublisher.h>
+
+namespace ROS2
+{
+    namespace Internal
+    {
+        //! Layout of the pixels of an image encoding, as seen by the encoders.
+        struct EncodingLayout
+        {
+            const char* m_encoding;
+            AZ::u32 m_channelCount;
+            AZ::u32 m_channelSize;
+            bool m_isDepth; //!< 32-bit float depth.
+        };
+
+        constexpr EncodingLayout EncodingLayouts[] = {
+            { "rgba8", 4, 1, false }, { "rgba16", 4, 2, false }, { "mono8", 1, 1, false },
+            { "mono16", 1, 2, false }, { "32FC1", 1, 4, true },
+        };
+
+        const EncodingLayout* FindEncodingLayout(const std::string& encoding)
+        {
+            for (const auto& layout : EncodingLayouts)
+            {
+                if (encoding == layout.m_encoding)
+                {
+                    return &layout;
+                }
+            }
+            return nullptr;
+        }
+
+        //! Returns the name of the pixel format of encoded images, as in the format strings of the compressed image transport.
+        const char* GetCompressedContent(const EncodingLayout& layout, bool isJpeg)
+        {
+            if (layout.m_channelCount == 1)
+            {
+                return layout.m_channelSize == 1 ? "mono8" : "mono16";
+            }
+            if (isJpeg)
+            {
+                return "rgb8";
+            }
+            return layout.m_channelSize == 1 ? "rgba8" : "rgba16";
+        }
+
+        AZ::u64 GetStampNanoseconds(const builtin_interfaces::msg::Time& stamp)
+        {
+            return static_cast<AZ::u64>(stamp.sec) * 1000000000ull + stamp.nanosec;
+        }
+    } // namespace Internal
+
+    CompressedImagePublisher::CompressedImagePublisher(
+        const std::shared_ptr<rclcpp::Node>& node,
+        const AZStd::string& imageTopic,
+        const rclcpp::QoS& qos,
+        bool isDepth,
+        const Settings& settings)
+        : m_settings(settings)
+    {
+        const bool isCompressedDepth = isDepth && !settings.m_isLosslessDepth;
+        const AZStd::string topic = imageTopic + (isCompressedDepth ? "/compressedDepth" : "/compressed");
+        m_publisher = node->create_publisher<sensor_msgs::msg::CompressedImage>(topic.data(), qos, GetSensorPublisherOptions(qos));
+        for (auto& frame : m_frames)
+        {
+            m_freeFrames.push_back(&frame);
+        }
+    }
+
+    bool CompressedImagePublisher::Publish(const sensor_msgs::msg::Image& image)
+    {
+        Frame* frame = nullptr;
+        {
+            AZStd::lock_guard<AZStd::mutex> lock(m_mutex);
+            if (m_freeFrames.empty())
+            {
+                return false;
+            }
+            frame = m_freeFrames.back();
+            m_freeFrames.pop_back();
+        }
+
+        // The frame keeps the buffer of its image copy, so images of the same size are copied without allocations.
+        frame->m_image = image;
+        AZ::CreateJobFunction(
+            [self = shared_from_this(), frame]()
+            {
+                self->EncodeAndPublish(frame);
+            },
+            true)
+            ->Start();
+        return true;
+    }
+
+    void CompressedImagePublisher::EncodeAndPublish(Frame* frame)
+    {
+        const bool encoded = Encode(frame->m_image, m_settings, frame->m_encoder, frame->m_message);
+        AZ_WarningOnce(
+            "CompressedImagePublisher", encoded, "Compression of %s images is not supported.", frame->m_image.encoding.c_str());
+
+        if (encoded)
+        {
+            AZStd::lock_guard<AZStd::mutex> lock(m_publishMutex);
+            const AZ::u64 stamp = Internal::GetStampNanoseconds(frame->m_message.header.stamp);
+            if (stamp >= m_lastPublishedStamp)
+            {
+                m_lastPublishedStamp = stamp;
+                m_publisher->publish(frame->m_message);
+            }
+        }
+
+        AZStd::lock_guard<AZStd::mutex> lock(m_mutex);
+        m_freeFrames.push_back(frame);
+    }
+
+    bool CompressedImagePublisher::Encode(
+        const sensor_msgs::msg::Image& image, const Settings& settings, ImageEncoder& encoder, sensor_msgs::msg::CompressedImage& message)
+    {
+        message.header = image.header;
+        const Internal::EncodingLayout* layout = Internal::FindEncodingLayout(image.encoding);
+        Format format = settings.m_format;
+        if (!layout || format == Format::None)
+        {
+            return false;
+        }
+
+        ImageView view;
+        view.m_data = image.data.data();
+        view.m_width = image.width;
+        view.m_height = image.height;
+        view.m_step = image.step;
+        view.m_channelCount = layout->m_channelCount;
+        view.m_channelSize = layout->m_channelSize;
+        if (image.data.size() < size_t{ view.m_step } * view.m_height)
+        {
+            return false;
+        }
+
+        if (layout->m_isDepth && !settings.m_isLosslessDepth)
+        {
+            // Format string of the compressed depth transport, which always encodes depth as PNG here.
+            message.format = AZStd::string::format("%s; compressedDepth png", layout->m_encoding).c_str();
+            return encoder.EncodeCompressedDepth(view, settings.m_maxDepth, settings.m_pngCompressionLevel, message.data);
+        }
+
+        if (layout->m_isDepth)
+        {
+            // The bytes of each float are stored as an RGBA8 pixel, which both PNG and QOI keep exactly.
+            view.m_channelCount = 4;
+            view.m_channelSize = 1;
+            format = format == Format::Qoi ? Format::Qoi : Format::Png;
+        }
+        // JPEG supports 8-bit images only, and QOI supports 8-bit color images only.
+        else if (
+            (format == Format::Jpeg && layout->m_channelSize != 1) ||
+            (format == Format::Qoi && (layout->m_channelCount != 4 || layout->m_channelSize != 1)))
+        {
+            format = Format::Png;
+        }
+
+        const char* formatName = nullptr;
+        bool encoded = false;
+        switch (format)
+        {
+        case Format::Jpeg:
+            formatName = "jpeg";
+            encoded = encoder.EncodeJpeg(view, settings.m_jpegQuality, message.data);
+            break;
+        case Format::Png:
+            formatName = "png";
+            encoded = encoder.EncodePng(view, settings.m_pngCompressionLevel, message.data);
+            break;
+        case Format::Qoi:
+            formatName = "qoi";
+            encoded = encoder.EncodeQoi(view, message.data);
+            break;
+        default:
+            break;
+        }
+
+        const char* compressedContent = layout->m_isDepth ? "rgba8" : Internal::GetCompressedContent(*layout, format == Format::Jpeg);
+        message.format = AZStd::string::format("%s; %s compressed %s", layout->m_encoding, formatName, compressedContent).c_str();
+        return encoded;
+    }
+} // namespace ROS2
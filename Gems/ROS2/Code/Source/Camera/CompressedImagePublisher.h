@@ -0,0 +1,99 @@
+/*
+ * Copyright (c) Contributors to the Open 3D Engine Project.
+ * For complete copyright and license terms please see the LICENSE at the root of this distribution.
+ *
+ * SPDX-License-Identifier: Apache-2.0 OR MIT
+ *
+ */
+#pragma once
+
+#include "CameraSensorConfiguration.h"
+#include "ImageEncoder.h"
+
+#include <AzCore/std/containers/array.h>
+#include <AzCore/std/containers/vector.h>
+#include <AzCore/std/parallel/mutex.h>
+#include <AzCore/std/smart_ptr/enable_shared_from_this.h>
+#include <AzCore/std/string/string.h>
+#include <memory>
+#include <rclcpp/node.hpp>
+#include <rclcpp/publisher.hpp>
+#include <sensor_msgs/msg/compressed_image.hpp>
+#include <sensor_msgs/msg/image.hpp>
+
+namespace ROS2
+{
+    //! Publishes compressed images of a camera channel, in the format of the compressed image transport.
+    //! Images are encoded and published by jobs, so that encoding does not hold up readbacks of the camera. Frames are dropped
+    //! when all of them are being encoded, and frames which finish encoding after a newer frame are dropped too, so subscribers
+    //! receive frames in order.
+    //! Depth images are published in the format of the compressed depth image transport instead, on the "/compressedDepth"
+    //! topic, as quantized inverse depth in a 16-bit PNG. With lossless depth, they are published on the "/compressed" topic, as
+    //! PNG or QOI images storing the bytes of each 32-bit float as an RGBA8 pixel, with the format string
+    //! "32FC1; png compressed rgba8" (or "qoi"). Decoders reinterpret the pixels as the original little-endian floats.
+    class CompressedImagePublisher : public AZStd::enable_shared_from_this<CompressedImagePublisher>
+    {
+    public:
+        using Format = CameraSensorConfiguration::CompressedImageFormat;
+
+        struct Settings
+        {
+            Format m_format = Format::Png;
+            int m_jpegQuality = 90;
+            int m_pngCompressionLevel = 1;
+            //! Largest depth of compressed depth images, in meters. Farther depth is published as invalid.
+            float m_maxDepth = 100.0f;
+            //! Whether depth is compressed losslessly instead of in the compressed depth format.
+            bool m_isLosslessDepth = false;
+        };
+
+        //! Number of frames which may be encoded at once.
+        static constexpr size_t MaxFramesInFlight = 2;
+
+        //! @param node Node to create the publisher on.
+        //! @param imageTopic Topic of raw images, which gets the "/compressed" suffix, or "/compressedDepth" for depth images
+        //! which are not compressed losslessly.
+        //! @param qos Quality of service of raw images, which compressed images share.
+        //! @param isDepth Whether the channel publishes depth images.
+        CompressedImagePublisher(
+            const std::shared_ptr<rclcpp::Node>& node,
+            const AZStd::string& imageTopic,
+            const rclcpp::QoS& qos,
+            bool isDepth,
+            const Settings& settings);
+
+        //! Copies an image and starts a job which encodes and publishes it.
+        //! @return Whether the image is encoded, or false if it is dropped since all frames are in flight.
+        bool Publish(const sensor_msgs::msg::Image& image);
+
+        //! Encodes an image into a compressed image message, including its header and format.
+        //! Depth images are encoded in the compressed depth format, unless they are compressed losslessly. Formats which do not
+        //! support an image fall back to PNG, e.g. JPEG for 16-bit images and QOI for single channel images.
+        //! @return Whether the encoding of the image is supported.
+        static bool Encode(
+            const sensor_msgs::msg::Image& image,
+            const Settings& settings,
+            ImageEncoder& encoder,
+            sensor_msgs::msg::CompressedImage& message);
+
+    private:
+        struct Frame
+        {
+            sensor_msgs::msg::Image m_image;
+            sensor_msgs::msg::CompressedImage m_message;
+            ImageEncoder m_encoder;
+        };
+
+        void EncodeAndPublish(Frame* frame);
+
+        Settings m_settings;
+        rclcpp::Publisher<sensor_msgs::msg::CompressedImage>::SharedPtr m_publisher;
+
+        AZStd::array<Frame, MaxFramesInFlight> m_frames;
+        AZStd::mutex m_mutex;
+        AZStd::vector<Frame*> m_freeFrames; //!< Guarded by m_mutex.
+        //! Orders publication of encoded frames. Separate from m_mutex, so that publishing does not hold up new frames.
+        AZStd::mutex m_publishMutex;
+        AZ::u64 m_lastPublishedStamp = 0; //!< Stamp of the newest published frame in nanoseconds, guarded by m_publishMutex.
+    };
+} // namespace ROS2
@@ -0,0 +1,758 @@
+/*
+ * Copyright (c) Contributors to the Open 3D Engine Project.
+ * For complete copyright and license terms please see the LICENSE at the root of this distribution.
+ *
+ * SPDX-License-Identifier: Apache-2.0 OR MIT
+ *
+ */
+
+#include "ImageEncoder.h"
+
+#include <AzCore/Compression/compression.h>
+#include <AzCore/std/algorithm.h>
+#include <AzCore/std/containers/array.h>
+#include <cmath>
+#include <cstring>
+
+namespace ROS2
+{
+    namespace Internal
+    {
+        void AppendU16BigEndian(std::vector<uint8_t>& output, AZ::u32 value)
+        {
+            output.push_back(static_cast<uint8_t>(value >> 8));
+            output.push_back(static_cast<uint8_t>(value));
+        }
+
+        void AppendU32BigEndian(std::vector<uint8_t>& output, AZ::u32 value)
+        {
+            AppendU16BigEndian(output, value >> 16);
+            AppendU16BigEndian(output, value & 0xFFFF);
+        }
+
+        //////////////////////////////////////////////////////////////////////////
+        // JPEG
+
+        //! Natural order index of each coefficient in zigzag order.
+        constexpr AZStd::array<uint8_t, 64> ZigZag{ 0,  1,  8,  16, 9,  2,  3,  10, 17, 24, 32, 25, 18, 11, 4,  5,
+                                                    12, 19, 26, 33, 40, 48, 41, 34, 27, 20, 13, 6,  7,  14, 21, 28,
+                                                    35, 42, 49, 56, 57, 50, 43, 36, 29, 22, 15, 23, 30, 37, 44, 51,
+                                                    58, 59, 52, 45, 38, 31, 39, 46, 53, 60, 61, 54, 47, 55, 62, 63 };
+
+        //! Example quantization tables of the JPEG specification (K.1 and K.2), in natural order.
+        constexpr AZStd::array<uint8_t, 64> LuminanceQuantization{ 16, 11, 10, 16, 24,  40,  51,  61,  12, 12, 14, 19, 26,  58,  60,  55,
+                                                                   14, 13, 16, 24, 40,  57,  69,  56,  14, 17, 22, 29, 51,  87,  80,  62,
+                                                                   18, 22, 37, 56, 68,  109, 103, 77,  24, 35, 55, 64, 81,  104, 113, 92,
+                                                                   49, 64, 78, 87, 103, 121, 120, 101, 72, 92, 95, 98, 112, 100, 103, 99 };
+        constexpr AZStd::array<uint8_t, 64> ChrominanceQuantization{ 17, 18, 24, 47, 99, 99, 99, 99, 18, 21, 26, 66, 99, 99, 99, 99,
+                                                                     24, 26, 56, 99, 99, 99, 99, 99, 47, 66, 99, 99, 99, 99, 99, 99,
+                                                                     99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99,
+                                                                     99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99 };
+
+        //! Typical Huffman tables of the JPEG specification (K.3): code counts by length, then symbols by code.
+        constexpr AZStd::array<uint8_t, 16> LuminanceDcBits{ 0, 1, 5, 1, 1, 1, 1, 1, 1, 0, 0, 0, 0, 0, 0, 0 };
+        constexpr AZStd::array<uint8_t, 12> LuminanceDcSymbols{ 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11 };
+        constexpr AZStd::array<uint8_t, 16> ChrominanceDcBits{ 0, 3, 1, 1, 1, 1, 1, 1, 1, 1, 1, 0, 0, 0, 0, 0 };
+        constexpr AZStd::array<uint8_t, 12> ChrominanceDcSymbols{ 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11 };
+        constexpr AZStd::array<uint8_t, 16> LuminanceAcBits{ 0, 2, 1, 3, 3, 2, 4, 3, 5, 5, 4, 4, 0, 0, 1, 0x7d };
+        constexpr AZStd::array<uint8_t, 162> LuminanceAcSymbols{
+            0x01, 0x02, 0x03, 0x00, 0x04, 0x11, 0x05, 0x12, 0x21, 0x31, 0x41, 0x06, 0x13, 0x51, 0x61, 0x07, 0x22, 0x71, 0x14, 0x32, 0x81,
+            0x91, 0xa1, 0x08, 0x23, 0x42, 0xb1, 0xc1, 0x15, 0x52, 0xd1, 0xf0, 0x24, 0x33, 0x62, 0x72, 0x82, 0x09, 0x0a, 0x16, 0x17, 0x18,
+            0x19, 0x1a, 0x25, 0x26, 0x27, 0x28, 0x29, 0x2a, 0x34, 0x35, 0x36, 0x37, 0x38, 0x39, 0x3a, 0x43, 0x44, 0x45, 0x46, 0x47, 0x48,
+            0x49, 0x4a, 0x53, 0x54, 0x55, 0x56, 0x57, 0x58, 0x59, 0x5a, 0x63, 0x64, 0x65, 0x66, 0x67, 0x68, 0x69, 0x6a, 0x73, 0x74, 0x75,
+            0x76, 0x77, 0x78, 0x79, 0x7a, 0x83, 0x84, 0x85, 0x86, 0x87, 0x88, 0x89, 0x8a, 0x92, 0x93, 0x94, 0x95, 0x96, 0x97, 0x98, 0x99,
+            0x9a, 0xa2, 0xa3, 0xa4, 0xa5, 0xa6, 0xa7, 0xa8, 0xa9, 0xaa, 0xb2, 0xb3, 0xb4, 0xb5, 0xb6, 0xb7, 0xb8, 0xb9, 0xba, 0xc2, 0xc3,
+            0xc4, 0xc5, 0xc6, 0xc7, 0xc8, 0xc9, 0xca, 0xd2, 0xd3, 0xd4, 0xd5, 0xd6, 0xd7, 0xd8, 0xd9, 0xda, 0xe1, 0xe2, 0xe3, 0xe4, 0xe5,
+            0xe6, 0xe7, 0xe8, 0xe9, 0xea, 0xf1, 0xf2, 0xf3, 0xf4, 0xf5, 0xf6, 0xf7, 0xf8, 0xf9, 0xfa
+        };
+        constexpr AZStd::array<uint8_t, 16> ChrominanceAcBits{ 0, 2, 1, 2, 4, 4, 3, 4, 7, 5, 4, 4, 0, 1, 2, 0x77 };
+        constexpr AZStd::array<uint8_t, 162> ChrominanceAcSymbols{
+            0x00, 0x01, 0x02, 0x03, 0x11, 0x04, 0x05, 0x21, 0x31, 0x06, 0x12, 0x41, 0x51, 0x07, 0x61, 0x71, 0x13, 0x22, 0x32, 0x81, 0x08,
+            0x14, 0x42, 0x91, 0xa1, 0xb1, 0xc1, 0x09, 0x23, 0x33, 0x52, 0xf0, 0x15, 0x62, 0x72, 0xd1, 0x0a, 0x16, 0x24, 0x34, 0xe1, 0x25,
+            0xf1, 0x17, 0x18, 0x19, 0x1a, 0x26, 0x27, 0x28, 0x29, 0x2a, 0x35, 0x36, 0x37, 0x38, 0x39, 0x3a, 0x43, 0x44, 0x45, 0x46, 0x47,
+            0x48, 0x49, 0x4a, 0x53, 0x54, 0x55, 0x56, 0x57, 0x58, 0x59, 0x5a, 0x63, 0x64, 0x65, 0x66, 0x67, 0x68, 0x69, 0x6a, 0x73, 0x74,
+            0x75, 0x76, 0x77, 0x78, 0x79, 0x7a, 0x82, 0x83, 0x84, 0x85, 0x86, 0x87, 0x88, 0x89, 0x8a, 0x92, 0x93, 0x94, 0x95, 0x96, 0x97,
+            0x98, 0x99, 0x9a, 0xa2, 0xa3, 0xa4, 0xa5, 0xa6, 0xa7, 0xa8, 0xa9, 0xaa, 0xb2, 0xb3, 0xb4, 0xb5, 0xb6, 0xb7, 0xb8, 0xb9, 0xba,
+            0xc2, 0xc3, 0xc4, 0xc5, 0xc6, 0xc7, 0xc8, 0xc9, 0xca, 0xd2, 0xd3, 0xd4, 0xd5, 0xd6, 0xd7, 0xd8, 0xd9, 0xda, 0xe2, 0xe3, 0xe4,
+            0xe5, 0xe6, 0xe7, 0xe8, 0xe9, 0xea, 0xf2, 0xf3, 0xf4, 0xf5, 0xf6, 0xf7, 0xf8, 0xf9, 0xfa
+        };
+
+        //! Scale factors of the AAN DCT, which are folded into the quantization divisors.
+        constexpr AZStd::array<float, 8> AanScaleFactors{ 1.0f,         1.387039845f, 1.306562965f, 1.175875602f,
+                                                          1.0f,         0.785694958f, 0.541196100f, 0.275899379f };
+
+        struct HuffmanCode
+        {
+            AZ::u16 m_code = 0;
+            AZ::u8 m_length = 0;
+        };
+
+        using HuffmanTable = AZStd::array<HuffmanCode, 256>;
+
+        //! Assigns canonical codes to the symbols of a table, as in Annex C of the JPEG specification.
+        template<size_t SymbolCount>
+        HuffmanTable BuildHuffmanTable(const AZStd::array<uint8_t, 16>& bits, const AZStd::array<uint8_t, SymbolCount>& symbols)
+        {
+            HuffmanTable table;
+            AZ::u16 code = 0;
+            size_t symbol = 0;
+            for (AZ::u8 length = 1; length <= 16; ++length)
+            {
+                for (uint8_t i = 0; i < bits[length - 1]; ++i)
+                {
+                    table[symbols[symbol++]] = { code++, length };
+                }
+                code <<= 1;
+            }
+            return table;
+        }
+
+        const HuffmanTable LuminanceDcTable = BuildHuffmanTable(LuminanceDcBits, LuminanceDcSymbols);
+        const HuffmanTable ChrominanceDcTable = BuildHuffmanTable(ChrominanceDcBits, ChrominanceDcSymbols);
+        const HuffmanTable LuminanceAcTable = BuildHuffmanTable(LuminanceAcBits, LuminanceAcSymbols);
+        const HuffmanTable ChrominanceAcTable = BuildHuffmanTable(ChrominanceAcBits, ChrominanceAcSymbols);
+
+        //! Returns a quantization table scaled to a quality, the way the IJG library scales it.
+        AZStd::array<uint8_t, 64> ScaleQuantization(const AZStd::array<uint8_t, 64>& table, int quality)
+        {
+            quality = AZStd::clamp(quality, 1, 100);
+            const int scale = quality < 50 ? 5000 / quality : 200 - quality * 2;
+            AZStd::array<uint8_t, 64> scaled;
+            for (size_t i = 0; i < table.size(); ++i)
+            {
+                scaled[i] = static_cast<uint8_t>(AZStd::clamp((table[i] * scale + 50) / 100, 1, 255));
+            }
+            return scaled;
+        }
+
+        //! Returns reciprocals of the quantization divisors of the AAN DCT outputs, in natural order.
+        AZStd::array<float, 64> GetQuantizationMultipliers(const AZStd::array<uint8_t, 64>& table)
+        {
+            AZStd::array<float, 64> multipliers;
+            for (size_t row = 0; row < 8; ++row)
+            {
+                for (size_t column = 0; column < 8; ++column)
+                {
+                    const size_t i = row * 8 + column;
+                    multipliers[i] = 1.0f / (table[i] * AanScaleFactors[row] * AanScaleFactors[column] * 8.0f);
+                }
+            }
+            return multipliers;
+        }
+
+        //! Forward DCT of 8 samples, from the floating point AAN algorithm of the IJG library.
+        void Dct8(float* data, size_t stride)
+        {
+            float& d0 = data[0];
+            float& d1 = data[stride];
+            float& d2 = data[2 * stride];
+            float& d3 = data[3 * stride];
+            float& d4 = data[4 * stride];
+            float& d5 = data[5 * stride];
+            float& d6 = data[6 * stride];
+            float& d7 = data[7 * stride];
+
+            const float tmp0 = d0 + d7;
+            const float tmp7 = d0 - d7;
+            const float tmp1 = d1 + d6;
+            const float tmp6 = d1 - d6;
+            const float tmp2 = d2 + d5;
+            const float tmp5 = d2 - d5;
+            const float tmp3 = d3 + d4;
+            const float tmp4 = d3 - d4;
+
+            // Even part.
+            float tmp10 = tmp0 + tmp3;
+            const float tmp13 = tmp0 - tmp3;
+            float tmp11 = tmp1 + tmp2;
+            float tmp12 = tmp1 - tmp2;
+            d0 = tmp10 + tmp11;
+            d4 = tmp10 - tmp11;
+            const float z1 = (tmp12 + tmp13) * 0.707106781f;
+            d2 = tmp13 + z1;
+            d6 = tmp13 - z1;
+
+            // Odd part.
+            tmp10 = tmp4 + tmp5;
+            tmp11 = tmp5 + tmp6;
+            tmp12 = tmp6 + tmp7;
+            const float z5 = (tmp10 - tmp12) * 0.382683433f;
+            const float z2 = 0.541196100f * tmp10 + z5;
+            const float z4 = 1.306562965f * tmp12 + z5;
+            const float z3 = tmp11 * 0.707106781f;
+            const float z11 = tmp7 + z3;
+            const float z13 = tmp7 - z3;
+            d5 = z13 + z2;
+            d3 = z13 - z2;
+            d1 = z11 + z4;
+            d7 = z11 - z4;
+        }
+
+        //! Writes entropy-coded data, stuffing a zero byte after each 0xFF byte.
+        class BitWriter
+        {
+        public:
+            explicit BitWriter(std::vector<uint8_t>& output)
+                : m_output(output)
+            {
+            }
+
+            void Write(AZ::u32 bits, AZ::u32 length)
+            {
+                m_buffer = (m_buffer << length) | (bits & ((1u << length) - 1));
+                m_length += length;
+                while (m_length >= 8)
+                {
+                    m_length -= 8;
+                    const auto byte = static_cast<uint8_t>(m_buffer >> m_length);
+                    m_output.push_back(byte);
+                    if (byte == 0xFF)
+                    {
+                        m_output.push_back(0);
+                    }
+                }
+            }
+
+            void Write(const HuffmanCode& code)
+            {
+                Write(code.m_code, code.m_length);
+            }
+
+            //! Pads the last byte with one bits.
+            void Flush()
+            {
+                if (m_length > 0)
+                {
+                    Write(0x7F, 8 - m_length);
+                }
+            }
+
+        private:
+            std::vector<uint8_t>& m_output;
+            AZ::u32 m_buffer = 0;
+            AZ::u32 m_length = 0;
+        };
+
+        //! Number of bits of the magnitude of a coefficient, which is its JPEG category.
+        AZ::u32 GetBitLength(int value)
+        {
+            AZ::u32 magnitude = static_cast<AZ::u32>(value < 0 ? -value : value);
+            AZ::u32 length = 0;
+            while (magnitude)
+            {
+                ++length;
+                magnitude >>= 1;
+            }
+            return length;
+        }
+
+        //! Transforms, quantizes and writes a block of level-shifted samples, in natural order.
+        //! @param previousDc Quantized DC coefficient of the previous block of the component, updated to this block.
+        void EncodeBlock(
+            BitWriter& writer,
+            AZStd::array<float, 64>& block,
+            const AZStd::array<float, 64>& multipliers,
+            const HuffmanTable& dcTable,
+            const HuffmanTable& acTable,
+            int& previousDc)
+        {
+            for (size_t row = 0; row < 8; ++row)
+            {
+                Dct8(block.data() + row * 8, 1);
+            }
+            for (size_t column = 0; column < 8; ++column)
+            {
+                Dct8(block.data() + column, 8);
+            }
+
+            AZStd::array<int, 64> coefficients;
+            for (size_t i = 0; i < 64; ++i)
+            {
+                const size_t natural = ZigZag[i];
+                coefficients[i] = static_cast<int>(std::lround(block[natural] * multipliers[natural]));
+            }
+
+            const int dcDifference = coefficients[0] - previousDc;
+            previousDc = coefficients[0];
+            AZ::u32 length = GetBitLength(dcDifference);
+            writer.Write(dcTable[length]);
+            if (length > 0)
+            {
+                // Negative values are written as their one's complement.
+                writer.Write(static_cast<AZ::u32>(dcDifference < 0 ? dcDifference - 1 : dcDifference), length);
+            }
+
+            AZ::u32 zeroRun = 0;
+            for (size_t i = 1; i < 64; ++i)
+            {
+                const int coefficient = coefficients[i];
+                if (coefficient == 0)
+                {
+                    ++zeroRun;
+                    continue;
+                }
+                while (zeroRun >= 16)
+                {
+                    writer.Write(acTable[0xF0]);
+                    zeroRun -= 16;
+                }
+                length = GetBitLength(coefficient);
+                writer.Write(acTable[(zeroRun << 4) | length]);
+                writer.Write(static_cast<AZ::u32>(coefficient < 0 ? coefficient - 1 : coefficient), length);
+                zeroRun = 0;
+            }
+            if (zeroRun > 0)
+            {
+                writer.Write(acTable[0x00]);
+            }
+        }
+
+        void AppendQuantizationTable(std::vector<uint8_t>& output, uint8_t tableId, const AZStd::array<uint8_t, 64>& table)
+        {
+            output.push_back(tableId);
+            for (const uint8_t natural : ZigZag)
+            {
+                output.push_back(table[natural]);
+            }
+        }
+
+        template<size_t SymbolCount>
+        void AppendHuffmanTable(
+            std::vector<uint8_t>& output,
+            uint8_t tableClassAndId,
+            const AZStd::array<uint8_t, 16>& bits,
+            const AZStd::array<uint8_t, SymbolCount>& symbols)
+        {
+            output.push_back(tableClassAndId);
+            output.insert(output.end(), bits.begin(), bits.end());
+            output.insert(output.end(), symbols.begin(), symbols.end());
+        }
+
+        void AppendJpegHeaders(
+            std::vector<uint8_t>& output,
+            const ImageView& image,
+            bool isColor,
+            const AZStd::array<uint8_t, 64>& luminanceQuantization,
+            const AZStd::array<uint8_t, 64>& chrominanceQuantization)
+        {
+            const AZ::u32 componentCount = isColor ? 3 : 1;
+
+            // Start of image and JFIF header, version 1.1 without density or thumbnail.
+            output.insert(output.end(), { 0xFF, 0xD8, 0xFF, 0xE0, 0, 16, 'J', 'F', 'I', 'F', 0, 1, 1, 0, 0, 1, 0, 1, 0, 0 });
+
+            output.insert(output.end(), { 0xFF, 0xDB });
+            AppendU16BigEndian(output, 2 + 65 * (isColor ? 2 : 1));
+            AppendQuantizationTable(output, 0, luminanceQuantization);
+            if (isColor)
+            {
+                AppendQuantizationTable(output, 1, chrominanceQuantization);
+            }
+
+            // Baseline frame, with luminance sampled 2x2 relative to chrominance.
+            output.insert(output.end(), { 0xFF, 0xC0 });
+            AppendU16BigEndian(output, 8 + 3 * componentCount);
+            output.push_back(8);
+            AppendU16BigEndian(output, image.m_height);
+            AppendU16BigEndian(output, image.m_width);
+            output.push_back(static_cast<uint8_t>(componentCount));
+            output.insert(output.end(), { 1, static_cast<uint8_t>(isColor ? 0x22 : 0x11), 0 });
+            if (isColor)
+            {
+                output.insert(output.end(), { 2, 0x11, 1, 3, 0x11, 1 });
+            }
+
+            output.insert(output.end(), { 0xFF, 0xC4 });
+            AppendU16BigEndian(output, 2 + (isColor ? 2 : 1) * (2 * 17 + 12 + 162));
+            AppendHuffmanTable(output, 0x00, LuminanceDcBits, LuminanceDcSymbols);
+            AppendHuffmanTable(output, 0x10, LuminanceAcBits, LuminanceAcSymbols);
+            if (isColor)
+            {
+                AppendHuffmanTable(output, 0x01, ChrominanceDcBits, ChrominanceDcSymbols);
+                AppendHuffmanTable(output, 0x11, ChrominanceAcBits, ChrominanceAcSymbols);
+            }
+
+            output.insert(output.end(), { 0xFF, 0xDA });
+            AppendU16BigEndian(output, 6 + 2 * componentCount);
+            output.push_back(static_cast<uint8_t>(componentCount));
+            output.insert(output.end(), { 1, 0x00 });
+            if (isColor)
+            {
+                output.insert(output.end(), { 2, 0x11, 3, 0x11 });
+            }
+            output.insert(output.end(), { 0, 63, 0 });
+        }
+
+        //////////////////////////////////////////////////////////////////////////
+        // PNG
+
+        AZStd::array<AZ::u32, 256> MakeCrcTable()
+        {
+            AZStd::array<AZ::u32, 256> table;
+            for (AZ::u32 i = 0; i < 256; ++i)
+            {
+                AZ::u32 crc = i;
+                for (int bit = 0; bit < 8; ++bit)
+                {
+                    crc = (crc & 1) ? 0xEDB88320u ^ (crc >> 1) : crc >> 1;
+                }
+                table[i] = crc;
+            }
+            return table;
+        }
+
+        const AZStd::array<AZ::u32, 256> CrcTable = MakeCrcTable();
+
+        //! Appends a PNG chunk, with the data already appended after the reserved length and type.
+        //! @param chunkStart Offset of the chunk in the output.
+        void FinishPngChunk(std::vector<uint8_t>& output, size_t chunkStart)
+        {
+            const size_t dataSize = output.size() - chunkStart - 8;
+            const AZ::u32 length = static_cast<AZ::u32>(dataSize);
+            output[chunkStart] = static_cast<uint8_t>(length >> 24);
+            output[chunkStart + 1] = static_cast<uint8_t>(length >> 16);
+            output[chunkStart + 2] = static_cast<uint8_t>(length >> 8);
+            output[chunkStart + 3] = static_cast<uint8_t>(length);
+
+            // The checksum covers the chunk type and data.
+            AZ::u32 crc = 0xFFFFFFFFu;
+            for (size_t i = chunkStart + 4; i < output.size(); ++i)
+            {
+                crc = CrcTable[(crc ^ output[i]) & 0xFF] ^ (crc >> 8);
+            }
+            AppendU32BigEndian(output, crc ^ 0xFFFFFFFFu);
+        }
+
+        size_t StartPngChunk(std::vector<uint8_t>& output, const char* type)
+        {
+            const size_t chunkStart = output.size();
+            output.insert(output.end(), { 0, 0, 0, 0 });
+            output.insert(output.end(), type, type + 4);
+            return chunkStart;
+        }
+
+        //////////////////////////////////////////////////////////////////////////
+        // QOI
+
+        constexpr uint8_t QoiOpIndex = 0x00;
+        constexpr uint8_t QoiOpDiff = 0x40;
+        constexpr uint8_t QoiOpLuma = 0x80;
+        constexpr uint8_t QoiOpRun = 0xC0;
+        constexpr uint8_t QoiOpRgb = 0xFE;
+        constexpr uint8_t QoiOpRgba = 0xFF;
+        constexpr int QoiMaxRun = 62;
+
+        struct QoiPixel
+        {
+            uint8_t r = 0;
+            uint8_t g = 0;
+            uint8_t b = 0;
+            uint8_t a = 255;
+
+            bool operator==(const QoiPixel& other) const
+            {
+                return r == other.r && g == other.g && b == other.b && a == other.a;
+            }
+        };
+
+        size_t GetQoiHash(const QoiPixel& pixel)
+        {
+            return (pixel.r * 3 + pixel.g * 5 + pixel.b * 7 + pixel.a * 11) % 64;
+        }
+    } // namespace Internal
+
+    bool ImageEncoder::EncodeJpeg(const ImageView& image, int quality, std::vector<uint8_t>& output)
+    {
+        const bool isColor = image.m_channelCount == 3 || image.m_channelCount == 4;
+        if (image.m_channelSize != 1 || (!isColor && image.m_channelCount != 1) || image.m_width == 0 || image.m_height == 0 ||
+            image.m_width > 0xFFFF || image.m_height > 0xFFFF)
+        {
+            return false;
+        }
+
+        const auto luminanceQuantization = Internal::ScaleQuantization(Internal::LuminanceQuantization, quality);
+        const auto chrominanceQuantization = Internal::ScaleQuantization(Internal::ChrominanceQuantization, quality);
+        const auto luminanceMultipliers = Internal::GetQuantizationMultipliers(luminanceQuantization);
+        const auto chrominanceMultipliers = Internal::GetQuantizationMultipliers(chrominanceQuantization);
+
+        output.clear();
+        Internal::AppendJpegHeaders(output, image, isColor, luminanceQuantization, chrominanceQuantization);
+
+        Internal::BitWriter writer(output);
+        int previousDc[3] = { 0, 0, 0 };
+        const AZ::u32 mcuSize = isColor ? 16 : 8;
+        const AZ::u32 channelCount = image.m_channelCount;
+        AZStd::array<float, 64> block;
+        // Chrominance of a 16x16 MCU, averaged over 2x2 pixels while the luminance blocks are gathered.
+        AZStd::array<float, 64> blueDifference;
+        AZStd::array<float, 64> redDifference;
+
+        for (AZ::u32 mcuY = 0; mcuY < image.m_height; mcuY += mcuSize)
+        {
+            for (AZ::u32 mcuX = 0; mcuX < image.m_width; mcuX += mcuSize)
+            {
+                if (!isColor)
+                {
+                    for (AZ::u32 y = 0; y < 8; ++y)
+                    {
+                        // Pixels past the edge repeat the last row and column.
+                        const uint8_t* row = image.m_data + size_t{ AZStd::min(mcuY + y, image.m_height - 1) } * image.m_step;
+                        for (AZ::u32 x = 0; x < 8; ++x)
+                        {
+                            block[y * 8 + x] = row[AZStd::min(mcuX + x, image.m_width - 1)] - 128.0f;
+                        }
+                    }
+                    Internal::EncodeBlock(
+                        writer, block, luminanceMultipliers, Internal::LuminanceDcTable, Internal::LuminanceAcTable, previousDc[0]);
+                    continue;
+                }
+
+                blueDifference.fill(0.0f);
+                redDifference.fill(0.0f);
+                for (AZ::u32 blockIndex = 0; blockIndex < 4; ++blockIndex)
+                {
+                    const AZ::u32 blockX = mcuX + (blockIndex & 1) * 8;
+                    const AZ::u32 blockY = mcuY + (blockIndex >> 1) * 8;
+                    for (AZ::u32 y = 0; y < 8; ++y)
+                    {
+                        const uint8_t* row = image.m_data + size_t{ AZStd::min(blockY + y, image.m_height - 1) } * image.m_step;
+                        const size_t chromaRow = ((blockIndex >> 1) * 8 + y) / 2;
+                        for (AZ::u32 x = 0; x < 8; ++x)
+                        {
+                            const uint8_t* pixel = row + size_t{ AZStd::min(blockX + x, image.m_width - 1) } * channelCount;
+                            const float r = pixel[0];
+                            const float g = pixel[1];
+                            const float b = pixel[2];
+                            block[y * 8 + x] = 0.299f * r + 0.587f * g + 0.114f * b - 128.0f;
+                            const size_t chroma = chromaRow * 8 + ((blockIndex & 1) * 8 + x) / 2;
+                            blueDifference[chroma] += 0.25f * (-0.168736f * r - 0.331264f * g + 0.5f * b);
+                            redDifference[chroma] += 0.25f * (0.5f * r - 0.418688f * g - 0.081312f * b);
+                        }
+                    }
+                    Internal::EncodeBlock(
+                        writer, block, luminanceMultipliers, Internal::LuminanceDcTable, Internal::LuminanceAcTable, previousDc[0]);
+                }
+                Internal::EncodeBlock(
+                    writer,
+                    blueDifference,
+                    chrominanceMultipliers,
+                    Internal::ChrominanceDcTable,
+                    Internal::ChrominanceAcTable,
+                    previousDc[1]);
+                Internal::EncodeBlock(
+                    writer,
+                    redDifference,
+                    chrominanceMultipliers,
+                    Internal::ChrominanceDcTable,
+                    Internal::ChrominanceAcTable,
+                    previousDc[2]);
+            }
+        }
+        writer.Flush();
+        output.insert(output.end(), { 0xFF, 0xD9 });
+        return true;
+    }
+
+    bool ImageEncoder::EncodePng(const ImageView& image, int compressionLevel, std::vector<uint8_t>& output)
+    {
+        if ((image.m_channelSize != 1 && image.m_channelSize != 2) || image.m_channelCount < 1 || image.m_channelCount > 4 ||
+            image.m_width == 0 || image.m_height == 0)
+        {
+            return false;
+        }
+
+        output.clear();
+        AppendPng(image, compressionLevel, output);
+        return true;
+    }
+
+    void ImageEncoder::AppendPng(const ImageView& image, int compressionLevel, std::vector<uint8_t>& output)
+    {
+        static constexpr uint8_t ColorTypes[] = { 0, 4, 2, 6 }; // Gray, gray with alpha, RGB, RGBA.
+
+        // Each row is filtered with the Sub filter, which stores differences to the previous pixel and is cheap to compute.
+        // PNG stores 16-bit samples big-endian, so their bytes are swapped on the way.
+        const size_t pixelSize = size_t{ image.m_channelCount } * image.m_channelSize;
+        const size_t rowSize = size_t{ image.m_width } * pixelSize;
+        m_filteredRows.resize((rowSize + 1) * image.m_height);
+        for (AZ::u32 y = 0; y < image.m_height; ++y)
+        {
+            const uint8_t* source = image.m_data + size_t{ y } * image.m_step;
+            uint8_t* filtered = m_filteredRows.data() + y * (rowSize + 1);
+            filtered[0] = 1;
+            ++filtered;
+            if (image.m_channelSize == 1)
+            {
+                AZStd::copy(source, source + pixelSize, filtered);
+                for (size_t i = pixelSize; i < rowSize; ++i)
+                {
+                    filtered[i] = static_cast<uint8_t>(source[i] - source[i - pixelSize]);
+                }
+            }
+            else
+            {
+                for (size_t i = 0; i < rowSize; ++i)
+                {
+                    const size_t swapped = i ^ 1;
+                    const uint8_t left = i >= pixelSize ? source[swapped - pixelSize] : 0;
+                    filtered[i] = static_cast<uint8_t>(source[swapped] - left);
+                }
+            }
+        }
+
+        output.insert(output.end(), { 0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n' });
+
+        size_t chunkStart = Internal::StartPngChunk(output, "IHDR");
+        Internal::AppendU32BigEndian(output, image.m_width);
+        Internal::AppendU32BigEndian(output, image.m_height);
+        output.push_back(static_cast<uint8_t>(8 * image.m_channelSize));
+        output.push_back(ColorTypes[image.m_channelCount - 1]);
+        output.insert(output.end(), { 0, 0, 0 }); // Deflate, adaptive filtering, no interlace.
+        Internal::FinishPngChunk(output, chunkStart);
+
+        chunkStart = Internal::StartPngChunk(output, "IDAT");
+        AZ::ZLib zlib;
+        zlib.StartCompressor(AZStd::clamp(compressionLevel, 1, 9));
+        const size_t dataStart = output.size();
+        const unsigned int filteredSize = static_cast<unsigned int>(m_filteredRows.size());
+        const unsigned int maxCompressedSize = zlib.GetMinCompressedBufferSize(filteredSize);
+        output.resize(dataStart + maxCompressedSize);
+        unsigned int remainingSize = filteredSize;
+        const unsigned int compressedSize =
+            zlib.Compress(m_filteredRows.data(), remainingSize, output.data() + dataStart, maxCompressedSize, AZ::ZLib::FT_FINISH);
+        zlib.StopCompressor();
+        AZ_Assert(remainingSize == 0, "PNG data does not fit into the compressed buffer.");
+        output.resize(dataStart + compressedSize);
+        Internal::FinishPngChunk(output, chunkStart);
+
+        chunkStart = Internal::StartPngChunk(output, "IEND");
+        Internal::FinishPngChunk(output, chunkStart);
+    }
+
+    bool ImageEncoder::EncodeQoi(const ImageView& image, std::vector<uint8_t>& output)
+    {
+        const AZ::u32 channelCount = image.m_channelCount;
+        if (image.m_channelSize != 1 || (channelCount != 3 && channelCount != 4) || image.m_width == 0 || image.m_height == 0)
+        {
+            return false;
+        }
+
+        output.clear();
+        output.reserve(14 + size_t{ image.m_width } * image.m_height * (channelCount + 1) + 8);
+        output.insert(output.end(), { 'q', 'o', 'i', 'f' });
+        Internal::AppendU32BigEndian(output, image.m_width);
+        Internal::AppendU32BigEndian(output, image.m_height);
+        output.push_back(static_cast<uint8_t>(channelCount));
+        output.push_back(0); // sRGB with linear alpha.
+
+        // Unlike the previous pixel, which starts opaque black, the index starts with zeroes in all channels.
+        AZStd::array<Internal::QoiPixel, 64> index;
+        index.fill(Internal::QoiPixel{ 0, 0, 0, 0 });
+        Internal::QoiPixel previous;
+        int run = 0;
+        for (AZ::u32 y = 0; y < image.m_height; ++y)
+        {
+            const uint8_t* row = image.m_data + size_t{ y } * image.m_step;
+            for (AZ::u32 x = 0; x < image.m_width; ++x)
+            {
+                const uint8_t* source = row + size_t{ x } * channelCount;
+                const Internal::QoiPixel pixel{ source[0], source[1], source[2], channelCount == 4 ? source[3] : uint8_t{ 255 } };
+                if (pixel == previous)
+                {
+                    if (++run == Internal::QoiMaxRun)
+                    {
+                        output.push_back(static_cast<uint8_t>(Internal::QoiOpRun | (run - 1)));
+                        run = 0;
+                    }
+                    continue;
+                }
+                if (run > 0)
+                {
+                    output.push_back(static_cast<uint8_t>(Internal::QoiOpRun | (run - 1)));
+                    run = 0;
+                }
+
+                const size_t hash = Internal::GetQoiHash(pixel);
+                if (index[hash] == pixel)
+                {
+                    output.push_back(static_cast<uint8_t>(Internal::QoiOpIndex | hash));
+                }
+                else
+                {
+                    index[hash] = pixel;
+                    if (pixel.a == previous.a)
+                    {
+                        const int dr = static_cast<int8_t>(pixel.r - previous.r);
+                        const int dg = static_cast<int8_t>(pixel.g - previous.g);
+                        const int db = static_cast<int8_t>(pixel.b - previous.b);
+                        const int drg = dr - dg;
+                        const int dbg = db - dg;
+                        if (dr >= -2 && dr <= 1 && dg >= -2 && dg <= 1 && db >= -2 && db <= 1)
+                        {
+                            output.push_back(static_cast<uint8_t>(Internal::QoiOpDiff | (dr + 2) << 4 | (dg + 2) << 2 | (db + 2)));
+                        }
+                        else if (drg >= -8 && drg <= 7 && dg >= -32 && dg <= 31 && dbg >= -8 && dbg <= 7)
+                        {
+                            output.push_back(static_cast<uint8_t>(Internal::QoiOpLuma | (dg + 32)));
+                            output.push_back(static_cast<uint8_t>((drg + 8) << 4 | (dbg + 8)));
+                        }
+                        else
+                        {
+                            output.insert(output.end(), { Internal::QoiOpRgb, pixel.r, pixel.g, pixel.b });
+                        }
+                    }
+                    else
+                    {
+                        output.insert(output.end(), { Internal::QoiOpRgba, pixel.r, pixel.g, pixel.b, pixel.a });
+                    }
+                }
+                previous = pixel;
+            }
+        }
+        if (run > 0)
+        {
+            output.push_back(static_cast<uint8_t>(Internal::QoiOpRun | (run - 1)));
+        }
+        output.insert(output.end(), { 0, 0, 0, 0, 0, 0, 0, 1 });
+        return true;
+    }
+
+    bool ImageEncoder::EncodeCompressedDepth(const ImageView& image, float maxDepth, int compressionLevel, std::vector<uint8_t>& output)
+    {
+        if (image.m_channelSize != 4 || image.m_channelCount != 1 || image.m_width == 0 || image.m_height == 0 || !(maxDepth > 0.0f))
+        {
+            return false;
+        }
+
+        // Quantization of the compressed depth image transport, which decodes depth as quantizationA / (value - quantizationB).
+        const float quantizationA = DepthQuantization * (DepthQuantization + 1.0f);
+        const float quantizationB = 1.0f - quantizationA / maxDepth;
+        m_inverseDepth.resize(size_t{ image.m_width } * image.m_height * 2);
+        uint8_t* inverseDepth = m_inverseDepth.data();
+        for (AZ::u32 y = 0; y < image.m_height; ++y)
+        {
+            const uint8_t* row = image.m_data + size_t{ y } * image.m_step;
+            for (AZ::u32 x = 0; x < image.m_width; ++x)
+            {
+                float depth;
+                memcpy(&depth, row + size_t{ x } * sizeof(float), sizeof(float));
+                // Depth closer than quantizationA / 65535 saturates, instead of wrapping around to far depth.
+                const AZ::u32 value = depth > 0.0f && depth < maxDepth
+                    ? static_cast<AZ::u32>(AZStd::min(quantizationA / depth + quantizationB, 65535.0f))
+                    : 0;
+                *inverseDepth++ = static_cast<uint8_t>(value);
+                *inverseDepth++ = static_cast<uint8_t>(value >> 8);
+            }
+        }
+
+        // The header is written in the byte order of the host, which is how the transport reads it.
+        static constexpr AZ::s32 InverseDepthFormat = 0;
+        const float quantization[] = { quantizationA, quantizationB };
+        output.resize(sizeof(InverseDepthFormat) + sizeof(quantization));
+        memcpy(output.data(), &InverseDepthFormat, sizeof(InverseDepthFormat));
+        memcpy(output.data() + sizeof(InverseDepthFormat), quantization, sizeof(quantization));
+
+        const ImageView inverseDepthView{ m_inverseDepth.data(), image.m_width, image.m_height, image.m_width * 2, 1, 2 };
+        AppendPng(inverseDepthView, compressionLevel, output);
+        return true;
+    }
+} // namespace ROS2
@@ -0,0 +1,77 @@
+/*
+ * Copyright (c) Contributors to the Open 3D Engine Project.
+ * For complete copyright and license terms please see the LICENSE at the root of this distribution.
+ *
+ * SPDX-License-Identifier: Apache-2.0 OR MIT
+ *
+ */
+#pragma once
+
+#include <AzCore/base.h>
+#include <AzCore/std/containers/vector.h>
+#include <vector>
+
+namespace ROS2
+{
+    //! Pixels of an image to encode, which the image does not own.
+    struct ImageView
+    {
+        const uint8_t* m_data = nullptr;
+        AZ::u32 m_width = 0;
+        AZ::u32 m_height = 0;
+        //! Size of a row in bytes, which may include padding.
+        AZ::u32 m_step = 0;
+        AZ::u32 m_channelCount = 0;
+        //! Size of a channel in bytes, 1 or 2, or 4 for 32-bit float depth. Multi-byte channels are little-endian.
+        AZ::u32 m_channelSize = 1;
+    };
+
+    //! Encodes images to JPEG, PNG and QOI, the formats of compressed image topics.
+    //! Encoders are self-contained, so that encoding does not depend on libraries which may be missing on the simulation host.
+    //! An encoder keeps its working buffers between images, so it does not allocate for images of the same size. It must only be
+    //! used by one thread at a time.
+    class ImageEncoder
+    {
+    public:
+        //! Encodes a baseline JPEG, with chroma subsampled 2x2 for color images.
+        //! Supports 8-bit images with 1 (gray), 3 (RGB) or 4 channels (RGBA, with alpha dropped).
+        //! @param quality Quality from 1 to 100, scaling the example quantization tables of the JPEG specification.
+        //! @param output Encoded image, replacing previous content.
+        //! @return Whether the image is supported.
+        bool EncodeJpeg(const ImageView& image, int quality, std::vector<uint8_t>& output);
+
+        //! Encodes a lossless PNG. Supports 8-bit and 16-bit images with 1 to 4 channels.
+        //! @param compressionLevel zlib compression level, from 1 (fastest) to 9 (smallest).
+        //! @param output Encoded image, replacing previous content.
+        //! @return Whether the image is supported.
+        bool EncodePng(const ImageView& image, int compressionLevel, std::vector<uint8_t>& output);
+
+        //! Encodes a lossless QOI image, see https://qoiformat.org. Supports 8-bit images with 3 or 4 channels.
+        //! @param output Encoded image, replacing previous content.
+        //! @return Whether the image is supported.
+        bool EncodeQoi(const ImageView& image, std::vector<uint8_t>& output);
+
+        //! Encodes a depth image in the format of the compressed depth image transport: a header with the quantization
+        //! parameters, followed by a 16-bit PNG of quantized inverse depth. Near depth keeps more precision than far depth.
+        //! Supports single channel 32-bit float images. Depth which is not positive, or not closer than the maximum depth,
+        //! is encoded as invalid and decoded as zero. The encoding is lossy; depth is kept exactly by encoding the bytes of its
+        //! floats as an 8-bit, 4 channel image with EncodePng or EncodeQoi instead.
+        //! @param maxDepth Largest depth which is encoded, in meters.
+        //! @param compressionLevel zlib compression level, from 1 (fastest) to 9 (smallest).
+        //! @param output Encoded image, replacing previous content.
+        //! @return Whether the image is supported.
+        bool EncodeCompressedDepth(const ImageView& image, float maxDepth, int compressionLevel, std::vector<uint8_t>& output);
+
+        //! Depth quantization of the compressed depth image transport, which sets the precision of near depth.
+        static constexpr float DepthQuantization = 100.0f;
+
+    private:
+        //! Appends a PNG of an image to the output, without checking whether the image is supported.
+        void AppendPng(const ImageView& image, int compressionLevel, std::vector<uint8_t>& output);
+
+        //! Rows of a PNG image, each prefixed with its filter type.
+        AZStd::vector<uint8_t> m_filteredRows;
+        //! Quantized inverse depth of a compressed depth image, as 16-bit little-endian pixels.
+        AZStd::vector<uint8_t> m_inverseDepth;
+    };
+} // namespace ROS2
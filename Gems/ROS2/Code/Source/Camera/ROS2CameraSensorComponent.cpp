@@ -46,6 +46,12 @@ namespace ROS2
             SetImageSource<CameraDepthSensor>();
         }
 
+        if (CameraSensorEffects::HasEffects(m_cameraConfiguration))
+        {
+            m_sensorEffects = AZStd::make_unique<CameraSensorEffects>(m_cameraConfiguration, GetCameraMatrix());
+            m_sensorEffects->Connect(GetEntityId());
+        }
+
         const auto* component = Utils::GetGameOrEditorComponent<ROS2FrameComponent>(GetEntity());
         AZ_Assert(component, "Entity has no ROS2FrameComponent");
         m_frameName = component->GetFrameID();
@@ -61,12 +67,18 @@ namespace ROS2
                 }
                 FrequencyTick();
             });
+        if (m_cameraSensor)
+        {
+            m_cameraSensor->SetSensorProfile(GetSensorProfile());
+        }
     }
 
     void ROS2CameraSensorComponent::Deactivate()
     {
         StopSensor();
         m_cameraSensor.reset();
+        // Disconnecting waits for frames which are being post-processed.
+        m_sensorEffects.reset();
         ROS2::CameraCalibrationRequestBus::Handler::BusDisconnect(GetEntityId());
     }
 
@@ -16,6 +16,7 @@
 
 #include "CameraSensor.h"
 #include "CameraSensorConfiguration.h"
+#include "CameraSensorEffects.h"
 #include <ROS2/Camera/CameraCalibrationRequestBus.h>
 #include <ROS2/ROS2Bus.h>
 #include <ROS2/Sensor/Events/TickBasedSource.h>
@@ -75,5 +76,7 @@ namespace ROS2
         CameraSensorConfiguration m_cameraConfiguration;
         AZStd::string m_frameName;
         AZStd::shared_ptr<CameraSensor> m_cameraSensor;
+        //! Lens distortion and noise of images, present only if the configuration has any.
+        AZStd::unique_ptr<CameraSensorEffects> m_sensorEffects;
     };
 } // namespace ROS2
@@ -0,0 +1,175 @@
+/*
+ * Copyright (c) Contributors to the Open 3D Engine Project.
+ * For complete copyright and license terms please see the LICENSE at the root of this distribution.
+ *
+ * SPDX-License-Identifier: Apache-2.0 OR MIT
+ *
+ */
+
+#include <AzCore/Component/TickBus.h>
+#include <AzCore/std/smart_ptr/make_shared.h>
+#include <AzCore/std/smart_ptr/weak_ptr.h>
+#include <AzCore/std/string/string.h>
+#include <AzFramework/Physics/PhysicsScene.h>
+#include <AzFramework/Physics/PhysicsSystem.h>
+#include <Clock/LockstepSimulation.h>
+#include <ROS2/ROS2Bus.h>
+
+namespace ROS2
+{
+    namespace
+    {
+        constexpr const char* StepCountParameter = "lockstep_steps";
+    }
+
+    LockstepSimulation::~LockstepSimulation()
+    {
+        Deactivate();
+    }
+
+    void LockstepSimulation::Activate(const std::shared_ptr<rclcpp::Node>& node)
+    {
+        m_node = node;
+        m_activeToken = AZStd::make_shared<bool>(true);
+        m_simulatedStepCount = 0;
+
+        if (!m_node->has_parameter(StepCountParameter))
+        {
+            m_node->declare_parameter<int64_t>(StepCountParameter, 1);
+        }
+
+        m_stepService = m_node->create_service<std_srvs::srv::Trigger>(
+            "step_simulation",
+            [this](
+                std::shared_ptr<StepService> service,
+                std::shared_ptr<rmw_request_id_t> requestHeader,
+                [[maybe_unused]] std::shared_ptr<std_srvs::srv::Trigger::Request> request)
+            {
+                const int64_t stepCount = m_node->get_parameter(StepCountParameter).as_int();
+                OnStepRequest(service, requestHeader, static_cast<AZ::u64>(AZStd::max<int64_t>(stepCount, 0)));
+            });
+
+        auto* systemInterface = AZ::Interface<AzPhysics::SystemInterface>::Get();
+        if (!systemInterface)
+        {
+            AZ_Warning("LockstepSimulation", false, "Failed to get AzPhysics::SystemInterface, lockstep is not available");
+            return;
+        }
+
+        // The default scene is created when the simulation starts, which may happen after activation.
+        m_onSceneAdded = AzPhysics::SystemEvents::OnSceneAddedEvent::Handler(
+            [this](AzPhysics::SceneHandle sceneHandle)
+            {
+                TakeOverScene(sceneHandle);
+            });
+        systemInterface->RegisterSceneAddedEvent(m_onSceneAdded);
+
+        m_onSceneRemoved = AzPhysics::SystemEvents::OnSceneRemovedEvent::Handler(
+            [this](AzPhysics::SceneHandle sceneHandle)
+            {
+                if (sceneHandle == m_sceneHandle)
+                {
+                    m_sceneHandle = AzPhysics::InvalidSceneHandle;
+                }
+            });
+        systemInterface->RegisterSceneRemovedEvent(m_onSceneRemoved);
+
+        if (auto* sceneInterface = AZ::Interface<AzPhysics::SceneInterface>::Get())
+        {
+            TakeOverScene(sceneInterface->GetSceneHandle(AzPhysics::DefaultPhysicsSceneName));
+        }
+    }
+
+    void LockstepSimulation::Deactivate()
+    {
+        m_onSceneAdded.Disconnect();
+        m_onSceneRemoved.Disconnect();
+        m_activeToken.reset();
+        m_stepService.reset();
+        m_node.reset();
+
+        if (m_sceneHandle != AzPhysics::InvalidSceneHandle)
+        {
+            if (auto* sceneInterface = AZ::Interface<AzPhysics::SceneInterface>::Get())
+            {
+                sceneInterface->SetEnabled(m_sceneHandle, true);
+            }
+            m_sceneHandle = AzPhysics::InvalidSceneHandle;
+        }
+    }
+
+    void LockstepSimulation::TakeOverScene(AzPhysics::SceneHandle sceneHandle)
+    {
+        auto* sceneInterface = AZ::Interface<AzPhysics::SceneInterface>::Get();
+        if (sceneHandle == AzPhysics::InvalidSceneHandle ||
+            sceneHandle != sceneInterface->GetSceneHandle(AzPhysics::DefaultPhysicsSceneName))
+        {
+            return;
+        }
+
+        // A disabled scene is skipped by the physics system, so it only advances when stepped here.
+        AZ_Printf("LockstepSimulation", "Default physics scene is stepped by the step_simulation service");
+        m_sceneHandle = sceneHandle;
+        sceneInterface->SetEnabled(m_sceneHandle, false);
+    }
+
+    void LockstepSimulation::OnStepRequest(
+        const std::shared_ptr<StepService>& service, const std::shared_ptr<rmw_request_id_t>& requestHeader, AZ::u64 stepCount)
+    {
+        // Steps are simulated on the game thread, whichever thread handles ROS 2 callbacks, and the response is deferred
+        // until they are done.
+        AZStd::weak_ptr<bool> activeToken = m_activeToken;
+        AZ::TickBus::QueueFunction(
+            [this, activeToken, service, requestHeader, stepCount]()
+            {
+                if (activeToken.expired())
+                {
+                    return;
+                }
+
+                std_srvs::srv::Trigger::Response response;
+                const AZ::u64 simulatedStepCount = Step(stepCount);
+                response.success = simulatedStepCount == stepCount;
+                const builtin_interfaces::msg::Time time = ROS2Interface::Get()->GetROSTimestamp();
+                // Nanoseconds are zero padded, so that the time reads as a decimal number of seconds.
+                const AZStd::string message = AZStd::string::format(
+                    "%llu steps simulated, simulation time %d.%09u",
+                    static_cast<unsigned long long>(simulatedStepCount),
+                    time.sec,
+                    time.nanosec);
+                response.message = message.c_str();
+                service->send_response(*requestHeader, response);
+            });
+    }
+
+    AZ::u64 LockstepSimulation::Step(AZ::u64 stepCount)
+    {
+        auto* sceneInterface = AZ::Interface<AzPhysics::SceneInterface>::Get();
+        auto* systemInterface = AZ::Interface<AzPhysics::SystemInterface>::Get();
+        if (m_sceneHandle == AzPhysics::InvalidSceneHandle || !sceneInterface || !systemInterface)
+        {
+            AZ_Warning("LockstepSimulation", false, "No default physics scene to step");
+            return 0;
+        }
+
+        const float timeStep = systemInterface->GetConfiguration()->m_fixedTimestep;
+
+        // The scene is enabled only for the duration of the steps, which the physics system cannot interleave with its own,
+        // since both run on the game thread.
+        sceneInterface->SetEnabled(m_sceneHandle, true);
+        for (AZ::u64 step = 0; step < stepCount; ++step)
+        {
+            sceneInterface->StartSimulation(m_sceneHandle, timeStep);
+            sceneInterface->FinishSimulation(m_sceneHandle);
+        }
+        sceneInterface->SetEnabled(m_sceneHandle, false);
+
+        m_simulatedStepCount += stepCount;
+        return stepCount;
+    }
+
+    AZ::u64 LockstepSimulation::GetSimulatedStepCount() const
+    {
+        return m_simulatedStepCount;
+    }
+} // namespace ROS2
@@ -0,0 +1,66 @@
+/*
+ * Copyright (c) Contributors to the Open 3D Engine Project.
+ * For complete copyright and license terms please see the LICENSE at the root of this distribution.
+ *
+ * SPDX-License-Identifier: Apache-2.0 OR MIT
+ *
+ */
+#pragma once
+
+#include <AzCore/std/smart_ptr/shared_ptr.h>
+#include <AzFramework/Physics/Common/PhysicsEvents.h>
+#include <AzFramework/Physics/Common/PhysicsTypes.h>
+#include <rclcpp/node.hpp>
+#include <rclcpp/service.hpp>
+#include <std_srvs/srv/trigger.hpp>
+
+namespace ROS2
+{
+    //! Lets an external controller step the simulation, instead of the physics system stepping it with the frame time.
+    //! While active, the default physics scene only advances when the `step_simulation` service is called. Each call
+    //! simulates the number of fixed time steps given by the `lockstep_steps` parameter of the central node, back to back
+    //! and as fast as possible, and responds once they are done. Rendering and per-frame publishing wait until then, while
+    //! sensors driven by physics events publish within the steps.
+    //! @note Timestamps are reproducible only with the physically stable clock, which counts the simulated steps.
+    class LockstepSimulation
+    {
+    public:
+        LockstepSimulation() = default;
+        ~LockstepSimulation();
+
+        LockstepSimulation(const LockstepSimulation&) = delete;
+        LockstepSimulation& operator=(const LockstepSimulation&) = delete;
+
+        //! Takes over stepping of the default physics scene and advertises the step service on the node.
+        void Activate(const std::shared_ptr<rclcpp::Node>& node);
+        //! Gives stepping back to the physics system.
+        void Deactivate();
+
+        //! Simulates the given number of fixed time steps of the default physics scene. Must be called from the game thread.
+        //! @return Number of simulated steps, which is 0 if there is no default physics scene yet.
+        AZ::u64 Step(AZ::u64 stepCount);
+
+        //! Number of steps simulated since activation.
+        AZ::u64 GetSimulatedStepCount() const;
+
+    private:
+        using StepService = rclcpp::Service<std_srvs::srv::Trigger>;
+
+        void OnStepRequest(
+            const std::shared_ptr<StepService>& service,
+            const std::shared_ptr<rmw_request_id_t>& requestHeader,
+            AZ::u64 stepCount);
+
+        void TakeOverScene(AzPhysics::SceneHandle sceneHandle);
+
+        std::shared_ptr<rclcpp::Node> m_node;
+        std::shared_ptr<StepService> m_stepService;
+        //! Expires on deactivation, so that step requests queued for the game thread are ignored afterwards.
+        AZStd::shared_ptr<bool> m_activeToken;
+
+        AzPhysics::SceneHandle m_sceneHandle = AzPhysics::InvalidSceneHandle;
+        AzPhysics::SystemEvents::OnSceneAddedEvent::Handler m_onSceneAdded;
+        AzPhysics::SystemEvents::OnSceneRemovedEvent::Handler m_onSceneRemoved;
+        AZ::u64 m_simulatedStepCount = 0;
+    };
+} // namespace ROS2
@@ -8,9 +8,6 @@
 
 #include <AzCore/Time/ITime.h>
 #include <AzCore/std/algorithm.h>
-#include <AzCore/std/containers/deque.h>
-#include <AzCore/std/containers/vector.h>
-#include <AzCore/std/sort.h>
 #include <ROS2/Clock/SimulationClock.h>
 #include <ROS2/ROS2Bus.h>
 #include <rclcpp/qos.hpp>
@@ -40,9 +37,69 @@ namespace ROS2
         }
     }
 
+    namespace
+    {
+        constexpr AZStd::chrono::seconds DiagnosticsPublishPeriod{ 1 };
+
+        double ToSeconds(const builtin_interfaces::msg::Time& time)
+        {
+            return time.sec + time.nanosec * 1e-9;
+        }
+
+        diagnostic_msgs::msg::KeyValue MakeKeyValue(const char* key, double value)
+        {
+            diagnostic_msgs::msg::KeyValue keyValue;
+            keyValue.key = key;
+            keyValue.value = std::to_string(value);
+            return keyValue;
+        }
+    } // namespace
+
+    void SimulationClock::FrameTimeWindow::Add(AZ::s64 frameTime, AZ::s64 wallTime, double simulationTime)
+    {
+        m_median.Add(static_cast<double>(frameTime));
+        m_95thPercentile.Add(static_cast<double>(frameTime));
+        m_99thPercentile.Add(static_cast<double>(frameTime));
+        m_wallTime += wallTime;
+        m_simulationTime += simulationTime;
+    }
+
+    void SimulationClock::FrameTimeWindow::Reset()
+    {
+        m_median.Reset();
+        m_95thPercentile.Reset();
+        m_99thPercentile.Reset();
+        m_wallTime = 0;
+        m_simulationTime = 0.0;
+    }
+
     AZStd::chrono::duration<float, AZStd::chrono::seconds::period> SimulationClock::GetExpectedSimulationLoopTime() const
     {
-        return AZStd::chrono::duration<AZ::s64, AZStd::chrono::microseconds::period>(m_currentMedian);
+        return AZStd::chrono::duration<float, AZStd::chrono::seconds::period>(GetFrameTimeStatistics().m_medianFrameTime);
+    }
+
+    SimulationClock::FrameTimeStatistics SimulationClock::GetFrameTimeStatistics() const
+    {
+        const FrameTimeWindow* window = &m_frameTimeWindows[m_currentWindow];
+        const FrameTimeWindow& previousWindow = m_frameTimeWindows[1 - m_currentWindow];
+        if (window->m_median.GetCount() < MinFramesNumberForStats && previousWindow.m_median.GetCount() > 0)
+        {
+            window = &previousWindow;
+        }
+
+        FrameTimeStatistics statistics;
+        statistics.m_medianFrameTime = static_cast<float>(window->m_median.GetEstimate() * 1e-6);
+        statistics.m_95thPercentileFrameTime = static_cast<float>(window->m_95thPercentile.GetEstimate() * 1e-6);
+        statistics.m_99thPercentileFrameTime = static_cast<float>(window->m_99thPercentile.GetEstimate() * 1e-6);
+        statistics.m_realTimeFactor =
+            window->m_wallTime > 0 ? static_cast<float>(window->m_simulationTime / (window->m_wallTime * 1e-6)) : 0.0f;
+        statistics.m_frameCount = window->m_median.GetCount();
+        return statistics;
+    }
+
+    void SimulationClock::SetClockPublishRate(double rate)
+    {
+        m_clockPublishPeriod = rate > 0.0 ? 1.0 / rate : 0.0;
     }
 
     void SimulationClock::Tick()
@@ -54,23 +111,67 @@ namespace ROS2
 
             rclcpp::ClockQoS qos;
             m_clockPublisher = ros2Node->create_publisher<rosgraph_msgs::msg::Clock>("/clock", qos);
+            m_diagnosticsPublisher = ros2Node->create_publisher<diagnostic_msgs::msg::DiagnosticArray>("/diagnostics", rclcpp::QoS(1));
+            m_lastWallTime = AZStd::chrono::steady_clock::now();
+            m_nextDiagnosticsPublishTime = m_lastWallTime + DiagnosticsPublishPeriod;
         }
 
-        rosgraph_msgs::msg::Clock msg;
-        msg.clock = GetROSTimestamp();
-        m_clockPublisher->publish(msg);
+        const builtin_interfaces::msg::Time timestamp = GetROSTimestamp();
+        const double simulationTime = ToSeconds(timestamp);
+        const bool isJumpBack = simulationTime < m_lastSimulationTime;
+        if (simulationTime >= m_nextClockPublishTime || isJumpBack)
+        {
+            rosgraph_msgs::msg::Clock msg;
+            msg.clock = timestamp;
+            m_clockPublisher->publish(msg);
+            // Keeps the rate steady when ticks do not line up with the period, without bursts after pauses. After a jump back
+            // in time, the period restarts from the new time, so that the clock is not silent until it catches up.
+            m_nextClockPublishTime = isJumpBack ? simulationTime + m_clockPublishPeriod
+                                                : AZStd::max(m_nextClockPublishTime + m_clockPublishPeriod, simulationTime);
+        }
 
         AZ::s64 deltaTime = elapsed - m_lastExecutionTime;
         m_lastExecutionTime = elapsed;
 
-        // statistics on execution time
-        m_frameTimes.push_back(deltaTime);
-        if (m_frameTimes.size() > FramesNumberForStats)
+        const auto wallTime = AZStd::chrono::steady_clock::now();
+        const AZ::s64 deltaWallTime = AZStd::chrono::duration_cast<AZStd::chrono::microseconds>(wallTime - m_lastWallTime).count();
+        m_lastWallTime = wallTime;
+        const double deltaSimulationTime = AZStd::max(simulationTime - m_lastSimulationTime, 0.0);
+        m_lastSimulationTime = simulationTime;
+
+        // statistics on execution time, estimated without keeping past frame times
+        FrameTimeWindow& window = m_frameTimeWindows[m_currentWindow];
+        window.Add(deltaTime, deltaWallTime, deltaSimulationTime);
+        if (window.m_median.GetCount() >= FramesNumberForStats)
         {
-            m_frameTimes.pop_front();
+            m_currentWindow = 1 - m_currentWindow;
+            m_frameTimeWindows[m_currentWindow].Reset();
         }
-        AZStd::vector<AZ::s64> frameTimeSorted{ m_frameTimes.begin(), m_frameTimes.end() };
-        AZStd::sort(frameTimeSorted.begin(), frameTimeSorted.end());
-        m_currentMedian = frameTimeSorted[frameTimeSorted.size() / 2];
+
+        if (wallTime >= m_nextDiagnosticsPublishTime)
+        {
+            m_nextDiagnosticsPublishTime = wallTime + DiagnosticsPublishPeriod;
+            PublishDiagnostics();
+        }
+    }
+
+    void SimulationClock::PublishDiagnostics()
+    {
+        const FrameTimeStatistics statistics = GetFrameTimeStatistics();
+
+        diagnostic_msgs::msg::DiagnosticStatus status;
+        status.level = diagnostic_msgs::msg::DiagnosticStatus::OK;
+        status.name = "o3de_ros2: Simulation clock";
+        status.hardware_id = "o3de";
+        status.message = "Frame time statistics";
+        status.values.push_back(MakeKeyValue("median_frame_time", statistics.m_medianFrameTime));
+        status.values.push_back(MakeKeyValue("p95_frame_time", statistics.m_95thPercentileFrameTime));
+        status.values.push_back(MakeKeyValue("p99_frame_time", statistics.m_99thPercentileFrameTime));
+        status.values.push_back(MakeKeyValue("real_time_factor", statistics.m_realTimeFactor));
+
+        diagnostic_msgs::msg::DiagnosticArray message;
+        message.header.stamp = GetROSTimestamp();
+        message.status.push_back(AZStd::move(status));
+        m_diagnosticsPublisher->publish(message);
     }
 } // namespace ROS2
@@ -0,0 +1,328 @@
+/*
+ * Copyright (c) Contributors to the Open 3D Engine Project.
+ * For complete copyright and license terms please see the LICENSE at the root of this distribution.
+ *
+ * SPDX-License-Identifier: Apache-2.0 OR MIT
+ *
+ */
+
+#include <AzCore/std/algorithm.h>
+#include <Communication/MarshallingExecutor.h>
+#include <rclcpp/any_executable.hpp>
+#include <rclcpp/serialized_message.hpp>
+
+namespace ROS2
+{
+    MarshallingExecutor::MarshallingExecutor(Mode mode)
+        : m_mode(mode)
+    {
+    }
+
+    MarshallingExecutor::~MarshallingExecutor()
+    {
+        Stop();
+    }
+
+    void MarshallingExecutor::Start()
+    {
+        AZ_Assert(!m_spinThread.joinable(), "MarshallingExecutor is already started.");
+
+        AZStd::thread_desc threadDesc;
+        threadDesc.m_name = "ROS2Executor";
+        m_spinThread = AZStd::thread(
+            threadDesc,
+            [this]()
+            {
+                spin();
+            });
+    }
+
+    void MarshallingExecutor::Stop()
+    {
+        if (!m_spinThread.joinable())
+        {
+            return;
+        }
+
+        cancel();
+        m_spinThread.join();
+
+        PendingCallback pendingCallback;
+        while (m_pendingCallbacks.Pop(pendingCallback))
+        {
+        }
+        m_deferredCallbacks.clear();
+    }
+
+    void MarshallingExecutor::add_node(rclcpp::node_interfaces::NodeBaseInterface::SharedPtr nodePtr, bool notify)
+    {
+        {
+            AZStd::lock_guard<AZStd::mutex> lock(m_executionMutex);
+            m_nodes.insert(nodePtr.get());
+        }
+        rclcpp::Executor::add_node(nodePtr, notify);
+    }
+
+    void MarshallingExecutor::remove_node(rclcpp::node_interfaces::NodeBaseInterface::SharedPtr nodePtr, bool notify)
+    {
+        rclcpp::Executor::remove_node(nodePtr, notify);
+
+        // The background thread does not pick entities of the node anymore, but may be taking, queueing or handling one it picked
+        // before. It holds the mutex meanwhile and checks whether the node is still added once it has the mutex.
+        AZStd::lock_guard<AZStd::mutex> lock(m_executionMutex);
+        m_nodes.erase(nodePtr.get());
+
+        // Callbacks of other nodes keep their order: they are moved out of the queue and handled first on the next drain.
+        PendingCallback pendingCallback;
+        while (m_pendingCallbacks.Pop(pendingCallback))
+        {
+            if (pendingCallback.m_node != nodePtr.get())
+            {
+                m_deferredCallbacks.push_back(AZStd::move(pendingCallback));
+            }
+        }
+        // Cleared in place, since the node may be removed by a deferred callback while they are handled.
+        for (PendingCallback& deferredCallback : m_deferredCallbacks)
+        {
+            if (deferredCallback.m_node == nodePtr.get())
+            {
+                deferredCallback.m_callback = {};
+            }
+        }
+    }
+
+    void MarshallingExecutor::spin()
+    {
+        [[maybe_unused]] const bool wasSpinning = spinning.exchange(true);
+        AZ_Assert(!wasSpinning, "MarshallingExecutor is spun from more than one thread.");
+
+        while (rclcpp::ok(context_) && spinning.load())
+        {
+            rclcpp::AnyExecutable anyExecutable;
+            if (!get_next_executable(anyExecutable))
+            {
+                continue;
+            }
+
+            AZStd::unique_lock<AZStd::mutex> lock(m_executionMutex);
+            PendingCallback pendingCallback;
+            pendingCallback.m_node = anyExecutable.node_base.get();
+            // The node may have been removed after the entity was picked, in which case its owner may be gone already.
+            if (IsNodeAdded(pendingCallback.m_node))
+            {
+                pendingCallback.m_callback = TakeExecutable(anyExecutable);
+                pendingCallback.m_receiptTime = Clock::now();
+            }
+
+            // The data is already taken, so the entity is no longer ready and other entities of its callback group may be
+            // taken before this callback is handled. Callbacks are still handled one at a time, in the order they were taken.
+            if (anyExecutable.callback_group)
+            {
+                anyExecutable.callback_group->can_be_taken_from().store(true);
+                anyExecutable.callback_group.reset();
+            }
+
+            if (!pendingCallback.m_callback)
+            {
+                continue;
+            }
+
+            if (m_mode == Mode::Background)
+            {
+                Execute(pendingCallback);
+                continue;
+            }
+
+            while (!m_pendingCallbacks.Push(AZStd::move(pendingCallback)) && spinning.load())
+            {
+                AZ_WarningOnce("MarshallingExecutor", false, "The game thread falls behind ROS 2 callbacks, delaying further events.");
+                // The game thread may be removing a node, which needs the mutex.
+                lock.unlock();
+                AZStd::this_thread::sleep_for(AZStd::chrono::microseconds(100));
+                lock.lock();
+                if (!IsNodeAdded(pendingCallback.m_node))
+                {
+                    break;
+                }
+            }
+        }
+
+        spinning.store(false);
+    }
+
+    AZStd::function<void()> MarshallingExecutor::TakeExecutable(rclcpp::AnyExecutable& anyExecutable)
+    {
+        // Timers are called and waitables have their data taken by the executor when they are picked.
+        // Callbacks hold their entities weakly: an entity destroyed by its owner before the callback is handled must not have the
+        // callback run, since it usually captures the owner.
+        if (anyExecutable.timer)
+        {
+            return [timer = std::weak_ptr<rclcpp::TimerBase>(anyExecutable.timer)]()
+            {
+                if (auto lockedTimer = timer.lock())
+                {
+                    lockedTimer->execute_callback();
+                }
+            };
+        }
+
+        if (anyExecutable.waitable)
+        {
+            return [waitable = std::weak_ptr<rclcpp::Waitable>(anyExecutable.waitable), data = anyExecutable.data]() mutable
+            {
+                if (auto lockedWaitable = waitable.lock())
+                {
+                    lockedWaitable->execute(data);
+                }
+            };
+        }
+
+        if (anyExecutable.subscription)
+        {
+            auto subscription = anyExecutable.subscription;
+            rclcpp::MessageInfo messageInfo;
+            messageInfo.get_rmw_message_info().from_intra_process = false;
+
+            if (subscription->is_serialized())
+            {
+                std::shared_ptr<rclcpp::SerializedMessage> message = subscription->create_serialized_message();
+                if (!subscription->take_serialized(*message, messageInfo))
+                {
+                    subscription->return_serialized_message(message);
+                    return {};
+                }
+                return [subscription = std::weak_ptr<rclcpp::SubscriptionBase>(subscription), message, messageInfo]() mutable
+                {
+                    if (auto lockedSubscription = subscription.lock())
+                    {
+                        lockedSubscription->handle_serialized_message(message, messageInfo);
+                        lockedSubscription->return_serialized_message(message);
+                    }
+                };
+            }
+
+            std::shared_ptr<void> message = subscription->create_message();
+            if (!subscription->take_type_erased(message.get(), messageInfo))
+            {
+                subscription->return_message(message);
+                return {};
+            }
+            return [subscription = std::weak_ptr<rclcpp::SubscriptionBase>(subscription), message, messageInfo]() mutable
+            {
+                if (auto lockedSubscription = subscription.lock())
+                {
+                    lockedSubscription->handle_message(message, messageInfo);
+                    lockedSubscription->return_message(message);
+                }
+            };
+        }
+
+        if (anyExecutable.service)
+        {
+            auto service = anyExecutable.service;
+            auto requestHeader = service->create_request_header();
+            std::shared_ptr<void> request = service->create_request();
+            if (!service->take_type_erased_request(request.get(), *requestHeader))
+            {
+                return {};
+            }
+            return [service = std::weak_ptr<rclcpp::ServiceBase>(service), requestHeader, request]()
+            {
+                if (auto lockedService = service.lock())
+                {
+                    lockedService->handle_request(requestHeader, request);
+                }
+            };
+        }
+
+        if (anyExecutable.client)
+        {
+            auto client = anyExecutable.client;
+            auto requestHeader = client->create_request_header();
+            std::shared_ptr<void> response = client->create_response();
+            if (!client->take_type_erased_response(response.get(), *requestHeader))
+            {
+                return {};
+            }
+            return [client = std::weak_ptr<rclcpp::ClientBase>(client), requestHeader, response]()
+            {
+                if (auto lockedClient = client.lock())
+                {
+                    lockedClient->handle_response(requestHeader, response);
+                }
+            };
+        }
+
+        return {};
+    }
+
+    bool MarshallingExecutor::IsNodeAdded(const rclcpp::node_interfaces::NodeBaseInterface* node) const
+    {
+        // Callback groups added without a node have no node to be removed.
+        return !node || m_nodes.contains(node);
+    }
+
+    void MarshallingExecutor::ExecutePendingCallbacks()
+    {
+        // Deferred callbacks were queued before the ones still in the queue. Each is moved out before it is handled, since a
+        // callback which removes a node adds to the deferred callbacks.
+        for (size_t index = 0; index < m_deferredCallbacks.size(); ++index)
+        {
+            PendingCallback deferredCallback = AZStd::move(m_deferredCallbacks[index]);
+            if (deferredCallback.m_callback)
+            {
+                Execute(deferredCallback);
+            }
+        }
+        m_deferredCallbacks.clear();
+
+        // Only callbacks queued before draining started are handled, so that a busy topic cannot stall the frame.
+        size_t pendingCount = m_pendingCallbacks.Size();
+        PendingCallback pendingCallback;
+        while (pendingCount-- > 0 && m_pendingCallbacks.Pop(pendingCallback))
+        {
+            Execute(pendingCallback);
+        }
+    }
+
+    void MarshallingExecutor::Execute(PendingCallback& pendingCallback)
+    {
+        const auto latency = AZStd::chrono::duration_cast<AZStd::chrono::nanoseconds>(Clock::now() - pendingCallback.m_receiptTime);
+        const AZ::u64 latencyNanoseconds = static_cast<AZ::u64>(AZStd::max<AZ::s64>(latency.count(), 0));
+
+        m_callbackCount.fetch_add(1, AZStd::memory_order_relaxed);
+        m_totalLatencyNanoseconds.fetch_add(latencyNanoseconds, AZStd::memory_order_relaxed);
+        AZ::u64 maxLatencyNanoseconds = m_maxLatencyNanoseconds.load(AZStd::memory_order_relaxed);
+        while (latencyNanoseconds > maxLatencyNanoseconds &&
+               !m_maxLatencyNanoseconds.compare_exchange_weak(maxLatencyNanoseconds, latencyNanoseconds, AZStd::memory_order_relaxed))
+        {
+        }
+
+        pendingCallback.m_callback();
+        pendingCallback.m_callback = {};
+    }
+
+    void MarshallingExecutor::WaitForRunningCallback()
+    {
+        AZStd::lock_guard<AZStd::mutex> lock(m_executionMutex);
+    }
+
+    size_t MarshallingExecutor::GetPendingCallbackCount() const
+    {
+        return m_deferredCallbacks.size() + m_pendingCallbacks.Size();
+    }
+
+    MarshallingExecutor::Mode MarshallingExecutor::GetMode() const
+    {
+        return m_mode;
+    }
+
+    CallbackLatencyStatistics MarshallingExecutor::GetCallbackLatencyStatistics() const
+    {
+        CallbackLatencyStatistics statistics;
+        statistics.m_callbackCount = m_callbackCount.load(AZStd::memory_order_relaxed);
+        statistics.m_totalLatencyNanoseconds = m_totalLatencyNanoseconds.load(AZStd::memory_order_relaxed);
+        statistics.m_maxLatencyNanoseconds = m_maxLatencyNanoseconds.load(AZStd::memory_order_relaxed);
+        return statistics;
+    }
+} // namespace ROS2
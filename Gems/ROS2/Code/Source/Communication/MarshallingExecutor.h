@@ -0,0 +1,115 @@
+/*
+ * Copyright (c) Contributors to the Open 3D Engine Project.
+ * For complete copyright and license terms please see the LICENSE at the root of this distribution.
+ *
+ * SPDX-License-Identifier: Apache-2.0 OR MIT
+ *
+ */
+#pragma once
+
+#include <AzCore/std/chrono/chrono.h>
+#include <AzCore/std/containers/unordered_set.h>
+#include <AzCore/std/containers/vector.h>
+#include <AzCore/std/functional.h>
+#include <AzCore/std/parallel/atomic.h>
+#include <AzCore/std/parallel/mutex.h>
+#include <AzCore/std/parallel/thread.h>
+#include <ROS2/ROS2Bus.h>
+#include <ROS2/Utilities/SpscRingBuffer.h>
+#include <rclcpp/executor.hpp>
+
+namespace ROS2
+{
+    //! Executor which waits for ROS 2 events on a background thread instead of polling for them once per frame.
+    //! The background thread takes incoming messages, requests, responses and timer events from the middleware as soon as
+    //! they arrive. Depending on the mode, their callbacks are either handled right away on that thread, or marshalled to
+    //! the game thread through a lock-free queue, which is drained by ExecutePendingCallbacks at a fixed point of the frame.
+    //! Since all callbacks run on a single thread in both modes, callback groups never run concurrently.
+    //! Callbacks hold their subscriptions, services, clients, timers and waitables weakly, and are dropped if these are destroyed
+    //! before the callbacks are handled, so that callbacks do not outlive the objects which own these entities.
+    //! Removing a node drops its callbacks waiting for the game thread, and waits for its callback running on the background
+    //! thread, so that the node can be destroyed, and the library it was loaded from unloaded, right after it is removed.
+    class MarshallingExecutor : public rclcpp::Executor
+    {
+    public:
+        enum class Mode
+        {
+            //! Callbacks are handled on the game thread, in ExecutePendingCallbacks.
+            GameThread,
+            //! Callbacks are handled on the background thread. They must not touch the engine state without synchronization.
+            Background
+        };
+
+        //! Maximum number of callbacks waiting for the game thread. The background thread stops taking events when it is reached.
+        static constexpr size_t PendingCallbackCapacity = 1024;
+
+        explicit MarshallingExecutor(Mode mode);
+        ~MarshallingExecutor() override;
+
+        using rclcpp::Executor::add_node;
+        using rclcpp::Executor::remove_node;
+
+        void add_node(rclcpp::node_interfaces::NodeBaseInterface::SharedPtr nodePtr, bool notify = true) override;
+
+        //! Removes a node, dropping its pending callbacks. Must be called from the game thread.
+        void remove_node(rclcpp::node_interfaces::NodeBaseInterface::SharedPtr nodePtr, bool notify = true) override;
+
+        //! Waits for events and takes them until the executor is cancelled. Called by the background thread.
+        void spin() override;
+
+        //! Starts the background thread.
+        void Start();
+
+        //! Cancels waiting and joins the background thread. Callbacks still waiting for the game thread are dropped.
+        void Stop();
+
+        //! Handles callbacks marshalled to the game thread since the last call. Does nothing in Background mode.
+        void ExecutePendingCallbacks();
+
+        //! Waits until the callback running on the background thread, if any, is handled. Callbacks starting afterwards see
+        //! entities destroyed before the call as gone. Used in Background mode when owners of entities are torn down.
+        void WaitForRunningCallback();
+
+        //! Returns the number of callbacks waiting for the game thread. Must be called from the game thread.
+        size_t GetPendingCallbackCount() const;
+
+        Mode GetMode() const;
+
+        CallbackLatencyStatistics GetCallbackLatencyStatistics() const;
+
+    private:
+        using Clock = AZStd::chrono::steady_clock;
+
+        struct PendingCallback
+        {
+            AZStd::function<void()> m_callback;
+            //! Time the event was taken from the middleware.
+            Clock::time_point m_receiptTime;
+            //! Node of the entity the callback handles, compared against removed nodes only.
+            const rclcpp::node_interfaces::NodeBaseInterface* m_node = nullptr;
+        };
+
+        //! Takes the data of an executable picked by the executor and wraps handling it in a callback.
+        //! @return Callback to handle, or an empty function if there was nothing to take.
+        AZStd::function<void()> TakeExecutable(rclcpp::AnyExecutable& anyExecutable);
+
+        void Execute(PendingCallback& pendingCallback);
+
+        //! Whether the node of a taken event is still added. Must be called with the execution mutex held.
+        bool IsNodeAdded(const rclcpp::node_interfaces::NodeBaseInterface* node) const;
+
+        Mode m_mode;
+        SpscRingBuffer<PendingCallback> m_pendingCallbacks{ PendingCallbackCapacity };
+        //! Callbacks taken out of the queue when a node was removed, handled before the queue. Used by the game thread only.
+        AZStd::vector<PendingCallback> m_deferredCallbacks;
+        //! Held while an event is taken, queued or handled on the background thread.
+        AZStd::mutex m_executionMutex;
+        //! Nodes added to the executor, guarded by the execution mutex. Events taken from nodes removed in the meantime are dropped.
+        AZStd::unordered_set<const rclcpp::node_interfaces::NodeBaseInterface*> m_nodes;
+        AZStd::thread m_spinThread;
+
+        AZStd::atomic<AZ::u64> m_callbackCount{ 0 };
+        AZStd::atomic<AZ::u64> m_totalLatencyNanoseconds{ 0 };
+        AZStd::atomic<AZ::u64> m_maxLatencyNanoseconds{ 0 };
+    };
+} // namespace ROS2
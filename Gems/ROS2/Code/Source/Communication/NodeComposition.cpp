@@ -0,0 +1,135 @@
+/*
+ * Copyright (c) Contributors to the Open 3D Engine Project.
+ * For complete copyright and license terms please see the LICENSE at the root of this distribution.
+ *
+ * SPDX-License-Identifier: Apache-2.0 OR MIT
+ *
+ */
+
+#include <AzCore/IO/SystemFile.h>
+#include <AzCore/std/algorithm.h>
+#include <Communication/NodeComposition.h>
+#include <rclcpp_components/node_factory.hpp>
+
+namespace ROS2
+{
+    NodeComposition::NodeComposition(rclcpp::Executor& executor, bool isIntraProcessEnabled)
+        : m_executor(executor)
+        , m_isIntraProcessEnabled(isIntraProcessEnabled)
+    {
+    }
+
+    NodeComposition::~NodeComposition()
+    {
+        for (auto& [nodeId, loadedNode] : m_loadedNodes)
+        {
+            m_executor.remove_node(loadedNode.get_node_base_interface());
+        }
+        m_loadedNodes.clear();
+        for (const auto& node : m_addedNodes)
+        {
+            m_executor.remove_node(node);
+        }
+        m_addedNodes.clear();
+    }
+
+    bool NodeComposition::IsIntraProcessEnabled() const
+    {
+        return m_isIntraProcessEnabled;
+    }
+
+    rclcpp::NodeOptions NodeComposition::GetNodeOptions() const
+    {
+        rclcpp::NodeOptions options;
+        options.use_intra_process_comms(m_isIntraProcessEnabled);
+        return options;
+    }
+
+    void NodeComposition::AddNode(const rclcpp::node_interfaces::NodeBaseInterface::SharedPtr& node)
+    {
+        AZ_Assert(node, "Composing an empty node.");
+        m_executor.add_node(node);
+        m_addedNodes.push_back(node);
+    }
+
+    void NodeComposition::RemoveNode(const rclcpp::node_interfaces::NodeBaseInterface::SharedPtr& node)
+    {
+        auto it = AZStd::find(m_addedNodes.begin(), m_addedNodes.end(), node);
+        if (it == m_addedNodes.end())
+        {
+            AZ_Warning("NodeComposition", false, "Removing a node which was not composed.");
+            return;
+        }
+        m_executor.remove_node(node);
+        m_addedNodes.erase(it);
+    }
+
+    AZ::u64 NodeComposition::LoadNode(
+        const AZStd::string& libraryPath, const AZStd::string& className, const AZStd::string& nodeName, const AZStd::string& nodeNamespace)
+    {
+        // Loading a missing library throws, so it is checked up front.
+        if (!AZ::IO::SystemFile::Exists(libraryPath.c_str()))
+        {
+            AZ_Warning("NodeComposition", false, "Component library %s does not exist.", libraryPath.c_str());
+            return 0;
+        }
+
+        class_loader::ClassLoader& loader = GetLoader(libraryPath);
+        // Libraries registered with RCLCPP_COMPONENTS_REGISTER_NODE export factories named after the component class.
+        const std::string factoryName = std::string("rclcpp_components::NodeFactoryTemplate<") + className.c_str() + ">";
+        for (const std::string& availableClass : loader.getAvailableClasses<rclcpp_components::NodeFactory>())
+        {
+            if (availableClass != className.c_str() && availableClass != factoryName)
+            {
+                continue;
+            }
+
+            std::vector<std::string> arguments{ "--ros-args" };
+            if (!nodeName.empty())
+            {
+                arguments.insert(arguments.end(), { "-r", std::string("__node:=") + nodeName.c_str() });
+            }
+            if (!nodeNamespace.empty())
+            {
+                arguments.insert(arguments.end(), { "-r", std::string("__ns:=") + nodeNamespace.c_str() });
+            }
+            rclcpp::NodeOptions options = GetNodeOptions();
+            options.use_global_arguments(false).arguments(arguments);
+
+            auto factory = loader.createInstance<rclcpp_components::NodeFactory>(availableClass);
+            rclcpp_components::NodeInstanceWrapper loadedNode = factory->create_node_instance(options);
+            m_executor.add_node(loadedNode.get_node_base_interface());
+
+            const AZ::u64 nodeId = m_nextNodeId++;
+            m_loadedNodes.emplace(nodeId, AZStd::move(loadedNode));
+            AZ_Printf("NodeComposition", "Composed node %s from %s", className.c_str(), libraryPath.c_str());
+            return nodeId;
+        }
+
+        AZ_Warning("NodeComposition", false, "Component library %s has no component %s.", libraryPath.c_str(), className.c_str());
+        return 0;
+    }
+
+    bool NodeComposition::UnloadNode(AZ::u64 nodeId)
+    {
+        auto it = m_loadedNodes.find(nodeId);
+        if (it == m_loadedNodes.end())
+        {
+            return false;
+        }
+        // The executor drops callbacks of the node which are waiting for the game thread, so the node can be destroyed right away.
+        m_executor.remove_node(it->second.get_node_base_interface());
+        m_loadedNodes.erase(it);
+        return true;
+    }
+
+    class_loader::ClassLoader& NodeComposition::GetLoader(const AZStd::string& libraryPath)
+    {
+        auto& loader = m_loaders[libraryPath];
+        if (!loader)
+        {
+            loader = std::make_unique<class_loader::ClassLoader>(libraryPath.c_str());
+        }
+        return *loader;
+    }
+} // namespace ROS2
@@ -0,0 +1,67 @@
+/*
+ * Copyright (c) Contributors to the Open 3D Engine Project.
+ * For complete copyright and license terms please see the LICENSE at the root of this distribution.
+ *
+ * SPDX-License-Identifier: Apache-2.0 OR MIT
+ *
+ */
+#pragma once
+
+#include <AzCore/std/containers/unordered_map.h>
+#include <AzCore/std/containers/vector.h>
+#include <AzCore/std/string/string.h>
+#include <class_loader/class_loader.hpp>
+#include <memory>
+#include <rclcpp/executor.hpp>
+#include <rclcpp/node_options.hpp>
+#include <rclcpp_components/node_instance_wrapper.hpp>
+
+namespace ROS2
+{
+    //! Composes additional nodes into the simulator process, next to the central node. Composed nodes are handled by the executor
+    //! of the central node and, with intra-process communication enabled, take sensor messages without serialization.
+    //! Nodes are either created by the caller, or loaded from component libraries the way a component container loads them.
+    class NodeComposition
+    {
+    public:
+        //! @param executor Executor of the central node, which must outlive the composition.
+        //! @param isIntraProcessEnabled Whether composed nodes use intra-process communication.
+        NodeComposition(rclcpp::Executor& executor, bool isIntraProcessEnabled);
+        ~NodeComposition();
+
+        NodeComposition(const NodeComposition&) = delete;
+        NodeComposition& operator=(const NodeComposition&) = delete;
+
+        bool IsIntraProcessEnabled() const;
+
+        //! Returns options for nodes composed into the simulator process.
+        rclcpp::NodeOptions GetNodeOptions() const;
+
+        void AddNode(const rclcpp::node_interfaces::NodeBaseInterface::SharedPtr& node);
+        void RemoveNode(const rclcpp::node_interfaces::NodeBaseInterface::SharedPtr& node);
+
+        //! Loads a node from a component library and adds it to the executor.
+        //! @return Id of the loaded node, or 0 if the library or the class could not be found.
+        AZ::u64 LoadNode(
+            const AZStd::string& libraryPath,
+            const AZStd::string& className,
+            const AZStd::string& nodeName,
+            const AZStd::string& nodeNamespace);
+
+        //! Removes a loaded node from the executor and destroys it.
+        //! @return Whether a node with the id was loaded.
+        bool UnloadNode(AZ::u64 nodeId);
+
+    private:
+        //! Returns the loader of a library, loading the library on first use.
+        class_loader::ClassLoader& GetLoader(const AZStd::string& libraryPath);
+
+        rclcpp::Executor& m_executor;
+        bool m_isIntraProcessEnabled;
+        //! Loaders stay alive until destruction, since unloading a library while objects created from it exist is unsafe.
+        AZStd::unordered_map<AZStd::string, std::unique_ptr<class_loader::ClassLoader>> m_loaders;
+        AZStd::unordered_map<AZ::u64, rclcpp_components::NodeInstanceWrapper> m_loadedNodes;
+        AZStd::vector<rclcpp::node_interfaces::NodeBaseInterface::SharedPtr> m_addedNodes;
+        AZ::u64 m_nextNodeId = 1;
+    };
+} // namespace ROS2
@@ -0,0 +1,171 @@
+/*
+ * Copyright (c) Contributors to the Open 3D Engine Project.
+ * For complete copyright and license terms please see the LICENSE at the root of this distribution.
+ *
+ * SPDX-License-Identifier: Apache-2.0 OR MIT
+ *
+ */
+
+#include <AzCore/std/algorithm.h>
+#include <Communication/ParallelExecutor.h>
+
+namespace ROS2
+{
+    namespace
+    {
+        //! Executor and thread index of the calling thread, if it belongs to the pool of an executor.
+        thread_local const ParallelExecutor* CurrentExecutor = nullptr;
+        thread_local size_t CurrentThreadIndex = 0;
+    } // namespace
+
+    ParallelExecutor::ParallelExecutor(size_t threadCount)
+        : m_threadCount(threadCount > 0 ? threadCount : AZStd::max<size_t>(AZStd::thread::hardware_concurrency(), 2))
+        , m_callbackEpochs(m_threadCount, 0)
+    {
+    }
+
+    ParallelExecutor::~ParallelExecutor()
+    {
+        Stop();
+    }
+
+    void ParallelExecutor::Start()
+    {
+        AZ_Assert(!m_spinThread.joinable(), "ParallelExecutor is already started.");
+
+        AZStd::thread_desc threadDesc;
+        threadDesc.m_name = "ROS2RobotExecutor";
+        m_spinThread = AZStd::thread(
+            threadDesc,
+            [this]()
+            {
+                spin();
+            });
+
+        // Cancelling an executor which is not spinning yet has no effect on the spin started afterwards.
+        AZStd::unique_lock<AZStd::mutex> lock(m_callbackMutex);
+        m_callbackCondition.wait(
+            lock,
+            [this]()
+            {
+                return m_isStarted;
+            });
+    }
+
+    void ParallelExecutor::Stop()
+    {
+        if (!m_spinThread.joinable())
+        {
+            return;
+        }
+
+        cancel();
+        m_spinThread.join();
+        AZStd::lock_guard<AZStd::mutex> lock(m_callbackMutex);
+        m_isStarted = false;
+    }
+
+    void ParallelExecutor::spin()
+    {
+        [[maybe_unused]] const bool wasSpinning = spinning.exchange(true);
+        AZ_Assert(!wasSpinning, "ParallelExecutor is spun from more than one thread.");
+        {
+            AZStd::lock_guard<AZStd::mutex> lock(m_callbackMutex);
+            m_isStarted = true;
+        }
+        m_callbackCondition.notify_all();
+
+        AZStd::vector<AZStd::thread> threads;
+        threads.reserve(m_threadCount - 1);
+        AZStd::thread_desc threadDesc;
+        threadDesc.m_name = "ROS2RobotExecutor";
+        for (size_t threadIndex = 1; threadIndex < m_threadCount; ++threadIndex)
+        {
+            threads.emplace_back(
+                threadDesc,
+                [this, threadIndex]()
+                {
+                    Run(threadIndex);
+                });
+        }
+        Run(0);
+        for (AZStd::thread& thread : threads)
+        {
+            thread.join();
+        }
+
+        spinning.store(false);
+    }
+
+    void ParallelExecutor::Run(size_t threadIndex)
+    {
+        CurrentExecutor = this;
+        CurrentThreadIndex = threadIndex;
+
+        while (rclcpp::ok(context_) && spinning.load())
+        {
+            rclcpp::AnyExecutable anyExecutable;
+            {
+                AZStd::lock_guard<AZStd::mutex> waitLock(m_waitMutex);
+                if (!rclcpp::ok(context_) || !spinning.load())
+                {
+                    break;
+                }
+
+                // The callback counts as running before its entity is picked, so that an owner destroying the entity meanwhile
+                // waits for it. Waiting for work does not count, since it may take indefinitely.
+                BeginCallback(threadIndex);
+                if (!get_next_ready_executable(anyExecutable))
+                {
+                    EndCallback(threadIndex);
+                    wait_for_work(std::chrono::nanoseconds(-1));
+                    continue;
+                }
+            }
+
+            execute_any_executable(anyExecutable);
+            // Keeps the destructor of the executable from resetting the callback group, which execute_any_executable did already.
+            anyExecutable.callback_group.reset();
+            EndCallback(threadIndex);
+        }
+
+        CurrentExecutor = nullptr;
+    }
+
+    void ParallelExecutor::BeginCallback(size_t threadIndex)
+    {
+        AZStd::lock_guard<AZStd::mutex> lock(m_callbackMutex);
+        ++m_callbackEpochs[threadIndex];
+    }
+
+    void ParallelExecutor::EndCallback(size_t threadIndex)
+    {
+        {
+            AZStd::lock_guard<AZStd::mutex> lock(m_callbackMutex);
+            ++m_callbackEpochs[threadIndex];
+        }
+        m_callbackCondition.notify_all();
+    }
+
+    void ParallelExecutor::WaitForRunningCallbacks()
+    {
+        AZStd::unique_lock<AZStd::mutex> lock(m_callbackMutex);
+        const AZStd::vector<AZ::u64> runningEpochs = m_callbackEpochs;
+        const size_t callingThreadIndex = CurrentExecutor == this ? CurrentThreadIndex : m_threadCount;
+        // Threads which run another callback than the one running at the call have ended it, even if they run one again.
+        m_callbackCondition.wait(
+            lock,
+            [this, &runningEpochs, callingThreadIndex]()
+            {
+                for (size_t threadIndex = 0; threadIndex < m_threadCount; ++threadIndex)
+                {
+                    const bool wasRunning = (runningEpochs[threadIndex] & 1) != 0;
+                    if (wasRunning && threadIndex != callingThreadIndex && m_callbackEpochs[threadIndex] == runningEpochs[threadIndex])
+                    {
+                        return false;
+                    }
+                }
+                return true;
+            });
+    }
+} // namespace ROS2
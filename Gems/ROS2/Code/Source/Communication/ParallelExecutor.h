@@ -0,0 +1,61 @@
+/*
+ * Copyright (c) Contributors to the Open 3D Engine Project.
+ * For complete copyright and license terms please see the LICENSE at the root of this distribution.
+ *
+ * SPDX-License-Identifier: Apache-2.0 OR MIT
+ *
+ */
+#pragma once
+
+#include <AzCore/std/containers/vector.h>
+#include <AzCore/std/parallel/condition_variable.h>
+#include <AzCore/std/parallel/mutex.h>
+#include <AzCore/std/parallel/thread.h>
+#include <rclcpp/executor.hpp>
+
+namespace ROS2
+{
+    //! Spins nodes on a pool of threads, the way rclcpp::executors::MultiThreadedExecutor does, and keeps track of callbacks
+    //! running on them, so that owners of entities can wait for callbacks before they are destroyed.
+    //! A callback counts as running from the moment its entity is picked, until it is handled.
+    class ParallelExecutor : public rclcpp::Executor
+    {
+    public:
+        //! @param threadCount Number of threads handling callbacks, or 0 for the number of cores.
+        explicit ParallelExecutor(size_t threadCount);
+        ~ParallelExecutor() override;
+
+        //! Runs the pool of threads until the executor is cancelled. Called by the thread started with Start.
+        void spin() override;
+
+        //! Starts spinning on a new thread. Returns once the executor is spinning, so that Stop cancels it.
+        void Start();
+
+        //! Cancels spinning and joins all threads.
+        void Stop();
+
+        //! Waits until the callbacks running when called, if any, are handled. Callbacks starting afterwards see entities destroyed
+        //! before the call as gone. Callbacks of the calling thread, if it is a thread of the executor, are not waited for.
+        void WaitForRunningCallbacks();
+
+    private:
+        //! Picks and handles callbacks on one thread of the pool, until the executor is cancelled.
+        void Run(size_t threadIndex);
+
+        void BeginCallback(size_t threadIndex);
+        void EndCallback(size_t threadIndex);
+
+        size_t m_threadCount;
+        AZStd::thread m_spinThread;
+        //! Held while a thread of the pool waits for work or picks an entity, as in the multi-threaded executor of rclcpp.
+        AZStd::mutex m_waitMutex;
+
+        //! Guards the state below, which the condition variable signals changes of.
+        AZStd::mutex m_callbackMutex;
+        AZStd::condition_variable m_callbackCondition;
+        //! Set while spinning is started, which Start waits for.
+        bool m_isStarted = false;
+        //! Number of callbacks begun and ended by each thread of the pool, which is odd while the thread runs a callback.
+        AZStd::vector<AZ::u64> m_callbackEpochs;
+    };
+} // namespace ROS2
@@ -0,0 +1,151 @@
+/*
+ * Copyright (c) Contributors to the Open 3D Engine Project.
+ * For complete copyright and license terms please see the LICENSE at the root of this distribution.
+ *
+ * SPDX-License-Identifier: Apache-2.0 OR MIT
+ *
+ */
+
+#include <Communication/RobotNodes.h>
+
+namespace ROS2
+{
+    RobotNodes::RobotNodes(MarshallingExecutor& executor, size_t threadCount)
+        : m_executor(executor)
+    {
+        if (m_executor.GetMode() != MarshallingExecutor::Mode::Background)
+        {
+            return;
+        }
+
+        m_parallelExecutor = std::make_unique<ParallelExecutor>(threadCount);
+        m_parallelExecutor->Start();
+    }
+
+    RobotNodes::~RobotNodes()
+    {
+        if (m_parallelExecutor)
+        {
+            m_parallelExecutor->Stop();
+        }
+
+        AZStd::lock_guard<AZStd::mutex> lock(m_nodesMutex);
+        for (const auto& [robotName, node] : m_nodes)
+        {
+            if (m_parallelExecutor)
+            {
+                m_parallelExecutor->remove_node(node);
+            }
+            else
+            {
+                m_executor.remove_node(node);
+            }
+        }
+        m_nodes.clear();
+    }
+
+    std::shared_ptr<rclcpp::Node> RobotNodes::GetNode(const AZStd::string& ns)
+    {
+        const AZStd::string robotName = GetRobotName(ns);
+        if (robotName.empty())
+        {
+            return nullptr;
+        }
+
+        AZStd::lock_guard<AZStd::mutex> lock(m_nodesMutex);
+        auto& node = m_nodes[robotName];
+        if (!node)
+        {
+            node = std::make_shared<rclcpp::Node>(GetNodeName(robotName).c_str());
+            if (m_parallelExecutor)
+            {
+                m_parallelExecutor->add_node(node);
+            }
+            else
+            {
+                m_executor.add_node(node);
+            }
+        }
+        return node;
+    }
+
+    void RobotNodes::AcquireNode(const AZStd::string& ns)
+    {
+        const AZStd::string robotName = GetRobotName(ns);
+        if (robotName.empty())
+        {
+            return;
+        }
+
+        AZStd::lock_guard<AZStd::mutex> lock(m_nodesMutex);
+        ++m_referenceCounts[robotName];
+    }
+
+    void RobotNodes::ReleaseNode(const AZStd::string& ns)
+    {
+        const AZStd::string robotName = GetRobotName(ns);
+        if (robotName.empty())
+        {
+            return;
+        }
+
+        AZStd::lock_guard<AZStd::mutex> lock(m_nodesMutex);
+        auto referenceCountIt = m_referenceCounts.find(robotName);
+        if (referenceCountIt == m_referenceCounts.end())
+        {
+            AZ_Warning("RobotNodes", false, "Releasing the node of robot %s, which was not acquired.", robotName.c_str());
+            return;
+        }
+        if (--referenceCountIt->second > 0)
+        {
+            return;
+        }
+        m_referenceCounts.erase(referenceCountIt);
+
+        // Components of the robot release their publishers and subscriptions before its frames, which they depend on.
+        auto nodeIt = m_nodes.find(robotName);
+        if (nodeIt == m_nodes.end())
+        {
+            return;
+        }
+        if (m_parallelExecutor)
+        {
+            m_parallelExecutor->remove_node(nodeIt->second);
+        }
+        else
+        {
+            m_executor.remove_node(nodeIt->second);
+        }
+        m_nodes.erase(nodeIt);
+    }
+
+    void RobotNodes::WaitForRunningCallbacks()
+    {
+        if (m_parallelExecutor)
+        {
+            m_parallelExecutor->WaitForRunningCallbacks();
+        }
+    }
+
+    size_t RobotNodes::GetNodeCount() const
+    {
+        AZStd::lock_guard<AZStd::mutex> lock(m_nodesMutex);
+        return m_nodes.size();
+    }
+
+    AZStd::string RobotNodes::GetRobotName(const AZStd::string& ns)
+    {
+        const size_t begin = ns.find_first_not_of('/');
+        if (begin == AZStd::string::npos)
+        {
+            return {};
+        }
+        const size_t end = ns.find('/', begin);
+        return ns.substr(begin, end == AZStd::string::npos ? AZStd::string::npos : end - begin);
+    }
+
+    AZStd::string RobotNodes::GetNodeName(const AZStd::string& robotName)
+    {
+        return AZStd::string::format("o3de_ros2_node_%s", robotName.c_str());
+    }
+} // namespace ROS2
@@ -0,0 +1,72 @@
+/*
+ * Copyright (c) Contributors to the Open 3D Engine Project.
+ * For complete copyright and license terms please see the LICENSE at the root of this distribution.
+ *
+ * SPDX-License-Identifier: Apache-2.0 OR MIT
+ *
+ */
+#pragma once
+
+#include <AzCore/std/containers/unordered_map.h>
+#include <AzCore/std/parallel/mutex.h>
+#include <AzCore/std/string/string.h>
+#include <Communication/MarshallingExecutor.h>
+#include <Communication/ParallelExecutor.h>
+#include <memory>
+#include <rclcpp/node.hpp>
+
+namespace ROS2
+{
+    //! Gives each robot its own node, so that discovery, graph introspection and callback dispatch of a fleet are not funneled
+    //! through the central node. A robot is identified by the first segment of its namespace, and its node is created in the root
+    //! namespace on first use, so that topic names resolve the same way as on the central node.
+    //! With the executor in GameThread mode, robot nodes are added to it and their callbacks stay on the game thread. In Background
+    //! mode, they are spun by a pool of threads instead. Callbacks of one robot never run concurrently, since each node uses its
+    //! default, mutually exclusive callback group, while callbacks of different robots run in parallel.
+    //! Frames of a robot acquire its node while they are active, and the node is removed once the last of them is released,
+    //! e.g. when the robot is despawned.
+    class RobotNodes
+    {
+    public:
+        //! @param executor Executor of the central node, which must outlive robot nodes.
+        //! @param threadCount Number of threads spinning robot nodes in Background mode, or 0 for the number of cores.
+        RobotNodes(MarshallingExecutor& executor, size_t threadCount);
+        ~RobotNodes();
+
+        RobotNodes(const RobotNodes&) = delete;
+        RobotNodes& operator=(const RobotNodes&) = delete;
+
+        //! Returns the node of the robot owning a namespace, creating it on first use.
+        //! @param ns Namespace of an entity of the robot, e.g. "robot1/arm".
+        //! @return Node of the robot, or nullptr if the namespace is empty.
+        std::shared_ptr<rclcpp::Node> GetNode(const AZStd::string& ns);
+
+        //! Keeps the node of the robot owning a namespace from being removed. Called by frames of the robot when they activate.
+        void AcquireNode(const AZStd::string& ns);
+
+        //! Releases the node acquired with AcquireNode, removing it once it is released by all frames of the robot.
+        void ReleaseNode(const AZStd::string& ns);
+
+        size_t GetNodeCount() const;
+
+        //! Waits until callbacks of robot nodes running in Background mode, if any, are handled. Used when owners of entities are
+        //! torn down, together with MarshallingExecutor::WaitForRunningCallback. Does nothing in GameThread mode.
+        void WaitForRunningCallbacks();
+
+        //! Returns the robot part of a namespace, which is its first segment.
+        static AZStd::string GetRobotName(const AZStd::string& ns);
+
+        //! Returns the name of the node of a robot.
+        static AZStd::string GetNodeName(const AZStd::string& robotName);
+
+    private:
+        MarshallingExecutor& m_executor;
+        //! Present only in Background mode.
+        std::unique_ptr<ParallelExecutor> m_parallelExecutor;
+
+        mutable AZStd::mutex m_nodesMutex;
+        AZStd::unordered_map<AZStd::string, std::shared_ptr<rclcpp::Node>> m_nodes;
+        //! Number of active frames of each robot.
+        AZStd::unordered_map<AZStd::string, AZ::u32> m_referenceCounts;
+    };
+} // namespace ROS2
@@ -64,11 +64,11 @@ namespace ROS2
         AZ::ComponentApplicationBus::BroadcastResult(entity, &AZ::ComponentApplicationRequests::FindEntity, m_entityId);
         m_entityName = entity->GetName();
 
-        auto ros2Node = ROS2Interface::Get()->GetNode();
+        auto ros2Node = GetRobotNode();
         AZ_Assert(m_sensorConfiguration.m_publishersConfigurations.size() == 1, "Invalid configuration of publishers for Contact sensor");
         const auto publisherConfig = m_sensorConfiguration.m_publishersConfigurations["gazebo_msgs::msg::ContactsState"];
         const auto fullTopic = ROS2Names::GetNamespacedName(GetNamespace(), publisherConfig.m_topic);
-        m_contactsPublisher = ros2Node->create_publisher<gazebo_msgs::msg::ContactsState>(fullTopic.data(), publisherConfig.GetQoS());
+        m_contactsPublisher = SensorPublisher<gazebo_msgs::msg::ContactsState>::Create(ros2Node, fullTopic, publisherConfig.GetQoS());
 
         m_onCollisionBeginHandler = AzPhysics::SimulatedBodyEvents::OnCollisionBegin::Handler(
             [this]([[maybe_unused]] AzPhysics::SimulatedBodyHandle bodyHandle, const AzPhysics::CollisionEvent& event)
@@ -99,6 +99,7 @@ namespace ROS2
                 }
                 FrequencyTick();
             });
+        m_contactsPublisher->SetSensorProfile(GetSensorProfile());
     }
 
     void ROS2ContactSensorComponent::Deactivate()
@@ -137,22 +138,25 @@ namespace ROS2
         }
 
         // Publishes all contacts
-        gazebo_msgs::msg::ContactsState msg;
         const auto* ros2Frame = Utils::GetGameOrEditorComponent<ROS2FrameComponent>(GetEntity());
         AZ_Assert(ros2Frame, "Invalid component pointer value");
-        msg.header.frame_id = ros2Frame->GetFrameID().data();
-        msg.header.stamp = ROS2Interface::Get()->GetROSTimestamp();
 
         {
             // If there are no active collisions, then there is nothing to send
             AZStd::lock_guard<AZStd::mutex> lock(m_activeContactsMutex);
             if (!m_activeContacts.empty())
             {
-                for (auto [id, contact] : m_activeContacts)
+                if (gazebo_msgs::msg::ContactsState* msg = m_contactsPublisher->AcquireMessage())
                 {
-                    msg.states.push_back(AZStd::move(contact));
+                    msg->header.frame_id = ros2Frame->GetFrameID().data();
+                    msg->header.stamp = ROS2Interface::Get()->GetROSTimestamp();
+                    msg->states.clear();
+                    for (auto [id, contact] : m_activeContacts)
+                    {
+                        msg->states.push_back(AZStd::move(contact));
+                    }
+                    m_contactsPublisher->Submit(msg);
                 }
-                m_contactsPublisher->publish(AZStd::move(msg));
                 m_activeContacts.clear();
             }
         }
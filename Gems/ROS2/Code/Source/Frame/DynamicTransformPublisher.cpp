@@ -0,0 +1,292 @@
+/*
+ * Copyright (c) Contributors to the Open 3D Engine Project.
+ * For complete copyright and license terms please see the LICENSE at the root of this distribution.
+ *
+ * SPDX-License-Identifier: Apache-2.0 OR MIT
+ *
+ */
+
+#include <AzCore/std/algorithm.h>
+#include <AzCore/std/math.h>
+#include <Frame/DynamicTransformPublisher.h>
+#include <ROS2/Utilities/ROS2Conversions.h>
+#include <tf2_ros/qos.hpp>
+
+namespace ROS2
+{
+    DynamicTransformPublisher::DynamicTransformPublisher(const std::shared_ptr<rclcpp::Node>& node, const Configuration& configuration)
+        : m_configuration(configuration)
+        , m_minRotationDot(AZStd::cos(0.5f * configuration.m_angularTolerance))
+    {
+        m_publisher = node->create_publisher<tf2_msgs::msg::TFMessage>("/tf", tf2_ros::DynamicBroadcasterQoS());
+    }
+
+    DynamicTransformPublisher::~DynamicTransformPublisher()
+    {
+        AZ::EntityBus::MultiHandler::BusDisconnect();
+    }
+
+    void DynamicTransformPublisher::RegisterFrame(
+        AZ::EntityId frameEntityId, AZ::EntityId parentEntityId, const AZStd::string& parentFrameId, const AZStd::string& frameId)
+    {
+        if (m_frameIndices.find(frameEntityId) != m_frameIndices.end())
+        {
+            AZ_Error("DynamicTransformPublisher", false, "Frame %s is already registered.", frameId.c_str());
+            return;
+        }
+
+        DynamicFrame frame;
+        frame.m_entityId = frameEntityId;
+        frame.m_node = AcquireNode(frameEntityId);
+        frame.m_parentNode = parentEntityId.IsValid() ? AcquireNode(parentEntityId) : InvalidIndex;
+        // Forces the first tick to write the entry.
+        frame.m_transform = AZ::Transform::CreateUniformScale(0.0f);
+        frame.m_publishTime = AZStd::numeric_limits<double>::lowest();
+
+        m_frameIndices[frameEntityId] = m_frames.size();
+        m_frames.push_back(frame);
+
+        geometry_msgs::msg::TransformStamped& entry = m_message.transforms.emplace_back();
+        entry.header.frame_id = parentFrameId.c_str();
+        entry.child_frame_id = frameId.c_str();
+    }
+
+    void DynamicTransformPublisher::UnregisterFrame(AZ::EntityId frameEntityId)
+    {
+        auto frameIndexIt = m_frameIndices.find(frameEntityId);
+        if (frameIndexIt == m_frameIndices.end())
+        {
+            return;
+        }
+
+        const size_t frameIndex = frameIndexIt->second;
+        m_frameIndices.erase(frameIndexIt);
+
+        const DynamicFrame& frame = m_frames[frameIndex];
+        ReleaseNode(frame.m_node);
+        if (frame.m_parentNode != InvalidIndex)
+        {
+            ReleaseNode(frame.m_parentNode);
+        }
+
+        // Frames are kept contiguous, in the same order as message entries.
+        const size_t lastIndex = m_frames.size() - 1;
+        if (frameIndex != lastIndex)
+        {
+            m_frames[frameIndex] = m_frames[lastIndex];
+            m_message.transforms[frameIndex] = AZStd::move(m_message.transforms[lastIndex]);
+            m_frameIndices[m_frames[frameIndex].m_entityId] = frameIndex;
+        }
+        m_frames.pop_back();
+        m_message.transforms.pop_back();
+    }
+
+    size_t DynamicTransformPublisher::AcquireNode(AZ::EntityId entityId)
+    {
+        if (auto nodeIndexIt = m_nodeIndices.find(entityId); nodeIndexIt != m_nodeIndices.end())
+        {
+            ++m_nodes[nodeIndexIt->second].m_referenceCount;
+            return nodeIndexIt->second;
+        }
+
+        size_t nodeIndex = m_nodes.size();
+        if (!m_freeNodes.empty())
+        {
+            nodeIndex = m_freeNodes.back();
+            m_freeNodes.pop_back();
+        }
+        else
+        {
+            m_nodes.emplace_back();
+            m_worldTransforms.emplace_back(AZ::Transform::CreateIdentity());
+            m_inverseWorldTransforms.emplace_back(AZ::Transform::CreateIdentity());
+            m_isInverseValid.push_back(0);
+        }
+
+        TransformNode& node = m_nodes[nodeIndex];
+        node.m_entityId = entityId;
+        node.m_transformInterface = nullptr;
+        node.m_referenceCount = 1;
+        m_nodeIndices[entityId] = nodeIndex;
+        AZ::EntityBus::MultiHandler::BusConnect(entityId);
+        return nodeIndex;
+    }
+
+    void DynamicTransformPublisher::ReleaseNode(size_t nodeIndex)
+    {
+        TransformNode& node = m_nodes[nodeIndex];
+        AZ_Assert(node.m_referenceCount > 0, "Releasing an unused transform node.");
+        if (--node.m_referenceCount == 0)
+        {
+            AZ::EntityBus::MultiHandler::BusDisconnect(node.m_entityId);
+            m_nodeIndices.erase(node.m_entityId);
+            node.m_entityId = AZ::EntityId();
+            node.m_transformInterface = nullptr;
+            m_freeNodes.push_back(nodeIndex);
+        }
+    }
+
+    void DynamicTransformPublisher::OnEntityDeactivated(const AZ::EntityId& entityId)
+    {
+        // Parent entities need not have frames of their own, so nodes are not released when they deactivate. The transform
+        // interface is looked up again instead of being used after its component is gone, e.g. once the entity is deleted.
+        if (auto nodeIndexIt = m_nodeIndices.find(entityId); nodeIndexIt != m_nodeIndices.end())
+        {
+            m_nodes[nodeIndexIt->second].m_transformInterface = nullptr;
+        }
+    }
+
+    void DynamicTransformPublisher::QueueTransform(const geometry_msgs::msg::TransformStamped& transform)
+    {
+        // Ticks skipped by the publication rate would otherwise grow the queue without bound. Only the latest transform of
+        // each frame is published, as the earlier ones would be stale by then anyway. A child frame has a single parent in the
+        // transform tree, so frames are told apart by their child frame ids, and each keeps its slot across ticks.
+        auto [slotIt, isNewSlot] =
+            m_queuedTransformSlots.emplace(AZStd::string(transform.child_frame_id.c_str()), m_queuedTransforms.size());
+        const size_t slot = slotIt->second;
+        if (isNewSlot)
+        {
+            m_queuedTransforms.push_back(transform);
+            m_isSlotQueued.push_back(0);
+        }
+        else
+        {
+            m_queuedTransforms[slot] = transform;
+        }
+
+        if (!m_isSlotQueued[slot])
+        {
+            m_isSlotQueued[slot] = 1;
+            m_queuedSlots.push_back(slot);
+        }
+    }
+
+    bool DynamicTransformPublisher::IsChanged(const DynamicFrame& frame, const AZ::Transform& transform) const
+    {
+        const float linearTolerance = m_configuration.m_linearTolerance;
+        if (transform.GetTranslation().GetDistanceSq(frame.m_transform.GetTranslation()) > linearTolerance * linearTolerance)
+        {
+            return true;
+        }
+        if (m_configuration.m_angularTolerance <= 0.0f)
+        {
+            return transform.GetRotation() != frame.m_transform.GetRotation();
+        }
+        return AZStd::abs(transform.GetRotation().Dot(frame.m_transform.GetRotation())) < m_minRotationDot;
+    }
+
+    void DynamicTransformPublisher::Publish(const builtin_interfaces::msg::Time& timestamp)
+    {
+        if (m_frames.empty() && m_queuedSlots.empty())
+        {
+            return;
+        }
+
+        const double time = timestamp.sec + timestamp.nanosec * 1e-9;
+        if (m_configuration.m_publishRate > 0.0)
+        {
+            if (time < m_nextPublishTime)
+            {
+                return;
+            }
+            // Keeps the rate steady when ticks do not line up with the period, without bursts after pauses.
+            const double period = 1.0 / m_configuration.m_publishRate;
+            m_nextPublishTime = AZStd::max(m_nextPublishTime + period, time);
+        }
+
+        // World transforms are read once per node, however many frames refer to it.
+        for (size_t nodeIndex = 0; nodeIndex < m_nodes.size(); ++nodeIndex)
+        {
+            TransformNode& node = m_nodes[nodeIndex];
+            m_isInverseValid[nodeIndex] = 0;
+            if (node.m_referenceCount == 0)
+            {
+                continue;
+            }
+            if (!node.m_transformInterface)
+            {
+                // Resolved lazily, since the parent entity of a frame may activate after the frame itself.
+                node.m_transformInterface = AZ::TransformBus::FindFirstHandler(node.m_entityId);
+            }
+            if (node.m_transformInterface)
+            {
+                m_worldTransforms[nodeIndex] = node.m_transformInterface->GetWorldTM();
+            }
+        }
+
+        const bool skipUnchanged = m_configuration.m_keepAliveInterval > 0.0;
+        size_t changedCount = 0;
+        for (size_t frameIndex = 0; frameIndex < m_frames.size(); ++frameIndex)
+        {
+            DynamicFrame& frame = m_frames[frameIndex];
+            AZ::Transform transform = m_worldTransforms[frame.m_node];
+            if (frame.m_parentNode != InvalidIndex)
+            {
+                if (!m_isInverseValid[frame.m_parentNode])
+                {
+                    m_inverseWorldTransforms[frame.m_parentNode] = m_worldTransforms[frame.m_parentNode].GetInverse();
+                    m_isInverseValid[frame.m_parentNode] = 1;
+                }
+                transform = m_inverseWorldTransforms[frame.m_parentNode] * transform;
+            }
+
+            // Without skipping, entries are rewritten on any change, but all of them are published.
+            const bool isChanged = skipUnchanged ? IsChanged(frame, transform) : transform != frame.m_transform;
+            if (skipUnchanged && !isChanged && time - frame.m_publishTime < m_configuration.m_keepAliveInterval)
+            {
+                ++m_skippedTransformCount;
+                continue;
+            }
+
+            geometry_msgs::msg::TransformStamped& entry = m_message.transforms[frameIndex];
+            entry.header.stamp = timestamp;
+            if (isChanged)
+            {
+                entry.transform.translation = ROS2Conversions::ToROS2Vector3(transform.GetTranslation());
+                entry.transform.rotation = ROS2Conversions::ToROS2Quaternion(transform.GetRotation());
+                frame.m_transform = transform;
+            }
+            frame.m_publishTime = time;
+
+            if (skipUnchanged)
+            {
+                // Assigning to existing entries reuses the storage of their frame id strings.
+                if (changedCount < m_changedMessage.transforms.size())
+                {
+                    m_changedMessage.transforms[changedCount] = entry;
+                }
+                else
+                {
+                    m_changedMessage.transforms.push_back(entry);
+                }
+                ++changedCount;
+            }
+        }
+
+        tf2_msgs::msg::TFMessage& message = skipUnchanged ? m_changedMessage : m_message;
+        const size_t frameCount = skipUnchanged ? changedCount : m_frames.size();
+        message.transforms.resize(frameCount);
+        for (const size_t slot : m_queuedSlots)
+        {
+            message.transforms.push_back(m_queuedTransforms[slot]);
+            m_isSlotQueued[slot] = 0;
+        }
+        m_queuedSlots.clear();
+
+        if (!message.transforms.empty())
+        {
+            m_publisher->publish(message);
+        }
+        message.transforms.resize(frameCount);
+    }
+
+    size_t DynamicTransformPublisher::GetFrameCount() const
+    {
+        return m_frames.size();
+    }
+
+    AZ::u64 DynamicTransformPublisher::GetSkippedTransformCount() const
+    {
+        return m_skippedTransformCount;
+    }
+} // namespace ROS2
@@ -0,0 +1,137 @@
+/*
+ * Copyright (c) Contributors to the Open 3D Engine Project.
+ * For complete copyright and license terms please see the LICENSE at the root of this distribution.
+ *
+ * SPDX-License-Identifier: Apache-2.0 OR MIT
+ *
+ */
+#pragma once
+
+#include <AzCore/Component/EntityBus.h>
+#include <AzCore/Component/EntityId.h>
+#include <AzCore/Component/TransformBus.h>
+#include <AzCore/Math/Transform.h>
+#include <AzCore/std/containers/unordered_map.h>
+#include <AzCore/std/containers/vector.h>
+#include <AzCore/std/limits.h>
+#include <AzCore/std/string/string.h>
+#include <builtin_interfaces/msg/time.hpp>
+#include <geometry_msgs/msg/transform_stamped.hpp>
+#include <rclcpp/node.hpp>
+#include <rclcpp/publisher.hpp>
+#include <tf2_msgs/msg/tf_message.hpp>
+
+namespace ROS2
+{
+    //! Publishes all dynamic frames of the simulation to /tf as a single message per frame.
+    //! The frame tree is resolved when frames are registered: parents, frame ids and transform interfaces are cached, so
+    //! publishing does not walk the entity hierarchy or build strings. The message is allocated once and each entry is
+    //! only rewritten when the transform of its frame changed. Publication can be limited to a rate in simulation time,
+    //! and frames which did not move can be skipped until a keep-alive interval passes.
+    //! Cached transform interfaces are dropped when their entities deactivate, and looked up again once they are back.
+    class DynamicTransformPublisher : private AZ::EntityBus::MultiHandler
+    {
+    public:
+        //! Limits how often transforms are published. The default configuration publishes every frame on every tick.
+        struct Configuration
+        {
+            //! Rate of publication in simulation time, in Hz. Zero publishes on every tick.
+            double m_publishRate = 0.0;
+            //! Frames which did not move further than the tolerances since they were last published are skipped,
+            //! until the keep-alive interval passes. Zero keep-alive interval publishes all frames every time.
+            double m_keepAliveInterval = 0.0;
+            //! Translation tolerance, in meters.
+            float m_linearTolerance = 0.0f;
+            //! Rotation tolerance, in radians.
+            float m_angularTolerance = 0.0f;
+        };
+
+        explicit DynamicTransformPublisher(const std::shared_ptr<rclcpp::Node>& node, const Configuration& configuration = {});
+        ~DynamicTransformPublisher() override;
+
+        //! Registers a frame whose transform to its parent frame is published every tick.
+        //! @param frameEntityId Entity of the frame. Each entity has at most one frame.
+        //! @param parentEntityId Entity of the parent frame, or an invalid id if the frame is relative to the global frame.
+        //! @param parentFrameId Id of the parent frame, with namespace.
+        //! @param frameId Id of the frame, with namespace.
+        void RegisterFrame(
+            AZ::EntityId frameEntityId, AZ::EntityId parentEntityId, const AZStd::string& parentFrameId, const AZStd::string& frameId);
+
+        void UnregisterFrame(AZ::EntityId frameEntityId);
+
+        //! Queues a transform to be published with the next message, in addition to the registered frames.
+        //! A transform queued again for the same child frame before the message is published replaces the earlier one.
+        void QueueTransform(const geometry_msgs::msg::TransformStamped& transform);
+
+        //! Updates transforms of registered frames and publishes them along with queued transforms, when the publication
+        //! period passed. Only frames which moved or reached the keep-alive interval are included.
+        //! @param timestamp Current simulation time, used as timestamp of all transforms of registered frames.
+        void Publish(const builtin_interfaces::msg::Time& timestamp);
+
+        size_t GetFrameCount() const;
+
+        //! Number of frame transforms left out of published messages because their frames did not move.
+        AZ::u64 GetSkippedTransformCount() const;
+
+    private:
+        static constexpr size_t InvalidIndex = AZStd::numeric_limits<size_t>::max();
+
+        //! Entity whose world transform is read once per tick. Shared by a frame and the children frames relative to it.
+        struct TransformNode
+        {
+            AZ::EntityId m_entityId;
+            AZ::TransformInterface* m_transformInterface = nullptr;
+            AZ::u32 m_referenceCount = 0;
+        };
+
+        struct DynamicFrame
+        {
+            AZ::EntityId m_entityId;
+            size_t m_node;
+            size_t m_parentNode;
+            //! Transform currently written in the message entry of the frame.
+            AZ::Transform m_transform;
+            //! Simulation time the frame was last published at, in seconds.
+            double m_publishTime;
+        };
+
+        // AZ::EntityBus::MultiHandler overrides
+        void OnEntityDeactivated(const AZ::EntityId& entityId) override;
+
+        //! Whether the frame moved beyond the tolerances since it was last published.
+        bool IsChanged(const DynamicFrame& frame, const AZ::Transform& transform) const;
+
+        size_t AcquireNode(AZ::EntityId entityId);
+        void ReleaseNode(size_t nodeIndex);
+
+        rclcpp::Publisher<tf2_msgs::msg::TFMessage>::SharedPtr m_publisher;
+        Configuration m_configuration;
+        //! Cosine of half the angular tolerance, compared with the dot product of rotations.
+        float m_minRotationDot;
+        double m_nextPublishTime = 0.0;
+        AZ::u64 m_skippedTransformCount = 0;
+
+        AZStd::vector<TransformNode> m_nodes;
+        AZStd::vector<size_t> m_freeNodes;
+        AZStd::unordered_map<AZ::EntityId, size_t> m_nodeIndices;
+        //! World transforms of nodes and their inverses, refreshed every tick. Inverses are computed only for parent nodes.
+        AZStd::vector<AZ::Transform> m_worldTransforms;
+        AZStd::vector<AZ::Transform> m_inverseWorldTransforms;
+        AZStd::vector<AZ::u8> m_isInverseValid;
+
+        //! Registered frames, in the order of their entries in the message.
+        AZStd::vector<DynamicFrame> m_frames;
+        AZStd::unordered_map<AZ::EntityId, size_t> m_frameIndices;
+
+        //! Message with an entry for every registered frame, followed by transforms queued for the current tick.
+        tf2_msgs::msg::TFMessage m_message;
+        //! Message with entries of the frames that are published, used when unchanged frames are skipped.
+        tf2_msgs::msg::TFMessage m_changedMessage;
+        //! Latest queued transform of each child frame that was ever queued, in slots found by the child frame id.
+        AZStd::vector<geometry_msgs::msg::TransformStamped> m_queuedTransforms;
+        AZStd::unordered_map<AZStd::string, size_t> m_queuedTransformSlots;
+        //! Slots queued for the next message, in the order they were first queued, and whether each slot is among them.
+        AZStd::vector<size_t> m_queuedSlots;
+        AZStd::vector<AZ::u8> m_isSlotQueued;
+    };
+} // namespace ROS2
@@ -75,6 +75,12 @@ namespace ROS2
     void ROS2FrameComponent::Activate()
     {
         m_namespaceConfiguration.PopulateNamespace(IsTopLevel(), GetEntity()->GetName());
+        // Components of the entity depend on the frame, so they activate after the node of their robot is acquired.
+        m_robotNodeNamespace = GetNamespace();
+        if (auto* ros2Interface = ROS2Interface::Get())
+        {
+            ros2Interface->AcquireRobotNode(m_robotNodeNamespace);
+        }
 
         if (m_publishTransform)
         {
@@ -105,13 +111,16 @@ namespace ROS2
                 GetFrameID().data(),
                 IsDynamic() ? "continuously to /tf" : "once to /tf_static");
 
-            m_ros2Transform = AZStd::make_unique<ROS2Transform>(GetParentFrameID(), GetFrameID(), IsDynamic());
             if (IsDynamic())
             {
-                AZ::TickBus::Handler::BusConnect();
+                // Dynamic transforms of all frames are published together, from the frame tree cached at registration.
+                const auto* parentFrame = GetParentROS2FrameComponent();
+                ROS2Interface::Get()->RegisterDynamicFrame(
+                    GetEntityId(), parentFrame ? parentFrame->GetEntityId() : AZ::EntityId(), GetParentFrameID(), GetFrameID());
             }
             else
             {
+                m_ros2Transform = AZStd::make_unique<ROS2Transform>(GetParentFrameID(), GetFrameID(), IsDynamic());
                 m_ros2Transform->Publish(GetFrameTransform());
             }
         }
@@ -123,15 +132,17 @@ namespace ROS2
         {
             if (IsDynamic())
             {
-                AZ::TickBus::Handler::BusDisconnect();
+                if (auto* ros2Interface = ROS2Interface::Get())
+                {
+                    ros2Interface->UnregisterDynamicFrame(GetEntityId());
+                }
             }
             m_ros2Transform.reset();
         }
-    }
-
-    void ROS2FrameComponent::OnTick([[maybe_unused]] float deltaTime, [[maybe_unused]] AZ::ScriptTimePoint time)
-    {
-        m_ros2Transform->Publish(GetFrameTransform());
+        if (auto* ros2Interface = ROS2Interface::Get())
+        {
+            ros2Interface->ReleaseRobotNode(m_robotNodeNamespace);
+        }
     }
 
     AZStd::string ROS2FrameComponent::GetGlobalFrameName() const
@@ -66,12 +66,12 @@ namespace ROS2
 
     void ROS2GNSSSensorComponent::Activate()
     {
-        auto ros2Node = ROS2Interface::Get()->GetNode();
+        auto ros2Node = GetRobotNode();
         AZ_Assert(m_sensorConfiguration.m_publishersConfigurations.size() == 1, "Invalid configuration of publishers for GNSS sensor");
 
         const auto publisherConfig = m_sensorConfiguration.m_publishersConfigurations[GNSSMsgType];
         const auto fullTopic = ROS2Names::GetNamespacedName(GetNamespace(), publisherConfig.m_topic);
-        m_gnssPublisher = ros2Node->create_publisher<sensor_msgs::msg::NavSatFix>(fullTopic.data(), publisherConfig.GetQoS());
+        m_gnssPublisher = SensorPublisher<sensor_msgs::msg::NavSatFix>::Create(ros2Node, fullTopic, publisherConfig.GetQoS());
 
         m_gnssMsg.header.frame_id = "gnss_frame_id";
 
@@ -85,6 +85,7 @@ namespace ROS2
                 }
                 FrequencyTick();
             });
+        m_gnssPublisher->SetSensorProfile(GetSensorProfile());
     }
 
     void ROS2GNSSSensorComponent::Deactivate()
@@ -108,7 +109,7 @@ namespace ROS2
         m_gnssMsg.status.status = sensor_msgs::msg::NavSatStatus::STATUS_SBAS_FIX;
         m_gnssMsg.status.service = sensor_msgs::msg::NavSatStatus::SERVICE_GALILEO;
 
-        m_gnssPublisher->publish(m_gnssMsg);
+        m_gnssPublisher->Publish(m_gnssMsg);
     }
 
     AZ::Transform ROS2GNSSSensorComponent::GetCurrentPose() const
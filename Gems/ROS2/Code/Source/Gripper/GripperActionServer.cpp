@@ -18,12 +18,12 @@
 
 namespace ROS2
 {
-    GripperActionServer::GripperActionServer(const AZStd::string& actionName, const AZ::EntityId& entityId)
+    GripperActionServer::GripperActionServer(
+        const std::shared_ptr<rclcpp::Node>& node, const AZStd::string& actionName, const AZ::EntityId& entityId)
         : m_entityId(entityId)
     {
-        auto ros2Node = ROS2Interface::Get()->GetNode();
         actionServer = rclcpp_action::create_server<GripperCommand>(
-            ros2Node,
+            node,
             actionName.data(),
             AZStd::bind(&GripperActionServer::GoalReceivedCallback, this, AZStd::placeholders::_1, AZStd::placeholders::_2),
             AZStd::bind(&GripperActionServer::GoalCancelledCallback, this, AZStd::placeholders::_1),
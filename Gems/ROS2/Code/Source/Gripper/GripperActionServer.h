@@ -28,9 +28,10 @@ namespace ROS2
         using GoalHandleGripperCommand = rclcpp_action::ServerGoalHandle<control_msgs::action::GripperCommand>;
 
         //! Create an action server for GripperAction action and bind Goal callbacks.
+        //! @param node Node to create the action server on.
         //! @param actionName Name of the action, similar to topic or service name.
         //! @param entityId entity which will execute callbacks through GripperRequestBus.
-        GripperActionServer(const AZStd::string& actionName, const AZ::EntityId& entityId);
+        GripperActionServer(const std::shared_ptr<rclcpp::Node>& node, const AZStd::string& actionName, const AZ::EntityId& entityId);
 
         //! Cancel the current goal.
         //! @param result Result to be passed to through action server to the client.
@@ -81,12 +81,12 @@ namespace ROS2
 
     void ROS2ImuSensorComponent::Activate()
     {
-        auto ros2Node = ROS2Interface::Get()->GetNode();
+        auto ros2Node = GetRobotNode();
         AZ_Assert(m_sensorConfiguration.m_publishersConfigurations.size() == 1, "Invalid configuration of publishers for IMU sensor");
         m_imuMsg.header.frame_id = GetFrameID().c_str();
         const auto publisherConfig = m_sensorConfiguration.m_publishersConfigurations[Internal::kImuMsgType];
         const auto fullTopic = ROS2Names::GetNamespacedName(GetNamespace(), publisherConfig.m_topic);
-        m_imuPublisher = ros2Node->create_publisher<sensor_msgs::msg::Imu>(fullTopic.data(), publisherConfig.GetQoS());
+        m_imuPublisher = SensorPublisher<sensor_msgs::msg::Imu>::Create(ros2Node, fullTopic, publisherConfig.GetQoS());
 
         m_linearAccelerationCovariance = ToDiagonalCovarianceMatrix(m_imuConfiguration.m_linearAccelerationVariance);
         m_angularVelocityCovariance = ToDiagonalCovarianceMatrix(m_imuConfiguration.m_angularVelocityVariance);
@@ -106,6 +106,7 @@ namespace ROS2
             {
                 OnPhysicsEvent(sceneHandle);
             });
+        m_imuPublisher->SetSensorProfile(GetSensorProfile());
     }
 
     void ROS2ImuSensorComponent::Deactivate()
@@ -187,7 +188,7 @@ namespace ROS2
             m_imuMsg.orientation_covariance = ROS2Conversions::ToROS2Covariance(m_orientationCovariance);
         }
         m_imuMsg.header.stamp = ROS2Interface::Get()->GetROSTimestamp();
-        this->m_imuPublisher->publish(m_imuMsg);
+        m_imuPublisher->Publish(m_imuMsg);
     }
 
     AZ::Matrix3x3 ROS2ImuSensorComponent::ToDiagonalCovarianceMatrix(const AZ::Vector3& variance)
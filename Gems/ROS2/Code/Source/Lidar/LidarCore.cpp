@@ -74,9 +74,7 @@ namespace ROS2
                 m_lidarConfiguration.m_lidarParameters.m_noiseParameters.m_distanceNoiseStdDevRisePerMeter);
         }
 
-        RaycastResultFlags requestedFlags = RaycastResultFlags::Ranges | RaycastResultFlags::Points;
-
-        LidarRaycasterRequestBus::Event(m_lidarRaycasterId, &LidarRaycasterRequestBus::Events::ConfigureRaycastResultFlags, requestedFlags);
+        ConfigureRaycastResultFlags(RaycastResultFlags::Ranges | RaycastResultFlags::Points);
 
         if (m_lidarConfiguration.m_lidarSystemFeatures & LidarSystemFeatures::CollisionLayers)
         {
@@ -92,6 +90,27 @@ namespace ROS2
                 m_lidarRaycasterId, &LidarRaycasterRequestBus::Events::ExcludeEntities, m_lidarConfiguration.m_excludedEntities);
         }
 
+        if (m_lidarConfiguration.m_lidarSystemFeatures & LidarSystemFeatures::OrganizedPointCloud)
+        {
+            const bool isOrganized = m_lidarConfiguration.m_organizedPointCloud && !m_lidarConfiguration.m_lidarParameters.m_is2D;
+            LidarRaycasterRequestBus::Event(
+                m_lidarRaycasterId,
+                &LidarRaycasterRequestBus::Events::ConfigureOrganizedPointCloud,
+                isOrganized ? m_lidarConfiguration.m_lidarParameters.m_layers : 0);
+        }
+
+        if (m_lidarConfiguration.m_lidarSystemFeatures & LidarSystemFeatures::AdaptiveDensity)
+        {
+            const bool isAdaptive = m_lidarConfiguration.m_adaptiveDensity && !m_lidarConfiguration.m_lidarParameters.m_is2D;
+            LidarRaycasterRequestBus::Event(
+                m_lidarRaycasterId,
+                &LidarRaycasterRequestBus::Events::ConfigureAdaptiveDensity,
+                m_lidarConfiguration.m_lidarParameters.m_layers,
+                m_lidarConfiguration.m_fullDensityRange,
+                isAdaptive ? m_lidarConfiguration.m_maxDecimation : 1,
+                isAdaptive ? m_lidarConfiguration.m_rayBudget : 0);
+        }
+
         if (m_lidarConfiguration.m_lidarSystemFeatures & LidarSystemFeatures::MaxRangePoints)
         {
             LidarRaycasterRequestBus::Event(
@@ -161,18 +180,69 @@ namespace ROS2
         return m_lidarRaycasterId;
     }
 
-    RaycastResult LidarCore::PerformRaycast()
+    AZ::Transform LidarCore::GetEntityWorldTM() const
     {
         AZ::Entity* entity = nullptr;
         AZ::ComponentApplicationBus::BroadcastResult(entity, &AZ::ComponentApplicationRequests::FindEntity, m_entityId);
         const auto entityTransform = entity->FindComponent<AzFramework::TransformComponent>();
+        return entityTransform->GetWorldTM();
+    }
 
+    bool LidarCore::PerformRaycastToPointCloud(sensor_msgs::msg::PointCloud2& message)
+    {
+        bool isWritten = false;
         LidarRaycasterRequestBus::EventResult(
-            m_lastScanResults, m_lidarRaycasterId, &LidarRaycasterRequestBus::Events::PerformRaycast, entityTransform->GetWorldTM());
-        if (m_lastScanResults.m_points.empty())
+            isWritten, m_lidarRaycasterId, &LidarRaycasterRequestBus::Events::PerformRaycastToPointCloud, GetEntityWorldTM(), message);
+        if (isWritten)
+        {
+            m_lastScanResults.m_points.clear();
+            m_lastScanResults.m_ranges.clear();
+        }
+        return isWritten;
+    }
+
+    bool LidarCore::AppendRaycastToPointCloud(size_t firstRay, size_t rayCount, sensor_msgs::msg::PointCloud2& message)
+    {
+        bool isWritten = false;
+        LidarRaycasterRequestBus::EventResult(
+            isWritten,
+            m_lidarRaycasterId,
+            &LidarRaycasterRequestBus::Events::AppendRaycastToPointCloud,
+            GetEntityWorldTM(),
+            firstRay,
+            rayCount,
+            message);
+        return isWritten;
+    }
+
+    RaycastStatistics LidarCore::GetRaycastStatistics() const
+    {
+        RaycastStatistics statistics;
+        LidarRaycasterRequestBus::EventResult(statistics, m_lidarRaycasterId, &LidarRaycasterRequestBus::Events::GetRaycastStatistics);
+        return statistics;
+    }
+
+    bool LidarCore::ScheduleRaycast()
+    {
+        bool isScheduled = false;
+        LidarRaycasterRequestBus::EventResult(
+            isScheduled, m_lidarRaycasterId, &LidarRaycasterRequestBus::Events::ScheduleRaycast, GetEntityWorldTM());
+        return isScheduled;
+    }
+
+    void LidarCore::ConfigureRaycastResultFlags(RaycastResultFlags flags)
+    {
+        m_resultFlags = flags;
+        LidarRaycasterRequestBus::Event(m_lidarRaycasterId, &LidarRaycasterRequestBus::Events::ConfigureRaycastResultFlags, flags);
+    }
+
+    const RaycastResult& LidarCore::PerformRaycast()
+    {
+        LidarRaycasterRequestBus::Event(
+            m_lidarRaycasterId, &LidarRaycasterRequestBus::Events::PerformRaycastInPlace, GetEntityWorldTM(), m_lastScanResults);
+        if ((m_resultFlags & RaycastResultFlags::Points) == RaycastResultFlags::Points && m_lastScanResults.m_points.empty())
         {
             AZ_TracePrintf("Lidar Sensor Component", "No results from raycast\n");
-            return RaycastResult();
         }
         return m_lastScanResults;
     }
@@ -12,6 +12,7 @@
 #include <AzCore/Serialization/SerializeContext.h>
 #include <ROS2/Lidar/LidarRegistrarBus.h>
 #include <ROS2/Lidar/LidarSystemBus.h>
+#include <sensor_msgs/msg/point_cloud2.hpp>
 
 #include "LidarRaycaster.h"
 #include "LidarSensorConfiguration.h"
@@ -36,8 +37,36 @@ namespace ROS2
         void Deinit();
 
         //! Perform a raycast.
-        //! @return Results of the raycast.
-        RaycastResult PerformRaycast();
+        //! The results are stored in buffers owned by the lidar and reused between scans.
+        //! @return Results of the raycast, valid until the next raycast.
+        const RaycastResult& PerformRaycast();
+
+        //! Perform a raycast, writing the points straight into a point cloud message.
+        //! The points are packed x, y, z floats in the lidar reference frame. Results are not kept for visualization.
+        //! @param message Message receiving the point cloud; its header is not modified.
+        //! @return False if the used raycaster does not support writing point clouds, in which case the message is untouched.
+        bool PerformRaycastToPointCloud(sensor_msgs::msg::PointCloud2& message);
+
+        //! Perform a raycast of a contiguous range of rays, appending the points to a point cloud message.
+        //! Rays are ordered increment-major, i.e. increment i covers rays [i * layers, (i + 1) * layers).
+        //! @param firstRay Index of the first ray to cast.
+        //! @param rayCount Number of consecutive rays to cast.
+        //! @param message Message the points are appended to; its header is not modified.
+        //! @return False if the used raycaster does not support writing point clouds, in which case the message is untouched.
+        bool AppendRaycastToPointCloud(size_t firstRay, size_t rayCount, sensor_msgs::msg::PointCloud2& message);
+
+        //! Schedule a raycast batched with other lidars. The scan is published by the raycaster.
+        //! @return False if the used raycaster cannot schedule raycasts.
+        bool ScheduleRaycast();
+
+        //! Select which results PerformRaycast returns. Both points and ranges are returned by default.
+        //! No results are needed when the raycaster publishes on its own and nothing is visualized.
+        //! @param flags Requested results.
+        void ConfigureRaycastResultFlags(RaycastResultFlags flags);
+
+        //! Get the ray counts of the used raycaster, e.g. to monitor the rays saved by adaptive density.
+        RaycastStatistics GetRaycastStatistics() const;
+
         //! Visualize the results of the last performed raycast.
         void VisualizeResults() const;
 
@@ -49,6 +78,7 @@ namespace ROS2
         LidarSensorConfiguration m_lidarConfiguration;
 
     private:
+        AZ::Transform GetEntityWorldTM() const;
         void ConnectToLidarRaycaster();
         void ConfigureLidarRaycaster();
 
@@ -60,6 +90,7 @@ namespace ROS2
 
         AZStd::vector<AZ::Vector3> m_lastRotations;
         RaycastResult m_lastScanResults;
+        RaycastResultFlags m_resultFlags{ RaycastResultFlags::Ranges | RaycastResultFlags::Points };
 
         AZ::EntityId m_entityId;
     };
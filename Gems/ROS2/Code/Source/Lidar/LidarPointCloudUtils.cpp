@@ -0,0 +1,59 @@
+/*
+ * Copyright (c) Contributors to the Open 3D Engine Project.
+ * For complete copyright and license terms please see the LICENSE at the root of this distribution.
+ *
+ * SPDX-License-Identifier: Apache-2.0 OR MIT
+ *
+ */
+
+#include <AzCore/Casting/numeric_cast.h>
+#include <Lidar/LidarPointCloudUtils.h>
+
+namespace ROS2
+{
+    void LidarPointCloudUtils::SetPackedXYZLayout(sensor_msgs::msg::PointCloud2& message)
+    {
+        static constexpr AZStd::array<const char*, 3> FieldNames = { "x", "y", "z" };
+
+        bool isLayoutSet = message.fields.size() == FieldNames.size();
+        for (size_t i = 0; isLayoutSet && i < FieldNames.size(); ++i)
+        {
+            isLayoutSet = message.fields[i].name == FieldNames[i] && message.fields[i].offset == i * sizeof(float);
+        }
+
+        if (!isLayoutSet)
+        {
+            message.fields.clear();
+            for (size_t i = 0; i < FieldNames.size(); ++i)
+            {
+                sensor_msgs::msg::PointField pf;
+                pf.name = FieldNames[i];
+                pf.offset = aznumeric_cast<uint32_t>(i * sizeof(float));
+                pf.datatype = sensor_msgs::msg::PointField::FLOAT32;
+                pf.count = 1;
+                message.fields.push_back(pf);
+            }
+        }
+
+        message.point_step = PointStep;
+        message.is_bigendian = false;
+    }
+
+    void LidarPointCloudUtils::ResizePoints(sensor_msgs::msg::PointCloud2& message, size_t pointCount)
+    {
+        message.height = 1;
+        message.width = aznumeric_cast<uint32_t>(pointCount);
+        message.row_step = message.width * message.point_step;
+        message.is_dense = true;
+        message.data.resize(message.row_step * message.height);
+    }
+
+    void LidarPointCloudUtils::ResizeOrganizedPoints(sensor_msgs::msg::PointCloud2& message, size_t height, size_t width)
+    {
+        message.height = aznumeric_cast<uint32_t>(height);
+        message.width = aznumeric_cast<uint32_t>(width);
+        message.row_step = message.width * message.point_step;
+        message.is_dense = false;
+        message.data.resize(message.row_step * message.height);
+    }
+} // namespace ROS2
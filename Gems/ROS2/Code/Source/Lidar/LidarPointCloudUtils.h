@@ -0,0 +1,62 @@
+/*
+ * Copyright (c) Contributors to the Open 3D Engine Project.
+ * For complete copyright and license terms please see the LICENSE at the root of this distribution.
+ *
+ * SPDX-License-Identifier: Apache-2.0 OR MIT
+ *
+ */
+#pragma once
+
+#include <AzCore/Math/Vector3.h>
+#include <AzCore/std/containers/array.h>
+#include <AzCore/std/limits.h>
+#include <sensor_msgs/msg/point_cloud2.hpp>
+
+namespace ROS2
+{
+    //! Utilities for writing lidar points straight into PointCloud2 messages.
+    //! Points are packed as three float32 fields (x, y, z) without padding, so a point takes 12 bytes on the wire.
+    namespace LidarPointCloudUtils
+    {
+        //! Size of a single packed point in bytes.
+        inline constexpr AZ::u32 PointStep = 3 * sizeof(float);
+
+        //! Set the x, y, z field layout of a message.
+        //! Fields are only rebuilt if they differ from the packed layout, so reused messages are not reallocated.
+        //! @param message Message to configure.
+        void SetPackedXYZLayout(sensor_msgs::msg::PointCloud2& message);
+
+        //! Resize the message to hold an unorganized cloud of the given number of points.
+        //! The data buffer keeps its capacity, so shrinking and growing up to the previous size does not allocate.
+        //! @param message Message with a packed layout (see SetPackedXYZLayout).
+        //! @param pointCount Number of points in the cloud.
+        void ResizePoints(sensor_msgs::msg::PointCloud2& message, size_t pointCount);
+
+        //! Resize the message to hold an organized cloud of height x width points.
+        //! Organized clouds hold invalid points, so they are marked as not dense.
+        //! @param message Message with a packed layout (see SetPackedXYZLayout).
+        //! @param height Number of rows (lidar layers).
+        //! @param width Number of columns (lidar increments).
+        void ResizeOrganizedPoints(sensor_msgs::msg::PointCloud2& message, size_t height, size_t width);
+
+        //! Write a point into the data buffer of a message.
+        //! @param message Message with a packed layout, large enough to hold the point.
+        //! @param index Index of the point in the cloud.
+        //! @param point Point coordinates.
+        inline void WritePoint(sensor_msgs::msg::PointCloud2& message, size_t index, const AZ::Vector3& point)
+        {
+            const AZStd::array<float, 3> coordinates{ point.GetX(), point.GetY(), point.GetZ() };
+            memcpy(message.data.data() + index * PointStep, coordinates.data(), PointStep);
+        }
+
+        //! Write an invalid point (NaN coordinates), marking a ray without a return in an organized cloud.
+        //! @param message Message with a packed layout, large enough to hold the point.
+        //! @param index Index of the point in the cloud.
+        inline void WriteInvalidPoint(sensor_msgs::msg::PointCloud2& message, size_t index)
+        {
+            constexpr float NaN = AZStd::numeric_limits<float>::quiet_NaN();
+            const AZStd::array<float, 3> coordinates{ NaN, NaN, NaN };
+            memcpy(message.data.data() + index * PointStep, coordinates.data(), PointStep);
+        }
+    } // namespace LidarPointCloudUtils
+} // namespace ROS2
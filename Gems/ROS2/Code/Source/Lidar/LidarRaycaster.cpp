@@ -7,16 +7,132 @@
  */
 
 #include <AzCore/Component/Component.h>
-#include <AzCore/std/smart_ptr/make_shared.h>
+#include <AzCore/Jobs/JobCompletion.h>
+#include <AzCore/Jobs/JobFunction.h>
+#include <AzCore/Math/MathUtils.h>
+#include <AzCore/Math/Simd.h>
+#include <AzCore/std/chrono/chrono.h>
+#include <AzCore/std/math.h>
+#include <AzCore/std/parallel/atomic.h>
 #include <AzFramework/Physics/Common/PhysicsSceneQueries.h>
+#include <AzFramework/Physics/Common/PhysicsSimulatedBody.h>
 #include <AzFramework/Physics/PhysicsScene.h>
 #include <AzFramework/Physics/PhysicsSystem.h>
 #include <AzFramework/Physics/Shape.h>
+#include <Lidar/LidarPointCloudUtils.h>
 #include <Lidar/LidarRaycaster.h>
+#include <Lidar/LidarScanScheduler.h>
 #include <Lidar/LidarTemplateUtils.h>
+#include <ROS2/ROS2Bus.h>
 
 namespace ROS2
 {
+    //! Collision layer indices that fit into the ignored layers bitmask.
+    static constexpr AZ::u32 MaxIgnoredCollisionLayers = 64;
+
+    //! Source of standard normal samples for the noise stage, producing four samples at a time with SIMD.
+    //! Each lane runs its own linear congruential generator, and pairs of uniform values become pairs of normal samples with
+    //! the Box-Muller transform.
+    class GaussianSampler
+    {
+    public:
+        using Vec4 = AZ::Simd::Vec4;
+
+        explicit GaussianSampler(AZ::u64 seed)
+        {
+            // SplitMix64 spreads the seed over the lanes, so that the lanes draw unrelated sequences.
+            int32_t laneSeeds[4];
+            for (int32_t& laneSeed : laneSeeds)
+            {
+                seed += 0x9E3779B97F4A7C15ull;
+                AZ::u64 mixed = (seed ^ (seed >> 30)) * 0xBF58476D1CE4E5B9ull;
+                mixed = (mixed ^ (mixed >> 27)) * 0x94D049BB133111EBull;
+                laneSeed = static_cast<int32_t>(mixed ^ (mixed >> 31));
+            }
+            m_state = Vec4::LoadUnaligned(laneSeeds);
+        }
+
+        //! Returns four independent standard normal samples.
+        Vec4::FloatType Sample4()
+        {
+            if (m_hasSpare)
+            {
+                m_hasSpare = false;
+                return m_spare;
+            }
+
+            // 1 - u keeps the logarithm argument in (0, 1].
+            const Vec4::FloatType one = Vec4::Splat(1.0f);
+            const Vec4::FloatType radius = Vec4::Sqrt(Vec4::Mul(Vec4::Splat(-2.0f), Log(Vec4::Sub(one, NextUniform()))));
+            const Vec4::FloatType angle = Vec4::Mul(Vec4::Splat(AZ::Constants::TwoPi), NextUniform());
+            Vec4::FloatType sin;
+            Vec4::FloatType cos;
+            Vec4::SinCos(angle, sin, cos);
+            m_spare = Vec4::Mul(radius, sin);
+            m_hasSpare = true;
+            return Vec4::Mul(radius, cos);
+        }
+
+        //! Writes standard normal samples to an array.
+        void Fill(float* samples, size_t count)
+        {
+            size_t i = 0;
+            for (; i + 4 <= count; i += 4)
+            {
+                Vec4::StoreUnaligned(samples + i, Sample4());
+            }
+            if (i < count)
+            {
+                float tail[4];
+                Vec4::StoreUnaligned(tail, Sample4());
+                AZStd::copy(tail, tail + (count - i), samples + i);
+            }
+        }
+
+    private:
+        //! Advances the generators of the lanes and returns uniform values in [0, 1), made of the 23 high bits of each state.
+        Vec4::FloatType NextUniform()
+        {
+            m_state = Vec4::Add(Vec4::Mul(m_state, Vec4::Splat(1664525)), Vec4::Splat(1013904223));
+            const Vec4::IntType mantissa = Vec4::And(Vec4::ShiftRight(m_state, 9), Vec4::Splat(0x007FFFFF));
+            return Vec4::Sub(Vec4::CastToFloat(Vec4::Or(mantissa, Vec4::Splat(0x3F800000))), Vec4::Splat(1.0f));
+        }
+
+        //! Natural logarithm of positive normal values: the exponent is read from the bits of the value, and the logarithm of the
+        //! mantissa m in [1, 2) comes from the series of atanh((m - 1) / (m + 1)), which stays within 1e-5 of the exact value.
+        static Vec4::FloatType Log(Vec4::FloatArgType value)
+        {
+            const Vec4::IntType bits = Vec4::CastToInt(value);
+            const Vec4::FloatType exponent = Vec4::ConvertToFloat(Vec4::Sub(Vec4::ShiftRight(bits, 23), Vec4::Splat(127)));
+            const Vec4::FloatType mantissa =
+                Vec4::CastToFloat(Vec4::Or(Vec4::And(bits, Vec4::Splat(0x007FFFFF)), Vec4::Splat(0x3F800000)));
+            const Vec4::FloatType one = Vec4::Splat(1.0f);
+            const Vec4::FloatType t = Vec4::Div(Vec4::Sub(mantissa, one), Vec4::Add(mantissa, one));
+            const Vec4::FloatType t2 = Vec4::Mul(t, t);
+            Vec4::FloatType series = Vec4::Madd(t2, Vec4::Splat(2.0f / 9.0f), Vec4::Splat(2.0f / 7.0f));
+            series = Vec4::Madd(t2, series, Vec4::Splat(2.0f / 5.0f));
+            series = Vec4::Madd(t2, series, Vec4::Splat(2.0f / 3.0f));
+            series = Vec4::Madd(t2, series, Vec4::Splat(2.0f));
+            return Vec4::Madd(exponent, Vec4::Splat(Ln2), Vec4::Mul(t, series));
+        }
+
+        static constexpr float Ln2 = 0.69314718f;
+
+        Vec4::IntType m_state;
+        Vec4::FloatType m_spare;
+        bool m_hasSpare{ false };
+    };
+
+    //! Each thread draws from its own generator, so that shards running as parallel jobs apply noise without synchronization.
+    static GaussianSampler& GetThreadGaussianSampler()
+    {
+        static AZStd::atomic<AZ::u64> samplerCount{ 0 };
+        thread_local GaussianSampler sampler(
+            static_cast<AZ::u64>(AZStd::chrono::steady_clock::now().time_since_epoch().count()) +
+            0x9E3779B97F4A7C15ull * ++samplerCount);
+        return sampler;
+    }
+
     static AzPhysics::SceneHandle GetPhysicsSceneFromEntityId(const AZ::EntityId& entityId)
     {
         auto* physicsSystem = AZ::Interface<AzPhysics::SystemInterface>::Get();
@@ -32,23 +148,53 @@ namespace ROS2
         return lidarPhysicsSceneHandle;
     }
 
-    LidarRaycaster::LidarRaycaster(LidarId busId, AZ::EntityId sceneEntityId)
+    LidarRaycaster::LidarRaycaster(LidarId busId, AZ::EntityId sceneEntityId, size_t workerCount, LidarScanScheduler* scanScheduler)
         : m_busId{ busId }
         , m_sceneEntityId{ sceneEntityId }
+        , m_workerCount{ AZStd::max<size_t>(workerCount, 1) }
+        , m_scanScheduler{ scanScheduler }
     {
+        LidarTemplateUtils::RotationsToLocalDirections({ AZ::Vector3::CreateZero() }, m_localRayDirections);
+        ConfigureRequests();
         ROS2::LidarRaycasterRequestBus::Handler::BusConnect(busId);
     }
 
     LidarRaycaster::LidarRaycaster(LidarRaycaster&& lidarRaycaster)
-        : m_busId{ lidarRaycaster.m_busId }
-        , m_sceneEntityId{ lidarRaycaster.m_sceneEntityId }
+        : m_rayRequests{ AZStd::move(lidarRaycaster.m_rayRequests) }
+        , m_rayHits{ AZStd::move(lidarRaycaster.m_rayHits) }
         , m_sceneHandle{ lidarRaycaster.m_sceneHandle }
+        , m_busId{ lidarRaycaster.m_busId }
+        , m_sceneEntityId{ lidarRaycaster.m_sceneEntityId }
+        , m_workerCount{ lidarRaycaster.m_workerCount }
+        , m_scanScheduler{ lidarRaycaster.m_scanScheduler }
         , m_resultFlags{ lidarRaycaster.m_resultFlags }
         , m_minRange{ lidarRaycaster.m_minRange }
         , m_range{ lidarRaycaster.m_range }
         , m_addMaxRangePoints{ lidarRaycaster.m_addMaxRangePoints }
-        , m_rayRotations{ AZStd::move(lidarRaycaster.m_rayRotations) }
-        , m_ignoredCollisionLayers{ lidarRaycaster.m_ignoredCollisionLayers }
+        , m_organizedLayerCount{ lidarRaycaster.m_organizedLayerCount }
+        , m_isAdaptiveDensityEnabled{ lidarRaycaster.m_isAdaptiveDensityEnabled }
+        , m_adaptiveDensityLayerCount{ lidarRaycaster.m_adaptiveDensityLayerCount }
+        , m_fullDensityRange{ lidarRaycaster.m_fullDensityRange }
+        , m_maxDecimation{ lidarRaycaster.m_maxDecimation }
+        , m_rayBudget{ lidarRaycaster.m_rayBudget }
+        , m_lastCastRanges{ AZStd::move(lidarRaycaster.m_lastCastRanges) }
+        , m_isRayCast{ AZStd::move(lidarRaycaster.m_isRayCast) }
+        , m_selectionPhase{ lidarRaycaster.m_selectionPhase }
+        , m_statistics{ lidarRaycaster.m_statistics }
+        , m_localRayDirections{ AZStd::move(lidarRaycaster.m_localRayDirections) }
+        , m_rayDirections{ AZStd::move(lidarRaycaster.m_rayDirections) }
+        , m_rayRequestBatch{ AZStd::move(lidarRaycaster.m_rayRequestBatch) }
+        , m_ignoredCollisionLayersMask{ lidarRaycaster.m_ignoredCollisionLayersMask }
+        , m_angularNoiseStdDev{ lidarRaycaster.m_angularNoiseStdDev }
+        , m_distanceNoiseStdDevBase{ lidarRaycaster.m_distanceNoiseStdDevBase }
+        , m_distanceNoiseStdDevRisePerMeter{ lidarRaycaster.m_distanceNoiseStdDevRisePerMeter }
+        , m_excludedEntities{ AZStd::move(lidarRaycaster.m_excludedEntities) }
+        , m_excludedBodyHandles{ AZStd::move(lidarRaycaster.m_excludedBodyHandles) }
+        , m_excludedBodies{ AZStd::move(lidarRaycaster.m_excludedBodies) }
+        , m_hasUnresolvedExclusions{ lidarRaycaster.m_hasUnresolvedExclusions }
+        , m_pointCloudPublisher{ AZStd::move(lidarRaycaster.m_pointCloudPublisher) }
+        , m_pointCloudFrameId{ AZStd::move(lidarRaycaster.m_pointCloudFrameId) }
+        , m_publisherTimestampNanoseconds{ lidarRaycaster.m_publisherTimestampNanoseconds }
     {
         lidarRaycaster.BusDisconnect();
         lidarRaycaster.m_busId = LidarId::CreateNull();
@@ -58,19 +204,25 @@ namespace ROS2
 
     LidarRaycaster::~LidarRaycaster()
     {
+        if (m_scanScheduler)
+        {
+            m_scanScheduler->Cancel(*this);
+        }
         ROS2::LidarRaycasterRequestBus::Handler::BusDisconnect();
     }
 
     void LidarRaycaster::ConfigureRayOrientations(const AZStd::vector<AZ::Vector3>& orientations)
     {
         ValidateRayOrientations(orientations);
-        m_rayRotations = orientations;
+        LidarTemplateUtils::RotationsToLocalDirections(orientations, m_localRayDirections);
+        ConfigureRequests();
     }
 
     void LidarRaycaster::ConfigureRayRange(float range)
     {
         ValidateRayRange(range);
         m_range = range;
+        ConfigureRequests();
     }
 
     void LidarRaycaster::ConfigureMinimumRayRange(float range)
@@ -83,87 +235,574 @@ namespace ROS2
         m_resultFlags = flags;
     }
 
-    AzPhysics::SceneQueryRequests LidarRaycaster::prepareRequests(
-        const AZ::Transform& lidarTransform, const AZStd::vector<AZ::Vector3>& rayDirections) const
+    void LidarRaycaster::ConfigureRequests()
     {
-        using AzPhysics::SceneQuery::HitFlags;
-        const AZ::Vector3& lidarPosition = lidarTransform.GetTranslation();
+        const size_t rayCount = m_localRayDirections.Size();
+        m_rayRequests.resize(rayCount);
+        m_rayHits.resize(rayCount);
+        m_rayDirections.Resize(rayCount);
+        // Rays without a previous range are cast at full density.
+        m_lastCastRanges.resize(rayCount, 0.0f);
+        m_isRayCast.resize(rayCount, 1);
 
-        AzPhysics::SceneQueryRequests requests;
-        requests.reserve(rayDirections.size());
-        for (const AZ::Vector3& direction : rayDirections)
+        m_excludedBodies.reset();
+        AZStd::vector<AzPhysics::SimulatedBodyHandle> excludedBodies;
+        for (const AzPhysics::SimulatedBodyHandle& bodyHandle : m_excludedBodyHandles)
+        {
+            if (bodyHandle != AzPhysics::InvalidSimulatedBodyHandle)
+            {
+                excludedBodies.push_back(bodyHandle);
+            }
+        }
+        if (!excludedBodies.empty())
         {
-            AZStd::shared_ptr<AzPhysics::RayCastRequest> request = AZStd::make_shared<AzPhysics::RayCastRequest>();
-            request->m_start = lidarPosition;
-            request->m_direction = direction;
-            request->m_distance = m_range;
-            request->m_reportMultipleHits = false;
+            m_excludedBodies = AZStd::make_shared<const AZStd::vector<AzPhysics::SimulatedBodyHandle>>(AZStd::move(excludedBodies));
+        }
 
-            request->m_filterCallback = [ignoredCollisionLayers = this->m_ignoredCollisionLayers](
-                                            const AzPhysics::SimulatedBody* simBody, const Physics::Shape* shape)
+        // A single filter, capturing only the layer bitmask and the shared excluded bodies, is used by all requests.
+        // It is not installed at all if nothing is filtered out, so that the physics engine can skip the pre-filtering.
+        decltype(AzPhysics::RayCastRequest::m_filterCallback) filterCallback;
+        if (m_ignoredCollisionLayersMask != 0 || m_excludedBodies)
+        {
+            filterCallback = [ignoredLayersMask = m_ignoredCollisionLayersMask, excludedBodies = m_excludedBodies](
+                                 const AzPhysics::SimulatedBody* simBody, const Physics::Shape* shape)
             {
-                if (ignoredCollisionLayers.contains(shape->GetCollisionLayer().GetIndex()))
+                const AZ::u64 layerBit = AZ::u64{ 1 } << shape->GetCollisionLayer().GetIndex();
+                if (ignoredLayersMask & layerBit)
+                {
+                    return AzPhysics::SceneQuery::QueryHitType::None;
+                }
+
+                // Only a handful of entities is excluded in practice, for which a linear search beats any lookup structure.
+                if (excludedBodies &&
+                    AZStd::find(excludedBodies->begin(), excludedBodies->end(), simBody->m_bodyHandle) != excludedBodies->end())
                 {
                     return AzPhysics::SceneQuery::QueryHitType::None;
                 }
+
                 return AzPhysics::SceneQuery::QueryHitType::Block;
             };
+        }
 
-            requests.emplace_back(AZStd::move(request));
+        for (AzPhysics::RayCastRequest& request : m_rayRequests)
+        {
+            request.m_distance = m_range;
+            request.m_reportMultipleHits = false;
+            request.m_filterCallback = filterCallback;
+        }
+
+        // Batch queries take shared requests. These alias the stored requests without owning them, so that building a batch
+        // neither allocates nor counts references. They are rebuilt here, as resizing may have moved the stored requests.
+        m_rayRequestBatch.resize(rayCount);
+        for (size_t i = 0; i < rayCount; ++i)
+        {
+            m_rayRequestBatch[i] =
+                AZStd::shared_ptr<AzPhysics::SceneQueryRequest>(AZStd::shared_ptr<AzPhysics::SceneQueryRequest>(), &m_rayRequests[i]);
         }
-        return requests;
     }
 
-    RaycastResult LidarRaycaster::PerformRaycast(const AZ::Transform& lidarTransform)
+    bool LidarRaycaster::ResolveExcludedBodies()
     {
-        AZ_Assert(!m_rayRotations.empty(), "Ray poses are not configured. Unable to Perform a raycast.");
-        AZ_Assert(m_range > 0.0f, "Ray range is not configured. Unable to Perform a raycast.");
+        if (!m_hasUnresolvedExclusions)
+        {
+            return false;
+        }
+
+        auto* physicsSystem = AZ::Interface<AzPhysics::SystemInterface>::Get();
+        bool isAnyResolved = false;
+        m_hasUnresolvedExclusions = false;
+        for (size_t i = 0; i < m_excludedEntities.size(); ++i)
+        {
+            if (m_excludedBodyHandles[i] != AzPhysics::InvalidSimulatedBodyHandle)
+            {
+                continue;
+            }
+
+            // Excluded entities may activate after the lidar, in which case they do not have a body yet.
+            const AzPhysics::SimulatedBodyHandle bodyHandle =
+                physicsSystem->FindAttachedBodyHandleFromEntityId(m_excludedEntities[i]).second;
+            if (bodyHandle != AzPhysics::InvalidSimulatedBodyHandle)
+            {
+                m_excludedBodyHandles[i] = bodyHandle;
+                isAnyResolved = true;
+            }
+            else
+            {
+                m_hasUnresolvedExclusions = true;
+            }
+        }
+
+        return isAnyResolved;
+    }
+
+    void LidarRaycaster::ApplyAngularNoise(size_t first, size_t last)
+    {
+        if (m_angularNoiseStdDev <= 0.0f)
+        {
+            return;
+        }
+
+        // Adding an isotropic Gaussian offset to a unit direction deflects it by an angle with the given standard deviation
+        // (for small angles); the offset along the direction only changes the length and is removed by normalization.
+        using AZ::Simd::Vec4;
+        GaussianSampler& sampler = GetThreadGaussianSampler();
+        float* x = m_rayDirections.m_x.data();
+        float* y = m_rayDirections.m_y.data();
+        float* z = m_rayDirections.m_z.data();
+        const Vec4::FloatType stdDev = Vec4::Splat(m_angularNoiseStdDev);
+        const Vec4::FloatType one = Vec4::Splat(1.0f);
+        size_t i = first;
+        for (; i + 4 <= last; i += 4)
+        {
+            const Vec4::FloatType noisyX = Vec4::Madd(stdDev, sampler.Sample4(), Vec4::LoadUnaligned(x + i));
+            const Vec4::FloatType noisyY = Vec4::Madd(stdDev, sampler.Sample4(), Vec4::LoadUnaligned(y + i));
+            const Vec4::FloatType noisyZ = Vec4::Madd(stdDev, sampler.Sample4(), Vec4::LoadUnaligned(z + i));
+            const Vec4::FloatType lengthSquared =
+                Vec4::Madd(noisyZ, noisyZ, Vec4::Madd(noisyY, noisyY, Vec4::Mul(noisyX, noisyX)));
+            const Vec4::FloatType inverseLength = Vec4::Div(one, Vec4::Sqrt(lengthSquared));
+            Vec4::StoreUnaligned(x + i, Vec4::Mul(noisyX, inverseLength));
+            Vec4::StoreUnaligned(y + i, Vec4::Mul(noisyY, inverseLength));
+            Vec4::StoreUnaligned(z + i, Vec4::Mul(noisyZ, inverseLength));
+        }
+
+        float samples[12];
+        sampler.Fill(samples, 3 * (last - i));
+        for (size_t sample = 0; i < last; ++i, sample += 3)
+        {
+            const AZ::Vector3 noise(samples[sample], samples[sample + 1], samples[sample + 2]);
+            const AZ::Vector3 normalized = (AZ::Vector3(x[i], y[i], z[i]) + m_angularNoiseStdDev * noise).GetNormalized();
+            x[i] = normalized.GetX();
+            y[i] = normalized.GetY();
+            z[i] = normalized.GetZ();
+        }
+    }
+
+    void LidarRaycaster::ApplyDistanceNoise(size_t first, size_t last)
+    {
+        if (m_distanceNoiseStdDevBase <= 0.0f && m_distanceNoiseStdDevRisePerMeter <= 0.0f)
+        {
+            return;
+        }
+
+        // Samples are drawn four at a time into a buffer of the thread, since hits are scattered over separate result structures.
+        thread_local AZStd::vector<float> samples;
+        samples.resize(last - first);
+        GetThreadGaussianSampler().Fill(samples.data(), samples.size());
+        for (size_t i = first; i < last; ++i)
+        {
+            AzPhysics::SceneQueryHits& requestResult = m_rayHits[i];
+            if (!requestResult)
+            {
+                continue;
+            }
 
+            // Misses are left untouched, so that max range points stay at the configured range.
+            AzPhysics::SceneQueryHit& hit = requestResult.m_hits[0];
+            const float stdDev = m_distanceNoiseStdDevBase + m_distanceNoiseStdDevRisePerMeter * hit.m_distance;
+            hit.m_distance += stdDev * samples[i - first];
+            hit.m_position = m_rayRequests[i].m_start + m_rayRequests[i].m_direction * hit.m_distance;
+        }
+    }
+
+    AZ::Vector3 LidarRaycaster::GetCastLocalDirection(const AZ::Quaternion& inverseLidarRotation, size_t rayIndex) const
+    {
+        if (m_angularNoiseStdDev > 0.0f)
+        {
+            return inverseLidarRotation.TransformVector(m_rayRequests[rayIndex].m_direction);
+        }
+        return m_localRayDirections.GetDirection(rayIndex);
+    }
+
+    AzPhysics::SceneHandle LidarRaycaster::AcquireSceneHandle() const
+    {
+        return GetPhysicsSceneFromEntityId(m_sceneEntityId);
+    }
+
+    AzPhysics::SceneHandle LidarRaycaster::GetSceneHandle()
+    {
         if (m_sceneHandle == AzPhysics::InvalidSceneHandle)
         {
-            m_sceneHandle = GetPhysicsSceneFromEntityId(m_sceneEntityId);
+            m_sceneHandle = AcquireSceneHandle();
+        }
+        return m_sceneHandle;
+    }
+
+    AzPhysics::SceneQueryHitsList LidarRaycaster::QueryBatch(const AzPhysics::SceneQueryRequests& requests) const
+    {
+        return AZ::Interface<AzPhysics::SceneInterface>::Get()->QuerySceneBatch(m_sceneHandle, requests);
+    }
+
+    void LidarRaycaster::PrepareRequests(const AZ::Transform& lidarTransform, size_t first, size_t last)
+    {
+        LidarTemplateUtils::RotateDirections(m_localRayDirections, lidarTransform.GetRotation(), m_rayDirections, first, last);
+        ApplyAngularNoise(first, last);
+
+        const AZ::Vector3& lidarPosition = lidarTransform.GetTranslation();
+        for (size_t i = first; i < last; ++i)
+        {
+            m_rayRequests[i].m_start = lidarPosition;
+            m_rayRequests[i].m_direction = m_rayDirections.GetDirection(i);
+        }
+    }
+
+    void LidarRaycaster::AppendCastRequests(
+        size_t first, size_t last, AzPhysics::SceneQueryRequests& requests, AZStd::vector<size_t>& rayIndices)
+    {
+        for (size_t i = first; i < last; ++i)
+        {
+            if (IsRaySkipped(i))
+            {
+                // Hits of skipped rays are cleared, so that stale hits of earlier scans are never reported.
+                m_rayHits[i].m_hits.clear();
+                continue;
+            }
+            requests.push_back(m_rayRequestBatch[i]);
+            rayIndices.push_back(i);
+        }
+    }
+
+    void LidarRaycaster::StoreHits(AzPhysics::SceneQueryHitsList& hits, size_t firstHit, const size_t* rayIndices, size_t count)
+    {
+        AZ_Assert(firstHit + count <= hits.size(), "A batch query returned fewer hits than it had requests.");
+        for (size_t i = 0; i < count; ++i)
+        {
+            m_rayHits[rayIndices[i]] = AZStd::move(hits[firstHit + i]);
+        }
+    }
+
+    void LidarRaycaster::CompleteRays(size_t first, size_t last)
+    {
+        if (m_isAdaptiveDensityEnabled)
+        {
+            for (size_t i = first; i < last; ++i)
+            {
+                if (m_isRayCast[i])
+                {
+                    m_lastCastRanges[i] = m_rayHits[i] ? m_rayHits[i].m_hits[0].m_distance : m_range;
+                }
+            }
+        }
+        ApplyDistanceNoise(first, last);
+    }
+
+    void LidarRaycaster::CastShard(const AZ::Transform& lidarTransform, size_t first, size_t last)
+    {
+        PrepareRequests(lidarTransform, first, last);
+
+        // The rays of a shard are cast by one batch query, which sets up the query and locks the scene once for all of them.
+        // Selected rays of adaptive density are gathered into the same batch. The buffers of the thread keep their capacity.
+        thread_local AzPhysics::SceneQueryRequests requests;
+        thread_local AZStd::vector<size_t> rayIndices;
+        requests.clear();
+        rayIndices.clear();
+        AppendCastRequests(first, last, requests, rayIndices);
+        if (!requests.empty())
+        {
+            AzPhysics::SceneQueryHitsList hits = QueryBatch(requests);
+            StoreHits(hits, 0, rayIndices.data(), rayIndices.size());
+        }
+        CompleteRays(first, last);
+    }
+
+    AZ::u32 LidarRaycaster::GetDecimationFactor(float range) const
+    {
+        AZ::u32 factor = 1;
+        while (factor < m_maxDecimation && range >= m_fullDensityRange * aznumeric_cast<float>(factor))
+        {
+            factor *= 2;
+        }
+        return AZStd::min(factor, m_maxDecimation);
+    }
+
+    void LidarRaycaster::SelectRays(size_t first, size_t last)
+    {
+        if (!m_isAdaptiveDensityEnabled)
+        {
+            m_statistics.m_castRayCount += last - first;
+            return;
+        }
+
+        ++m_selectionPhase;
+        size_t selectedCount = 0;
+        for (size_t i = first; i < last; ++i)
+        {
+            const size_t increment = i / m_adaptiveDensityLayerCount;
+            const bool isCast = (increment + m_selectionPhase) % GetDecimationFactor(m_lastCastRanges[i]) == 0;
+            m_isRayCast[i] = isCast ? 1 : 0;
+            selectedCount += isCast ? 1 : 0;
+        }
+
+        // The budget applies to a full scan, so partial casts (of spinning lidars) get their share of it.
+        const size_t budget = m_rayBudget > 0 ? AZStd::max<size_t>(m_rayBudget * (last - first) / m_rayRequests.size(), 1) : 0;
+        if (budget > 0 && selectedCount > budget)
+        {
+            // Thinning keeps every stride-th selected ray, so that the density is reduced evenly over the whole scan.
+            const size_t stride = (selectedCount + budget - 1) / budget;
+            size_t selectedIndex = m_selectionPhase;
+            selectedCount = 0;
+            for (size_t i = first; i < last; ++i)
+            {
+                if (m_isRayCast[i])
+                {
+                    const bool isKept = selectedIndex++ % stride == 0;
+                    m_isRayCast[i] = isKept ? 1 : 0;
+                    selectedCount += isKept ? 1 : 0;
+                }
+            }
+        }
+
+        m_statistics.m_castRayCount += selectedCount;
+        m_statistics.m_savedRayCount += (last - first) - selectedCount;
+    }
+
+    void LidarRaycaster::CastShards(const AZ::Transform& lidarTransform, size_t first, size_t last)
+    {
+        const size_t rayCount = last - first;
+        const size_t shardCount = AZStd::min(m_workerCount, AZStd::max<size_t>(rayCount / MinRaysPerShard, 1));
+        if (shardCount <= 1)
+        {
+            CastShard(lidarTransform, first, last);
+            return;
         }
 
-        const AZStd::vector<AZ::Vector3> rayDirections = LidarTemplateUtils::RotationsToDirections(m_rayRotations, lidarTransform);
-        AzPhysics::SceneQueryRequests requests = prepareRequests(lidarTransform, rayDirections);
+        // Rays are ordered increment-major, so a contiguous range of rays is an azimuth sector of the scan.
+        // Each shard writes directions, requests and hits only in its own slice, which leaves the results in the original order.
+        const size_t shardSize = (rayCount + shardCount - 1) / shardCount;
+        AZ::JobCompletion completion;
+        for (size_t shardFirst = first + shardSize; shardFirst < last; shardFirst += shardSize)
+        {
+            const size_t shardLast = AZStd::min(shardFirst + shardSize, last);
+            AZ::Job* job = AZ::CreateJobFunction(
+                [this, &lidarTransform, shardFirst, shardLast]()
+                {
+                    CastShard(lidarTransform, shardFirst, shardLast);
+                },
+                true);
+            job->SetDependent(&completion);
+            job->Start();
+        }
+
+        // The calling thread handles the first shard instead of idling.
+        CastShard(lidarTransform, first, first + shardSize);
+        completion.StartAndWaitForCompletion();
+    }
 
+    RaycastResult LidarRaycaster::PerformRaycast(const AZ::Transform& lidarTransform)
+    {
         RaycastResult results;
+        PerformRaycastInPlace(lidarTransform, results);
+        return results;
+    }
+
+    void LidarRaycaster::CastScan(const AZ::Transform& lidarTransform, size_t first, size_t last)
+    {
+        PrepareScan(first, last);
+        CastShards(lidarTransform, first, last);
+    }
+
+    void LidarRaycaster::PrepareScan(size_t first, size_t last)
+    {
+        AZ_Assert(m_localRayDirections.Size() > 0, "Ray poses are not configured. Unable to Perform a raycast.");
+        AZ_Assert(m_range > 0.0f, "Ray range is not configured. Unable to Perform a raycast.");
+
+        GetSceneHandle();
+        if (ResolveExcludedBodies())
+        {
+            ConfigureRequests();
+        }
+
+        ++m_statistics.m_castCount;
+        SelectRays(first, last);
+    }
+
+    void LidarRaycaster::PerformRaycastInPlace(const AZ::Transform& lidarTransform, RaycastResult& results)
+    {
+        CastScan(lidarTransform, 0, m_rayRequests.size());
+        if (m_pointCloudPublisher)
+        {
+            PublishScan(lidarTransform, m_publisherTimestampNanoseconds);
+        }
+        GatherResults(lidarTransform, results);
+    }
+
+    bool LidarRaycaster::ScheduleRaycast(const AZ::Transform& lidarTransform)
+    {
+        if (!m_scanScheduler || !m_pointCloudPublisher)
+        {
+            return false;
+        }
+
+        m_scanScheduler->Schedule(*this, lidarTransform, m_publisherTimestampNanoseconds);
+        return true;
+    }
+
+    void LidarRaycaster::CompleteScheduledScan(const AZ::Transform& lidarTransform, AZ::u64 timestampNanoseconds)
+    {
+        if (m_pointCloudPublisher)
+        {
+            PublishScan(lidarTransform, timestampNanoseconds);
+        }
+    }
+
+    void LidarRaycaster::PublishScan(const AZ::Transform& lidarTransform, AZ::u64 timestampNanoseconds)
+    {
+        sensor_msgs::msg::PointCloud2* message = m_pointCloudPublisher->AcquireMessage();
+        if (!message)
+        {
+            AZ_WarningOnce("LidarRaycaster", false, "Point cloud publishing falls behind the lidar, dropping scans.");
+            return;
+        }
+
+        message->header.frame_id = m_pointCloudFrameId.c_str();
+        message->header.stamp.sec = aznumeric_cast<int32_t>(timestampNanoseconds / 1'000'000'000);
+        message->header.stamp.nanosec = aznumeric_cast<uint32_t>(timestampNanoseconds % 1'000'000'000);
+        LidarPointCloudUtils::ResizePoints(*message, 0);
+        WritePointCloud(lidarTransform, 0, m_rayRequests.size(), *message);
+        m_pointCloudPublisher->Submit(message);
+    }
+
+    bool LidarRaycaster::PerformRaycastToPointCloud(const AZ::Transform& lidarTransform, sensor_msgs::msg::PointCloud2& message)
+    {
+        LidarPointCloudUtils::SetPackedXYZLayout(message);
+        LidarPointCloudUtils::ResizePoints(message, 0);
+        return AppendRaycastToPointCloud(lidarTransform, 0, m_rayRequests.size(), message);
+    }
+
+    bool LidarRaycaster::AppendRaycastToPointCloud(
+        const AZ::Transform& lidarTransform, size_t firstRay, size_t rayCount, sensor_msgs::msg::PointCloud2& message)
+    {
+        AZ_Assert(firstRay + rayCount <= m_rayRequests.size(), "Requested rays exceed the configured ray count.");
+        const size_t lastRay = AZStd::min(firstRay + rayCount, m_rayRequests.size());
+        CastScan(lidarTransform, firstRay, lastRay);
+        WritePointCloud(lidarTransform, firstRay, lastRay, message);
+        return true;
+    }
+
+    void LidarRaycaster::WritePointCloud(
+        const AZ::Transform& lidarTransform, size_t first, size_t last, sensor_msgs::msg::PointCloud2& message) const
+    {
+        LidarPointCloudUtils::SetPackedXYZLayout(message);
+        if (m_organizedLayerCount > 0)
+        {
+            WriteOrganizedPointCloud(lidarTransform, first, last, message);
+            return;
+        }
+
+        // The buffer is sized for all cast rays first and trimmed to the number of points afterwards, keeping its capacity.
+        size_t pointCount = message.width;
+        LidarPointCloudUtils::ResizePoints(message, pointCount + last - first);
+
+        const AZ::Quaternion inverseLidarRotation = lidarTransform.GetRotation().GetInverseFast();
+        const float maxRange = m_addMaxRangePoints ? m_range : AZStd::numeric_limits<float>::infinity();
+        for (size_t i = first; i < last; ++i)
+        {
+            const auto& requestResult = m_rayHits[i];
+            const float hitRange = requestResult ? requestResult.m_hits[0].m_distance : maxRange;
+            if (IsRaySkipped(i) || hitRange < m_minRange || AZStd::isinf(hitRange))
+            {
+                continue;
+            }
+
+            // Points are computed in the lidar frame directly, without a round trip through world coordinates.
+            LidarPointCloudUtils::WritePoint(message, pointCount++, GetCastLocalDirection(inverseLidarRotation, i) * hitRange);
+        }
+
+        LidarPointCloudUtils::ResizePoints(message, pointCount);
+    }
+
+    void LidarRaycaster::WriteOrganizedPointCloud(
+        const AZ::Transform& lidarTransform, size_t first, size_t last, sensor_msgs::msg::PointCloud2& message) const
+    {
+        // The layout is fixed by the ray pattern, so the buffer is only resized when the message is used for the first time
+        // (or was used for an unorganized cloud). Rays of a partial cast fill their own columns and leave the rest untouched.
+        const size_t height = m_organizedLayerCount;
+        const size_t width = m_rayRequests.size() / height;
+        if (message.height != height || message.width != width)
+        {
+            LidarPointCloudUtils::ResizeOrganizedPoints(message, height, width);
+        }
+
+        const AZ::Quaternion inverseLidarRotation = lidarTransform.GetRotation().GetInverseFast();
+        const float maxRange = m_addMaxRangePoints ? m_range : AZStd::numeric_limits<float>::infinity();
+        for (size_t i = first; i < last; ++i)
+        {
+            // Rays are ordered increment-major, while rows of the cloud are layers.
+            const size_t pointIndex = (i % height) * width + i / height;
+            const auto& requestResult = m_rayHits[i];
+            const float hitRange = requestResult ? requestResult.m_hits[0].m_distance : maxRange;
+            if (IsRaySkipped(i) || hitRange < m_minRange || AZStd::isinf(hitRange))
+            {
+                LidarPointCloudUtils::WriteInvalidPoint(message, pointIndex);
+            }
+            else
+            {
+                LidarPointCloudUtils::WritePoint(message, pointIndex, GetCastLocalDirection(inverseLidarRotation, i) * hitRange);
+            }
+        }
+    }
+
+    void LidarRaycaster::GatherResults(const AZ::Transform& lidarTransform, RaycastResult& results) const
+    {
         const bool handlePoints = (m_resultFlags & RaycastResultFlags::Points) == RaycastResultFlags::Points;
         const bool handleRanges = (m_resultFlags & RaycastResultFlags::Ranges) == RaycastResultFlags::Ranges;
+
+        // Clearing keeps the capacity of the caller's buffers, so no allocation happens when they are reused.
+        results.m_points.clear();
+        results.m_ranges.clear();
+        if (!handlePoints && !handleRanges)
+        {
+            return;
+        }
         if (handlePoints)
         {
-            results.m_points.reserve(rayDirections.size());
+            results.m_points.reserve(m_rayHits.size());
         }
-        if (handleRanges)
+        const bool isRangeImage = handleRanges && m_organizedLayerCount > 0;
+        const size_t rangeImageWidth = isRangeImage ? m_rayHits.size() / m_organizedLayerCount : 0;
+        if (isRangeImage)
         {
-            results.m_ranges.reserve(rayDirections.size());
+            results.m_ranges.resize(m_rayHits.size());
+        }
+        else if (handleRanges)
+        {
+            results.m_ranges.reserve(m_rayHits.size());
         }
 
-        auto* sceneInterface = AZ::Interface<AzPhysics::SceneInterface>::Get();
-        auto requestResults = sceneInterface->QuerySceneBatch(m_sceneHandle, requests);
-        AZ_Assert(requestResults.size() == rayDirections.size(), "Request size should be equal to directions size");
-        const auto localTransform =
-            AZ::Transform::CreateFromQuaternionAndTranslation(lidarTransform.GetRotation(), lidarTransform.GetTranslation()).GetInverse();
+        const AZ::Quaternion inverseLidarRotation = lidarTransform.GetRotation().GetInverseFast();
         const float maxRange = m_addMaxRangePoints ? m_range : AZStd::numeric_limits<float>::infinity();
 
-        for (int i = 0; i < requestResults.size(); i++)
+        for (size_t i = 0; i < m_rayHits.size(); ++i)
         {
-            const auto& requestResult = requestResults[i];
+            const auto& requestResult = m_rayHits[i];
             float hitRange = requestResult ? requestResult.m_hits[0].m_distance : maxRange;
-            if (hitRange < m_minRange)
+            if (IsRaySkipped(i))
+            {
+                // Skipped rays have no range, and produce no point.
+                hitRange = AZStd::numeric_limits<float>::quiet_NaN();
+            }
+            else if (hitRange < m_minRange)
             {
                 hitRange = -AZStd::numeric_limits<float>::infinity();
             }
-            if (handleRanges)
+            if (isRangeImage)
+            {
+                const size_t pixelIndex = (i % m_organizedLayerCount) * rangeImageWidth + i / m_organizedLayerCount;
+                results.m_ranges[pixelIndex] = AZStd::isinf(hitRange) ? AZStd::numeric_limits<float>::quiet_NaN() : hitRange;
+            }
+            else if (handleRanges)
             {
                 results.m_ranges.push_back(hitRange);
             }
             if (handlePoints)
             {
+                if (AZStd::isnan(hitRange))
+                {
+                    continue;
+                }
                 if (hitRange == maxRange)
                 {
-                    // to properly visualize max points they need to be transformed to local coordinate system before applying maxRange
-                    const AZ::Vector3 maxPoint = lidarTransform.TransformPoint(localTransform.TransformVector(rayDirections[i]) * hitRange);
+                    // to properly visualize max points the range is applied to the direction in the local coordinate system
+                    const AZ::Vector3 maxPoint = lidarTransform.TransformPoint(GetCastLocalDirection(inverseLidarRotation, i) * hitRange);
                     results.m_points.push_back(maxPoint);
                 }
                 else if (!AZStd::isinf(hitRange))
@@ -173,16 +812,91 @@ namespace ROS2
                 }
             }
         }
-
-        return results;
     }
 
     void LidarRaycaster::ConfigureIgnoredCollisionLayers(const AZStd::unordered_set<AZ::u32>& layerIndices)
     {
-        m_ignoredCollisionLayers = layerIndices;
+        m_ignoredCollisionLayersMask = 0;
+        for (const AZ::u32 layerIndex : layerIndices)
+        {
+            AZ_Assert(layerIndex < MaxIgnoredCollisionLayers, "Collision layer index %u is out of range.", layerIndex);
+            m_ignoredCollisionLayersMask |= AZ::u64{ 1 } << layerIndex;
+        }
+        ConfigureRequests();
     }
+
     void LidarRaycaster::ConfigureMaxRangePointAddition(bool addMaxRangePoints)
     {
         m_addMaxRangePoints = addMaxRangePoints;
     }
+
+    void LidarRaycaster::ConfigureNoiseParameters(
+        float angularNoiseStdDev, float distanceNoiseStdDevBase, float distanceNoiseStdDevRisePerMeter)
+    {
+        m_angularNoiseStdDev = AZ::DegToRad(angularNoiseStdDev);
+        m_distanceNoiseStdDevBase = distanceNoiseStdDevBase;
+        m_distanceNoiseStdDevRisePerMeter = distanceNoiseStdDevRisePerMeter;
+    }
+
+    void LidarRaycaster::ConfigurePointCloudPublisher(
+        const AZStd::string& topicName, const AZStd::string& frameId, const QoS& qoSPolicy)
+    {
+        // Without the namespace of the lidar, point clouds are published on the central node.
+        ConfigureRobotPointCloudPublisher(AZStd::string(), topicName, frameId, qoSPolicy);
+    }
+
+    void LidarRaycaster::ConfigureRobotPointCloudPublisher(
+        const AZStd::string& robotNamespace, const AZStd::string& topicName, const AZStd::string& frameId, const QoS& qoSPolicy)
+    {
+        m_pointCloudPublisher.reset();
+        auto ros2Node = ROS2Interface::Get()->GetRobotNode(robotNamespace);
+        m_pointCloudPublisher = SensorPublisher<sensor_msgs::msg::PointCloud2>::Create(ros2Node, topicName, qoSPolicy.GetQoS());
+        m_pointCloudFrameId = frameId;
+    }
+
+    void LidarRaycaster::UpdatePublisherTimestamp(AZ::u64 timestampNanoseconds)
+    {
+        m_publisherTimestampNanoseconds = timestampNanoseconds;
+    }
+
+    bool LidarRaycaster::CanHandlePublishing()
+    {
+        // Points are written in the lidar frame with all configured features (noise, max range points), so there is no
+        // configuration that requires the sensor component to publish instead.
+        return true;
+    }
+
+    void LidarRaycaster::ConfigureOrganizedPointCloud(AZ::u32 layerCount)
+    {
+        AZ_Assert(
+            layerCount == 0 || m_rayRequests.size() % layerCount == 0,
+            "Ray count %zu is not a multiple of the layer count %u.",
+            m_rayRequests.size(),
+            layerCount);
+        m_organizedLayerCount = layerCount;
+    }
+
+    void LidarRaycaster::ConfigureAdaptiveDensity(AZ::u32 layerCount, float fullDensityRange, AZ::u32 maxDecimation, AZ::u32 rayBudget)
+    {
+        m_isAdaptiveDensityEnabled = maxDecimation > 1 || rayBudget > 0;
+        m_adaptiveDensityLayerCount = AZStd::max<AZ::u32>(layerCount, 1);
+        m_fullDensityRange = fullDensityRange;
+        m_maxDecimation = AZStd::max<AZ::u32>(maxDecimation, 1);
+        m_rayBudget = rayBudget;
+        m_isRayCast.assign(m_rayRequests.size(), 1);
+    }
+
+    RaycastStatistics LidarRaycaster::GetRaycastStatistics()
+    {
+        return m_statistics;
+    }
+
+    void LidarRaycaster::ExcludeEntities(const AZStd::vector<AZ::EntityId>& excludedEntities)
+    {
+        m_excludedEntities = excludedEntities;
+        m_excludedBodyHandles.assign(excludedEntities.size(), AzPhysics::InvalidSimulatedBodyHandle);
+        m_hasUnresolvedExclusions = !excludedEntities.empty();
+        ResolveExcludedBodies();
+        ConfigureRequests();
+    }
 } // namespace ROS2
@@ -11,17 +11,38 @@
 #include <AzCore/Math/Transform.h>
 #include <AzCore/Math/Vector3.h>
 #include <AzCore/std/containers/vector.h>
+#include <AzCore/std/smart_ptr/shared_ptr.h>
+#include <AzCore/std/smart_ptr/unique_ptr.h>
+#include <AzCore/std/string/string.h>
+#include <AzFramework/Physics/Common/PhysicsSceneQueries.h>
 #include <AzFramework/Physics/PhysicsScene.h>
+#include <Lidar/LidarTemplateUtils.h>
 #include <ROS2/Lidar/LidarRaycasterBus.h>
+#include <ROS2/Sensor/SensorPublisher.h>
+#include <sensor_msgs/msg/point_cloud2.hpp>
 
 namespace ROS2
 {
+    class LidarScanScheduler;
+
+    //! Lidar raycaster that uses the physics scene queries.
+    //! Ray requests, ray directions and hit buffers are kept across scans and updated in place,
+    //! so that consecutive scans with an unchanged configuration do not allocate.
     class LidarRaycaster : protected LidarRaycasterRequestBus::Handler
     {
+        friend class LidarScanScheduler;
+
     public:
-        LidarRaycaster(LidarId busId, AZ::EntityId sceneEntityId);
+        //! Smallest number of rays worth a separate job; smaller scans (e.g. of 2D lidars) stay serial.
+        static constexpr size_t MinRaysPerShard = 4096;
+
+        //! @param busId Id under which the raycaster connects to the LidarRaycasterRequestBus.
+        //! @param sceneEntityId Entity used to acquire the physics scene handle.
+        //! @param workerCount Maximum number of jobs a scan is split into. Values of 0 or 1 make the raycast serial.
+        //! @param scanScheduler Scheduler batching scans of published lidars, or nullptr to always cast scans right away.
+        LidarRaycaster(LidarId busId, AZ::EntityId sceneEntityId, size_t workerCount = 1, LidarScanScheduler* scanScheduler = nullptr);
         LidarRaycaster(LidarRaycaster&& lidarSystem);
-        LidarRaycaster(const LidarRaycaster& lidarSystem) = default;
+        LidarRaycaster(const LidarRaycaster& lidarSystem) = delete;
         ~LidarRaycaster() override;
 
     protected:
@@ -32,24 +53,145 @@ namespace ROS2
         void ConfigureRaycastResultFlags(RaycastResultFlags flags) override;
 
         RaycastResult PerformRaycast(const AZ::Transform& lidarTransform) override;
+        void PerformRaycastInPlace(const AZ::Transform& lidarTransform, RaycastResult& results) override;
+        bool PerformRaycastToPointCloud(const AZ::Transform& lidarTransform, sensor_msgs::msg::PointCloud2& message) override;
+        bool AppendRaycastToPointCloud(
+            const AZ::Transform& lidarTransform, size_t firstRay, size_t rayCount, sensor_msgs::msg::PointCloud2& message) override;
 
         void ConfigureIgnoredCollisionLayers(const AZStd::unordered_set<AZ::u32>& layerIndices) override;
         void ConfigureMaxRangePointAddition(bool addMaxRangePoints) override;
+        void ConfigureNoiseParameters(
+            float angularNoiseStdDev, float distanceNoiseStdDevBase, float distanceNoiseStdDevRisePerMeter) override;
+        void ExcludeEntities(const AZStd::vector<AZ::EntityId>& excludedEntities) override;
+        void ConfigureOrganizedPointCloud(AZ::u32 layerCount) override;
+        void ConfigureAdaptiveDensity(AZ::u32 layerCount, float fullDensityRange, AZ::u32 maxDecimation, AZ::u32 rayBudget) override;
+        RaycastStatistics GetRaycastStatistics() override;
+
+        void ConfigurePointCloudPublisher(const AZStd::string& topicName, const AZStd::string& frameId, const QoS& qoSPolicy) override;
+        void ConfigureRobotPointCloudPublisher(
+            const AZStd::string& robotNamespace, const AZStd::string& topicName, const AZStd::string& frameId, const QoS& qoSPolicy) override;
+        void UpdatePublisherTimestamp(AZ::u64 timestampNanoseconds) override;
+        bool CanHandlePublishing() override;
+        bool ScheduleRaycast(const AZ::Transform& lidarTransform) override;
+
+        //! Resolves the physics scene that rays are cast into. Called before the first scan.
+        virtual AzPhysics::SceneHandle AcquireSceneHandle() const;
+
+        //! Casts a batch of prepared requests and returns their hits, in the order of the requests.
+        //! Can be called concurrently for disjoint batches.
+        virtual AzPhysics::SceneQueryHitsList QueryBatch(const AzPhysics::SceneQueryRequests& requests) const;
+
+        //! Requests prepared for the current scan, one per ray.
+        AZStd::vector<AzPhysics::RayCastRequest> m_rayRequests;
+        //! Hits of the current scan, one entry per ray.
+        AZStd::vector<AzPhysics::SceneQueryHits> m_rayHits;
+        AzPhysics::SceneHandle m_sceneHandle{ AzPhysics::InvalidSceneHandle };
 
     private:
-        AzPhysics::SceneQueryRequests prepareRequests(
-            const AZ::Transform& lidarTransform, const AZStd::vector<AZ::Vector3>& rayDirections) const;
+        //! Casts rays with indices in range [first, last) from the given lidar pose, leaving their hits in m_rayHits.
+        void CastScan(const AZ::Transform& lidarTransform, size_t first, size_t last);
+        //! Returns the physics scene that rays are cast into, resolving it on first use.
+        AzPhysics::SceneHandle GetSceneHandle();
+        //! Resolves the scene handle and excluded bodies and selects rays in range [first, last) to cast.
+        void PrepareScan(size_t first, size_t last);
+        //! Selects rays in range [first, last) cast in this scan, according to the adaptive density configuration.
+        void SelectRays(size_t first, size_t last);
+        //! Decimation factor of a ray with the given range in the previous scan.
+        AZ::u32 GetDecimationFactor(float range) const;
+        //! Writes the start and direction of the requests of rays in range [first, last) for the lidar pose.
+        void PrepareRequests(const AZ::Transform& lidarTransform, size_t first, size_t last);
+        //! Appends the requests of rays in range [first, last) selected by SelectRays to a batch, together with their indices.
+        //! Hits of the other rays are cleared.
+        void AppendCastRequests(size_t first, size_t last, AzPhysics::SceneQueryRequests& requests, AZStd::vector<size_t>& rayIndices);
+        //! Moves hits of a batch query, starting at firstHit, to the rays with the given indices.
+        void StoreHits(AzPhysics::SceneQueryHitsList& hits, size_t firstHit, const size_t* rayIndices, size_t count);
+        //! Records the ranges of rays in range [first, last) for adaptive density and applies distance noise to their hits.
+        void CompleteRays(size_t first, size_t last);
+        //! Is the ray left out of the current scan by adaptive density?
+        bool IsRaySkipped(size_t rayIndex) const
+        {
+            return m_isAdaptiveDensityEnabled && !m_isRayCast[rayIndex];
+        }
+        //! Writes the static part of the requests (range, filter) after a configuration change.
+        void ConfigureRequests();
+        //! Resolves excluded entities that have no body handle yet. Returns true if any new handle was found.
+        bool ResolveExcludedBodies();
+        //! Casts rays in range [first, last), split into angular shards that run as parallel jobs.
+        void CastShards(const AZ::Transform& lidarTransform, size_t first, size_t last);
+        //! Prepares, casts and applies noise to rays in range [first, last), casting them as one batch.
+        //! Runs on a job worker or on the calling thread.
+        void CastShard(const AZ::Transform& lidarTransform, size_t first, size_t last);
+        //! Deflects the world space directions of rays in range [first, last) by the configured angular noise.
+        void ApplyAngularNoise(size_t first, size_t last);
+        //! Offsets the hit distances and positions of rays in range [first, last) by the configured distance noise.
+        void ApplyDistanceNoise(size_t first, size_t last);
+        //! Returns the direction of a cast ray in the lidar frame, including its angular noise.
+        AZ::Vector3 GetCastLocalDirection(const AZ::Quaternion& inverseLidarRotation, size_t rayIndex) const;
+        //! Appends points of the cast rays in range [first, last) to the message, in the lidar frame.
+        //! For organized point clouds, the points are written to their cells of the layers x increments grid instead.
+        void WritePointCloud(const AZ::Transform& lidarTransform, size_t first, size_t last, sensor_msgs::msg::PointCloud2& message) const;
+        void WriteOrganizedPointCloud(
+            const AZ::Transform& lidarTransform, size_t first, size_t last, sensor_msgs::msg::PointCloud2& message) const;
+        //! Writes the current scan into a pooled message and hands it over to the publisher thread.
+        void PublishScan(const AZ::Transform& lidarTransform, AZ::u64 timestampNanoseconds);
+        //! Called by the scan scheduler once the rays of a scheduled scan are cast.
+        void CompleteScheduledScan(const AZ::Transform& lidarTransform, AZ::u64 timestampNanoseconds);
+        //! Converts the hits of the current scan to the requested result form.
+        void GatherResults(const AZ::Transform& lidarTransform, RaycastResult& results) const;
+
         LidarId m_busId;
         //! EntityId that is used to acquire the physics scene handle.
         AZ::EntityId m_sceneEntityId;
-        AzPhysics::SceneHandle m_sceneHandle{ AzPhysics::InvalidSceneHandle };
+        size_t m_workerCount{ 1 };
+        LidarScanScheduler* m_scanScheduler{ nullptr };
 
         RaycastResultFlags m_resultFlags{ RaycastResultFlags::Points };
         float m_minRange{ 0.0f };
         float m_range{ 1.0f };
         bool m_addMaxRangePoints{ false };
-        AZStd::vector<AZ::Vector3> m_rayRotations{ { AZ::Vector3::CreateZero() } };
+        //! Number of rows of organized point clouds and range images, or 0 for unorganized point clouds.
+        AZ::u32 m_organizedLayerCount{ 0 };
+
+        //! Adaptive density configuration (see ConfigureAdaptiveDensity).
+        bool m_isAdaptiveDensityEnabled{ false };
+        AZ::u32 m_adaptiveDensityLayerCount{ 1 };
+        float m_fullDensityRange{ 0.0f };
+        AZ::u32 m_maxDecimation{ 1 };
+        AZ::u32 m_rayBudget{ 0 };
+        //! Range of every ray when it was last cast (the range for misses), deciding its decimation.
+        AZStd::vector<float> m_lastCastRanges;
+        //! Rays selected for the current scan, one entry per ray.
+        AZStd::vector<AZ::u8> m_isRayCast;
+        //! Counter rotating the cast increments and thinned rays between scans.
+        AZ::u32 m_selectionPhase{ 0 };
+        RaycastStatistics m_statistics;
+        //! Ray directions in the lidar frame, computed once per ray orientation configuration.
+        LidarTemplateUtils::RayDirectionTable m_localRayDirections;
+        //! World space directions of the current scan, one per ray.
+        LidarTemplateUtils::RayDirectionTable m_rayDirections;
+        //! Requests of m_rayRequests in the form batch queries take, pointing into m_rayRequests without owning it.
+        AzPhysics::SceneQueryRequests m_rayRequestBatch;
+
+        //! Bitmask of ignored collision layers (bit i set means layer i is ignored).
+        AZ::u64 m_ignoredCollisionLayersMask{ 0 };
+
+        //! Angular noise standard deviation, in radians.
+        float m_angularNoiseStdDev{ 0.0f };
+        float m_distanceNoiseStdDevBase{ 0.0f };
+        float m_distanceNoiseStdDevRisePerMeter{ 0.0f };
+
+        //! Entities excluded from raycasting and the body handles they were resolved to.
+        //! Entities without a simulated body yet keep an invalid handle and are resolved again before following scans.
+        AZStd::vector<AZ::EntityId> m_excludedEntities;
+        AZStd::vector<AzPhysics::SimulatedBodyHandle> m_excludedBodyHandles;
+        //! Resolved handles shared with the filter callback of every request.
+        AZStd::shared_ptr<const AZStd::vector<AzPhysics::SimulatedBodyHandle>> m_excludedBodies;
+        bool m_hasUnresolvedExclusions{ false };
 
-        AZStd::unordered_set<AZ::u32> m_ignoredCollisionLayers;
+        //! Raycaster-side publisher, created when the sensor hands publishing over to the raycaster. Point clouds are published
+        //! on the sensor publishing thread, so that serialization does not take time from the thread that casts rays.
+        AZStd::unique_ptr<SensorPublisher<sensor_msgs::msg::PointCloud2>> m_pointCloudPublisher;
+        AZStd::string m_pointCloudFrameId;
+        AZ::u64 m_publisherTimestampNanoseconds{ 0 };
     };
 } // namespace ROS2
@@ -0,0 +1,253 @@
+/*
+ * Copyright (c) Contributors to the Open 3D Engine Project.
+ * For complete copyright and license terms please see the LICENSE at the root of this distribution.
+ *
+ * SPDX-License-Identifier: Apache-2.0 OR MIT
+ *
+ */
+
+#include <AzCore/Jobs/JobCompletion.h>
+#include <AzCore/Jobs/JobFunction.h>
+#include <AzCore/std/algorithm.h>
+#include <AzFramework/Physics/PhysicsScene.h>
+#include <Lidar/LidarRaycaster.h>
+#include <Lidar/LidarScanScheduler.h>
+
+namespace ROS2
+{
+    namespace Internal
+    {
+        //! Splits items in range [0, itemCount) evenly between at most workerCount jobs and calls the function with the range
+        //! of each job. The calling thread handles the first range instead of idling.
+        template<typename Function>
+        void RunInJobs(size_t itemCount, size_t workerCount, const Function& function)
+        {
+            if (itemCount == 0)
+            {
+                return;
+            }
+
+            const size_t jobCount = AZStd::min(workerCount, itemCount);
+            const size_t itemsPerJob = (itemCount + jobCount - 1) / jobCount;
+            AZ::JobCompletion completion;
+            for (size_t jobFirst = itemsPerJob; jobFirst < itemCount; jobFirst += itemsPerJob)
+            {
+                const size_t jobLast = AZStd::min(jobFirst + itemsPerJob, itemCount);
+                AZ::Job* job = AZ::CreateJobFunction(
+                    [&function, jobFirst, jobLast]()
+                    {
+                        function(jobFirst, jobLast);
+                    },
+                    true);
+                job->SetDependent(&completion);
+                job->Start();
+            }
+
+            function(0, AZStd::min(itemsPerJob, itemCount));
+            completion.StartAndWaitForCompletion();
+        }
+    } // namespace Internal
+
+    LidarScanScheduler::LidarScanScheduler(size_t workerCount)
+        : m_workerCount{ AZStd::max<size_t>(workerCount, 1) }
+    {
+    }
+
+    LidarScanScheduler::~LidarScanScheduler()
+    {
+        Deactivate();
+    }
+
+    void LidarScanScheduler::Activate()
+    {
+        m_isActive = true;
+        for (const PendingScan& pendingScan : m_pendingScans)
+        {
+            Subscribe(pendingScan.m_sceneHandle);
+        }
+    }
+
+    void LidarScanScheduler::Deactivate()
+    {
+        m_isActive = false;
+        m_sceneSubscriptions.clear();
+    }
+
+    void LidarScanScheduler::Subscribe(AzPhysics::SceneHandle sceneHandle)
+    {
+        for (const auto& sceneSubscription : m_sceneSubscriptions)
+        {
+            if (sceneSubscription->m_sceneHandle == sceneHandle)
+            {
+                return;
+            }
+        }
+
+        // Scenes stay subscribed once they have lidars, since lidars usually schedule a scan every few steps.
+        auto sceneSubscription = AZStd::make_unique<SceneSubscription>();
+        sceneSubscription->m_sceneHandle = sceneHandle;
+        sceneSubscription->m_onSceneSimulationFinishHandler = AzPhysics::SceneEvents::OnSceneSimulationFinishHandler(
+            [this](AzPhysics::SceneHandle finishedSceneHandle, [[maybe_unused]] float deltaTime)
+            {
+                Flush(finishedSceneHandle);
+            });
+        auto* sceneInterface = AZ::Interface<AzPhysics::SceneInterface>::Get();
+        sceneInterface->RegisterSceneSimulationFinishHandler(sceneHandle, sceneSubscription->m_onSceneSimulationFinishHandler);
+        m_sceneSubscriptions.push_back(AZStd::move(sceneSubscription));
+    }
+
+    void LidarScanScheduler::Schedule(LidarRaycaster& raycaster, const AZ::Transform& lidarTransform, AZ::u64 timestampNanoseconds)
+    {
+        for (PendingScan& pendingScan : m_pendingScans)
+        {
+            if (pendingScan.m_raycaster == &raycaster)
+            {
+                pendingScan.m_lidarTransform = lidarTransform;
+                pendingScan.m_timestampNanoseconds = timestampNanoseconds;
+                return;
+            }
+        }
+
+        const AzPhysics::SceneHandle sceneHandle = raycaster.GetSceneHandle();
+        m_pendingScans.push_back({ &raycaster, sceneHandle, lidarTransform, timestampNanoseconds });
+        if (m_isActive)
+        {
+            Subscribe(sceneHandle);
+        }
+    }
+
+    void LidarScanScheduler::Cancel(const LidarRaycaster& raycaster)
+    {
+        m_pendingScans.erase(
+            AZStd::remove_if(
+                m_pendingScans.begin(),
+                m_pendingScans.end(),
+                [&raycaster](const PendingScan& pendingScan)
+                {
+                    return pendingScan.m_raycaster == &raycaster;
+                }),
+            m_pendingScans.end());
+    }
+
+    size_t LidarScanScheduler::GetPendingScanCount() const
+    {
+        return m_pendingScans.size();
+    }
+
+    void LidarScanScheduler::Flush()
+    {
+        while (!m_pendingScans.empty())
+        {
+            Flush(m_pendingScans.front().m_sceneHandle);
+        }
+    }
+
+    void LidarScanScheduler::Flush(AzPhysics::SceneHandle sceneHandle)
+    {
+        // Scans of other scenes stay pending, in their order.
+        m_batchScans.clear();
+        size_t pendingCount = 0;
+        for (const PendingScan& pendingScan : m_pendingScans)
+        {
+            if (pendingScan.m_sceneHandle == sceneHandle)
+            {
+                m_batchScans.push_back(pendingScan);
+            }
+            else
+            {
+                m_pendingScans[pendingCount++] = pendingScan;
+            }
+        }
+        m_pendingScans.resize(pendingCount);
+        if (m_batchScans.empty())
+        {
+            return;
+        }
+
+        // Excluded bodies are resolved and rays selected for all lidars up front, so that the jobs only prepare and cast rays.
+        m_shards.clear();
+        for (size_t scanIndex = 0; scanIndex < m_batchScans.size(); ++scanIndex)
+        {
+            LidarRaycaster& raycaster = *m_batchScans[scanIndex].m_raycaster;
+            const size_t rayCount = raycaster.m_rayRequests.size();
+            raycaster.PrepareScan(0, rayCount);
+
+            for (size_t first = 0; first < rayCount; first += LidarRaycaster::MinRaysPerShard)
+            {
+                m_shards.push_back({ scanIndex, first, AZStd::min(first + LidarRaycaster::MinRaysPerShard, rayCount) });
+            }
+        }
+
+        // Shards of all lidars are split evenly between the jobs, regardless of which lidar they belong to.
+        Internal::RunInJobs(
+            m_shards.size(),
+            m_workerCount,
+            [this](size_t first, size_t last)
+            {
+                for (size_t i = first; i < last; ++i)
+                {
+                    const ScanShard& shard = m_shards[i];
+                    const PendingScan& scan = m_batchScans[shard.m_scanIndex];
+                    scan.m_raycaster->PrepareRequests(scan.m_lidarTransform, shard.m_first, shard.m_last);
+                }
+            });
+
+        // The requests of all lidars of the scene form one span, which points into the request buffers of the raycasters.
+        m_requests.clear();
+        m_requestScans.clear();
+        m_requestRays.clear();
+        for (size_t scanIndex = 0; scanIndex < m_batchScans.size(); ++scanIndex)
+        {
+            LidarRaycaster& raycaster = *m_batchScans[scanIndex].m_raycaster;
+            raycaster.AppendCastRequests(0, raycaster.m_rayRequests.size(), m_requests, m_requestRays);
+            m_requestScans.resize(m_requests.size(), scanIndex);
+        }
+
+        Internal::RunInJobs(
+            m_requests.size(),
+            m_workerCount,
+            [this](size_t first, size_t last)
+            {
+                CastRequests(first, last);
+            });
+
+        Internal::RunInJobs(
+            m_shards.size(),
+            m_workerCount,
+            [this](size_t first, size_t last)
+            {
+                for (size_t i = first; i < last; ++i)
+                {
+                    const ScanShard& shard = m_shards[i];
+                    m_batchScans[shard.m_scanIndex].m_raycaster->CompleteRays(shard.m_first, shard.m_last);
+                }
+            });
+
+        for (const PendingScan& scan : m_batchScans)
+        {
+            scan.m_raycaster->CompleteScheduledScan(scan.m_lidarTransform, scan.m_timestampNanoseconds);
+        }
+        m_batchScans.clear();
+    }
+
+    void LidarScanScheduler::CastRequests(size_t first, size_t last)
+    {
+        // A job casts its part of the span with one batch query. All raycasters of the batch query the same scene.
+        thread_local AzPhysics::SceneQueryRequests requests;
+        requests.assign(m_requests.begin() + first, m_requests.begin() + last);
+        AzPhysics::SceneQueryHitsList hits = m_batchScans[m_requestScans[first]].m_raycaster->QueryBatch(requests);
+        requests.clear();
+
+        // Hits are scattered back in runs of requests of the same scan, which are disjoint between the jobs.
+        size_t runFirst = first;
+        for (size_t i = first + 1; i <= last; ++i)
+        {
+            if (i < last && m_requestScans[i] == m_requestScans[runFirst])
+            {
+                continue;
+            }
+            m_batchScans[m_requestScans[runFirst]].m_raycaster->StoreHits(hits, runFirst - first, &m_requestRays[runFirst], i - runFirst);
+            runFirst = i;
+        }
+    }
+} // namespace ROS2
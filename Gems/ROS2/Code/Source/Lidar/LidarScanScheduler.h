@@ -0,0 +1,99 @@
+/*
+ * Copyright (c) Contributors to the Open 3D Engine Project.
+ * For complete copyright and license terms please see the LICENSE at the root of this distribution.
+ *
+ * SPDX-License-Identifier: Apache-2.0 OR MIT
+ *
+ */
+#pragma once
+
+#include <AzCore/Math/Transform.h>
+#include <AzCore/std/containers/vector.h>
+#include <AzCore/std/smart_ptr/unique_ptr.h>
+#include <AzFramework/Physics/Common/PhysicsEvents.h>
+#include <AzFramework/Physics/Common/PhysicsSceneQueries.h>
+
+namespace ROS2
+{
+    class LidarRaycaster;
+
+    //! Casts the scans of many lidars as one batch per physics scene.
+    //! Lidars that publish on their own schedule their scans instead of casting them right away. After each simulation step of
+    //! a scene, the requests of all scans scheduled in that scene are prepared together and gathered into one combined span,
+    //! which is cast with one batch query per worker, so that the query is set up and the scene locked once per worker instead
+    //! of once per ray or lidar. The hits are then scattered back to the raycasters, which publish the results.
+    class LidarScanScheduler
+    {
+    public:
+        //! @param workerCount Maximum number of jobs a batch is split into. Values of 0 or 1 make the batch serial.
+        explicit LidarScanScheduler(size_t workerCount);
+        ~LidarScanScheduler();
+
+        LidarScanScheduler(const LidarScanScheduler&) = delete;
+        LidarScanScheduler& operator=(const LidarScanScheduler&) = delete;
+
+        //! Starts casting scheduled scans after each simulation step of the scenes of the scheduled lidars.
+        void Activate();
+        void Deactivate();
+
+        //! Schedules a scan of the raycaster. A raycaster that is already scheduled only has its pose and timestamp updated.
+        //! @param raycaster Raycaster to cast; must stay alive until the scan is cast or cancelled.
+        //! @param lidarTransform Pose of the lidar.
+        //! @param timestampNanoseconds Timestamp of the published scan.
+        void Schedule(LidarRaycaster& raycaster, const AZ::Transform& lidarTransform, AZ::u64 timestampNanoseconds);
+
+        //! Removes a pending scan of the raycaster, if any.
+        void Cancel(const LidarRaycaster& raycaster);
+
+        //! Casts all scheduled scans, as one batch per scene, and hands their results to the raycasters.
+        void Flush();
+
+        //! Casts the scans scheduled in a scene as one batch and hands their results to the raycasters.
+        void Flush(AzPhysics::SceneHandle sceneHandle);
+
+        size_t GetPendingScanCount() const;
+
+    private:
+        struct PendingScan
+        {
+            LidarRaycaster* m_raycaster;
+            AzPhysics::SceneHandle m_sceneHandle;
+            AZ::Transform m_lidarTransform;
+            AZ::u64 m_timestampNanoseconds;
+        };
+
+        //! A range of rays of one scan, prepared and completed as a unit.
+        struct ScanShard
+        {
+            size_t m_scanIndex;
+            size_t m_first;
+            size_t m_last;
+        };
+
+        //! Scene with scheduled lidars, whose scans are cast after its simulation steps.
+        struct SceneSubscription
+        {
+            AzPhysics::SceneHandle m_sceneHandle;
+            AzPhysics::SceneEvents::OnSceneSimulationFinishHandler m_onSceneSimulationFinishHandler;
+        };
+
+        //! Subscribes to simulation steps of a scene, if it is not subscribed yet.
+        void Subscribe(AzPhysics::SceneHandle sceneHandle);
+        //! Casts the requests in range [first, last) of the combined batch and scatters their hits to the raycasters.
+        void CastRequests(size_t first, size_t last);
+
+        size_t m_workerCount;
+        bool m_isActive{ false };
+        AZStd::vector<AZStd::unique_ptr<SceneSubscription>> m_sceneSubscriptions;
+        AZStd::vector<PendingScan> m_pendingScans;
+
+        // Buffers of the batch of a scene, kept to avoid allocating for every batch.
+        //! Scans of the batch, moved out of the pending scans.
+        AZStd::vector<PendingScan> m_batchScans;
+        AZStd::vector<ScanShard> m_shards;
+        //! Requests of all cast rays of the batch, and for each of them its scan and its ray index in the scan.
+        AzPhysics::SceneQueryRequests m_requests;
+        AZStd::vector<size_t> m_requestScans;
+        AZStd::vector<size_t> m_requestRays;
+    };
+} // namespace ROS2
@@ -17,13 +17,19 @@ namespace ROS2
         if (auto serializeContext = azrtti_cast<AZ::SerializeContext*>(context))
         {
             serializeContext->Class<LidarSensorConfiguration>()
-                ->Version(1)
+                ->Version(4)
                 ->Field("lidarModelName", &LidarSensorConfiguration::m_lidarModelName)
                 ->Field("lidarImplementation", &LidarSensorConfiguration::m_lidarSystem)
                 ->Field("LidarParameters", &LidarSensorConfiguration::m_lidarParameters)
                 ->Field("IgnoredLayerIndices", &LidarSensorConfiguration::m_ignoredCollisionLayers)
                 ->Field("ExcludedEntities", &LidarSensorConfiguration::m_excludedEntities)
-                ->Field("PointsAtMax", &LidarSensorConfiguration::m_addPointsAtMax);
+                ->Field("PointsAtMax", &LidarSensorConfiguration::m_addPointsAtMax)
+                ->Field("SpinningEmission", &LidarSensorConfiguration::m_spinningEmission)
+                ->Field("OrganizedPointCloud", &LidarSensorConfiguration::m_organizedPointCloud)
+                ->Field("AdaptiveDensity", &LidarSensorConfiguration::m_adaptiveDensity)
+                ->Field("FullDensityRange", &LidarSensorConfiguration::m_fullDensityRange)
+                ->Field("MaxDecimation", &LidarSensorConfiguration::m_maxDecimation)
+                ->Field("RayBudget", &LidarSensorConfiguration::m_rayBudget);
 
             if (AZ::EditContext* ec = serializeContext->GetEditContext())
             {
@@ -63,7 +69,52 @@ namespace ROS2
                         &LidarSensorConfiguration::m_addPointsAtMax,
                         "Points at Max",
                         "If set true LiDAR will produce points at max range for free space")
-                    ->Attribute(AZ::Edit::Attributes::Visibility, &LidarSensorConfiguration::IsMaxPointsConfigurationVisible);
+                    ->Attribute(AZ::Edit::Attributes::Visibility, &LidarSensorConfiguration::IsMaxPointsConfigurationVisible)
+                    ->DataElement(
+                        AZ::Edit::UIHandlers::Default,
+                        &LidarSensorConfiguration::m_spinningEmission,
+                        "Spinning emission",
+                        "If set true LiDAR sweeps its rays over time like a spinning sensor, casting one azimuth slice per physics step "
+                        "and publishing each full revolution. Spreads the raycast cost over physics steps and reproduces motion distortion. "
+                        "Results are not visualized in this mode.")
+                    ->Attribute(AZ::Edit::Attributes::Visibility, &LidarSensorConfiguration::IsSpinningEmissionVisible)
+                    ->DataElement(
+                        AZ::Edit::UIHandlers::Default,
+                        &LidarSensorConfiguration::m_organizedPointCloud,
+                        "Organized point cloud",
+                        "If set true LiDAR publishes organized point clouds, with a row per layer and a column per increment. "
+                        "Rays without a return are published as NaN points. Results are not visualized in this mode.")
+                    ->Attribute(AZ::Edit::Attributes::Visibility, &LidarSensorConfiguration::IsOrganizedPointCloudVisible)
+                    ->DataElement(
+                        AZ::Edit::UIHandlers::Default,
+                        &LidarSensorConfiguration::m_adaptiveDensity,
+                        "Adaptive density",
+                        "If set true LiDAR casts fewer rays in azimuth where previous scans saw the scene far away, "
+                        "and refreshes the left out rays in following scans.")
+                    ->Attribute(AZ::Edit::Attributes::Visibility, &LidarSensorConfiguration::IsAdaptiveDensityVisible)
+                    ->Attribute(AZ::Edit::Attributes::ChangeNotify, AZ::Edit::PropertyRefreshLevels::EntireTree)
+                    ->DataElement(
+                        AZ::Edit::UIHandlers::Default,
+                        &LidarSensorConfiguration::m_fullDensityRange,
+                        "Full density range",
+                        "Range below which all rays are cast. Rays are cast in every second increment up to twice this range, "
+                        "in every fourth up to four times this range, and so on.")
+                    ->Attribute(AZ::Edit::Attributes::Suffix, " m")
+                    ->Attribute(AZ::Edit::Attributes::Min, 0.0f)
+                    ->Attribute(AZ::Edit::Attributes::Visibility, &LidarSensorConfiguration::IsAdaptiveDensityConfigurationVisible)
+                    ->DataElement(
+                        AZ::Edit::UIHandlers::Default,
+                        &LidarSensorConfiguration::m_maxDecimation,
+                        "Max decimation",
+                        "Largest factor by which distant parts of the ray pattern are decimated.")
+                    ->Attribute(AZ::Edit::Attributes::Min, 1)
+                    ->Attribute(AZ::Edit::Attributes::Visibility, &LidarSensorConfiguration::IsAdaptiveDensityConfigurationVisible)
+                    ->DataElement(
+                        AZ::Edit::UIHandlers::Default,
+                        &LidarSensorConfiguration::m_rayBudget,
+                        "Ray budget",
+                        "Maximum number of rays cast per scan. Selected rays are thinned evenly to fit it. 0 for no limit.")
+                    ->Attribute(AZ::Edit::Attributes::Visibility, &LidarSensorConfiguration::IsAdaptiveDensityConfigurationVisible);
             }
         }
     }
@@ -140,6 +191,26 @@ namespace ROS2
         return m_lidarSystemFeatures & LidarSystemFeatures::MaxRangePoints;
     }
 
+    bool LidarSensorConfiguration::IsSpinningEmissionVisible() const
+    {
+        return !m_lidarParameters.m_is2D;
+    }
+
+    bool LidarSensorConfiguration::IsOrganizedPointCloudVisible() const
+    {
+        return !m_lidarParameters.m_is2D && (m_lidarSystemFeatures & LidarSystemFeatures::OrganizedPointCloud);
+    }
+
+    bool LidarSensorConfiguration::IsAdaptiveDensityVisible() const
+    {
+        return !m_lidarParameters.m_is2D && (m_lidarSystemFeatures & LidarSystemFeatures::AdaptiveDensity);
+    }
+
+    bool LidarSensorConfiguration::IsAdaptiveDensityConfigurationVisible() const
+    {
+        return IsAdaptiveDensityVisible() && m_adaptiveDensity;
+    }
+
     AZ::Crc32 LidarSensorConfiguration::OnLidarModelSelected()
     {
         FetchLidarModelConfiguration();
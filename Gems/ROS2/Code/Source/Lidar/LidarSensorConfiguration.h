@@ -40,12 +40,30 @@ namespace ROS2
         AZStd::vector<AZ::EntityId> m_excludedEntities;
 
         bool m_addPointsAtMax = false;
+        //! If true, the ray pattern is swept over time like in a spinning lidar, one azimuth slice per physics step,
+        //! instead of being cast all at once. Full revolutions are published as a single point cloud.
+        bool m_spinningEmission = false;
+        //! Publish organized point clouds (height = layers, width = increments) with NaN points for rays without a return.
+        bool m_organizedPointCloud = false;
+
+        //! If true, rays are left out in azimuth where previous scans saw the scene far away (see ConfigureAdaptiveDensity).
+        bool m_adaptiveDensity = false;
+        //! Range in meters below which the ray pattern is cast at full density.
+        float m_fullDensityRange = 30.0f;
+        //! Largest factor by which distant parts of the ray pattern are decimated.
+        AZ::u32 m_maxDecimation = 4;
+        //! Maximum number of rays cast per scan, 0 for no limit.
+        AZ::u32 m_rayBudget = 0;
 
     private:
         bool IsConfigurationVisible() const;
         bool IsIgnoredLayerConfigurationVisible() const;
         bool IsEntityExclusionVisible() const;
         bool IsMaxPointsConfigurationVisible() const;
+        bool IsSpinningEmissionVisible() const;
+        bool IsOrganizedPointCloudVisible() const;
+        bool IsAdaptiveDensityVisible() const;
+        bool IsAdaptiveDensityConfigurationVisible() const;
 
         //! Update the lidar configuration based on the current lidar model selected.
         void FetchLidarModelConfiguration();
@@ -5,13 +5,23 @@
  * SPDX-License-Identifier: Apache-2.0 OR MIT
  *
  */
+#include <AzCore/Settings/SettingsRegistry.h>
+#include <AzCore/std/parallel/thread.h>
 #include <Lidar/LidarSystem.h>
 #include <ROS2/Lidar/LidarRegistrarBus.h>
 
 namespace ROS2
 {
+    //! Number of parallel jobs a single lidar scan is split into. 1 (the default) disables sharding, 0 selects the number of hardware
+    //! threads.
+    constexpr AZStd::string_view RaycastWorkerCountConfigurationKey = "/O3DE/ROS2/Lidar/RaycastWorkerCount";
+    //! Should scans of lidars publishing on their own be batched and cast together after each physics step?
+    constexpr AZStd::string_view BatchScansConfigurationKey = "/O3DE/ROS2/Lidar/BatchScans";
+
     LidarSystem::LidarSystem(LidarSystem&& lidarSystem)
-        : m_lidars{ AZStd::move(lidarSystem.m_lidars) }
+        : m_raycastWorkerCount{ lidarSystem.m_raycastWorkerCount }
+        , m_scanScheduler{ AZStd::move(lidarSystem.m_scanScheduler) }
+        , m_lidars{ AZStd::move(lidarSystem.m_lidars) }
     {
         lidarSystem.BusDisconnect();
     }
@@ -25,8 +35,30 @@ namespace ROS2
     void LidarSystem::Activate()
     {
         static constexpr const char* Description = "Collider-based lidar implementation that uses the PhysX engine's raycasting.";
-        static constexpr auto SupportedFeatures =
-            aznumeric_cast<LidarSystemFeatures>(LidarSystemFeatures::CollisionLayers | LidarSystemFeatures::MaxRangePoints);
+        static constexpr auto SupportedFeatures = aznumeric_cast<LidarSystemFeatures>(
+            LidarSystemFeatures::Noise | LidarSystemFeatures::CollisionLayers | LidarSystemFeatures::EntityExclusion |
+            LidarSystemFeatures::MaxRangePoints | LidarSystemFeatures::PointcloudPublishing | LidarSystemFeatures::OrganizedPointCloud |
+            LidarSystemFeatures::AdaptiveDensity);
+
+        // Scans stay serial unless sharding is enabled, which keeps the behavior of existing scenes.
+        AZ::u64 raycastWorkerCount = 1;
+        bool batchScans = false;
+        if (auto* registry = AZ::SettingsRegistry::Get())
+        {
+            registry->Get(raycastWorkerCount, RaycastWorkerCountConfigurationKey);
+            registry->Get(batchScans, BatchScansConfigurationKey);
+        }
+        m_raycastWorkerCount = raycastWorkerCount > 0 ? aznumeric_cast<size_t>(raycastWorkerCount) : AZStd::thread::hardware_concurrency();
+
+        if (batchScans)
+        {
+            // The scheduler outlives deactivation, since raycasters created before keep a pointer to it.
+            if (!m_scanScheduler)
+            {
+                m_scanScheduler = AZStd::make_unique<LidarScanScheduler>(m_raycastWorkerCount);
+            }
+            m_scanScheduler->Activate();
+        }
 
         LidarSystemRequestBus::Handler::BusConnect(AZ_CRC(SystemName));
 
@@ -41,6 +73,11 @@ namespace ROS2
 
     void LidarSystem::Deactivate()
     {
+        if (m_scanScheduler)
+        {
+            m_scanScheduler->Deactivate();
+        }
+
         if (LidarSystemRequestBus::Handler::BusIsConnectedId(AZ_CRC(SystemName)))
         {
             LidarSystemRequestBus::Handler::BusDisconnect();
@@ -50,7 +87,7 @@ namespace ROS2
     LidarId LidarSystem::CreateLidar(AZ::EntityId lidarEntityId)
     {
         LidarId lidarId = LidarId::CreateRandom();
-        m_lidars.emplace(lidarId, LidarRaycaster(lidarId, lidarEntityId));
+        m_lidars.emplace(lidarId, LidarRaycaster(lidarId, lidarEntityId, m_raycastWorkerCount, m_scanScheduler.get()));
         return lidarId;
     }
 
@@ -7,7 +7,9 @@
  */
 #pragma once
 
+#include <AzCore/std/smart_ptr/unique_ptr.h>
 #include <Lidar/LidarRaycaster.h>
+#include <Lidar/LidarScanScheduler.h>
 #include <ROS2/Lidar/LidarSystemBus.h>
 
 namespace ROS2
@@ -18,8 +20,8 @@ namespace ROS2
         LidarSystem() = default;
         LidarSystem(LidarSystem&& lidarSystem);
         LidarSystem& operator=(LidarSystem&& lidarSystem);
-        LidarSystem(const LidarSystem& lidarSystem) = default;
-        LidarSystem& operator=(const LidarSystem& lidarSystem) = default;
+        LidarSystem(const LidarSystem& lidarSystem) = delete;
+        LidarSystem& operator=(const LidarSystem& lidarSystem) = delete;
 
         ~LidarSystem() = default;
 
@@ -33,6 +35,11 @@ namespace ROS2
         LidarId CreateLidar(AZ::EntityId lidarEntityId) override;
         void DestroyLidar(LidarId lidarId) override;
 
+        //! Number of jobs each raycast is split into.
+        size_t m_raycastWorkerCount{ 1 };
+        //! Scheduler batching the scans of all lidars on physics steps, if enabled in the settings registry.
+        //! Declared before the lidars, which cancel their scans on destruction, so that it is destroyed after them.
+        AZStd::unique_ptr<LidarScanScheduler> m_scanScheduler;
         AZStd::unordered_map<LidarId, LidarRaycaster> m_lidars;
     };
 } // namespace ROS2
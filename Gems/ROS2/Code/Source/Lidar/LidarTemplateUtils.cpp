@@ -6,7 +6,9 @@
  *
  */
 
+#include <AzCore/Math/Matrix3x3.h>
 #include <AzCore/Math/Quaternion.h>
+#include <AzCore/Math/Simd.h>
 #include <AzCore/Math/Transform.h>
 #include <Lidar/LidarTemplateUtils.h>
 
@@ -196,6 +198,23 @@ namespace ROS2
         };
     } // namespace
 
+    void LidarTemplateUtils::RayDirectionTable::Resize(size_t count)
+    {
+        m_x.resize(count);
+        m_y.resize(count);
+        m_z.resize(count);
+    }
+
+    size_t LidarTemplateUtils::RayDirectionTable::Size() const
+    {
+        return m_x.size();
+    }
+
+    AZ::Vector3 LidarTemplateUtils::RayDirectionTable::GetDirection(size_t index) const
+    {
+        return AZ::Vector3(m_x[index], m_y[index], m_z[index]);
+    }
+
     LidarTemplate LidarTemplateUtils::GetTemplate(LidarTemplate::LidarModel model)
     {
         auto it = templates.find(model);
@@ -269,14 +288,89 @@ namespace ROS2
         const AZStd::vector<AZ::Vector3>& rotations, const AZ::Transform& rootTransform)
     {
         AZStd::vector<AZ::Vector3> directions;
-        directions.reserve(rotations.size());
-        for (const auto& angle : rotations)
+        RotationsToDirections(rotations, rootTransform, directions);
+        return directions;
+    }
+
+    void LidarTemplateUtils::RotationsToDirections(
+        const AZStd::vector<AZ::Vector3>& rotations, const AZ::Transform& rootTransform, AZStd::vector<AZ::Vector3>& directions)
+    {
+        directions.resize(rotations.size());
+        const AZ::Quaternion rootRotation = rootTransform.GetRotation();
+        for (size_t i = 0; i < rotations.size(); ++i)
         {
+            const AZ::Vector3& angle = rotations[i];
             const AZ::Quaternion rotation =
-                rootTransform.GetRotation() * AZ::Quaternion::CreateFromEulerRadiansZYX({ 0.0f, -angle.GetY(), angle.GetZ() });
-            directions.emplace_back(rotation.TransformVector(AZ::Vector3::CreateAxisX()));
+                rootRotation * AZ::Quaternion::CreateFromEulerRadiansZYX({ 0.0f, -angle.GetY(), angle.GetZ() });
+            directions[i] = rotation.TransformVector(AZ::Vector3::CreateAxisX());
         }
+    }
 
-        return directions;
+    void LidarTemplateUtils::RotationsToLocalDirections(const AZStd::vector<AZ::Vector3>& rotations, RayDirectionTable& directions)
+    {
+        directions.Resize(rotations.size());
+        for (size_t i = 0; i < rotations.size(); ++i)
+        {
+            const AZ::Vector3& angle = rotations[i];
+            const AZ::Vector3 direction = AZ::Quaternion::CreateFromEulerRadiansZYX({ 0.0f, -angle.GetY(), angle.GetZ() })
+                                              .TransformVector(AZ::Vector3::CreateAxisX());
+            directions.m_x[i] = direction.GetX();
+            directions.m_y[i] = direction.GetY();
+            directions.m_z[i] = direction.GetZ();
+        }
+    }
+
+    void LidarTemplateUtils::RotateDirections(
+        const RayDirectionTable& localDirections, const AZ::Quaternion& rotation, RayDirectionTable& directions)
+    {
+        directions.Resize(localDirections.Size());
+        RotateDirections(localDirections, rotation, directions, 0, localDirections.Size());
+    }
+
+    void LidarTemplateUtils::RotateDirections(
+        const RayDirectionTable& localDirections, const AZ::Quaternion& rotation, RayDirectionTable& directions, size_t first, size_t last)
+    {
+        using AZ::Simd::Vec4;
+
+        AZ_Assert(first <= last && last <= localDirections.Size(), "Invalid range of directions to rotate.");
+        AZ_Assert(directions.Size() >= localDirections.Size(), "Output direction table is too small.");
+
+        const AZ::Matrix3x3 matrix = AZ::Matrix3x3::CreateFromQuaternion(rotation);
+        const float* inX = localDirections.m_x.data();
+        const float* inY = localDirections.m_y.data();
+        const float* inZ = localDirections.m_z.data();
+        float* outX = directions.m_x.data();
+        float* outY = directions.m_y.data();
+        float* outZ = directions.m_z.data();
+
+        const Vec4::FloatType m00 = Vec4::Splat(matrix.GetElement(0, 0));
+        const Vec4::FloatType m01 = Vec4::Splat(matrix.GetElement(0, 1));
+        const Vec4::FloatType m02 = Vec4::Splat(matrix.GetElement(0, 2));
+        const Vec4::FloatType m10 = Vec4::Splat(matrix.GetElement(1, 0));
+        const Vec4::FloatType m11 = Vec4::Splat(matrix.GetElement(1, 1));
+        const Vec4::FloatType m12 = Vec4::Splat(matrix.GetElement(1, 2));
+        const Vec4::FloatType m20 = Vec4::Splat(matrix.GetElement(2, 0));
+        const Vec4::FloatType m21 = Vec4::Splat(matrix.GetElement(2, 1));
+        const Vec4::FloatType m22 = Vec4::Splat(matrix.GetElement(2, 2));
+
+        // Four directions per iteration, each output coordinate being a dot product of a matrix row with the input.
+        size_t i = first;
+        for (; i + 4 <= last; i += 4)
+        {
+            const Vec4::FloatType x = Vec4::LoadUnaligned(inX + i);
+            const Vec4::FloatType y = Vec4::LoadUnaligned(inY + i);
+            const Vec4::FloatType z = Vec4::LoadUnaligned(inZ + i);
+            Vec4::StoreUnaligned(outX + i, Vec4::Madd(m02, z, Vec4::Madd(m01, y, Vec4::Mul(m00, x))));
+            Vec4::StoreUnaligned(outY + i, Vec4::Madd(m12, z, Vec4::Madd(m11, y, Vec4::Mul(m10, x))));
+            Vec4::StoreUnaligned(outZ + i, Vec4::Madd(m22, z, Vec4::Madd(m21, y, Vec4::Mul(m20, x))));
+        }
+
+        for (; i < last; ++i)
+        {
+            const AZ::Vector3 direction = matrix * AZ::Vector3(inX[i], inY[i], inZ[i]);
+            outX[i] = direction.GetX();
+            outY[i] = direction.GetY();
+            outZ[i] = direction.GetZ();
+        }
     }
 } // namespace ROS2
@@ -7,6 +7,7 @@
  */
 #pragma once
 
+#include <AzCore/Math/Quaternion.h>
 #include <AzCore/Math/Vector3.h>
 #include <AzCore/std/containers/vector.h>
 #include <Lidar/LidarTemplate.h>
@@ -16,6 +17,22 @@ namespace ROS2
     //! Utility class for Lidar model computations.
     namespace LidarTemplateUtils
     {
+        //! Ray directions stored as a structure of arrays, one array per coordinate.
+        //! This layout lets a single vectorized kernel rotate all directions of a scan.
+        struct RayDirectionTable
+        {
+            //! Resize all coordinate arrays to the given number of directions.
+            void Resize(size_t count);
+            //! @return Number of directions in the table.
+            size_t Size() const;
+            //! @return Direction at the given index.
+            AZ::Vector3 GetDirection(size_t index) const;
+
+            AZStd::vector<float> m_x;
+            AZStd::vector<float> m_y;
+            AZStd::vector<float> m_z;
+        };
+
         //! Get the lidar template for a model.
         //! @param model lidar model.
         //! @return the matching template which describes parameters for the model.
@@ -44,5 +61,33 @@ namespace ROS2
         //! @param rootRotation Root rotation as Euler angles in radians.
         //! @return Ray directions constructed by transforming an X axis unit vector by the provided rotations.
         AZStd::vector<AZ::Vector3> RotationsToDirections(const AZStd::vector<AZ::Vector3>& rotations, const AZ::Transform& rootTransform);
+
+        //! Compute ray directions from rotations, reusing the provided output buffer.
+        //! @param rotations Rotations as Euler angles in radians to compute directions from.
+        //! @param rootTransform Root transform whose rotation is applied to all directions.
+        //! @param directions Output buffer, resized to the number of rotations.
+        void RotationsToDirections(
+            const AZStd::vector<AZ::Vector3>& rotations, const AZ::Transform& rootTransform, AZStd::vector<AZ::Vector3>& directions);
+
+        //! Compute unit ray directions in the lidar frame from rotations.
+        //! Since the ray pattern is fixed, this only needs to be done once per configuration.
+        //! @param rotations Rotations as Euler angles in radians to compute directions from.
+        //! @param directions Output table, resized to the number of rotations.
+        void RotationsToLocalDirections(const AZStd::vector<AZ::Vector3>& rotations, RayDirectionTable& directions);
+
+        //! Rotate all directions of a table at once.
+        //! @param localDirections Directions to rotate, usually in the lidar frame.
+        //! @param rotation Rotation applied to each direction, usually the lidar world rotation.
+        //! @param directions Output table, resized to the size of localDirections.
+        void RotateDirections(const RayDirectionTable& localDirections, const AZ::Quaternion& rotation, RayDirectionTable& directions);
+
+        //! Rotate a range of directions of a table at once.
+        //! @param localDirections Directions to rotate, usually in the lidar frame.
+        //! @param rotation Rotation applied to each direction, usually the lidar world rotation.
+        //! @param directions Output table, which has to be at least as large as localDirections. Only the range is written.
+        //! @param first Index of the first direction to rotate.
+        //! @param last Index one past the last direction to rotate.
+        void RotateDirections(
+            const RayDirectionTable& localDirections, const AZ::Quaternion& rotation, RayDirectionTable& directions, size_t first, size_t last);
     }; // namespace LidarTemplateUtils
 } // namespace ROS2
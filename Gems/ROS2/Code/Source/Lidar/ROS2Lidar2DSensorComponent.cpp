@@ -67,12 +67,12 @@ namespace ROS2
     {
         m_lidarCore.Init(GetEntityId());
 
-        auto ros2Node = ROS2Interface::Get()->GetNode();
+        auto ros2Node = GetRobotNode();
         AZ_Assert(m_sensorConfiguration.m_publishersConfigurations.size() == 1, "Invalid configuration of publishers for lidar sensor");
 
         const TopicConfiguration& publisherConfig = m_sensorConfiguration.m_publishersConfigurations[LaserScanType];
         AZStd::string fullTopic = ROS2Names::GetNamespacedName(GetNamespace(), publisherConfig.m_topic);
-        m_laserScanPublisher = ros2Node->create_publisher<sensor_msgs::msg::LaserScan>(fullTopic.data(), publisherConfig.GetQoS());
+        m_laserScanPublisher = SensorPublisher<sensor_msgs::msg::LaserScan>::Create(ros2Node, fullTopic, publisherConfig.GetQoS());
 
         StartSensor(
             m_sensorConfiguration.m_frequency,
@@ -92,6 +92,7 @@ namespace ROS2
                 }
                 m_lidarCore.VisualizeResults();
             });
+        m_laserScanPublisher->SetSensorProfile(GetSensorProfile());
     }
 
     void ROS2Lidar2DSensorComponent::Deactivate()
@@ -108,10 +109,17 @@ namespace ROS2
 
     void ROS2Lidar2DSensorComponent::FrequencyTick()
     {
-        RaycastResult lastScanResults = m_lidarCore.PerformRaycast();
+        const RaycastResult& lastScanResults = m_lidarCore.PerformRaycast();
+
+        // The scan is written directly to a pooled message, which keeps the capacity of its ranges between scans.
+        sensor_msgs::msg::LaserScan* pooledMessage = m_laserScanPublisher->AcquireMessage();
+        if (!pooledMessage)
+        {
+            return;
+        }
 
         auto* ros2Frame = Utils::GetGameOrEditorComponent<ROS2FrameComponent>(GetEntity());
-        auto message = sensor_msgs::msg::LaserScan();
+        sensor_msgs::msg::LaserScan& message = *pooledMessage;
         message.header.frame_id = ros2Frame->GetFrameID().data();
         message.header.stamp = ROS2Interface::Get()->GetROSTimestamp();
         message.angle_min = AZ::DegToRad(m_lidarCore.m_lidarConfiguration.m_lidarParameters.m_minHAngle);
@@ -125,6 +133,6 @@ namespace ROS2
         message.time_increment = 0.0f;
 
         message.ranges.assign(lastScanResults.m_ranges.begin(), lastScanResults.m_ranges.end());
-        m_laserScanPublisher->publish(message);
+        m_laserScanPublisher->Submit(pooledMessage);
     }
 } // namespace ROS2
@@ -8,6 +8,7 @@
 
 #include <Atom/RPI.Public/AuxGeom/AuxGeomFeatureProcessorInterface.h>
 #include <Atom/RPI.Public/Scene.h>
+#include <Lidar/LidarPointCloudUtils.h>
 #include <Lidar/LidarRegistrarSystemComponent.h>
 #include <Lidar/ROS2LidarSensorComponent.h>
 #include <ROS2/Frame/ROS2FrameComponent.h>
@@ -74,7 +75,9 @@ namespace ROS2
 
         m_lidarRaycasterId = m_lidarCore.GetLidarRaycasterId();
         m_canRaycasterPublish = false;
-        if (m_lidarCore.m_lidarConfiguration.m_lidarSystemFeatures & LidarSystemFeatures::PointcloudPublishing)
+        // Spinning emission assembles revolutions from slices in the component, so it always publishes on its own.
+        if ((m_lidarCore.m_lidarConfiguration.m_lidarSystemFeatures & LidarSystemFeatures::PointcloudPublishing) &&
+            !m_lidarCore.m_lidarConfiguration.m_spinningEmission)
         {
             LidarRaycasterRequestBus::EventResult(
                 m_canRaycasterPublish, m_lidarRaycasterId, &LidarRaycasterRequestBus::Events::CanHandlePublishing);
@@ -87,26 +90,51 @@ namespace ROS2
 
             LidarRaycasterRequestBus::Event(
                 m_lidarRaycasterId,
-                &LidarRaycasterRequestBus::Events::ConfigurePointCloudPublisher,
+                &LidarRaycasterRequestBus::Events::ConfigureRobotPointCloudPublisher,
+                GetNamespace(),
                 ROS2Names::GetNamespacedName(GetNamespace(), publisherConfig.m_topic),
                 ros2Frame->GetFrameID().data(),
                 publisherConfig.GetQoS());
+
+            if (!m_sensorConfiguration.m_visualize)
+            {
+                // Only the raycast itself is left on this thread; the points go straight to the raycaster's publisher.
+                m_lidarCore.ConfigureRaycastResultFlags(RaycastResultFlags{});
+            }
         }
         else
         {
-            auto ros2Node = ROS2Interface::Get()->GetNode();
+            auto ros2Node = GetRobotNode();
             AZ_Assert(m_sensorConfiguration.m_publishersConfigurations.size() == 1, "Invalid configuration of publishers for lidar sensor");
 
             const TopicConfiguration& publisherConfig = m_sensorConfiguration.m_publishersConfigurations[PointCloudType];
             AZStd::string fullTopic = ROS2Names::GetNamespacedName(GetNamespace(), publisherConfig.m_topic);
-            m_pointCloudPublisher = ros2Node->create_publisher<sensor_msgs::msg::PointCloud2>(fullTopic.data(), publisherConfig.GetQoS());
+            m_pointCloudPublisher = SensorPublisher<sensor_msgs::msg::PointCloud2>::Create(ros2Node, fullTopic, publisherConfig.GetQoS());
+
+            auto* ros2Frame = Utils::GetGameOrEditorComponent<ROS2FrameComponent>(GetEntity());
+            m_pointCloudFrameId = ros2Frame->GetFrameID();
+        }
+
+        m_isSpinning = m_lidarCore.m_lidarConfiguration.m_spinningEmission;
+        m_revolutionMessage = nullptr;
+        m_nextIncrement = 0;
+        m_pendingIncrements = 0.0f;
+        if (m_isSpinning)
+        {
+            m_spinningEventHandler = PhysicsBasedSource::SourceEventHandlerType(
+                [this]([[maybe_unused]] AzPhysics::SceneHandle sceneHandle, float deltaTime)
+                {
+                    SpinningStep(deltaTime);
+                });
+            m_spinningSource.ConnectToSourceEvent(m_spinningEventHandler);
+            m_spinningSource.Start();
         }
 
         StartSensor(
             m_sensorConfiguration.m_frequency,
             [this]([[maybe_unused]] auto&&... args)
             {
-                if (!m_sensorConfiguration.m_publishingEnabled)
+                if (!m_sensorConfiguration.m_publishingEnabled || m_isSpinning)
                 {
                     return;
                 }
@@ -120,19 +148,25 @@ namespace ROS2
                 }
                 m_lidarCore.VisualizeResults();
             });
+        if (m_pointCloudPublisher)
+        {
+            m_pointCloudPublisher->SetSensorProfile(GetSensorProfile());
+        }
     }
 
     void ROS2LidarSensorComponent::Deactivate()
     {
         StopSensor();
+        m_spinningSource.Stop();
+        m_spinningEventHandler.Disconnect();
+        // The message of an unfinished revolution goes back to the pool with the publisher.
+        m_revolutionMessage = nullptr;
         m_pointCloudPublisher.reset();
         m_lidarCore.Deinit();
     }
 
     void ROS2LidarSensorComponent::FrequencyTick()
     {
-        auto entityTransform = GetEntity()->FindComponent<AzFramework::TransformComponent>();
-
         if (m_canRaycasterPublish)
         {
             const builtin_interfaces::msg::Time timestamp = ROS2Interface::Get()->GetROSTimestamp();
@@ -140,45 +174,118 @@ namespace ROS2
                 m_lidarRaycasterId,
                 &LidarRaycasterRequestBus::Events::UpdatePublisherTimestamp,
                 aznumeric_cast<AZ::u64>(timestamp.sec) * aznumeric_cast<AZ::u64>(1.0e9f) + timestamp.nanosec);
+
+            // Skip publishing when it can be handled by the raycaster. Scans without visualization can be batched with other lidars.
+            if (m_sensorConfiguration.m_visualize || !m_lidarCore.ScheduleRaycast())
+            {
+                m_lidarCore.PerformRaycast();
+            }
+            return;
+        }
+
+        // A message held for a revolution is left over after spinning emission fell back to full scans.
+        sensor_msgs::msg::PointCloud2* message = AZStd::exchange(m_revolutionMessage, nullptr);
+        if (!message)
+        {
+            message = AcquirePointCloudMessage();
         }
+        if (!message)
+        {
+            return;
+        }
+        message->header.stamp = ROS2Interface::Get()->GetROSTimestamp();
 
-        auto lastScanResults = m_lidarCore.PerformRaycast();
+        // Points are written by the raycaster straight into the message, unless they are needed for visualization
+        // or the raycaster does not support it, in which case they are converted from the raycast results.
+        // Organized clouds can only be written by the raycaster, which takes precedence over visualization.
+        const bool isWritten = (!m_sensorConfiguration.m_visualize || m_lidarCore.m_lidarConfiguration.m_organizedPointCloud) &&
+            m_lidarCore.PerformRaycastToPointCloud(*message);
+        if (!isWritten)
+        {
+            const RaycastResult& lastScanResults = m_lidarCore.PerformRaycast();
+            auto entityTransform = GetEntity()->FindComponent<AzFramework::TransformComponent>();
+            const auto inverseLidarTM = entityTransform->GetWorldTM().GetInverse();
 
-        if (m_canRaycasterPublish)
-        { // Skip publishing when it can be handled by the raycaster.
+            LidarPointCloudUtils::ResizePoints(*message, lastScanResults.m_points.size());
+            for (size_t i = 0; i < lastScanResults.m_points.size(); ++i)
+            {
+                LidarPointCloudUtils::WritePoint(*message, i, inverseLidarTM.TransformPoint(lastScanResults.m_points[i]));
+            }
+        }
+
+        m_pointCloudPublisher->Submit(message);
+    }
+
+    void ROS2LidarSensorComponent::SpinningStep(float deltaTime)
+    {
+        if (!m_sensorConfiguration.m_publishingEnabled || !m_isSpinning)
+        {
             return;
         }
 
-        const auto inverseLidarTM = entityTransform->GetWorldTM().GetInverse();
-        for (auto& point : lastScanResults.m_points)
+        const auto& lidarParameters = m_lidarCore.m_lidarConfiguration.m_lidarParameters;
+        const size_t increments = lidarParameters.m_numberOfIncrements;
+        const size_t layers = lidarParameters.m_layers;
+        if (increments == 0 || layers == 0)
         {
-            point = inverseLidarTM.TransformPoint(point);
+            return;
         }
 
-        auto* ros2Frame = Utils::GetGameOrEditorComponent<ROS2FrameComponent>(GetEntity());
-        auto message = sensor_msgs::msg::PointCloud2();
-        message.header.frame_id = ros2Frame->GetFrameID().data();
-        message.header.stamp = ROS2Interface::Get()->GetROSTimestamp();
-        message.height = 1;
-        message.width = lastScanResults.m_points.size();
-        message.point_step = sizeof(AZ::Vector3);
-        message.row_step = message.width * message.point_step;
-
-        AZStd::array<const char*, 3> point_field_names = { "x", "y", "z" };
-        for (int i = 0; i < point_field_names.size(); i++)
+        // The sensor frequency is the revolution rate, so a step sweeps deltaTime * frequency of all increments.
+        m_pendingIncrements += deltaTime * m_sensorConfiguration.m_frequency * aznumeric_cast<float>(increments);
+        while (m_pendingIncrements >= 1.0f)
         {
-            sensor_msgs::msg::PointField pf;
-            pf.name = point_field_names[i];
-            pf.offset = i * 4;
-            pf.datatype = sensor_msgs::msg::PointField::FLOAT32;
-            pf.count = 1;
-            message.fields.push_back(pf);
+            if (m_nextIncrement == 0)
+            {
+                // A revolution is stamped with the time its first slice is cast.
+                m_revolutionMessage = AcquirePointCloudMessage();
+                if (m_revolutionMessage)
+                {
+                    m_revolutionMessage->header.stamp = ROS2Interface::Get()->GetROSTimestamp();
+                    LidarPointCloudUtils::ResizePoints(*m_revolutionMessage, 0);
+                }
+            }
+
+            const size_t sliceIncrements = AZStd::min(aznumeric_cast<size_t>(m_pendingIncrements), increments - m_nextIncrement);
+            // Slices of a dropped revolution are swept without casting them.
+            if (m_revolutionMessage &&
+                !m_lidarCore.AppendRaycastToPointCloud(m_nextIncrement * layers, sliceIncrements * layers, *m_revolutionMessage))
+            {
+                AZ_Warning(
+                    "ROS2LidarSensorComponent",
+                    false,
+                    "Lidar implementation does not support spinning emission, casting full scans instead.");
+                // Full scans start from an empty message, without the slices of the unfinished revolution.
+                m_isSpinning = false;
+                m_nextIncrement = 0;
+                m_pendingIncrements = 0.0f;
+                LidarPointCloudUtils::ResizePoints(*m_revolutionMessage, 0);
+                return;
+            }
+
+            m_pendingIncrements -= aznumeric_cast<float>(sliceIncrements);
+            m_nextIncrement += sliceIncrements;
+            if (m_nextIncrement == increments)
+            {
+                if (m_revolutionMessage)
+                {
+                    m_pointCloudPublisher->Submit(AZStd::exchange(m_revolutionMessage, nullptr));
+                }
+                m_nextIncrement = 0;
+            }
         }
+    }
 
-        size_t sizeInBytes = lastScanResults.m_points.size() * sizeof(AZ::Vector3);
-        message.data.resize(sizeInBytes);
-        AZ_Assert(message.row_step * message.height == sizeInBytes, "Inconsistency in the size of point cloud data");
-        memcpy(message.data.data(), lastScanResults.m_points.data(), sizeInBytes);
-        m_pointCloudPublisher->publish(message);
+    sensor_msgs::msg::PointCloud2* ROS2LidarSensorComponent::AcquirePointCloudMessage()
+    {
+        sensor_msgs::msg::PointCloud2* message = m_pointCloudPublisher->AcquireMessage();
+        if (!message)
+        {
+            AZ_WarningOnce("ROS2LidarSensorComponent", false, "Point cloud publishing falls behind the lidar, dropping scans.");
+            return nullptr;
+        }
+        message->header.frame_id = m_pointCloudFrameId.c_str();
+        LidarPointCloudUtils::SetPackedXYZLayout(*message);
+        return message;
     }
 } // namespace ROS2
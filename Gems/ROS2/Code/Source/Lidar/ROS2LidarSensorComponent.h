@@ -11,9 +11,10 @@
 #include <AzCore/Serialization/SerializeContext.h>
 #include <ROS2/Lidar/LidarRegistrarBus.h>
 #include <ROS2/Lidar/LidarSystemBus.h>
+#include <ROS2/Sensor/Events/PhysicsBasedSource.h>
 #include <ROS2/Sensor/Events/TickBasedSource.h>
 #include <ROS2/Sensor/ROS2SensorComponentBase.h>
-#include <rclcpp/publisher.hpp>
+#include <ROS2/Sensor/SensorPublisher.h>
 #include <sensor_msgs/msg/point_cloud2.hpp>
 
 #include "LidarCore.h"
@@ -44,9 +45,30 @@ namespace ROS2
     private:
         //////////////////////////////////////////////////////////////////////////
         void FrequencyTick();
+        //! Casts the azimuth slice swept during a physics step in spinning emission mode.
+        //! @param deltaTime Physics step duration in seconds.
+        void SpinningStep(float deltaTime);
+
+        //! Takes a pooled message for a scan, with the frame and layout of the lidar points set.
+        //! @return Message to fill, or nullptr if the scan is dropped because publishing falls behind the lidar.
+        sensor_msgs::msg::PointCloud2* AcquirePointCloudMessage();
 
         bool m_canRaycasterPublish = false;
-        std::shared_ptr<rclcpp::Publisher<sensor_msgs::msg::PointCloud2>> m_pointCloudPublisher;
+        //! Publishes pooled messages, which keep the capacity of their data buffers between scans.
+        AZStd::unique_ptr<SensorPublisher<sensor_msgs::msg::PointCloud2>> m_pointCloudPublisher;
+        AZStd::string m_pointCloudFrameId;
+        //! Pooled message of the revolution being swept, or nullptr if the revolution is dropped.
+        //! When spinning emission falls back to full scans, the next full scan takes the message over.
+        sensor_msgs::msg::PointCloud2* m_revolutionMessage = nullptr;
+
+        //! Physics steps driving the spinning emission mode (see LidarSensorConfiguration::m_spinningEmission).
+        PhysicsBasedSource m_spinningSource;
+        PhysicsBasedSource::SourceEventHandlerType m_spinningEventHandler;
+        bool m_isSpinning = false;
+        //! Index of the next azimuth increment to cast in the current revolution.
+        size_t m_nextIncrement = 0;
+        //! Increments swept by the emulated sensor, but not cast yet (fractional part carried between physics steps).
+        float m_pendingIncrements = 0.0f;
 
         LidarCore m_lidarCore;
 
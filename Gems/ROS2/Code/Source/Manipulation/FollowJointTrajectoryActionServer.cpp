@@ -12,11 +12,12 @@
 
 namespace ROS2
 {
-    FollowJointTrajectoryActionServer::FollowJointTrajectoryActionServer(const AZStd::string& actionName, const AZ::EntityId& entityId)
+    FollowJointTrajectoryActionServer::FollowJointTrajectoryActionServer(
+        const std::shared_ptr<rclcpp::Node>& node, const AZStd::string& actionName, const AZ::EntityId& entityId)
         : m_entityId(entityId)
     {
         m_actionServer = rclcpp_action::create_server<FollowJointTrajectory>(
-            ROS2Interface::Get()->GetNode(),
+            node,
             actionName.c_str(),
             AZStd::bind(&FollowJointTrajectoryActionServer::GoalReceivedCallback, this, AZStd::placeholders::_1, AZStd::placeholders::_2),
             AZStd::bind(&FollowJointTrajectoryActionServer::GoalCancelledCallback, this, AZStd::placeholders::_1),
@@ -26,11 +26,13 @@ namespace ROS2
         using FollowJointTrajectory = control_msgs::action::FollowJointTrajectory;
 
         //! Create an action server for FollowJointTrajectory action and bind Goal callbacks.
+        //! @param node Node to create the action server on.
         //! @param actionName Name of the action, similar to topic or service name.
         //! @param entityId entity which will execute callbacks through JointsTrajectoryRequestBus.
         //! @see <a href="https://docs.ros.org/en/humble/p/rclcpp_action/generated/classrclcpp__action_1_1Server.html"> ROS 2 action
         //! server documentation </a>
-        FollowJointTrajectoryActionServer(const AZStd::string& actionName, const AZ::EntityId& entityId);
+        FollowJointTrajectoryActionServer(
+            const std::shared_ptr<rclcpp::Node>& node, const AZStd::string& actionName, const AZ::EntityId& entityId);
 
         //! Return trajectory action status.
         //! @return Status of the trajectory execution.
@@ -21,8 +21,8 @@ namespace ROS2
     {
         auto topicConfiguration = m_configuration.m_topicConfiguration;
         AZStd::string topic = ROS2Names::GetNamespacedName(context.m_publisherNamespace, topicConfiguration.m_topic);
-        auto ros2Node = ROS2Interface::Get()->GetNode();
-        m_jointStatePublisher = ros2Node->create_publisher<sensor_msgs::msg::JointState>(topic.data(), topicConfiguration.GetQoS());
+        auto ros2Node = ROS2Interface::Get()->GetRobotNode(context.m_publisherNamespace);
+        m_jointStatePublisher = SensorPublisher<sensor_msgs::msg::JointState>::Create(ros2Node, topic, topicConfiguration.GetQoS());
     }
 
     JointStatePublisher::~JointStatePublisher()
@@ -51,7 +51,7 @@ namespace ROS2
             m_jointStateMsg.velocity[i] = jointStateData.velocity;
             m_jointStateMsg.effort[i] = jointStateData.effort;
         }
-        m_jointStatePublisher->publish(m_jointStateMsg);
+        m_jointStatePublisher->Publish(m_jointStateMsg);
     }
 
     void JointStatePublisher::InitializePublisher()
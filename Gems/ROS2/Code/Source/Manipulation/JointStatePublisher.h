@@ -11,6 +11,7 @@
 #include <AzCore/Component/EntityId.h>
 #include <ROS2/Communication/PublisherConfiguration.h>
 #include <ROS2/Manipulation/JointInfo.h>
+#include <ROS2/Sensor/SensorPublisher.h>
 #include <rclcpp/publisher.hpp>
 #include <sensor_msgs/msg/joint_state.hpp>
 
@@ -45,7 +46,7 @@ namespace ROS2
         PublisherConfiguration m_configuration;
         JointStatePublisherContext m_context;
 
-        std::shared_ptr<rclcpp::Publisher<sensor_msgs::msg::JointState>> m_jointStatePublisher;
+        AZStd::unique_ptr<SensorPublisher<sensor_msgs::msg::JointState>> m_jointStatePublisher;
         sensor_msgs::msg::JointState m_jointStateMsg;
 
         AZStd::vector<AZStd::string> m_jointNames;
@@ -93,19 +93,19 @@ namespace ROS2
         const auto odometry = m_initialTransform.GetInverse() * rigidbodyPtr->GetTransform();
 
         m_odometryMsg.pose.pose = ROS2Conversions::ToROS2Pose(odometry);
-        m_odometryPublisher->publish(m_odometryMsg);
+        m_odometryPublisher->Publish(m_odometryMsg);
     }
     void ROS2OdometrySensorComponent::Activate()
     {
         // "odom" is globally fixed frame for all robots, no matter the namespace
         m_odometryMsg.header.frame_id = ROS2Names::GetNamespacedName(GetNamespace(), "odom").c_str();
         m_odometryMsg.child_frame_id = GetFrameID().c_str();
-        auto ros2Node = ROS2Interface::Get()->GetNode();
+        auto ros2Node = GetRobotNode();
         AZ_Assert(m_sensorConfiguration.m_publishersConfigurations.size() == 1, "Invalid configuration of publishers for Odometry sensor");
 
         const auto publisherConfig = m_sensorConfiguration.m_publishersConfigurations[OdometryMsgType];
         const auto fullTopic = ROS2Names::GetNamespacedName(GetNamespace(), publisherConfig.m_topic);
-        m_odometryPublisher = ros2Node->create_publisher<nav_msgs::msg::Odometry>(fullTopic.data(), publisherConfig.GetQoS());
+        m_odometryPublisher = SensorPublisher<nav_msgs::msg::Odometry>::Create(ros2Node, fullTopic, publisherConfig.GetQoS());
 
         StartSensor(
             m_sensorConfiguration.m_frequency,
@@ -117,6 +117,7 @@ namespace ROS2
                 }
                 OnOdometryEvent(sceneHandle);
             });
+        m_odometryPublisher->SetSensorProfile(GetSensorProfile());
     }
 
     void ROS2OdometrySensorComponent::Deactivate()
@@ -14,6 +14,7 @@
 #include <rclcpp/publisher.hpp>
 #include <ROS2/Sensor/Events/PhysicsBasedSource.h>
 #include <ROS2/Sensor/ROS2SensorComponentBase.h>
+#include <ROS2/Sensor/SensorPublisher.h>
 
 namespace ROS2
 {
@@ -38,7 +39,7 @@ namespace ROS2
 
     private:
         AzPhysics::SimulatedBodyHandle m_bodyHandle = AzPhysics::InvalidSimulatedBodyHandle;
-        std::shared_ptr<rclcpp::Publisher<nav_msgs::msg::Odometry>> m_odometryPublisher;
+        AZStd::unique_ptr<SensorPublisher<nav_msgs::msg::Odometry>> m_odometryPublisher;
         nav_msgs::msg::Odometry m_odometryMsg;
         AZ::Transform m_initialTransform;
 
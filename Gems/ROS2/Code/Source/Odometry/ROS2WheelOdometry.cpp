@@ -74,7 +74,7 @@ namespace ROS2
         m_odometryMsg.pose.pose.orientation = ROS2Conversions::ToROS2Quaternion(m_robotRotation);
         m_odometryMsg.pose.covariance = m_poseCovariance.GetRosCovariance();
 
-        m_odometryPublisher->publish(m_odometryMsg);
+        m_odometryPublisher->Publish(m_odometryMsg);
     }
 
     void ROS2WheelOdometryComponent::OnPhysicsEvent(float physicsDeltaTime)
@@ -107,12 +107,12 @@ namespace ROS2
         m_odometryMsg.header.frame_id = ROS2Names::GetNamespacedName(GetNamespace(), "odom").c_str();
         m_odometryMsg.child_frame_id = GetFrameID().c_str();
 
-        auto ros2Node = ROS2Interface::Get()->GetNode();
+        auto ros2Node = GetRobotNode();
         AZ_Assert(m_sensorConfiguration.m_publishersConfigurations.size() == 1, "Invalid configuration of publishers for Odometry sensor");
 
         const auto& publisherConfig = m_sensorConfiguration.m_publishersConfigurations[WheelOdometryMsgType];
         const auto fullTopic = ROS2Names::GetNamespacedName(GetNamespace(), publisherConfig.m_topic);
-        m_odometryPublisher = ros2Node->create_publisher<nav_msgs::msg::Odometry>(fullTopic.data(), publisherConfig.GetQoS());
+        m_odometryPublisher = SensorPublisher<nav_msgs::msg::Odometry>::Create(ros2Node, fullTopic, publisherConfig.GetQoS());
 
         StartSensor(
             m_sensorConfiguration.m_frequency,
@@ -128,6 +128,7 @@ namespace ROS2
             {
                 OnPhysicsEvent(physicsDeltaTime);
             });
+        m_odometryPublisher->SetSensorProfile(GetSensorProfile());
     }
 
     void ROS2WheelOdometryComponent::Deactivate()
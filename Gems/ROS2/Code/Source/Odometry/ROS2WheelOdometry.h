@@ -12,6 +12,7 @@
 #include <rclcpp/publisher.hpp>
 #include <ROS2/Sensor/Events/PhysicsBasedSource.h>
 #include <ROS2/Sensor/ROS2SensorComponentBase.h>
+#include <ROS2/Sensor/SensorPublisher.h>
 
 #include "ROS2OdometryCovariance.h"
 
@@ -37,7 +38,7 @@ namespace ROS2
         //////////////////////////////////////////////////////////////////////////
 
     private:
-        std::shared_ptr<rclcpp::Publisher<nav_msgs::msg::Odometry>> m_odometryPublisher;
+        AZStd::unique_ptr<SensorPublisher<nav_msgs::msg::Odometry>> m_odometryPublisher;
         nav_msgs::msg::Odometry m_odometryMsg;
         AZ::Vector3 m_robotPose{ 0 };
         AZ::Quaternion m_robotRotation{ 0, 0, 0, 1 };
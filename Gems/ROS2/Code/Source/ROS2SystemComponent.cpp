@@ -25,12 +25,28 @@
 #include <AzCore/Settings/SettingsRegistry.h>
 #include <AzCore/Time/ITime.h>
 #include <AzCore/std/smart_ptr/make_shared.h>
+#include <AzCore/std/string/string.h>
 #include <AzCore/std/string/string_view.h>
 #include <AzFramework/API/ApplicationAPI.h>
 
 namespace ROS2
 {
     constexpr AZStd::string_view EnablePhysicsSteadyClockConfigurationKey = "/O3DE/ROS2/SteadyClock";
+    constexpr AZStd::string_view ClockPublishRateConfigurationKey = "/O3DE/ROS2/Clock/PublishRate";
+    constexpr AZStd::string_view EnableLockstepConfigurationKey = "/O3DE/ROS2/Lockstep/Enabled";
+    constexpr AZStd::string_view EnableSensorProfilerConfigurationKey = "/O3DE/ROS2/SensorProfiler/Enabled";
+    constexpr AZStd::string_view SensorTraceFilePathConfigurationKey = "/O3DE/ROS2/SensorProfiler/TraceFilePath";
+    constexpr AZStd::string_view StaggerSensorPhasesConfigurationKey = "/O3DE/ROS2/SensorScheduling/StaggerPhases";
+    constexpr AZStd::string_view CostWeightedSensorPhasesConfigurationKey = "/O3DE/ROS2/SensorScheduling/CostWeighted";
+    constexpr AZStd::string_view ThreadedSensorPublishingConfigurationKey = "/O3DE/ROS2/SensorPublishing/Threaded";
+    constexpr AZStd::string_view EnableIntraProcessConfigurationKey = "/O3DE/ROS2/IntraProcess/Enabled";
+    constexpr AZStd::string_view EnableRobotNodesConfigurationKey = "/O3DE/ROS2/RobotNodes/Enabled";
+    constexpr AZStd::string_view RobotExecutorThreadsConfigurationKey = "/O3DE/ROS2/RobotNodes/ExecutorThreads";
+    constexpr AZStd::string_view ExecutorModeConfigurationKey = "/O3DE/ROS2/Executor/Mode";
+    constexpr AZStd::string_view TransformPublishRateConfigurationKey = "/O3DE/ROS2/DynamicTransforms/PublishRate";
+    constexpr AZStd::string_view TransformKeepAliveIntervalConfigurationKey = "/O3DE/ROS2/DynamicTransforms/KeepAliveInterval";
+    constexpr AZStd::string_view TransformLinearToleranceConfigurationKey = "/O3DE/ROS2/DynamicTransforms/LinearTolerance";
+    constexpr AZStd::string_view TransformAngularToleranceConfigurationKey = "/O3DE/ROS2/DynamicTransforms/AngularTolerance";
 
     void ROS2SystemComponent::Reflect(AZ::ReflectContext* context)
     {
@@ -114,20 +130,170 @@ namespace ROS2
     void ROS2SystemComponent::InitClock()
     {
         bool useSteadyTime = false;
+        double clockPublishRate = 0.0;
         auto* registry = AZ::SettingsRegistry::Get();
         AZ_Assert(registry, "No Registry available");
         if (registry)
         {
             registry->Get(useSteadyTime, EnablePhysicsSteadyClockConfigurationKey);
-            if (useSteadyTime)
+            registry->Get(clockPublishRate, ClockPublishRateConfigurationKey);
+        }
+
+        if (useSteadyTime)
+        {
+            AZ_Printf("ROS2SystemComponent", "Enabling Physical steady clock");
+            m_simulationClock = AZStd::make_unique<PhysicallyStableClock>();
+        }
+        else
+        {
+            AZ_Printf("ROS2SystemComponent", "Enabling realtime clock");
+            m_simulationClock = AZStd::make_unique<SimulationClock>();
+        }
+        m_simulationClock->SetClockPublishRate(clockPublishRate);
+    }
+
+    void ROS2SystemComponent::InitLockstep()
+    {
+        bool enableLockstep = false;
+        bool useSteadyTime = false;
+        if (auto* registry = AZ::SettingsRegistry::Get())
+        {
+            registry->Get(enableLockstep, EnableLockstepConfigurationKey);
+            registry->Get(useSteadyTime, EnablePhysicsSteadyClockConfigurationKey);
+        }
+        if (!enableLockstep)
+        {
+            return;
+        }
+
+        AZ_Warning(
+            "ROS2SystemComponent",
+            useSteadyTime,
+            "Lockstep simulation is enabled without the physical steady clock, timestamps will not follow the simulated steps");
+        m_lockstepSimulation = AZStd::make_unique<LockstepSimulation>();
+        m_lockstepSimulation->Activate(m_ros2Node);
+    }
+
+    void ROS2SystemComponent::InitSensorProfiler()
+    {
+        bool enableSensorProfiler = false;
+        AZStd::string traceFilePath = "@user@/ROS2/sensor_trace.json";
+        if (auto* registry = AZ::SettingsRegistry::Get())
+        {
+            registry->Get(enableSensorProfiler, EnableSensorProfilerConfigurationKey);
+            registry->Get(traceFilePath, SensorTraceFilePathConfigurationKey);
+        }
+        if (!enableSensorProfiler)
+        {
+            return;
+        }
+
+        AZ_Printf("ROS2SystemComponent", "Enabling sensor profiler");
+        m_sensorProfilerRegistry = AZStd::make_unique<SensorProfilerRegistry>(m_ros2Node, traceFilePath);
+    }
+
+    void ROS2SystemComponent::InitSensorPublishing()
+    {
+        bool threadedPublishing = true;
+        if (auto* registry = AZ::SettingsRegistry::Get())
+        {
+            registry->Get(threadedPublishing, ThreadedSensorPublishingConfigurationKey);
+        }
+        if (!threadedPublishing)
+        {
+            AZ_Printf("ROS2SystemComponent", "Publishing sensor messages on threads of their event sources");
+            return;
+        }
+
+        m_sensorPublishingThread = AZStd::make_unique<SensorPublishingThread>();
+        SensorPublishingInterface::Register(m_sensorPublishingThread.get());
+    }
+
+    void ROS2SystemComponent::InitSensorPhaseScheduler()
+    {
+        bool staggerPhases = true;
+        bool costWeighted = false;
+        if (auto* registry = AZ::SettingsRegistry::Get())
+        {
+            registry->Get(staggerPhases, StaggerSensorPhasesConfigurationKey);
+            registry->Get(costWeighted, CostWeightedSensorPhasesConfigurationKey);
+        }
+        if (!staggerPhases)
+        {
+            return;
+        }
+
+        m_sensorPhaseScheduler = AZStd::make_unique<SensorPhaseScheduler>(costWeighted);
+        m_sensorPhaseScheduler->Activate();
+        SensorPhaseSchedulerInterface::Register(m_sensorPhaseScheduler.get());
+    }
+
+    void ROS2SystemComponent::InitNodeComposition()
+    {
+        bool enableIntraProcess = false;
+        if (auto* registry = AZ::SettingsRegistry::Get())
+        {
+            registry->Get(enableIntraProcess, EnableIntraProcessConfigurationKey);
+        }
+        if (enableIntraProcess)
+        {
+            // The central node keeps inter-process publishing by default, since rclcpp does not support intra-process
+            // communication for transient local publishers such as the static transform broadcaster.
+            AZ_Printf("ROS2SystemComponent", "Enabling intra-process communication for sensors and composed nodes");
+        }
+        m_nodeComposition = AZStd::make_unique<NodeComposition>(*m_executor, enableIntraProcess);
+    }
+
+    void ROS2SystemComponent::InitRobotNodes()
+    {
+        bool enableRobotNodes = false;
+        AZ::u64 executorThreads = 0;
+        if (auto* registry = AZ::SettingsRegistry::Get())
+        {
+            registry->Get(enableRobotNodes, EnableRobotNodesConfigurationKey);
+            registry->Get(executorThreads, RobotExecutorThreadsConfigurationKey);
+        }
+        if (!enableRobotNodes)
+        {
+            return;
+        }
+
+        AZ_Printf("ROS2SystemComponent", "Creating a ROS 2 node for each robot");
+        m_robotNodes = AZStd::make_unique<RobotNodes>(*m_executor, aznumeric_cast<size_t>(executorThreads));
+    }
+
+    MarshallingExecutor::Mode ROS2SystemComponent::GetExecutorMode() const
+    {
+        AZStd::string mode;
+        auto* registry = AZ::SettingsRegistry::Get();
+        if (registry && registry->Get(mode, ExecutorModeConfigurationKey))
+        {
+            if (mode == "Background")
             {
-                AZ_Printf("ROS2SystemComponent", "Enabling Physical steady clock");
-                m_simulationClock = AZStd::make_unique<PhysicallyStableClock>();
-                return;
+                AZ_Printf("ROS2SystemComponent", "Handling ROS 2 callbacks on the executor thread");
+                return MarshallingExecutor::Mode::Background;
             }
+            AZ_Warning("ROS2SystemComponent", mode == "GameThread", "Unknown executor mode %s, using GameThread", mode.c_str());
+        }
+        return MarshallingExecutor::Mode::GameThread;
+    }
+
+    DynamicTransformPublisher::Configuration ROS2SystemComponent::GetTransformPublisherConfiguration() const
+    {
+        DynamicTransformPublisher::Configuration configuration;
+        auto* registry = AZ::SettingsRegistry::Get();
+        if (registry)
+        {
+            double linearTolerance = configuration.m_linearTolerance;
+            double angularTolerance = configuration.m_angularTolerance;
+            registry->Get(configuration.m_publishRate, TransformPublishRateConfigurationKey);
+            registry->Get(configuration.m_keepAliveInterval, TransformKeepAliveIntervalConfigurationKey);
+            registry->Get(linearTolerance, TransformLinearToleranceConfigurationKey);
+            registry->Get(angularTolerance, TransformAngularToleranceConfigurationKey);
+            configuration.m_linearTolerance = aznumeric_cast<float>(linearTolerance);
+            configuration.m_angularTolerance = aznumeric_cast<float>(angularTolerance);
         }
-        AZ_Printf("ROS2SystemComponent", "Enabling realtime clock");
-        m_simulationClock = AZStd::make_unique<SimulationClock>();
+        return configuration;
     }
 
     void ROS2SystemComponent::InitPassTemplateMappingsHandler()
@@ -148,11 +314,18 @@ namespace ROS2
         InitClock();
         m_simulationClock->Activate();
         m_ros2Node = std::make_shared<rclcpp::Node>("o3de_ros2_node");
-        m_executor = AZStd::make_shared<rclcpp::executors::SingleThreadedExecutor>();
+        m_executor = AZStd::make_shared<MarshallingExecutor>(GetExecutorMode());
         m_executor->add_node(m_ros2Node);
+        m_executor->Start();
+        InitNodeComposition();
+        InitRobotNodes();
 
         m_staticTFBroadcaster = AZStd::make_unique<tf2_ros::StaticTransformBroadcaster>(m_ros2Node);
-        m_dynamicTFBroadcaster = AZStd::make_unique<tf2_ros::TransformBroadcaster>(m_ros2Node);
+        m_dynamicTransformPublisher = AZStd::make_unique<DynamicTransformPublisher>(m_ros2Node, GetTransformPublisherConfiguration());
+        InitLockstep();
+        InitSensorProfiler();
+        InitSensorPhaseScheduler();
+        InitSensorPublishing();
 
         AZ::ApplicationTypeQuery appType;
         AZ::ComponentApplicationBus::Broadcast(&AZ::ComponentApplicationBus::Events::QueryApplicationType, appType);
@@ -163,22 +336,69 @@ namespace ROS2
 
         ROS2RequestBus::Handler::BusConnect();
         AZ::TickBus::Handler::BusConnect();
+        if (m_executor->GetMode() == MarshallingExecutor::Mode::Background)
+        {
+            AZ::EntitySystemBus::Handler::BusConnect();
+        }
     }
 
     void ROS2SystemComponent::Deactivate()
     {
+        AZ::EntitySystemBus::Handler::BusDisconnect();
         AZ::TickBus::Handler::BusDisconnect();
         ROS2RequestBus::Handler::BusDisconnect();
+        if (m_lockstepSimulation)
+        {
+            m_lockstepSimulation->Deactivate();
+            m_lockstepSimulation.reset();
+        }
+        if (m_sensorPublishingThread)
+        {
+            SensorPublishingInterface::Unregister(m_sensorPublishingThread.get());
+            m_sensorPublishingThread.reset();
+        }
+        m_sensorProfilerRegistry.reset();
+        if (m_sensorPhaseScheduler)
+        {
+            SensorPhaseSchedulerInterface::Unregister(m_sensorPhaseScheduler.get());
+            m_sensorPhaseScheduler->Deactivate();
+            m_sensorPhaseScheduler.reset();
+        }
         m_simulationClock->Deactivate();
         m_loadTemplatesHandler.Disconnect();
-        m_dynamicTFBroadcaster.reset();
+        m_dynamicTransformPublisher.reset();
         m_staticTFBroadcaster.reset();
+        m_robotNodes.reset();
+        m_nodeComposition.reset();
+        m_executor->Stop();
+        const CallbackLatencyStatistics statistics = m_executor->GetCallbackLatencyStatistics();
+        if (statistics.m_callbackCount > 0)
+        {
+            AZ_Printf(
+                "ROS2SystemComponent",
+                "Handled %llu ROS 2 callbacks, latency mean %.3f ms, max %.3f ms",
+                statistics.m_callbackCount,
+                1e-6 * statistics.m_totalLatencyNanoseconds / statistics.m_callbackCount,
+                1e-6 * statistics.m_maxLatencyNanoseconds);
+        }
         m_executor->remove_node(m_ros2Node);
         m_executor.reset();
         m_simulationClock.reset();
         m_ros2Node.reset();
     }
 
+    void ROS2SystemComponent::OnEntityDeactivated([[maybe_unused]] const AZ::EntityId& entityId)
+    {
+        // Components release their subscriptions and services when they deactivate, but a callback of one of them may still be
+        // running on the executor thread, or on a thread spinning robot nodes. Waiting for them keeps the components from being
+        // destroyed under the callbacks.
+        m_executor->WaitForRunningCallback();
+        if (m_robotNodes)
+        {
+            m_robotNodes->WaitForRunningCallbacks();
+        }
+    }
+
     builtin_interfaces::msg::Time ROS2SystemComponent::GetROSTimestamp() const
     {
         return m_simulationClock->GetROSTimestamp();
@@ -189,16 +409,85 @@ namespace ROS2
         return m_ros2Node;
     }
 
+    std::shared_ptr<rclcpp::Node> ROS2SystemComponent::GetRobotNode(const AZStd::string& ns)
+    {
+        if (m_robotNodes)
+        {
+            if (auto robotNode = m_robotNodes->GetNode(ns))
+            {
+                return robotNode;
+            }
+        }
+        return m_ros2Node;
+    }
+
+    void ROS2SystemComponent::AcquireRobotNode(const AZStd::string& ns)
+    {
+        if (m_robotNodes)
+        {
+            m_robotNodes->AcquireNode(ns);
+        }
+    }
+
+    void ROS2SystemComponent::ReleaseRobotNode(const AZStd::string& ns)
+    {
+        if (m_robotNodes)
+        {
+            m_robotNodes->ReleaseNode(ns);
+        }
+    }
+
     const SimulationClock& ROS2SystemComponent::GetSimulationClock() const
     {
         return *m_simulationClock;
     }
 
+    CallbackLatencyStatistics ROS2SystemComponent::GetCallbackLatencyStatistics() const
+    {
+        return m_executor ? m_executor->GetCallbackLatencyStatistics() : CallbackLatencyStatistics{};
+    }
+
+    bool ROS2SystemComponent::IsIntraProcessEnabled() const
+    {
+        return m_nodeComposition && m_nodeComposition->IsIntraProcessEnabled();
+    }
+
+    rclcpp::NodeOptions ROS2SystemComponent::GetComposedNodeOptions() const
+    {
+        return m_nodeComposition ? m_nodeComposition->GetNodeOptions() : rclcpp::NodeOptions();
+    }
+
+    void ROS2SystemComponent::AddComposedNode(const rclcpp::node_interfaces::NodeBaseInterface::SharedPtr& node)
+    {
+        AZ_Assert(m_nodeComposition, "Composing a node while the ROS 2 system component is not active.");
+        m_nodeComposition->AddNode(node);
+    }
+
+    void ROS2SystemComponent::RemoveComposedNode(const rclcpp::node_interfaces::NodeBaseInterface::SharedPtr& node)
+    {
+        if (m_nodeComposition)
+        {
+            m_nodeComposition->RemoveNode(node);
+        }
+    }
+
+    AZ::u64 ROS2SystemComponent::LoadComposedNode(
+        const AZStd::string& libraryPath, const AZStd::string& className, const AZStd::string& nodeName, const AZStd::string& nodeNamespace)
+    {
+        AZ_Assert(m_nodeComposition, "Loading a node while the ROS 2 system component is not active.");
+        return m_nodeComposition->LoadNode(libraryPath, className, nodeName, nodeNamespace);
+    }
+
+    bool ROS2SystemComponent::UnloadComposedNode(AZ::u64 nodeId)
+    {
+        return m_nodeComposition && m_nodeComposition->UnloadNode(nodeId);
+    }
+
     void ROS2SystemComponent::BroadcastTransform(const geometry_msgs::msg::TransformStamped& t, bool isDynamic)
     {
         if (isDynamic)
         {
-            m_frameTransforms.push_back(t);
+            m_dynamicTransformPublisher->QueueTransform(t);
         }
         else
         {
@@ -206,15 +495,29 @@ namespace ROS2
         }
     }
 
+    void ROS2SystemComponent::RegisterDynamicFrame(
+        AZ::EntityId frameEntityId, AZ::EntityId parentEntityId, const AZStd::string& parentFrameId, const AZStd::string& frameId)
+    {
+        m_dynamicTransformPublisher->RegisterFrame(frameEntityId, parentEntityId, parentFrameId, frameId);
+    }
+
+    void ROS2SystemComponent::UnregisterDynamicFrame(AZ::EntityId frameEntityId)
+    {
+        if (m_dynamicTransformPublisher)
+        {
+            m_dynamicTransformPublisher->UnregisterFrame(frameEntityId);
+        }
+    }
+
     void ROS2SystemComponent::OnTick([[maybe_unused]] float deltaTime, [[maybe_unused]] AZ::ScriptTimePoint time)
     {
         if (rclcpp::ok())
         {
-            m_dynamicTFBroadcaster->sendTransform(m_frameTransforms);
-            m_frameTransforms.clear();
+            m_dynamicTransformPublisher->Publish(m_simulationClock->GetROSTimestamp());
 
             m_simulationClock->Tick();
-            m_executor->spin_some();
+            // Callbacks taken by the executor thread since the last frame are handled here, after the clock is updated.
+            m_executor->ExecutePendingCallbacks();
         }
     }
 
@@ -9,16 +9,24 @@
 
 #include <Atom/RPI.Public/Pass/PassSystemInterface.h>
 #include <AzCore/Component/Component.h>
+#include <AzCore/Component/EntityBus.h>
 #include <AzCore/Component/TickBus.h>
 #include <AzCore/std/smart_ptr/unique_ptr.h>
+#include <Clock/LockstepSimulation.h>
+#include <Communication/MarshallingExecutor.h>
+#include <Communication/NodeComposition.h>
+#include <Communication/RobotNodes.h>
+#include <Frame/DynamicTransformPublisher.h>
 #include <Lidar/LidarSystem.h>
 #include <ROS2/Clock/SimulationClock.h>
 #include <ROS2/ROS2Bus.h>
+#include <Sensor/Events/SensorPhaseScheduler.h>
+#include <Sensor/SensorProfilerRegistry.h>
+#include <Sensor/SensorPublishingThread.h>
 #include <builtin_interfaces/msg/time.hpp>
 #include <memory>
 #include <rclcpp/rclcpp.hpp>
 #include <tf2_ros/static_transform_broadcaster.h>
-#include <tf2_ros/transform_broadcaster.h>
 
 /**
  * \mainpage
@@ -44,6 +52,7 @@ namespace ROS2
         : public AZ::Component
         , public AZ::TickBus::Handler
         , protected ROS2RequestBus::Handler
+        , protected AZ::EntitySystemBus::Handler
     {
     public:
         AZ_COMPONENT(ROS2SystemComponent, "{cb28d486-afa4-4a9f-a237-ac5eb42e1c87}");
@@ -61,9 +70,29 @@ namespace ROS2
         //////////////////////////////////////////////////////////////////////////
         // ROS2RequestBus::Handler overrides
         std::shared_ptr<rclcpp::Node> GetNode() const override;
+        std::shared_ptr<rclcpp::Node> GetRobotNode(const AZStd::string& ns) override;
+        void AcquireRobotNode(const AZStd::string& ns) override;
+        void ReleaseRobotNode(const AZStd::string& ns) override;
         builtin_interfaces::msg::Time GetROSTimestamp() const override;
         void BroadcastTransform(const geometry_msgs::msg::TransformStamped& t, bool isDynamic) override;
+        void RegisterDynamicFrame(
+            AZ::EntityId frameEntityId,
+            AZ::EntityId parentEntityId,
+            const AZStd::string& parentFrameId,
+            const AZStd::string& frameId) override;
+        void UnregisterDynamicFrame(AZ::EntityId frameEntityId) override;
         const SimulationClock& GetSimulationClock() const override;
+        CallbackLatencyStatistics GetCallbackLatencyStatistics() const override;
+        bool IsIntraProcessEnabled() const override;
+        rclcpp::NodeOptions GetComposedNodeOptions() const override;
+        void AddComposedNode(const rclcpp::node_interfaces::NodeBaseInterface::SharedPtr& node) override;
+        void RemoveComposedNode(const rclcpp::node_interfaces::NodeBaseInterface::SharedPtr& node) override;
+        AZ::u64 LoadComposedNode(
+            const AZStd::string& libraryPath,
+            const AZStd::string& className,
+            const AZStd::string& nodeName,
+            const AZStd::string& nodeNamespace) override;
+        bool UnloadComposedNode(AZ::u64 nodeId) override;
         //////////////////////////////////////////////////////////////////////////
 
         void InitPassTemplateMappingsHandler();
@@ -80,16 +109,39 @@ namespace ROS2
         // AZTickBus interface implementation
         void OnTick(float deltaTime, AZ::ScriptTimePoint time) override;
         ////////////////////////////////////////////////////////////////////////
+
+        ////////////////////////////////////////////////////////////////////////
+        // AZ::EntitySystemBus::Handler overrides
+        void OnEntityDeactivated(const AZ::EntityId& entityId) override;
+        ////////////////////////////////////////////////////////////////////////
     private:
         void InitClock();
-
-        std::vector<geometry_msgs::msg::TransformStamped> m_frameTransforms;
+        void InitLockstep();
+        void InitSensorProfiler();
+        void InitSensorPhaseScheduler();
+        void InitSensorPublishing();
+        void InitNodeComposition();
+        void InitRobotNodes();
+        MarshallingExecutor::Mode GetExecutorMode() const;
+        DynamicTransformPublisher::Configuration GetTransformPublisherConfiguration() const;
 
         std::shared_ptr<rclcpp::Node> m_ros2Node;
-        AZStd::shared_ptr<rclcpp::executors::SingleThreadedExecutor> m_executor;
-        AZStd::unique_ptr<tf2_ros::TransformBroadcaster> m_dynamicTFBroadcaster;
+        AZStd::shared_ptr<MarshallingExecutor> m_executor;
+        //! Nodes composed into the simulator process, handled by the executor.
+        AZStd::unique_ptr<NodeComposition> m_nodeComposition;
+        //! Present only when per-robot nodes are enabled.
+        AZStd::unique_ptr<RobotNodes> m_robotNodes;
+        AZStd::unique_ptr<DynamicTransformPublisher> m_dynamicTransformPublisher;
         AZStd::unique_ptr<tf2_ros::StaticTransformBroadcaster> m_staticTFBroadcaster;
         AZStd::unique_ptr<SimulationClock> m_simulationClock;
+        //! Present only when lockstep simulation is enabled.
+        AZStd::unique_ptr<LockstepSimulation> m_lockstepSimulation;
+        //! Present only when sensor profiling is enabled.
+        AZStd::unique_ptr<SensorProfilerRegistry> m_sensorProfilerRegistry;
+        //! Present unless staggering of sensor phases is disabled.
+        AZStd::unique_ptr<SensorPhaseScheduler> m_sensorPhaseScheduler;
+        //! Present unless sensors publish on threads of their event sources.
+        AZStd::unique_ptr<SensorPublishingThread> m_sensorPublishingThread;
         //! Load the pass templates of the ROS2 gem.
         void LoadPassTemplateMappings();
         AZ::RPI::PassSystemInterface::OnReadyLoadTemplatesEvent::Handler m_loadTemplatesHandler;
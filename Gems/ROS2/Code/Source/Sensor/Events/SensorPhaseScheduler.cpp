@@ -0,0 +1,331 @@
+/*
+ * Copyright (c) Contributors to the Open 3D Engine Project.
+ * For complete copyright and license terms please see the LICENSE at the root of this distribution.
+ *
+ * SPDX-License-Identifier: Apache-2.0 OR MIT
+ *
+ */
+
+#include <AzCore/std/algorithm.h>
+#include <AzCore/std/sort.h>
+#include <AzFramework/Physics/PhysicsScene.h>
+#include <ROS2/Sensor/Events/PhysicsBasedSource.h>
+#include <ROS2/Sensor/Events/TickBasedSource.h>
+#include <Sensor/Events/SensorPhaseScheduler.h>
+
+namespace ROS2
+{
+    namespace
+    {
+        //! Cost assumed for a sensor before it is measured, when its group has no measured sensors either.
+        constexpr float DefaultCost = 1e-3f;
+        //! Weight of a new measurement in the moving average of the cost.
+        constexpr float CostSmoothing = 0.2f;
+        constexpr float RebalanceInterval = 1.0f;
+        //! Phases are reassigned only if it lowers the highest load by this fraction, so that noise does not shift sensors.
+        constexpr float RebalanceMargin = 0.1f;
+        constexpr size_t InvalidIndex = AZStd::numeric_limits<size_t>::max();
+
+        //! Orders phases by the bit-reversed sequence, e.g. 0, 5, 2, 7, 1, 6, 3, 8, 4, 9 for a period of 10.
+        AZStd::vector<AZ::u32> MakePhaseOrder(AZ::u32 period)
+        {
+            AZ::u32 bitCount = 0;
+            while ((AZ::u32{ 1 } << bitCount) < period)
+            {
+                ++bitCount;
+            }
+
+            AZStd::vector<AZ::u32> phaseOrder;
+            phaseOrder.reserve(period);
+            AZStd::vector<bool> isOrdered(period, false);
+            for (AZ::u32 index = 0; index < (AZ::u32{ 1 } << bitCount); ++index)
+            {
+                AZ::u32 reversed = 0;
+                for (AZ::u32 bit = 0; bit < bitCount; ++bit)
+                {
+                    reversed |= ((index >> bit) & 1) << (bitCount - 1 - bit);
+                }
+                // Scaling the reversed index to the period covers every phase, since the power of two is not smaller than the period.
+                const AZ::u32 phase = aznumeric_cast<AZ::u32>((AZ::u64{ reversed } * period) >> bitCount);
+                if (!isOrdered[phase])
+                {
+                    isOrdered[phase] = true;
+                    phaseOrder.push_back(phase);
+                }
+            }
+            return phaseOrder;
+        }
+    } // namespace
+
+    SensorPhaseScheduler::SensorPhaseScheduler(bool isCostWeighted)
+        : m_isCostWeighted(isCostWeighted)
+    {
+        m_tickCounters.push_back({ azrtti_typeid<TickBasedSource>() });
+        m_tickCounters.push_back({ azrtti_typeid<PhysicsBasedSource>() });
+
+        m_physicsStepHandler = AzPhysics::SceneEvents::OnSceneSimulationStartHandler(
+            [this]([[maybe_unused]] AzPhysics::SceneHandle sceneHandle, [[maybe_unused]] float fixedDeltaTime)
+            {
+                AdvanceTick(azrtti_typeid<PhysicsBasedSource>());
+            });
+    }
+
+    SensorPhaseScheduler::~SensorPhaseScheduler()
+    {
+        Deactivate();
+    }
+
+    void SensorPhaseScheduler::Activate()
+    {
+        m_isActive = true;
+        AZ::TickBus::Handler::BusConnect();
+    }
+
+    void SensorPhaseScheduler::Deactivate()
+    {
+        m_isActive = false;
+        AZ::TickBus::Handler::BusDisconnect();
+        m_physicsStepHandler.Disconnect();
+    }
+
+    void SensorPhaseScheduler::ConnectToPhysicsScene()
+    {
+        auto* sceneInterface = AZ::Interface<AzPhysics::SceneInterface>::Get();
+        if (!sceneInterface)
+        {
+            return;
+        }
+        // Physics based sources signal events of the default scene, which is created with the level, after the scheduler.
+        const AzPhysics::SceneHandle sceneHandle = sceneInterface->GetSceneHandle(AzPhysics::DefaultPhysicsSceneName);
+        if (sceneHandle != AzPhysics::InvalidSceneHandle)
+        {
+            sceneInterface->RegisterSceneSimulationStartHandler(sceneHandle, m_physicsStepHandler);
+        }
+    }
+
+    void SensorPhaseScheduler::OnTick(float deltaTime, [[maybe_unused]] AZ::ScriptTimePoint time)
+    {
+        AdvanceTick(azrtti_typeid<TickBasedSource>());
+
+        if (m_isCostWeighted)
+        {
+            m_timeSinceRebalance += deltaTime;
+            if (m_timeSinceRebalance >= RebalanceInterval)
+            {
+                m_timeSinceRebalance = 0.0f;
+                Rebalance();
+            }
+        }
+    }
+
+    int SensorPhaseScheduler::GetTickOrder()
+    {
+        // Ticks are counted before tick based sources signal them.
+        return AZ::TICK_FIRST;
+    }
+
+    void SensorPhaseScheduler::AdvanceTick(const AZ::TypeId& sourceType)
+    {
+        if (const size_t tickCounter = FindTickCounter(sourceType); tickCounter != InvalidIndex)
+        {
+            ++m_tickCounters[tickCounter].m_tickCount;
+        }
+    }
+
+    size_t SensorPhaseScheduler::FindTickCounter(const AZ::TypeId& sourceType) const
+    {
+        for (size_t i = 0; i < m_tickCounters.size(); ++i)
+        {
+            if (m_tickCounters[i].m_sourceType == sourceType)
+            {
+                return i;
+            }
+        }
+        return InvalidIndex;
+    }
+
+    size_t SensorPhaseScheduler::FindOrAddGroup(size_t tickCounter, AZ::u32 period)
+    {
+        for (size_t i = 0; i < m_groups.size(); ++i)
+        {
+            if (m_groups[i].m_tickCounter == tickCounter && m_groups[i].m_period == period)
+            {
+                return i;
+            }
+        }
+
+        PhaseGroup& group = m_groups.emplace_back();
+        group.m_tickCounter = tickCounter;
+        group.m_period = period;
+        group.m_loads.resize(period, 0.0f);
+        group.m_phaseOrder = MakePhaseOrder(period);
+        return m_groups.size() - 1;
+    }
+
+    AZ::u32 SensorPhaseScheduler::GetLeastLoadedPhase(const AZStd::vector<float>& loads, const AZStd::vector<AZ::u32>& phaseOrder)
+    {
+        AZ::u32 leastLoadedPhase = phaseOrder.front();
+        for (const AZ::u32 phase : phaseOrder)
+        {
+            if (loads[phase] < loads[leastLoadedPhase])
+            {
+                leastLoadedPhase = phase;
+            }
+        }
+        return leastLoadedPhase;
+    }
+
+    SensorPhaseScheduler::PhaseHandle SensorPhaseScheduler::AcquirePhase(const AZ::TypeId& sourceType, AZ::u32 period)
+    {
+        const size_t tickCounter = FindTickCounter(sourceType);
+        if (tickCounter == InvalidIndex || period == 0)
+        {
+            return InvalidPhaseHandle;
+        }
+        if (m_isActive && sourceType == azrtti_typeid<PhysicsBasedSource>() && !m_physicsStepHandler.IsConnected())
+        {
+            ConnectToPhysicsScene();
+        }
+
+        const size_t groupIndex = FindOrAddGroup(tickCounter, period);
+        PhaseGroup& group = m_groups[groupIndex];
+
+        float cost = 1.0f;
+        if (m_isCostWeighted)
+        {
+            // Until measured, a sensor is assumed to cost as much as others of its group.
+            cost = DefaultCost;
+            if (!group.m_members.empty())
+            {
+                float totalCost = 0.0f;
+                for (const PhaseHandle member : group.m_members)
+                {
+                    totalCost += m_phases[member].m_cost;
+                }
+                cost = totalCost / aznumeric_cast<float>(group.m_members.size());
+            }
+        }
+
+        PhaseHandle handle = aznumeric_cast<PhaseHandle>(m_phases.size());
+        if (!m_freePhases.empty())
+        {
+            handle = m_freePhases.back();
+            m_freePhases.pop_back();
+        }
+        else
+        {
+            m_phases.emplace_back();
+        }
+
+        Phase& phase = m_phases[handle];
+        phase.m_group = groupIndex;
+        phase.m_phase = GetLeastLoadedPhase(group.m_loads, group.m_phaseOrder);
+        phase.m_cost = cost;
+        phase.m_isUsed = true;
+        group.m_loads[phase.m_phase] += cost;
+        group.m_members.push_back(handle);
+        return handle;
+    }
+
+    void SensorPhaseScheduler::ReleasePhase(PhaseHandle handle)
+    {
+        if (handle >= m_phases.size() || !m_phases[handle].m_isUsed)
+        {
+            return;
+        }
+
+        Phase& phase = m_phases[handle];
+        PhaseGroup& group = m_groups[phase.m_group];
+        group.m_loads[phase.m_phase] = AZStd::max(0.0f, group.m_loads[phase.m_phase] - phase.m_cost);
+        group.m_members.erase(AZStd::remove(group.m_members.begin(), group.m_members.end(), handle), group.m_members.end());
+        phase = Phase{};
+        m_freePhases.push_back(handle);
+    }
+
+    AZ::u32 SensorPhaseScheduler::GetPhaseDelay(PhaseHandle handle) const
+    {
+        if (handle >= m_phases.size() || !m_phases[handle].m_isUsed)
+        {
+            return 0;
+        }
+
+        const Phase& phase = m_phases[handle];
+        const PhaseGroup& group = m_groups[phase.m_group];
+        const AZ::u32 currentPhase = aznumeric_cast<AZ::u32>(m_tickCounters[group.m_tickCounter].m_tickCount % group.m_period);
+        return (phase.m_phase + group.m_period - currentPhase) % group.m_period;
+    }
+
+    AZ::u32 SensorPhaseScheduler::GetPhase(PhaseHandle handle) const
+    {
+        return handle < m_phases.size() ? m_phases[handle].m_phase : 0;
+    }
+
+    void SensorPhaseScheduler::ReportCost(PhaseHandle handle, float duration)
+    {
+        if (!m_isCostWeighted || handle >= m_phases.size() || !m_phases[handle].m_isUsed)
+        {
+            return;
+        }
+
+        Phase& phase = m_phases[handle];
+        const float cost = phase.m_cost + CostSmoothing * (duration - phase.m_cost);
+        float& load = m_groups[phase.m_group].m_loads[phase.m_phase];
+        load = AZStd::max(0.0f, load + cost - phase.m_cost);
+        phase.m_cost = cost;
+    }
+
+    void SensorPhaseScheduler::Rebalance()
+    {
+        for (PhaseGroup& group : m_groups)
+        {
+            if (group.m_members.size() < 2)
+            {
+                continue;
+            }
+
+            // Longest processing time first: the most expensive sensors take the least loaded phases.
+            AZStd::vector<PhaseHandle> members = group.m_members;
+            AZStd::sort(
+                members.begin(),
+                members.end(),
+                [this](PhaseHandle lhs, PhaseHandle rhs)
+                {
+                    return m_phases[lhs].m_cost > m_phases[rhs].m_cost;
+                });
+
+            AZStd::vector<float> loads(group.m_period, 0.0f);
+            AZStd::vector<AZ::u32> assignedPhases;
+            assignedPhases.reserve(members.size());
+            for (const PhaseHandle member : members)
+            {
+                const AZ::u32 assignedPhase = GetLeastLoadedPhase(loads, group.m_phaseOrder);
+                loads[assignedPhase] += m_phases[member].m_cost;
+                assignedPhases.push_back(assignedPhase);
+            }
+
+            const float currentPeak = *AZStd::max_element(group.m_loads.begin(), group.m_loads.end());
+            const float balancedPeak = *AZStd::max_element(loads.begin(), loads.end());
+            if (balancedPeak < (1.0f - RebalanceMargin) * currentPeak)
+            {
+                for (size_t i = 0; i < members.size(); ++i)
+                {
+                    m_phases[members[i]].m_phase = assignedPhases[i];
+                }
+                group.m_loads = AZStd::move(loads);
+            }
+        }
+    }
+
+    float SensorPhaseScheduler::GetPhaseLoad(const AZ::TypeId& sourceType, AZ::u32 period, AZ::u32 phase) const
+    {
+        const size_t tickCounter = FindTickCounter(sourceType);
+        for (const PhaseGroup& group : m_groups)
+        {
+            if (group.m_tickCounter == tickCounter && group.m_period == period && phase < period)
+            {
+                return group.m_loads[phase];
+            }
+        }
+        return 0.0f;
+    }
+} // namespace ROS2
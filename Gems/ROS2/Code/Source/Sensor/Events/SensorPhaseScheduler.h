@@ -0,0 +1,104 @@
+/*
+ * Copyright (c) Contributors to the Open 3D Engine Project.
+ * For complete copyright and license terms please see the LICENSE at the root of this distribution.
+ *
+ * SPDX-License-Identifier: Apache-2.0 OR MIT
+ *
+ */
+
+#pragma once
+
+#include <AzCore/Component/TickBus.h>
+#include <AzCore/std/containers/vector.h>
+#include <AzFramework/Physics/Common/PhysicsEvents.h>
+#include <ROS2/Sensor/Events/SensorPhaseSchedulerBus.h>
+
+namespace ROS2
+{
+    //! Assigns phases to sensors of ROS2::TickBasedSource and ROS2::PhysicsBasedSource. Ticks of both sources are counted before sensors
+    //! receive them: ticks at the first tick order and physics steps at their start. So all sensors agree on the current tick,
+    //! regardless of the order in which their handlers are called. Sensors with the same source and period form a group, in which each
+    //! new sensor takes the least loaded phase. With cost weighting, phases of each group are periodically reassigned by measured cost.
+    //! All calls are expected on the game thread, where both sources signal their events.
+    class SensorPhaseScheduler
+        : public SensorPhaseSchedulerRequests
+        , protected AZ::TickBus::Handler
+    {
+    public:
+        AZ_RTTI(SensorPhaseScheduler, "{8E4B2C61-7A3D-4B9F-A5C2-0D6E1F3A7B58}", SensorPhaseSchedulerRequests);
+
+        //! @param isCostWeighted Whether phases balance measured cost of sensors, rather than their number.
+        explicit SensorPhaseScheduler(bool isCostWeighted = false);
+        ~SensorPhaseScheduler() override;
+
+        //! Starts counting ticks of event sources.
+        void Activate();
+        void Deactivate();
+
+        //! Counts a tick of the given source type. Ticks are counted by the scheduler itself once activated.
+        void AdvanceTick(const AZ::TypeId& sourceType);
+
+        //! Reassigns phases in every group by cost, if it lowers the highest load of the group by a meaningful margin.
+        void Rebalance();
+
+        //! Returns the load of a phase: total cost of its sensors with cost weighting, or their number otherwise.
+        float GetPhaseLoad(const AZ::TypeId& sourceType, AZ::u32 period, AZ::u32 phase) const;
+
+        //! Returns the phase of a handle, in range [0, period).
+        AZ::u32 GetPhase(PhaseHandle handle) const;
+
+        // SensorPhaseSchedulerRequests overrides
+        PhaseHandle AcquirePhase(const AZ::TypeId& sourceType, AZ::u32 period) override;
+        void ReleasePhase(PhaseHandle handle) override;
+        AZ::u32 GetPhaseDelay(PhaseHandle handle) const override;
+        void ReportCost(PhaseHandle handle, float duration) override;
+
+    private:
+        // AZ::TickBus::Handler overrides
+        void OnTick(float deltaTime, AZ::ScriptTimePoint time) override;
+        int GetTickOrder() override;
+
+        void ConnectToPhysicsScene();
+
+        struct TickCounter
+        {
+            AZ::TypeId m_sourceType;
+            AZ::u64 m_tickCount = 0;
+        };
+
+        //! Sensors with the same source and period, and the load of each of their phases.
+        struct PhaseGroup
+        {
+            size_t m_tickCounter;
+            AZ::u32 m_period;
+            AZStd::vector<float> m_loads;
+            //! Phases in the order they are tried for new sensors, so that few sensors are spread as far apart as possible.
+            AZStd::vector<AZ::u32> m_phaseOrder;
+            AZStd::vector<PhaseHandle> m_members;
+        };
+
+        struct Phase
+        {
+            size_t m_group = 0;
+            AZ::u32 m_phase = 0;
+            float m_cost = 0.0f;
+            bool m_isUsed = false;
+        };
+
+        size_t FindTickCounter(const AZ::TypeId& sourceType) const;
+        size_t FindOrAddGroup(size_t tickCounter, AZ::u32 period);
+        //! Returns the least loaded phase of the group, trying phases in the group order.
+        static AZ::u32 GetLeastLoadedPhase(const AZStd::vector<float>& loads, const AZStd::vector<AZ::u32>& phaseOrder);
+
+        bool m_isCostWeighted;
+        float m_timeSinceRebalance = 0.0f;
+
+        AZStd::vector<TickCounter> m_tickCounters;
+        AZStd::vector<PhaseGroup> m_groups;
+        AZStd::vector<Phase> m_phases;
+        AZStd::vector<PhaseHandle> m_freePhases;
+
+        AzPhysics::SceneEvents::OnSceneSimulationStartHandler m_physicsStepHandler;
+        bool m_isActive = false;
+    };
+} // namespace ROS2
@@ -0,0 +1,112 @@
+/*
+ * Copyright (c) Contributors to the Open 3D Engine Project.
+ * For complete copyright and license terms please see the LICENSE at the root of this distribution.
+ *
+ * SPDX-License-Identifier: Apache-2.0 OR MIT
+ *
+ */
+
+#include <AzCore/std/algorithm.h>
+#include <ROS2/Sensor/SensorProfiler.h>
+
+namespace ROS2
+{
+    namespace
+    {
+        const char* GetCallbackName(SensorCallbackType type)
+        {
+            return type == SensorCallbackType::Source ? "source" : "adapted";
+        }
+    } // namespace
+
+    SensorProfile::SensorProfile(AZStd::string sensorName)
+        : m_sensorName(AZStd::move(sensorName))
+    {
+        m_traceEvents.reserve(TraceEventCapacity);
+    }
+
+    void SensorProfile::RecordCallback(SensorCallbackType type, Clock::time_point start, Clock::time_point end)
+    {
+        const Clock::duration duration = end - start;
+        const AZ::u64 durationNanoseconds =
+            static_cast<AZ::u64>(AZStd::chrono::duration_cast<AZStd::chrono::nanoseconds>(duration).count());
+
+        AZStd::scoped_lock lock(m_mutex);
+        CallbackRecord& record = m_callbacks[static_cast<size_t>(type)];
+        ++record.m_callCount;
+        record.m_totalDurationNanoseconds += durationNanoseconds;
+        record.m_maxDurationNanoseconds = AZStd::max(record.m_maxDurationNanoseconds, durationNanoseconds);
+        record.m_99thPercentileDuration.Add(static_cast<double>(durationNanoseconds));
+
+        if (m_traceEvents.size() < TraceEventCapacity)
+        {
+            m_traceEvents.push_back({ start, duration, type });
+        }
+        else
+        {
+            m_traceEvents[m_nextTraceEvent] = { start, duration, type };
+        }
+        m_nextTraceEvent = (m_nextTraceEvent + 1) % TraceEventCapacity;
+    }
+
+    void SensorProfile::RecordPublishedBytes(size_t byteCount)
+    {
+        m_publishedBytes.fetch_add(byteCount, AZStd::memory_order_relaxed);
+    }
+
+    const AZStd::string& SensorProfile::GetSensorName() const
+    {
+        return m_sensorName;
+    }
+
+    SensorStatistics SensorProfile::GetStatistics() const
+    {
+        SensorStatistics statistics;
+        statistics.m_sensorName = m_sensorName;
+        statistics.m_publishedBytes = m_publishedBytes.load(AZStd::memory_order_relaxed);
+
+        AZStd::scoped_lock lock(m_mutex);
+        for (size_t i = 0; i < static_cast<size_t>(SensorCallbackType::Count); ++i)
+        {
+            const CallbackRecord& record = m_callbacks[i];
+            SensorCallbackStatistics& callbackStatistics = statistics.m_callbacks[i];
+            callbackStatistics.m_callCount = record.m_callCount;
+            if (record.m_callCount > 0)
+            {
+                callbackStatistics.m_meanDuration = 1e-6 * record.m_totalDurationNanoseconds / record.m_callCount;
+                callbackStatistics.m_99thPercentileDuration = 1e-6 * record.m_99thPercentileDuration.GetEstimate();
+                callbackStatistics.m_maxDuration = 1e-6 * record.m_maxDurationNanoseconds;
+            }
+        }
+        return statistics;
+    }
+
+    void SensorProfile::AppendTraceEvents(AZStd::string& traceEvents, Clock::time_point epoch, size_t threadId) const
+    {
+        AZStd::scoped_lock lock(m_mutex);
+
+        // Thread name metadata labels the track of the sensor.
+        if (!traceEvents.empty())
+        {
+            traceEvents += ",\n";
+        }
+        traceEvents += AZStd::string::format(
+            R"({"name":"thread_name","ph":"M","pid":1,"tid":%zu,"args":{"name":"%s"}})", threadId, m_sensorName.c_str());
+
+        // Oldest events first, starting after the most recent one once the ring buffer wrapped around.
+        const size_t first = m_traceEvents.size() < TraceEventCapacity ? 0 : m_nextTraceEvent;
+        for (size_t i = 0; i < m_traceEvents.size(); ++i)
+        {
+            const TraceEvent& event = m_traceEvents[(first + i) % m_traceEvents.size()];
+            const double timestamp = AZStd::chrono::duration<double, AZStd::chrono::microseconds::period>(event.m_start - epoch).count();
+            const double duration = AZStd::chrono::duration<double, AZStd::chrono::microseconds::period>(event.m_duration).count();
+            traceEvents += AZStd::string::format(
+                ",\n"
+                R"({"name":"%s","cat":"sensor","ph":"X","ts":%.3f,"dur":%.3f,"pid":1,"tid":%zu})",
+                GetCallbackName(event.m_type),
+                timestamp,
+                duration,
+                threadId);
+        }
+    }
+} // namespace ROS2
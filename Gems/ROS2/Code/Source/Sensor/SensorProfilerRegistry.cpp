@@ -0,0 +1,205 @@
+/*
+ * Copyright (c) Contributors to the Open 3D Engine Project.
+ * For complete copyright and license terms please see the LICENSE at the root of this distribution.
+ *
+ * SPDX-License-Identifier: Apache-2.0 OR MIT
+ *
+ */
+
+#include <AzCore/IO/FileIO.h>
+#include <AzCore/Utils/Utils.h>
+#include <AzCore/std/algorithm.h>
+#include <AzCore/std/smart_ptr/make_shared.h>
+#include <ROS2/ROS2Bus.h>
+#include <ROS2/Sensor/SensorPublisher.h>
+#include <Sensor/SensorProfilerRegistry.h>
+
+namespace ROS2
+{
+    namespace
+    {
+        constexpr AZStd::chrono::seconds StatisticsPublishPeriod{ 1 };
+
+        diagnostic_msgs::msg::KeyValue MakeKeyValue(const AZStd::string& key, const AZStd::string& value)
+        {
+            diagnostic_msgs::msg::KeyValue keyValue;
+            keyValue.key = key.c_str();
+            keyValue.value = value.c_str();
+            return keyValue;
+        }
+
+        void AppendCallbackStatistics(
+            diagnostic_msgs::msg::DiagnosticStatus& status, const char* name, const SensorCallbackStatistics& stats)
+        {
+            const AZStd::string prefix(name);
+            status.values.push_back(MakeKeyValue(prefix + "_count", AZStd::string::format("%llu", stats.m_callCount)));
+            status.values.push_back(MakeKeyValue(prefix + "_mean_ms", AZStd::string::format("%.4f", stats.m_meanDuration)));
+            status.values.push_back(MakeKeyValue(prefix + "_p99_ms", AZStd::string::format("%.4f", stats.m_99thPercentileDuration)));
+            status.values.push_back(MakeKeyValue(prefix + "_max_ms", AZStd::string::format("%.4f", stats.m_maxDuration)));
+        }
+
+        AZStd::string ToJson(const SensorCallbackStatistics& stats)
+        {
+            return AZStd::string::format(
+                R"({"count":%llu,"mean_ms":%.4f,"p99_ms":%.4f,"max_ms":%.4f})",
+                stats.m_callCount,
+                stats.m_meanDuration,
+                stats.m_99thPercentileDuration,
+                stats.m_maxDuration);
+        }
+    } // namespace
+
+    SensorProfilerRegistry::SensorProfilerRegistry(const std::shared_ptr<rclcpp::Node>& node, const AZStd::string& traceFilePath)
+        : m_epoch(SensorProfile::Clock::now())
+        , m_traceFilePath(traceFilePath)
+    {
+        m_statisticsPublisher = node->create_publisher<diagnostic_msgs::msg::DiagnosticArray>("/o3de/sensor_stats", rclcpp::QoS(1));
+        m_statisticsTimer = node->create_wall_timer(
+            StatisticsPublishPeriod,
+            [this]()
+            {
+                PublishStatistics();
+            });
+
+        m_getStatisticsService = node->create_service<std_srvs::srv::Trigger>(
+            "/o3de/get_sensor_stats",
+            [this](
+                [[maybe_unused]] const std::shared_ptr<std_srvs::srv::Trigger::Request> request,
+                std::shared_ptr<std_srvs::srv::Trigger::Response> response)
+            {
+                response->success = true;
+                response->message = GetStatisticsJson().c_str();
+            });
+
+        m_exportTraceService = node->create_service<std_srvs::srv::Trigger>(
+            "/o3de/export_sensor_trace",
+            [this](
+                [[maybe_unused]] const std::shared_ptr<std_srvs::srv::Trigger::Request> request,
+                std::shared_ptr<std_srvs::srv::Trigger::Response> response)
+            {
+                response->success = ExportChromeTrace(m_traceFilePath);
+                response->message = m_traceFilePath.c_str();
+            });
+
+        SensorProfilerInterface::Register(this);
+    }
+
+    SensorProfilerRegistry::~SensorProfilerRegistry()
+    {
+        SensorProfilerInterface::Unregister(this);
+    }
+
+    AZStd::shared_ptr<SensorProfile> SensorProfilerRegistry::RegisterSensor(const AZStd::string& sensorName)
+    {
+        auto profile = AZStd::make_shared<SensorProfile>(sensorName);
+        AZStd::scoped_lock lock(m_profilesMutex);
+        m_profiles.push_back(profile);
+        return profile;
+    }
+
+    void SensorProfilerRegistry::UnregisterSensor(const AZStd::shared_ptr<SensorProfile>& profile)
+    {
+        AZStd::scoped_lock lock(m_profilesMutex);
+        m_profiles.erase(AZStd::remove(m_profiles.begin(), m_profiles.end(), profile), m_profiles.end());
+    }
+
+    AZStd::vector<SensorStatistics> SensorProfilerRegistry::GetSensorStatistics() const
+    {
+        AZStd::vector<SensorStatistics> statistics;
+        AZStd::scoped_lock lock(m_profilesMutex);
+        statistics.reserve(m_profiles.size());
+        for (const auto& profile : m_profiles)
+        {
+            statistics.push_back(profile->GetStatistics());
+        }
+        return statistics;
+    }
+
+    bool SensorProfilerRegistry::ExportChromeTrace(const AZStd::string& filePath) const
+    {
+        AZStd::string traceEvents;
+        {
+            AZStd::scoped_lock lock(m_profilesMutex);
+            for (size_t i = 0; i < m_profiles.size(); ++i)
+            {
+                m_profiles[i]->AppendTraceEvents(traceEvents, m_epoch, i + 1);
+            }
+        }
+
+        char resolvedPath[AZ_MAX_PATH_LEN] = { 0 };
+        auto* fileIO = AZ::IO::FileIOBase::GetInstance();
+        if (!fileIO || !fileIO->ResolvePath(filePath.c_str(), resolvedPath, AZ_MAX_PATH_LEN))
+        {
+            azstrncpy(resolvedPath, AZ_MAX_PATH_LEN, filePath.c_str(), filePath.size());
+        }
+
+        const AZStd::string trace = AZStd::string::format("{\"traceEvents\":[\n%s\n]}\n", traceEvents.c_str());
+        auto outcome = AZ::Utils::WriteFile(trace, resolvedPath);
+        AZ_Error("SensorProfilerRegistry", outcome.IsSuccess(), "Failed to export sensor trace: %s", outcome.GetError().c_str());
+        if (outcome.IsSuccess())
+        {
+            AZ_Printf("SensorProfilerRegistry", "Exported sensor trace to %s", resolvedPath);
+        }
+        return outcome.IsSuccess();
+    }
+
+    AZStd::string SensorProfilerRegistry::GetStatisticsJson() const
+    {
+        AZStd::string json = "[";
+        for (const SensorStatistics& statistics : GetSensorStatistics())
+        {
+            if (json.size() > 1)
+            {
+                json += ",";
+            }
+            json += AZStd::string::format(
+                R"({"sensor":"%s","source":%s,"adapted":%s,"published_bytes":%llu})",
+                statistics.m_sensorName.c_str(),
+                ToJson(statistics.m_callbacks[static_cast<size_t>(SensorCallbackType::Source)]).c_str(),
+                ToJson(statistics.m_callbacks[static_cast<size_t>(SensorCallbackType::Adapted)]).c_str(),
+                statistics.m_publishedBytes);
+        }
+        json += "]";
+        return json;
+    }
+
+    void SensorProfilerRegistry::PublishStatistics()
+    {
+        const AZStd::vector<SensorStatistics> sensorStatistics = GetSensorStatistics();
+        AZStd::vector<SensorPublisherStatistics> publisherStatistics;
+        if (auto* publishingThread = SensorPublishingInterface::Get())
+        {
+            publisherStatistics = publishingThread->GetStatistics();
+        }
+        if (sensorStatistics.empty() && publisherStatistics.empty())
+        {
+            return;
+        }
+
+        diagnostic_msgs::msg::DiagnosticArray message;
+        message.header.stamp = ROS2Interface::Get()->GetROSTimestamp();
+        message.status.reserve(sensorStatistics.size() + publisherStatistics.size());
+        for (const SensorStatistics& statistics : sensorStatistics)
+        {
+            diagnostic_msgs::msg::DiagnosticStatus& status = message.status.emplace_back();
+            status.level = diagnostic_msgs::msg::DiagnosticStatus::OK;
+            status.name = statistics.m_sensorName.c_str();
+            status.hardware_id = "o3de";
+            AppendCallbackStatistics(status, "source", statistics.m_callbacks[static_cast<size_t>(SensorCallbackType::Source)]);
+            AppendCallbackStatistics(status, "adapted", statistics.m_callbacks[static_cast<size_t>(SensorCallbackType::Adapted)]);
+            status.values.push_back(MakeKeyValue("published_bytes", AZStd::string::format("%llu", statistics.m_publishedBytes)));
+        }
+        for (const SensorPublisherStatistics& statistics : publisherStatistics)
+        {
+            diagnostic_msgs::msg::DiagnosticStatus& status = message.status.emplace_back();
+            status.level =
+                statistics.m_droppedCount > 0 ? diagnostic_msgs::msg::DiagnosticStatus::WARN : diagnostic_msgs::msg::DiagnosticStatus::OK;
+            status.name = AZStd::string::format("publisher %s", statistics.m_topicName.c_str()).c_str();
+            status.hardware_id = "o3de";
+            status.values.push_back(MakeKeyValue("published", AZStd::string::format("%llu", statistics.m_publishedCount)));
+            status.values.push_back(MakeKeyValue("dropped", AZStd::string::format("%llu", statistics.m_droppedCount)));
+            status.values.push_back(MakeKeyValue("max_queue_depth", AZStd::string::format("%llu", statistics.m_maxQueueDepth)));
+        }
+        m_statisticsPublisher->publish(message);
+    }
+} // namespace ROS2
@@ -0,0 +1,51 @@
+/*
+ * Copyright (c) Contributors to the Open 3D Engine Project.
+ * For complete copyright and license terms please see the LICENSE at the root of this distribution.
+ *
+ * SPDX-License-Identifier: Apache-2.0 OR MIT
+ *
+ */
+#pragma once
+
+#include <AzCore/std/parallel/mutex.h>
+#include <ROS2/Sensor/SensorProfiler.h>
+#include <diagnostic_msgs/msg/diagnostic_array.hpp>
+#include <rclcpp/node.hpp>
+#include <std_srvs/srv/trigger.hpp>
+
+namespace ROS2
+{
+    //! Keeps profiles of running sensors and reports them over ROS 2, along with backpressure of sensor publishers.
+    //! Statistics of all sensors are published once per second as diagnostics. They can also be requested as JSON, and recent
+    //! callbacks can be exported as a Chrome trace, through services.
+    class SensorProfilerRegistry : public SensorProfilerRequests
+    {
+    public:
+        AZ_RTTI(SensorProfilerRegistry, "{0E1F8A37-6C0B-4C5E-8B5B-1F3D4C7E2A90}", SensorProfilerRequests);
+
+        //! @param node Node of the stats topic and services.
+        //! @param traceFilePath Path the Chrome trace is exported to by the export service. May contain file IO aliases.
+        SensorProfilerRegistry(const std::shared_ptr<rclcpp::Node>& node, const AZStd::string& traceFilePath);
+        ~SensorProfilerRegistry() override;
+
+        // SensorProfilerRequests overrides
+        AZStd::shared_ptr<SensorProfile> RegisterSensor(const AZStd::string& sensorName) override;
+        void UnregisterSensor(const AZStd::shared_ptr<SensorProfile>& profile) override;
+        AZStd::vector<SensorStatistics> GetSensorStatistics() const override;
+        bool ExportChromeTrace(const AZStd::string& filePath) const override;
+
+    private:
+        void PublishStatistics();
+        AZStd::string GetStatisticsJson() const;
+
+        mutable AZStd::mutex m_profilesMutex;
+        AZStd::vector<AZStd::shared_ptr<SensorProfile>> m_profiles;
+        const SensorProfile::Clock::time_point m_epoch;
+        AZStd::string m_traceFilePath;
+
+        rclcpp::Publisher<diagnostic_msgs::msg::DiagnosticArray>::SharedPtr m_statisticsPublisher;
+        rclcpp::TimerBase::SharedPtr m_statisticsTimer;
+        rclcpp::Service<std_srvs::srv::Trigger>::SharedPtr m_getStatisticsService;
+        rclcpp::Service<std_srvs::srv::Trigger>::SharedPtr m_exportTraceService;
+    };
+} // namespace ROS2
@@ -0,0 +1,92 @@
+/*
+ * Copyright (c) Contributors to the Open 3D Engine Project.
+ * For complete copyright and license terms please see the LICENSE at the root of this distribution.
+ *
+ * SPDX-License-Identifier: Apache-2.0 OR MIT
+ *
+ */
+
+#include <AzCore/std/algorithm.h>
+#include <Sensor/SensorPublishingThread.h>
+
+namespace ROS2
+{
+    SensorPublishingThread::SensorPublishingThread()
+    {
+        AZStd::thread_desc threadDesc;
+        threadDesc.m_name = "SensorPublishing";
+        m_publisherThread = AZStd::thread(
+            threadDesc,
+            [this]()
+            {
+                PublishLoop();
+            });
+    }
+
+    SensorPublishingThread::~SensorPublishingThread()
+    {
+        m_isRunning = false;
+        m_pendingSignal.release();
+        m_publisherThread.join();
+    }
+
+    void SensorPublishingThread::RegisterChannel(SensorPublicationChannel* channel)
+    {
+        AZStd::scoped_lock lock(m_channelsMutex);
+        m_channels.push_back(channel);
+    }
+
+    void SensorPublishingThread::UnregisterChannel(SensorPublicationChannel* channel)
+    {
+        // Waits for the thread to finish publishing, if it is publishing messages of the channel.
+        AZStd::scoped_lock lock(m_channelsMutex);
+        m_channels.erase(AZStd::remove(m_channels.begin(), m_channels.end(), channel), m_channels.end());
+
+        const SensorPublisherStatistics statistics = channel->GetStatistics();
+        AZ_Warning(
+            "SensorPublishingThread",
+            statistics.m_droppedCount == 0,
+            "Dropped %llu of %llu messages on %s, publishing fell behind the sensor.",
+            statistics.m_droppedCount,
+            statistics.m_droppedCount + statistics.m_publishedCount,
+            statistics.m_topicName.c_str());
+    }
+
+    void SensorPublishingThread::NotifyPending()
+    {
+        m_pendingSignal.release();
+    }
+
+    AZStd::vector<SensorPublisherStatistics> SensorPublishingThread::GetStatistics() const
+    {
+        AZStd::vector<SensorPublisherStatistics> statistics;
+        AZStd::scoped_lock lock(m_channelsMutex);
+        statistics.reserve(m_channels.size());
+        for (const SensorPublicationChannel* channel : m_channels)
+        {
+            statistics.push_back(channel->GetStatistics());
+        }
+        return statistics;
+    }
+
+    void SensorPublishingThread::PublishLoop()
+    {
+        while (true)
+        {
+            m_pendingSignal.acquire();
+
+            {
+                AZStd::scoped_lock lock(m_channelsMutex);
+                for (SensorPublicationChannel* channel : m_channels)
+                {
+                    channel->PublishPending();
+                }
+            }
+
+            if (!m_isRunning)
+            {
+                return;
+            }
+        }
+    }
+} // namespace ROS2
@@ -0,0 +1,48 @@
+/*
+ * Copyright (c) Contributors to the Open 3D Engine Project.
+ * For complete copyright and license terms please see the LICENSE at the root of this distribution.
+ *
+ * SPDX-License-Identifier: Apache-2.0 OR MIT
+ *
+ */
+
+#pragma once
+
+#include <AzCore/std/containers/vector.h>
+#include <AzCore/std/parallel/atomic.h>
+#include <AzCore/std/parallel/mutex.h>
+#include <AzCore/std/parallel/semaphore.h>
+#include <AzCore/std/parallel/thread.h>
+#include <ROS2/Sensor/SensorPublisher.h>
+
+namespace ROS2
+{
+    //! Single thread publishing messages of all sensor publishers. Sensors queue messages in their own single producer, single
+    //! consumer queues and wake the thread up, which publishes messages of every registered channel.
+    class SensorPublishingThread : public SensorPublishingRequests
+    {
+    public:
+        AZ_RTTI(SensorPublishingThread, "{5D2A8F3B-91C4-4E7D-B6A0-3F8E2C1D9B74}", SensorPublishingRequests);
+
+        SensorPublishingThread();
+        ~SensorPublishingThread() override;
+
+        SensorPublishingThread(const SensorPublishingThread&) = delete;
+        SensorPublishingThread& operator=(const SensorPublishingThread&) = delete;
+
+        // SensorPublishingRequests overrides
+        void RegisterChannel(SensorPublicationChannel* channel) override;
+        void UnregisterChannel(SensorPublicationChannel* channel) override;
+        void NotifyPending() override;
+        AZStd::vector<SensorPublisherStatistics> GetStatistics() const override;
+
+    private:
+        void PublishLoop();
+
+        mutable AZStd::mutex m_channelsMutex;
+        AZStd::vector<SensorPublicationChannel*> m_channels;
+        AZStd::semaphore m_pendingSignal;
+        AZStd::atomic_bool m_isRunning{ true };
+        AZStd::thread m_publisherThread;
+    };
+} // namespace ROS2
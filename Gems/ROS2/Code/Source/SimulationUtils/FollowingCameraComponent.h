@@ -11,6 +11,7 @@
 #include "FollowingCameraConfiguration.h"
 #include <AzCore/Component/Component.h>
 #include <AzCore/Component/TickBus.h>
+#include <AzCore/std/containers/deque.h>
 #include <AzFramework/Components/TransformComponent.h>
 #include <AzFramework/Input/Events/InputChannelEventListener.h>
 
@@ -0,0 +1,203 @@
+/*
+ * Copyright (c) Contributors to the Open 3D Engine Project.
+ * For complete copyright and license terms please see the LICENSE at the root of this distribution.
+ *
+ * SPDX-License-Identifier: Apache-2.0 OR MIT
+ *
+ */
+
+#include "AllocationCounter.h"
+
+#include <AzCore/Casting/numeric_cast.h>
+#include <AzCore/Memory/AllocationRecords.h>
+#include <AzCore/Memory/SystemAllocator.h>
+#include <AzCore/std/parallel/atomic.h>
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+
+#if defined(_WIN32)
+#include <malloc.h>
+#endif
+
+namespace Benchmark
+{
+    namespace Internal
+    {
+        static AZStd::atomic<AZ::s64> s_allocationCount{ 0 };
+        static AZStd::atomic_bool s_isCounting{ false };
+
+        //! Allocates with at least the alignment of the fundamental types. All replaced operators allocate through here, so that
+        //! every operator delete frees with the same function, whichever operator new made the allocation.
+        static void* Allocate(std::size_t size, std::size_t alignment) noexcept
+        {
+            if (s_isCounting.load(AZStd::memory_order_relaxed))
+            {
+                s_allocationCount.fetch_add(1, AZStd::memory_order_relaxed);
+            }
+            alignment = alignment > alignof(std::max_align_t) ? alignment : alignof(std::max_align_t);
+            size = size > 0 ? size : 1;
+#if defined(_WIN32)
+            return _aligned_malloc(size, alignment);
+#else
+            void* memory = nullptr;
+            return posix_memalign(&memory, alignment, size) == 0 ? memory : nullptr;
+#endif
+        }
+
+        static void Free(void* memory) noexcept
+        {
+#if defined(_WIN32)
+            _aligned_free(memory);
+#else
+            std::free(memory);
+#endif
+        }
+
+        static void* AllocateOrThrow(std::size_t size, std::size_t alignment)
+        {
+            if (void* memory = Allocate(size, alignment))
+            {
+                return memory;
+            }
+            throw std::bad_alloc();
+        }
+    } // namespace Internal
+
+    AllocationCounter::AllocationCounter()
+        : m_firstSystemAllocationCount(GetSystemAllocationCount())
+    {
+        AZ_Warning(
+            "AllocationCounter",
+            m_firstSystemAllocationCount >= 0,
+            "The system allocator keeps no allocation records, so only allocations of the global operator new are counted.");
+        Internal::s_allocationCount = 0;
+        Internal::s_isCounting = true;
+    }
+
+    AllocationCounter::~AllocationCounter()
+    {
+        Internal::s_isCounting = false;
+    }
+
+    AZ::s64 AllocationCounter::GetCount() const
+    {
+        if (m_firstSystemAllocationCount < 0)
+        {
+            return Internal::s_allocationCount;
+        }
+        return Internal::s_allocationCount + GetSystemAllocationCount() - m_firstSystemAllocationCount;
+    }
+
+    AZ::s64 AllocationCounter::GetSystemAllocationCount() const
+    {
+        const AZ::Debug::AllocationRecords* records = AZ::AllocatorInstance<AZ::SystemAllocator>::Get().GetRecords();
+        if (!records || records->GetMode() == AZ::Debug::AllocationRecords::RECORD_NO_RECORDS)
+        {
+            return -1;
+        }
+        return aznumeric_cast<AZ::s64>(records->RequestedAllocs());
+    }
+} // namespace Benchmark
+
+// Replaceable allocation functions, including the array, sized, aligned and non-throwing variants.
+
+void* operator new(std::size_t size)
+{
+    return Benchmark::Internal::AllocateOrThrow(size, 0);
+}
+
+void* operator new[](std::size_t size)
+{
+    return Benchmark::Internal::AllocateOrThrow(size, 0);
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment)
+{
+    return Benchmark::Internal::AllocateOrThrow(size, static_cast<std::size_t>(alignment));
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment)
+{
+    return Benchmark::Internal::AllocateOrThrow(size, static_cast<std::size_t>(alignment));
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept
+{
+    return Benchmark::Internal::Allocate(size, 0);
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept
+{
+    return Benchmark::Internal::Allocate(size, 0);
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept
+{
+    return Benchmark::Internal::Allocate(size, static_cast<std::size_t>(alignment));
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept
+{
+    return Benchmark::Internal::Allocate(size, static_cast<std::size_t>(alignment));
+}
+
+void operator delete(void* memory) noexcept
+{
+    Benchmark::Internal::Free(memory);
+}
+
+void operator delete[](void* memory) noexcept
+{
+    Benchmark::Internal::Free(memory);
+}
+
+void operator delete(void* memory, std::size_t) noexcept
+{
+    Benchmark::Internal::Free(memory);
+}
+
+void operator delete[](void* memory, std::size_t) noexcept
+{
+    Benchmark::Internal::Free(memory);
+}
+
+void operator delete(void* memory, std::align_val_t) noexcept
+{
+    Benchmark::Internal::Free(memory);
+}
+
+void operator delete[](void* memory, std::align_val_t) noexcept
+{
+    Benchmark::Internal::Free(memory);
+}
+
+void operator delete(void* memory, std::size_t, std::align_val_t) noexcept
+{
+    Benchmark::Internal::Free(memory);
+}
+
+void operator delete[](void* memory, std::size_t, std::align_val_t) noexcept
+{
+    Benchmark::Internal::Free(memory);
+}
+
+void operator delete(void* memory, const std::nothrow_t&) noexcept
+{
+    Benchmark::Internal::Free(memory);
+}
+
+void operator delete[](void* memory, const std::nothrow_t&) noexcept
+{
+    Benchmark::Internal::Free(memory);
+}
+
+void operator delete(void* memory, std::align_val_t, const std::nothrow_t&) noexcept
+{
+    Benchmark::Internal::Free(memory);
+}
+
+void operator delete[](void* memory, std::align_val_t, const std::nothrow_t&) noexcept
+{
+    Benchmark::Internal::Free(memory);
+}
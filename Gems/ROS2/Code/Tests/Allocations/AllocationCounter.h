@@ -0,0 +1,36 @@
+/*
+ * Copyright (c) Contributors to the Open 3D Engine Project.
+ * For complete copyright and license terms please see the LICENSE at the root of this distribution.
+ *
+ * SPDX-License-Identifier: Apache-2.0 OR MIT
+ *
+ */
+#pragma once
+
+#include <AzCore/base.h>
+
+namespace Benchmark
+{
+    //! Counts heap allocations made during its lifetime, e.g. in the timed loop of a benchmark.
+    //! ROS 2 messages allocate their buffers through the global operator new, which the AZ allocators do not see, while AZStd
+    //! containers allocate from the system allocator. Both are counted: the global operators are replaced only in the module
+    //! of allocation benchmarks, so that tests of other modules are not affected, and allocations of the system allocator are
+    //! taken from its allocation records, when it keeps them. Counters must not be nested.
+    class AllocationCounter
+    {
+    public:
+        AllocationCounter();
+        ~AllocationCounter();
+
+        AllocationCounter(const AllocationCounter&) = delete;
+        AllocationCounter& operator=(const AllocationCounter&) = delete;
+
+        //! Number of allocations since the counter was created, of all threads.
+        AZ::s64 GetCount() const;
+
+    private:
+        AZ::s64 GetSystemAllocationCount() const;
+
+        AZ::s64 m_firstSystemAllocationCount;
+    };
+} // namespace Benchmark
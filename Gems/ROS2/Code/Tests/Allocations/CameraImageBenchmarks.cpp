@@ -0,0 +1,126 @@
+/*
+ * Copyright (c) Contributors to the Open 3D Engine Project.
+ * For complete copyright and license terms please see the LICENSE at the root of this distribution.
+ *
+ * SPDX-License-Identifier: Apache-2.0 OR MIT
+ *
+ */
+
+#if defined(HAVE_BENCHMARK)
+
+#include <AzCore/Casting/numeric_cast.h>
+#include <AzCore/std/containers/array.h>
+#include <AzCore/std/smart_ptr/make_shared.h>
+#include <AzTest/AzTest.h>
+#include <benchmark/benchmark.h>
+
+#include <Allocations/AllocationCounter.h>
+#include <Camera/CameraAtlas.h>
+#include <Camera/CameraPublishers.h>
+#include <Camera/CameraUtilities.h>
+
+namespace Benchmark
+{
+    //! Builds a successful readback result of an image, the way Atom hands it over to camera sensors.
+    static AZ::RPI::AttachmentReadback::ReadbackResult CreateReadbackResult(AZ::u32 width, AZ::u32 height, AZ::RHI::Format format)
+    {
+        AZ::RPI::AttachmentReadback::ReadbackResult result;
+        result.m_state = AZ::RPI::AttachmentReadback::ReadbackState::Success;
+        result.m_attachmentType = AZ::RHI::AttachmentType::Image;
+        result.m_imageDescriptor.m_size = AZ::RHI::Size(width, height, 1);
+        result.m_imageDescriptor.m_format = format;
+        const size_t pixelSize = format == AZ::RHI::Format::R8G8B8A8_UNORM ? 4 : sizeof(float);
+        result.m_dataBuffer = AZStd::make_shared<AZStd::vector<uint8_t>>(size_t{ width } * height * pixelSize, uint8_t{ 127 });
+        return result;
+    }
+
+    //! Reports throughput and the heap allocations made per frame.
+    static void SetCounters(benchmark::State& state, size_t frameSize, AZ::s64 allocationCount)
+    {
+        state.SetBytesProcessed(state.iterations() * frameSize);
+        state.counters["allocations_per_frame"] =
+            benchmark::Counter(aznumeric_cast<double>(allocationCount) / aznumeric_cast<double>(state.iterations()));
+    }
+
+    static AZ::RHI::Format GetFormat(const benchmark::State& state)
+    {
+        return state.range(2) == 0 ? AZ::RHI::Format::R8G8B8A8_UNORM : AZ::RHI::Format::R32_FLOAT;
+    }
+
+    //! Previous image path: a new message per frame, with the data copied into a newly constructed vector.
+    static void BM_ImageMessageNewPerFrame(benchmark::State& state)
+    {
+        const auto result = CreateReadbackResult(
+            aznumeric_cast<AZ::u32>(state.range(0)), aznumeric_cast<AZ::u32>(state.range(1)), GetFormat(state));
+        const std_msgs::msg::Header header;
+        const AllocationCounter allocationCounter;
+        for ([[maybe_unused]] auto _ : state)
+        {
+            sensor_msgs::msg::Image imageMessage;
+            imageMessage.encoding = ROS2::CameraUtils::GetImageEncoding(result.m_imageDescriptor.m_format);
+            imageMessage.width = result.m_imageDescriptor.m_size.m_width;
+            imageMessage.height = result.m_imageDescriptor.m_size.m_height;
+            const AZStd::vector<uint8_t>& data = *result.m_dataBuffer;
+            imageMessage.data = std::vector<uint8_t>(data.data(), data.data() + data.size());
+            imageMessage.header = header;
+            benchmark::DoNotOptimize(imageMessage.data.data());
+        }
+        SetCounters(state, result.m_dataBuffer->size(), allocationCounter.GetCount());
+    }
+
+    //! Current image path: messages taken in turn from a pool, filled in place.
+    static void BM_ImageMessagePooled(benchmark::State& state)
+    {
+        const auto result = CreateReadbackResult(
+            aznumeric_cast<AZ::u32>(state.range(0)), aznumeric_cast<AZ::u32>(state.range(1)), GetFormat(state));
+        const std_msgs::msg::Header header;
+        AZStd::array<sensor_msgs::msg::Image, ROS2::CameraPublishers::ImagePoolSize> messagePool;
+        size_t nextMessage = 0;
+        const AllocationCounter allocationCounter;
+        for ([[maybe_unused]] auto _ : state)
+        {
+            sensor_msgs::msg::Image& imageMessage = messagePool[nextMessage];
+            nextMessage = (nextMessage + 1) % messagePool.size();
+            ROS2::CameraUtils::FillImageMessage(result, header, imageMessage);
+            benchmark::DoNotOptimize(imageMessage.data.data());
+        }
+        SetCounters(state, result.m_dataBuffer->size(), allocationCounter.GetCount());
+    }
+
+    //! Atlas path: messages of all cameras of an atlas filled from tiles of one readback, row by row.
+    static void BM_ImageMessagesFromAtlas(benchmark::State& state)
+    {
+        const ROS2::CameraAtlasLayout layout(
+            aznumeric_cast<AZ::u32>(state.range(0)), aznumeric_cast<AZ::u32>(state.range(1)), aznumeric_cast<AZ::u32>(state.range(2)));
+        const auto result = CreateReadbackResult(layout.GetAtlasWidth(), layout.GetAtlasHeight(), AZ::RHI::Format::R8G8B8A8_UNORM);
+        const auto atlas = ROS2::CameraUtils::GetImageView(result);
+        const std_msgs::msg::Header header;
+        AZStd::vector<sensor_msgs::msg::Image> messages(layout.GetTileCount());
+        const AllocationCounter allocationCounter;
+        for ([[maybe_unused]] auto _ : state)
+        {
+            for (AZ::u32 tile = 0; tile < layout.GetTileCount(); ++tile)
+            {
+                ROS2::CameraUtils::FillImageMessage(layout.GetTileView(atlas, tile), header, messages[tile]);
+                benchmark::DoNotOptimize(messages[tile].data.data());
+            }
+        }
+        SetCounters(state, result.m_dataBuffer->size(), allocationCounter.GetCount());
+    }
+
+    // VGA and full HD color (format 0, RGBA8) and full HD depth (format 1, 32FC1).
+    BENCHMARK(BM_ImageMessageNewPerFrame)
+        ->ArgNames({ "width", "height", "format" })
+        ->Args({ 640, 480, 0 })
+        ->Args({ 1920, 1080, 0 })
+        ->Args({ 1920, 1080, 1 });
+    BENCHMARK(BM_ImageMessagePooled)
+        ->ArgNames({ "width", "height", "format" })
+        ->Args({ 640, 480, 0 })
+        ->Args({ 1920, 1080, 0 })
+        ->Args({ 1920, 1080, 1 });
+    // Atlases of small robot cameras.
+    BENCHMARK(BM_ImageMessagesFromAtlas)->ArgNames({ "width", "height", "tiles" })->Args({ 320, 240, 4 })->Args({ 320, 240, 6 });
+} // namespace Benchmark
+
+#endif // HAVE_BENCHMARK
@@ -0,0 +1,273 @@
+/*
+ * Copyright (c) Contributors to the Open 3D Engine Project.
+ * For complete copyright and license terms please see the LICENSE at the root of this distribution.
+ *
+ * SPDX-License-Identifier: Apache-2.0 OR MIT
+ *
+ */
+
+#if defined(HAVE_BENCHMARK)
+
+#include <AzCore/Casting/numeric_cast.h>
+#include <AzCore/Jobs/JobContext.h>
+#include <AzCore/Jobs/JobManager.h>
+#include <AzCore/Jobs/JobManagerDesc.h>
+#include <AzCore/Math/Transform.h>
+#include <AzCore/Math/Vector2.h>
+#include <AzCore/std/parallel/thread.h>
+#include <AzCore/std/smart_ptr/unique_ptr.h>
+#include <AzTest/AzTest.h>
+#include <benchmark/benchmark.h>
+
+#include <Allocations/AllocationCounter.h>
+#include <Lidar/LidarRaycaster.h>
+#include <Lidar/LidarScanScheduler.h>
+#include <Lidar/LidarTemplateUtils.h>
+
+namespace Benchmark
+{
+    //! Lidar raycaster casting rays against an analytic scene (a ground plane surrounded by a cylindrical wall) instead of
+    //! the physics scene. Only the intersection of rays with the scene is replaced: requests are prepared, batched and their
+    //! hits stored as for the physics scene, and hits are returned in a newly allocated list, as physics scene batches are.
+    class AnalyticSceneLidarRaycaster : public ROS2::LidarRaycaster
+    {
+    public:
+        static constexpr float WallRadius = 20.0f;
+
+        explicit AnalyticSceneLidarRaycaster(size_t workerCount = 1, ROS2::LidarScanScheduler* scanScheduler = nullptr)
+            : ROS2::LidarRaycaster(ROS2::LidarId::CreateRandom(), AZ::EntityId(), workerCount, scanScheduler)
+        {
+        }
+
+        void Configure(const ROS2::LidarTemplate& lidarTemplate)
+        {
+            ConfigureRayOrientations(ROS2::LidarTemplateUtils::PopulateRayRotations(lidarTemplate));
+            ConfigureRayRange(lidarTemplate.m_maxRange);
+            ConfigureMinimumRayRange(lidarTemplate.m_minRange);
+            ConfigureRaycastResultFlags(ROS2::RaycastResultFlags::Points | ROS2::RaycastResultFlags::Ranges);
+        }
+
+        using ROS2::LidarRaycaster::ConfigureAdaptiveDensity;
+        using ROS2::LidarRaycaster::ConfigureRaycastResultFlags;
+        using ROS2::LidarRaycaster::GetRaycastStatistics;
+        using ROS2::LidarRaycaster::PerformRaycastInPlace;
+
+    protected:
+        AzPhysics::SceneHandle AcquireSceneHandle() const override
+        {
+            return AzPhysics::SceneHandle(AZ_CRC_CE("AnalyticScene"), 0);
+        }
+
+        AzPhysics::SceneQueryHitsList QueryBatch(const AzPhysics::SceneQueryRequests& requests) const override
+        {
+            AzPhysics::SceneQueryHitsList hitsList(requests.size());
+            for (size_t i = 0; i < requests.size(); ++i)
+            {
+                const auto& request = static_cast<const AzPhysics::RayCastRequest&>(*requests[i]);
+                const AZ::Vector3& start = request.m_start;
+                const AZ::Vector3& direction = request.m_direction;
+                float distance = AZStd::numeric_limits<float>::max();
+                if (direction.GetZ() < 0.0f)
+                {
+                    distance = AZStd::min(distance, start.GetZ() / -direction.GetZ());
+                }
+                if (const float horizontalLength = AZ::Vector2(direction.GetX(), direction.GetY()).GetLength(); horizontalLength > 0.0f)
+                {
+                    distance = AZStd::min(distance, WallRadius / horizontalLength);
+                }
+
+                if (distance <= request.m_distance)
+                {
+                    AZStd::vector<AzPhysics::SceneQueryHit>& hits = hitsList[i].m_hits;
+                    hits.resize(1);
+                    hits[0].m_distance = distance;
+                    hits[0].m_position = start + direction * distance;
+                }
+            }
+            return hitsList;
+        }
+    };
+
+    //! Measures full scans of every built-in lidar template.
+    //! Reports scans per second and the heap allocations per scan, counted after the first (warm-up) scan has sized the
+    //! buffers of the raycaster. Allocations left are those of batch queries, which return their hits in new lists.
+    static void BM_LidarRaycasterScan(benchmark::State& state)
+    {
+        const auto lidarTemplate = ROS2::LidarTemplateUtils::GetTemplate(static_cast<ROS2::LidarTemplate::LidarModel>(state.range(0)));
+        const size_t rayCount = ROS2::LidarTemplateUtils::TotalPointCount(lidarTemplate);
+        state.SetLabel(lidarTemplate.m_name.c_str());
+
+        AnalyticSceneLidarRaycaster raycaster;
+        raycaster.Configure(lidarTemplate);
+
+        const AZ::Transform lidarTransform = AZ::Transform::CreateTranslation(AZ::Vector3(0.0f, 0.0f, 1.5f));
+        ROS2::RaycastResult results;
+        raycaster.PerformRaycastInPlace(lidarTransform, results);
+
+        const AllocationCounter allocationCounter;
+        for ([[maybe_unused]] auto _ : state)
+        {
+            raycaster.PerformRaycastInPlace(lidarTransform, results);
+            benchmark::DoNotOptimize(results.m_points.data());
+        }
+
+        const auto iterations = aznumeric_cast<double>(state.iterations());
+        state.SetItemsProcessed(state.iterations() * rayCount);
+        state.counters["scans/s"] = benchmark::Counter(iterations, benchmark::Counter::kIsRate);
+        state.counters["allocations/scan"] = benchmark::Counter(aznumeric_cast<double>(allocationCounter.GetCount()) / iterations);
+    }
+
+    BENCHMARK(BM_LidarRaycasterScan)
+        ->DenseRange(
+            static_cast<int>(ROS2::LidarTemplate::LidarModel::Custom3DLidar),
+            static_cast<int>(ROS2::LidarTemplate::LidarModel::Slamtec_RPLIDAR_S1))
+        ->Unit(benchmark::kMicrosecond);
+
+    //! Measures scans of an Ouster OS2-64 with adaptive density, for decreasing full density ranges (0 disables it).
+    //! The wall of the analytic scene is 20 m away, so ranges below that decimate the wall and the distant ground.
+    //! Reports the fraction of the ray pattern actually cast.
+    static void BM_LidarRaycasterAdaptiveDensity(benchmark::State& state)
+    {
+        const auto lidarTemplate = ROS2::LidarTemplateUtils::GetTemplate(ROS2::LidarTemplate::LidarModel::Ouster_OS2_64);
+        const auto fullDensityRange = aznumeric_cast<float>(state.range(0));
+
+        AnalyticSceneLidarRaycaster raycaster;
+        raycaster.Configure(lidarTemplate);
+        raycaster.ConfigureAdaptiveDensity(lidarTemplate.m_layers, fullDensityRange, fullDensityRange > 0.0f ? 8 : 1, 0);
+
+        const AZ::Transform lidarTransform = AZ::Transform::CreateTranslation(AZ::Vector3(0.0f, 0.0f, 1.5f));
+        ROS2::RaycastResult results;
+        raycaster.PerformRaycastInPlace(lidarTransform, results);
+        const ROS2::RaycastStatistics warmUpStatistics = raycaster.GetRaycastStatistics();
+        for ([[maybe_unused]] auto _ : state)
+        {
+            raycaster.PerformRaycastInPlace(lidarTransform, results);
+            benchmark::DoNotOptimize(results.m_points.data());
+        }
+
+        const ROS2::RaycastStatistics statistics = raycaster.GetRaycastStatistics();
+        const auto castRays = aznumeric_cast<double>(statistics.m_castRayCount - warmUpStatistics.m_castRayCount);
+        const auto savedRays = aznumeric_cast<double>(statistics.m_savedRayCount - warmUpStatistics.m_savedRayCount);
+        state.counters["cast ratio"] = benchmark::Counter(castRays / AZStd::max(castRays + savedRays, 1.0));
+        state.counters["scans/s"] = benchmark::Counter(aznumeric_cast<double>(state.iterations()), benchmark::Counter::kIsRate);
+    }
+
+    BENCHMARK(BM_LidarRaycasterAdaptiveDensity)->ArgName("fullDensityRange")->Arg(0)->Arg(40)->Arg(10)->Arg(5)->Unit(benchmark::kMicrosecond);
+
+    //! Fixture providing a global job context, which sharded raycasts dispatch their jobs to.
+    class LidarRaycasterJobsFixture : public ::benchmark::Fixture
+    {
+    public:
+        void SetUp([[maybe_unused]] const ::benchmark::State& state) override
+        {
+            AZ::JobManagerDesc jobManagerDesc;
+            const AZ::JobManagerThreadDesc threadDesc;
+            for (unsigned int i = 0; i < AZStd::thread::hardware_concurrency(); ++i)
+            {
+                jobManagerDesc.m_workerThreads.push_back(threadDesc);
+            }
+            m_jobManager = AZStd::make_unique<AZ::JobManager>(jobManagerDesc);
+            m_jobContext = AZStd::make_unique<AZ::JobContext>(*m_jobManager);
+            AZ::JobContext::SetGlobalContext(m_jobContext.get());
+        }
+
+        void TearDown([[maybe_unused]] const ::benchmark::State& state) override
+        {
+            AZ::JobContext::SetGlobalContext(nullptr);
+            m_jobContext.reset();
+            m_jobManager.reset();
+        }
+
+    private:
+        AZStd::unique_ptr<AZ::JobManager> m_jobManager;
+        AZStd::unique_ptr<AZ::JobContext> m_jobContext;
+    };
+
+    //! Compares serial (1 worker) and sharded throughput of an Ouster OS1-64 scan (131k rays) for increasing worker counts.
+    BENCHMARK_DEFINE_F(LidarRaycasterJobsFixture, BM_LidarRaycasterShardedScan)(benchmark::State& state)
+    {
+        const auto lidarTemplate = ROS2::LidarTemplateUtils::GetTemplate(ROS2::LidarTemplate::LidarModel::Ouster_OS1_64);
+        const size_t rayCount = ROS2::LidarTemplateUtils::TotalPointCount(lidarTemplate);
+
+        AnalyticSceneLidarRaycaster raycaster(aznumeric_cast<size_t>(state.range(0)));
+        raycaster.Configure(lidarTemplate);
+
+        const AZ::Transform lidarTransform = AZ::Transform::CreateTranslation(AZ::Vector3(0.0f, 0.0f, 1.5f));
+        ROS2::RaycastResult results;
+        raycaster.PerformRaycastInPlace(lidarTransform, results);
+        for ([[maybe_unused]] auto _ : state)
+        {
+            raycaster.PerformRaycastInPlace(lidarTransform, results);
+            benchmark::DoNotOptimize(results.m_points.data());
+        }
+
+        state.SetItemsProcessed(state.iterations() * rayCount);
+        state.counters["rays/s"] = benchmark::Counter(aznumeric_cast<double>(state.iterations() * rayCount), benchmark::Counter::kIsRate);
+    }
+
+    BENCHMARK_REGISTER_F(LidarRaycasterJobsFixture, BM_LidarRaycasterShardedScan)
+        ->ArgName("workers")
+        ->RangeMultiplier(2)
+        ->Range(1, 32)
+        ->UseRealTime()
+        ->Unit(benchmark::kMicrosecond);
+
+    //! Compares a fleet of Velodyne Puck lidars (28.8k rays each) cast one after another, each split into its own shards,
+    //! with the same fleet cast as one combined batch query per worker by the LidarScanScheduler. Only rays are cast; no
+    //! results are gathered.
+    //! Reports aggregate rays per second of the whole fleet.
+    BENCHMARK_DEFINE_F(LidarRaycasterJobsFixture, BM_LidarFleetScan)(benchmark::State& state)
+    {
+        const size_t lidarCount = aznumeric_cast<size_t>(state.range(0));
+        const bool isBatched = state.range(1) != 0;
+        const auto lidarTemplate = ROS2::LidarTemplateUtils::GetTemplate(ROS2::LidarTemplate::LidarModel::Velodyne_Puck);
+        const size_t rayCount = ROS2::LidarTemplateUtils::TotalPointCount(lidarTemplate);
+        const size_t workerCount = AZStd::thread::hardware_concurrency();
+
+        ROS2::LidarScanScheduler scanScheduler(workerCount);
+        AZStd::vector<AZStd::unique_ptr<AnalyticSceneLidarRaycaster>> raycasters;
+        AZStd::vector<AZ::Transform> lidarTransforms;
+        for (size_t i = 0; i < lidarCount; ++i)
+        {
+            raycasters.push_back(AZStd::make_unique<AnalyticSceneLidarRaycaster>(workerCount, &scanScheduler));
+            raycasters.back()->Configure(lidarTemplate);
+            raycasters.back()->ConfigureRaycastResultFlags(ROS2::RaycastResultFlags{});
+            lidarTransforms.push_back(AZ::Transform::CreateTranslation(AZ::Vector3(aznumeric_cast<float>(i), 0.0f, 1.5f)));
+        }
+
+        ROS2::RaycastResult results;
+        for ([[maybe_unused]] auto _ : state)
+        {
+            if (isBatched)
+            {
+                for (size_t i = 0; i < lidarCount; ++i)
+                {
+                    scanScheduler.Schedule(*raycasters[i], lidarTransforms[i], 0);
+                }
+                scanScheduler.Flush();
+            }
+            else
+            {
+                for (size_t i = 0; i < lidarCount; ++i)
+                {
+                    raycasters[i]->PerformRaycastInPlace(lidarTransforms[i], results);
+                }
+            }
+        }
+
+        const auto fleetRayCount = aznumeric_cast<int64_t>(lidarCount * rayCount);
+        state.SetLabel(isBatched ? "batched" : "independent");
+        state.SetItemsProcessed(state.iterations() * fleetRayCount);
+        state.counters["rays/s"] =
+            benchmark::Counter(aznumeric_cast<double>(state.iterations() * fleetRayCount), benchmark::Counter::kIsRate);
+    }
+
+    BENCHMARK_REGISTER_F(LidarRaycasterJobsFixture, BM_LidarFleetScan)
+        ->ArgNames({ "lidars", "batched" })
+        ->RangeMultiplier(2)
+        ->Ranges({ { 1, 64 }, { 0, 1 } })
+        ->UseRealTime()
+        ->Unit(benchmark::kMicrosecond);
+} // namespace Benchmark
+
+#endif // HAVE_BENCHMARK
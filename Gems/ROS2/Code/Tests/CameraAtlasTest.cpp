@@ -0,0 +1,267 @@
+/*
+ * Copyright (c) Contributors to the Open 3D Engine Project.
+ * For complete copyright and license terms please see the LICENSE at the root of this distribution.
+ *
+ * SPDX-License-Identifier: Apache-2.0 OR MIT
+ *
+ */
+
+#include <AzCore/UnitTest/TestTypes.h>
+#include <AzCore/std/smart_ptr/make_shared.h>
+#include <AzTest/AzTest.h>
+#include <cstring>
+
+#include <Camera/CameraAtlas.h>
+#include <Camera/CameraPostProcessingPipeline.h>
+#include <rclcpp/rclcpp.hpp>
+
+namespace UnitTest
+{
+    class CameraAtlasTest : public LeakDetectionFixture
+    {
+    public:
+        //! Synthetic atlas of RGBA8 tiles, in which each pixel holds its tile index and its position in the tile.
+        static AZStd::vector<uint8_t> CreateColorAtlas(const ROS2::CameraAtlasLayout& layout)
+        {
+            AZStd::vector<uint8_t> atlas(size_t{ layout.GetAtlasWidth() } * layout.GetAtlasHeight() * 4, 0xEE);
+            for (AZ::u32 tile = 0; tile < layout.GetTileCount(); ++tile)
+            {
+                const auto [originX, originY] = layout.GetTileOrigin(tile);
+                for (AZ::u32 y = 0; y < layout.GetTileHeight(); ++y)
+                {
+                    for (AZ::u32 x = 0; x < layout.GetTileWidth(); ++x)
+                    {
+                        uint8_t* pixel = atlas.data() + ((size_t{ originY } + y) * layout.GetAtlasWidth() + originX + x) * 4;
+                        pixel[0] = static_cast<uint8_t>(tile);
+                        pixel[1] = static_cast<uint8_t>(x);
+                        pixel[2] = static_cast<uint8_t>(y);
+                        pixel[3] = 255;
+                    }
+                }
+            }
+            return atlas;
+        }
+
+        static ROS2::CameraUtils::ImageView GetAtlasView(
+            const ROS2::CameraAtlasLayout& layout, const AZStd::vector<uint8_t>& atlas, AZ::RHI::Format format)
+        {
+            ROS2::CameraUtils::ImageView view;
+            view.m_data = atlas.data();
+            view.m_width = layout.GetAtlasWidth();
+            view.m_height = layout.GetAtlasHeight();
+            view.m_step = size_t{ layout.GetAtlasWidth() } * ROS2::CameraUtils::GetPixelSize(format);
+            view.m_format = format;
+            return view;
+        }
+    };
+
+    TEST_F(CameraAtlasTest, LayoutIsCloseToSquare)
+    {
+        const ROS2::CameraAtlasLayout six(320, 240, 6);
+        EXPECT_EQ(six.GetColumnCount(), 3);
+        EXPECT_EQ(six.GetAtlasWidth(), 960);
+        EXPECT_EQ(six.GetAtlasHeight(), 480);
+
+        const ROS2::CameraAtlasLayout four(320, 240, 4);
+        EXPECT_EQ(four.GetAtlasWidth(), 640);
+        EXPECT_EQ(four.GetAtlasHeight(), 480);
+        EXPECT_EQ(four.GetTileOrigin(3), (AZStd::pair<AZ::u32, AZ::u32>(320, 240)));
+
+        const ROS2::CameraAtlasLayout single(320, 240, 1);
+        EXPECT_EQ(single.GetAtlasWidth(), 320);
+        EXPECT_EQ(single.GetAtlasHeight(), 240);
+    }
+
+    TEST_F(CameraAtlasTest, LayoutFitsInMaxAtlasSize)
+    {
+        constexpr AZ::u32 MaxSize = ROS2::CameraAtlasLayout::MaxAtlasSize;
+        const AZ::u32 maxTileCount = ROS2::CameraAtlasLayout::GetMaxTileCount(1000, 300);
+        EXPECT_EQ(maxTileCount, 4 * 13);
+        EXPECT_EQ(ROS2::CameraAtlasLayout::GetMaxTileCount(MaxSize + 1, 240), 0);
+
+        for (AZ::u32 count = 1; count <= maxTileCount; ++count)
+        {
+            const ROS2::CameraAtlasLayout wide(1000, 300, count);
+            EXPECT_LE(wide.GetAtlasWidth(), MaxSize);
+            EXPECT_LE(wide.GetAtlasHeight(), MaxSize);
+            const ROS2::CameraAtlasLayout tall(300, 1000, count);
+            EXPECT_LE(tall.GetAtlasWidth(), MaxSize);
+            EXPECT_LE(tall.GetAtlasHeight(), MaxSize);
+        }
+    }
+
+    TEST_F(CameraAtlasTest, CompatibleCamerasShareSizeAndChannels)
+    {
+        ROS2::CameraSensorConfiguration first;
+        first.m_width = 320;
+        first.m_height = 240;
+        ROS2::CameraSensorConfiguration second = first;
+        second.m_verticalFieldOfViewDeg = 60.0f;
+        EXPECT_FALSE(ROS2::CameraAtlasLayout::AreCompatible(first, second));
+
+        // Atlas readback is opt-in for both cameras.
+        first.m_atlasReadback = true;
+        EXPECT_FALSE(ROS2::CameraAtlasLayout::AreCompatible(first, second));
+        second.m_atlasReadback = true;
+        EXPECT_TRUE(ROS2::CameraAtlasLayout::AreCompatible(first, second));
+
+        second.m_depthCamera = !first.m_depthCamera;
+        EXPECT_FALSE(ROS2::CameraAtlasLayout::AreCompatible(first, second));
+
+        second = first;
+        second.m_height = 480;
+        EXPECT_FALSE(ROS2::CameraAtlasLayout::AreCompatible(first, second));
+    }
+
+    TEST_F(CameraAtlasTest, TileViewsPointIntoAtlas)
+    {
+        const ROS2::CameraAtlasLayout layout(32, 24, 5);
+        const auto atlas = CreateColorAtlas(layout);
+        const auto atlasView = GetAtlasView(layout, atlas, AZ::RHI::Format::R8G8B8A8_UNORM);
+        for (AZ::u32 tile = 0; tile < layout.GetTileCount(); ++tile)
+        {
+            const auto tileView = layout.GetTileView(atlasView, tile);
+            EXPECT_EQ(tileView.m_width, 32);
+            EXPECT_EQ(tileView.m_height, 24);
+            EXPECT_EQ(tileView.m_step, atlasView.m_step);
+            EXPECT_GE(tileView.m_data, atlas.data());
+            EXPECT_LT(tileView.m_data, atlas.data() + atlas.size());
+            EXPECT_EQ(tileView.m_data[0], tile);
+            EXPECT_EQ(tileView.m_data[1], 0);
+            EXPECT_EQ(tileView.m_data[2], 0);
+        }
+    }
+
+    TEST_F(CameraAtlasTest, TilesAreSlicedIntoMessages)
+    {
+        const ROS2::CameraAtlasLayout layout(32, 24, 6);
+        const auto atlas = CreateColorAtlas(layout);
+        const auto atlasView = GetAtlasView(layout, atlas, AZ::RHI::Format::R8G8B8A8_UNORM);
+        for (AZ::u32 tile = 0; tile < layout.GetTileCount(); ++tile)
+        {
+            std_msgs::msg::Header header;
+            header.frame_id = AZStd::string::format("camera_%u", tile).c_str();
+            sensor_msgs::msg::Image message;
+            ASSERT_TRUE(ROS2::CameraUtils::FillImageMessage(layout.GetTileView(atlasView, tile), header, message));
+            EXPECT_EQ(message.header.frame_id, header.frame_id);
+            EXPECT_EQ(message.encoding, "rgba8");
+            EXPECT_EQ(message.width, 32);
+            EXPECT_EQ(message.height, 24);
+            EXPECT_EQ(message.step, 32 * 4);
+            ASSERT_EQ(message.data.size(), 32 * 24 * 4);
+            for (AZ::u32 y = 0; y < message.height; ++y)
+            {
+                for (AZ::u32 x = 0; x < message.width; ++x)
+                {
+                    const uint8_t* pixel = message.data.data() + y * message.step + x * 4;
+                    EXPECT_EQ(pixel[0], tile);
+                    EXPECT_EQ(pixel[1], x);
+                    EXPECT_EQ(pixel[2], y);
+                }
+            }
+        }
+    }
+
+    TEST_F(CameraAtlasTest, DepthTilesKeepValues)
+    {
+        const ROS2::CameraAtlasLayout layout(16, 8, 3);
+        AZStd::vector<float> depth(size_t{ layout.GetAtlasWidth() } * layout.GetAtlasHeight());
+        for (size_t i = 0; i < depth.size(); ++i)
+        {
+            depth[i] = 0.5f + i * 0.25f;
+        }
+        AZStd::vector<uint8_t> atlas(depth.size() * sizeof(float));
+        memcpy(atlas.data(), depth.data(), atlas.size());
+        const auto atlasView = GetAtlasView(layout, atlas, AZ::RHI::Format::R32_FLOAT);
+
+        sensor_msgs::msg::Image message;
+        ASSERT_TRUE(ROS2::CameraUtils::FillImageMessage(layout.GetTileView(atlasView, 2), std_msgs::msg::Header(), message));
+        EXPECT_EQ(message.encoding, "32FC1");
+        EXPECT_EQ(message.step, 16 * sizeof(float));
+        const auto [originX, originY] = layout.GetTileOrigin(2);
+        for (AZ::u32 y = 0; y < message.height; ++y)
+        {
+            float rowStart = 0.0f;
+            memcpy(&rowStart, message.data.data() + y * message.step, sizeof(float));
+            EXPECT_EQ(rowStart, depth[(size_t{ originY } + y) * layout.GetAtlasWidth() + originX]);
+        }
+    }
+
+    TEST_F(CameraAtlasTest, MismatchedReadbackIsNotSliced)
+    {
+        const ROS2::CameraAtlasLayout layout(32, 24, 4);
+        AZ::RPI::AttachmentReadback::ReadbackResult result;
+        result.m_state = AZ::RPI::AttachmentReadback::ReadbackState::Success;
+        result.m_imageDescriptor.m_size = AZ::RHI::Size(32, 24, 1);
+        result.m_imageDescriptor.m_format = AZ::RHI::Format::R8G8B8A8_UNORM;
+        result.m_dataBuffer = AZStd::make_shared<AZStd::vector<uint8_t>>(32 * 24 * 4);
+
+        AZ_TEST_START_TRACE_SUPPRESSION;
+        EXPECT_FALSE(ROS2::SubmitAtlasTiles(layout, result, {}));
+        AZ_TEST_STOP_TRACE_SUPPRESSION(1);
+    }
+
+    TEST_F(CameraAtlasTest, SubmittedTilesArePublishedByTheirCameras)
+    {
+        if (!rclcpp::ok())
+        {
+            rclcpp::init(0, nullptr);
+        }
+        auto node = std::make_shared<rclcpp::Node>("camera_atlas_test", rclcpp::NodeOptions().use_intra_process_comms(true));
+
+        // Without post-processing, a pipeline publishes its frame within Submit, and the sensor publishers publish in place.
+        const ROS2::CameraAtlasLayout layout(8, 6, 3);
+        AZStd::vector<sensor_msgs::msg::Image> receivedImages(layout.GetTileCount());
+        AZStd::vector<rclcpp::Subscription<sensor_msgs::msg::Image>::SharedPtr> subscriptions;
+        AZStd::vector<ROS2::CameraAtlasRequest> requests(layout.GetTileCount());
+        for (AZ::u32 tile = 0; tile < layout.GetTileCount(); ++tile)
+        {
+            const std::string topic = "camera_atlas_test_image_" + std::to_string(tile);
+            auto imagePublisher = AZStd::make_shared<ROS2::SensorPublisher<sensor_msgs::msg::Image>>(
+                node->create_publisher<sensor_msgs::msg::Image>(topic, 10), ROS2::CameraPublishers::ImagePoolSize);
+            auto infoPublisher = AZStd::make_shared<ROS2::SensorPublisher<sensor_msgs::msg::CameraInfo>>(
+                node->create_publisher<sensor_msgs::msg::CameraInfo>(topic + "_info", 10));
+            requests[tile].m_pipeline = AZStd::make_shared<ROS2::CameraPostProcessingPipeline>(
+                AZ::EntityId(100 + tile), AZStd::move(imagePublisher), AZStd::move(infoPublisher), nullptr);
+            requests[tile].m_header.frame_id = AZStd::string::format("camera_%u", tile).c_str();
+            subscriptions.push_back(node->create_subscription<sensor_msgs::msg::Image>(
+                topic,
+                10,
+                [&receivedImages, tile](const sensor_msgs::msg::Image& image)
+                {
+                    receivedImages[tile] = image;
+                }));
+        }
+
+        const auto atlas = CreateColorAtlas(layout);
+        AZ::RPI::AttachmentReadback::ReadbackResult result;
+        result.m_state = AZ::RPI::AttachmentReadback::ReadbackState::Success;
+        result.m_attachmentType = AZ::RHI::AttachmentType::Image;
+        result.m_imageDescriptor.m_size = AZ::RHI::Size(layout.GetAtlasWidth(), layout.GetAtlasHeight(), 1);
+        result.m_imageDescriptor.m_format = AZ::RHI::Format::R8G8B8A8_UNORM;
+        result.m_dataBuffer = AZStd::make_shared<AZStd::vector<uint8_t>>(atlas);
+        ASSERT_TRUE(ROS2::SubmitAtlasTiles(layout, result, requests));
+        rclcpp::spin_some(node);
+
+        for (AZ::u32 tile = 0; tile < layout.GetTileCount(); ++tile)
+        {
+            const sensor_msgs::msg::Image& image = receivedImages[tile];
+            EXPECT_EQ(image.header.frame_id, requests[tile].m_header.frame_id);
+            ASSERT_EQ(image.width, layout.GetTileWidth());
+            ASSERT_EQ(image.height, layout.GetTileHeight());
+            for (AZ::u32 y = 0; y < image.height; ++y)
+            {
+                for (AZ::u32 x = 0; x < image.width; ++x)
+                {
+                    const uint8_t* pixel = image.data.data() + y * image.step + x * 4;
+                    EXPECT_EQ(pixel[0], tile);
+                    EXPECT_EQ(pixel[1], x);
+                    EXPECT_EQ(pixel[2], y);
+                }
+            }
+        }
+
+        subscriptions.clear();
+        requests.clear();
+    }
+} // namespace UnitTest
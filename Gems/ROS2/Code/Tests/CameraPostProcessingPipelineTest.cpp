@@ -0,0 +1,519 @@
+/*
+ * Copyright (c) Contributors to the Open 3D Engine Project.
+ * For complete copyright and license terms please see the LICENSE at the root of this distribution.
+ *
+ * SPDX-License-Identifier: Apache-2.0 OR MIT
+ *
+ */
+
+#include <AzCore/Jobs/JobContext.h>
+#include <AzCore/Jobs/JobManager.h>
+#include <AzCore/Jobs/JobManagerDesc.h>
+#include <AzCore/UnitTest/TestTypes.h>
+#include <AzCore/std/algorithm.h>
+#include <AzCore/std/chrono/chrono.h>
+#include <AzCore/std/containers/unordered_set.h>
+#include <AzCore/std/parallel/conditional_variable.h>
+#include <AzCore/std/smart_ptr/make_shared.h>
+#include <AzTest/AzTest.h>
+
+#include <Camera/CameraPostProcessingPipeline.h>
+#include <ROS2/Camera/CameraPostProcessingRequestBus.h>
+#include <rclcpp/rclcpp.hpp>
+
+namespace UnitTest
+{
+    //! Post-processing which appends a value to each pixel of a mono8 image, either for the whole image or by tiles.
+    class AppendingPostProcessing : public ROS2::CameraPostProcessingRequestBus::Handler
+    {
+    public:
+        AppendingPostProcessing(const AZ::EntityId& entityId, AZ::u8 priority, uint8_t value, bool supportsTiles)
+            : m_priority(priority)
+            , m_value(value)
+            , m_supportsTiles(supportsTiles)
+        {
+            ROS2::CameraPostProcessingRequestBus::Handler::BusConnect(entityId);
+        }
+
+        ~AppendingPostProcessing() override
+        {
+            ROS2::CameraPostProcessingRequestBus::Handler::BusDisconnect();
+        }
+
+        void ApplyPostProcessing(sensor_msgs::msg::Image& image) override
+        {
+            for (auto& pixel : image.data)
+            {
+                pixel = static_cast<uint8_t>(pixel * 10 + m_value);
+            }
+        }
+
+        bool SupportsFormat(const AZStd::string& encodingFormat) override
+        {
+            return encodingFormat == "mono8";
+        }
+
+        AZ::u8 GetPriority() const override
+        {
+            return m_priority;
+        }
+
+        bool SupportsTiles() const override
+        {
+            return m_supportsTiles;
+        }
+
+        void ApplyPostProcessingToTile(
+            const sensor_msgs::msg::Image& source,
+            sensor_msgs::msg::Image& target,
+            AZ::u32 firstRow,
+            AZ::u32 lastRow,
+            [[maybe_unused]] AZ::u64 frameSeed) override
+        {
+            for (size_t i = size_t{ firstRow } * source.step; i < size_t{ lastRow } * source.step; ++i)
+            {
+                target.data[i] = static_cast<uint8_t>(source.data[i] * 10 + m_value);
+            }
+        }
+
+    private:
+        AZ::u8 m_priority;
+        uint8_t m_value;
+        bool m_supportsTiles;
+    };
+
+    //! Post-processing which holds each frame until the test releases it, so that frames finish in an order chosen by the test.
+    //! Frames are identified by the seconds of their stamps.
+    class GatedPostProcessing : public ROS2::CameraPostProcessingRequestBus::Handler
+    {
+    public:
+        explicit GatedPostProcessing(const AZ::EntityId& entityId)
+        {
+            ROS2::CameraPostProcessingRequestBus::Handler::BusConnect(entityId);
+        }
+
+        ~GatedPostProcessing() override
+        {
+            ROS2::CameraPostProcessingRequestBus::Handler::BusDisconnect();
+        }
+
+        void ApplyPostProcessing(sensor_msgs::msg::Image& image) override
+        {
+            const int32_t frame = image.header.stamp.sec;
+            AZStd::unique_lock<AZStd::mutex> lock(m_mutex);
+            m_startedFrames.push_back(frame);
+            m_maxActiveCount = AZStd::max(m_maxActiveCount, ++m_activeCount);
+            m_condition.notify_all();
+            m_condition.wait(
+                lock,
+                [this, frame]()
+                {
+                    return m_isReleasingAll || m_releasedFrames.find(frame) != m_releasedFrames.end();
+                });
+            --m_activeCount;
+            m_finishedFrames.push_back(frame);
+            m_condition.notify_all();
+        }
+
+        bool SupportsFormat(const AZStd::string& encodingFormat) override
+        {
+            return encodingFormat == "mono8";
+        }
+
+        void Release(int32_t frame)
+        {
+            AZStd::lock_guard<AZStd::mutex> lock(m_mutex);
+            m_releasedFrames.insert(frame);
+            m_condition.notify_all();
+        }
+
+        //! Releases all frames, including frames which start processing later.
+        void ReleaseAll()
+        {
+            AZStd::lock_guard<AZStd::mutex> lock(m_mutex);
+            m_isReleasingAll = true;
+            m_condition.notify_all();
+        }
+
+        bool WaitForStarted(int32_t frame)
+        {
+            return WaitFor(m_startedFrames, frame);
+        }
+
+        bool WaitForFinished(int32_t frame)
+        {
+            return WaitFor(m_finishedFrames, frame);
+        }
+
+        AZStd::vector<int32_t> GetStartedFrames()
+        {
+            AZStd::lock_guard<AZStd::mutex> lock(m_mutex);
+            return m_startedFrames;
+        }
+
+        size_t GetMaxActiveCount()
+        {
+            AZStd::lock_guard<AZStd::mutex> lock(m_mutex);
+            return m_maxActiveCount;
+        }
+
+    private:
+        bool WaitFor(const AZStd::vector<int32_t>& frames, int32_t frame)
+        {
+            AZStd::unique_lock<AZStd::mutex> lock(m_mutex);
+            return m_condition.wait_for(
+                lock,
+                AZStd::chrono::seconds(5),
+                [&frames, frame]()
+                {
+                    return AZStd::find(frames.begin(), frames.end(), frame) != frames.end();
+                });
+        }
+
+        AZStd::mutex m_mutex;
+        AZStd::condition_variable m_condition;
+        AZStd::unordered_set<int32_t> m_releasedFrames;
+        bool m_isReleasingAll = false;
+        AZStd::vector<int32_t> m_startedFrames;
+        AZStd::vector<int32_t> m_finishedFrames;
+        size_t m_activeCount = 0;
+        size_t m_maxActiveCount = 0;
+    };
+
+    //! Tiled post-processing which records the frame seeds it is given.
+    class SeedRecordingPostProcessing : public ROS2::CameraPostProcessingRequestBus::Handler
+    {
+    public:
+        explicit SeedRecordingPostProcessing(const AZ::EntityId& entityId)
+        {
+            ROS2::CameraPostProcessingRequestBus::Handler::BusConnect(entityId);
+        }
+
+        ~SeedRecordingPostProcessing() override
+        {
+            ROS2::CameraPostProcessingRequestBus::Handler::BusDisconnect();
+        }
+
+        void ApplyPostProcessing([[maybe_unused]] sensor_msgs::msg::Image& image) override
+        {
+        }
+
+        bool SupportsFormat(const AZStd::string& encodingFormat) override
+        {
+            return encodingFormat == "mono8";
+        }
+
+        bool SupportsTiles() const override
+        {
+            return true;
+        }
+
+        void ApplyPostProcessingToTile(
+            [[maybe_unused]] const sensor_msgs::msg::Image& source,
+            [[maybe_unused]] sensor_msgs::msg::Image& target,
+            [[maybe_unused]] AZ::u32 firstRow,
+            [[maybe_unused]] AZ::u32 lastRow,
+            AZ::u64 frameSeed) override
+        {
+            AZStd::lock_guard<AZStd::mutex> lock(m_mutex);
+            m_seeds.push_back(frameSeed);
+        }
+
+        AZStd::vector<AZ::u64> GetSeeds()
+        {
+            AZStd::lock_guard<AZStd::mutex> lock(m_mutex);
+            return m_seeds;
+        }
+
+    private:
+        AZStd::mutex m_mutex;
+        AZStd::vector<AZ::u64> m_seeds;
+    };
+
+    class CameraPostProcessingPipelineTest : public LeakDetectionFixture
+    {
+    public:
+        void SetUp() override
+        {
+            LeakDetectionFixture::SetUp();
+            AZ::JobManagerDesc jobManagerDesc;
+            jobManagerDesc.m_workerThreads.resize(4);
+            m_jobManager = AZStd::make_unique<AZ::JobManager>(jobManagerDesc);
+            m_jobContext = AZStd::make_unique<AZ::JobContext>(*m_jobManager);
+            AZ::JobContext::SetGlobalContext(m_jobContext.get());
+        }
+
+        void TearDown() override
+        {
+            AZ::JobContext::SetGlobalContext(nullptr);
+            m_jobContext.reset();
+            m_jobManager.reset();
+            LeakDetectionFixture::TearDown();
+        }
+
+        static sensor_msgs::msg::Image CreateImage(AZ::u32 width, AZ::u32 height)
+        {
+            sensor_msgs::msg::Image image;
+            image.encoding = "mono8";
+            image.width = width;
+            image.height = height;
+            image.step = width;
+            image.data.resize(size_t{ width } * height, 0);
+            return image;
+        }
+
+        const AZ::EntityId m_entityId{ 42 };
+
+    private:
+        AZStd::unique_ptr<AZ::JobManager> m_jobManager;
+        AZStd::unique_ptr<AZ::JobContext> m_jobContext;
+    };
+
+    //! Submits frames to a pipeline which publishes them to an intra-process subscription.
+    class CameraPostProcessingPipelineSubmitTest : public CameraPostProcessingPipelineTest
+    {
+    public:
+        static constexpr const char* ImageTopic = "camera_post_processing_pipeline_test_image";
+        static constexpr const char* InfoTopic = "camera_post_processing_pipeline_test_camera_info";
+
+        void SetUp() override
+        {
+            CameraPostProcessingPipelineTest::SetUp();
+            if (!rclcpp::ok())
+            {
+                rclcpp::init(0, nullptr);
+            }
+            // Without a sensor publishing thread, sensor publishers publish in place, on the jobs of the pipeline.
+            m_node = std::make_shared<rclcpp::Node>(
+                "camera_post_processing_pipeline_test", rclcpp::NodeOptions().use_intra_process_comms(true));
+            m_imagePublisher = AZStd::make_shared<ROS2::SensorPublisher<sensor_msgs::msg::Image>>(
+                m_node->create_publisher<sensor_msgs::msg::Image>(ImageTopic, 10), ROS2::CameraPublishers::ImagePoolSize);
+            m_infoPublisher = AZStd::make_shared<ROS2::SensorPublisher<sensor_msgs::msg::CameraInfo>>(
+                m_node->create_publisher<sensor_msgs::msg::CameraInfo>(InfoTopic, 10));
+            m_pipeline = AZStd::make_shared<ROS2::CameraPostProcessingPipeline>(m_entityId, m_imagePublisher, m_infoPublisher, nullptr);
+            m_subscription = m_node->create_subscription<sensor_msgs::msg::Image>(
+                ImageTopic,
+                10,
+                [this](const sensor_msgs::msg::Image& image)
+                {
+                    m_receivedImages.push_back(image);
+                });
+        }
+
+        void TearDown() override
+        {
+            m_subscription.reset();
+            m_pipeline.reset();
+            m_infoPublisher.reset();
+            m_imagePublisher.reset();
+            m_node.reset();
+            m_receivedImages.clear();
+            CameraPostProcessingPipelineTest::TearDown();
+        }
+
+        //! Submits a 4x4 mono8 frame of zeroes, identified by the seconds of its stamp.
+        void Submit(int32_t frame)
+        {
+            static constexpr AZ::u32 Size = 4;
+            AZ::RPI::AttachmentReadback::ReadbackResult result;
+            result.m_state = AZ::RPI::AttachmentReadback::ReadbackState::Success;
+            result.m_attachmentType = AZ::RHI::AttachmentType::Image;
+            result.m_imageDescriptor.m_size = AZ::RHI::Size(Size, Size, 1);
+            result.m_imageDescriptor.m_format = AZ::RHI::Format::R8_UNORM;
+            result.m_dataBuffer = AZStd::make_shared<AZStd::vector<uint8_t>>(Size * Size, uint8_t{ 0 });
+
+            std_msgs::msg::Header header;
+            header.stamp.sec = frame;
+            header.frame_id = "camera";
+            m_pipeline->Submit(result, header, sensor_msgs::msg::CameraInfo());
+        }
+
+        //! Waits until the subscription received a number of images in total.
+        bool WaitForImages(size_t count)
+        {
+            const auto deadline = AZStd::chrono::steady_clock::now() + AZStd::chrono::seconds(5);
+            while (m_receivedImages.size() < count)
+            {
+                if (AZStd::chrono::steady_clock::now() > deadline)
+                {
+                    return false;
+                }
+                rclcpp::spin_some(m_node);
+            }
+            return true;
+        }
+
+        AZStd::vector<int32_t> GetReceivedFrames() const
+        {
+            AZStd::vector<int32_t> frames;
+            for (const auto& image : m_receivedImages)
+            {
+                frames.push_back(image.header.stamp.sec);
+            }
+            return frames;
+        }
+
+        std::shared_ptr<rclcpp::Node> m_node;
+        ROS2::CameraPublishers::ImagePublisherPtrType m_imagePublisher;
+        ROS2::CameraPublishers::CameraInfoPublisherPtrType m_infoPublisher;
+        AZStd::shared_ptr<ROS2::CameraPostProcessingPipeline> m_pipeline;
+        rclcpp::Subscription<sensor_msgs::msg::Image>::SharedPtr m_subscription;
+        AZStd::vector<sensor_msgs::msg::Image> m_receivedImages;
+    };
+
+    TEST_F(CameraPostProcessingPipelineTest, HandlersRunByDescendingPriority)
+    {
+        AppendingPostProcessing low(m_entityId, 10, 3, false);
+        AppendingPostProcessing high(m_entityId, 200, 1, false);
+        AppendingPostProcessing medium(m_entityId, ROS2::CameraPostProcessingRequests::DefaultPriority, 2, false);
+
+        auto image = CreateImage(4, 4);
+        sensor_msgs::msg::Image scratch;
+        ROS2::CameraPostProcessingPipeline::ApplyPostProcessing(m_entityId, image, scratch, 1, 1);
+        for (const auto pixel : image.data)
+        {
+            EXPECT_EQ(pixel, 123);
+        }
+    }
+
+    TEST_F(CameraPostProcessingPipelineTest, TilesCoverAllRows)
+    {
+        AppendingPostProcessing first(m_entityId, 200, 1, true);
+        AppendingPostProcessing second(m_entityId, 100, 2, false);
+        AppendingPostProcessing third(m_entityId, 50, 3, true);
+
+        // Heights which do not divide into whole tiles leave a shorter last tile.
+        auto image = CreateImage(16, ROS2::CameraPostProcessingPipeline::MinRowsPerTile * 5 + 7);
+        sensor_msgs::msg::Image scratch;
+        ROS2::CameraPostProcessingPipeline::ApplyPostProcessing(m_entityId, image, scratch, 4, 1);
+        ASSERT_EQ(image.data.size(), size_t{ image.step } * image.height);
+        for (const auto pixel : image.data)
+        {
+            EXPECT_EQ(pixel, 123);
+        }
+    }
+
+    TEST_F(CameraPostProcessingPipelineTest, UnsupportedEncodingIsLeftUntouched)
+    {
+        AppendingPostProcessing handler(m_entityId, 10, 3, true);
+
+        auto image = CreateImage(4, 4);
+        image.encoding = "rgba8";
+        sensor_msgs::msg::Image scratch;
+        EXPECT_FALSE(ROS2::CameraPostProcessingPipeline::HasPostProcessing(m_entityId, "rgba8"));
+        EXPECT_TRUE(ROS2::CameraPostProcessingPipeline::HasPostProcessing(m_entityId, "mono8"));
+        ROS2::CameraPostProcessingPipeline::ApplyPostProcessing(m_entityId, image, scratch, 4, 1);
+        for (const auto pixel : image.data)
+        {
+            EXPECT_EQ(pixel, 0);
+        }
+    }
+
+    TEST_F(CameraPostProcessingPipelineTest, TilesShareFrameSeed)
+    {
+        SeedRecordingPostProcessing handler(m_entityId);
+        auto image = CreateImage(16, ROS2::CameraPostProcessingPipeline::MinRowsPerTile * 4);
+        sensor_msgs::msg::Image scratch;
+        ROS2::CameraPostProcessingPipeline::ApplyPostProcessing(m_entityId, image, scratch, 4, 7);
+        EXPECT_EQ(handler.GetSeeds(), AZStd::vector<AZ::u64>(4, 7));
+    }
+
+    TEST_F(CameraPostProcessingPipelineSubmitTest, SubmittedFramesArePublished)
+    {
+        // Without post-processing, frames are published by Submit itself.
+        Submit(1);
+        EXPECT_EQ(m_imagePublisher->GetStatistics().m_publishedCount, 1u);
+        EXPECT_EQ(m_infoPublisher->GetStatistics().m_publishedCount, 1u);
+
+        {
+            AppendingPostProcessing handler(m_entityId, 10, 3, false);
+            Submit(2);
+            ASSERT_TRUE(WaitForImages(2));
+        }
+
+        const sensor_msgs::msg::Image& raw = m_receivedImages[0];
+        EXPECT_EQ(raw.header.frame_id, "camera");
+        EXPECT_EQ(raw.encoding, "mono8");
+        EXPECT_EQ(raw.width, 4u);
+        EXPECT_EQ(raw.step, 4u);
+        EXPECT_EQ(raw.data, std::vector<uint8_t>(16, 0));
+        EXPECT_EQ(m_receivedImages[1].data, std::vector<uint8_t>(16, 3));
+    }
+
+    TEST_F(CameraPostProcessingPipelineSubmitTest, FramesArePublishedInSubmissionOrder)
+    {
+        GatedPostProcessing gate(m_entityId);
+        Submit(1);
+        Submit(2);
+        ASSERT_TRUE(gate.WaitForStarted(1));
+        ASSERT_TRUE(gate.WaitForStarted(2));
+
+        // The second frame finishes first, but waits for the first one.
+        gate.Release(2);
+        ASSERT_TRUE(gate.WaitForFinished(2));
+        EXPECT_EQ(m_imagePublisher->GetStatistics().m_publishedCount, 0u);
+
+        gate.Release(1);
+        ASSERT_TRUE(WaitForImages(2));
+        EXPECT_EQ(GetReceivedFrames(), AZStd::vector<int32_t>({ 1, 2 }));
+    }
+
+    TEST_F(CameraPostProcessingPipelineSubmitTest, OldestWaitingFrameIsDropped)
+    {
+        GatedPostProcessing gate(m_entityId);
+        // Two frames are processed, the third one waits, and the next ones take the place of the waiting one.
+        Submit(1);
+        Submit(2);
+        Submit(3);
+        Submit(4);
+        Submit(5);
+
+        gate.ReleaseAll();
+        ASSERT_TRUE(WaitForImages(3));
+        EXPECT_EQ(GetReceivedFrames(), AZStd::vector<int32_t>({ 1, 2, 5 }));
+        const AZStd::vector<int32_t> startedFrames = gate.GetStartedFrames();
+        EXPECT_EQ(AZStd::find(startedFrames.begin(), startedFrames.end(), 3), startedFrames.end());
+        EXPECT_EQ(AZStd::find(startedFrames.begin(), startedFrames.end(), 4), startedFrames.end());
+    }
+
+    TEST_F(CameraPostProcessingPipelineSubmitTest, FramesInFlightAreBounded)
+    {
+        static_assert(ROS2::CameraPostProcessingPipeline::MaxParallelFrames == 2);
+        static_assert(ROS2::CameraPostProcessingPipeline::MaxFramesInFlight == 3);
+
+        GatedPostProcessing gate(m_entityId);
+        Submit(1);
+        Submit(2);
+        ASSERT_TRUE(gate.WaitForStarted(1));
+        ASSERT_TRUE(gate.WaitForStarted(2));
+        gate.Release(2);
+
+        // The third frame starts once the second one is done, which then waits for publication behind the first one.
+        Submit(3);
+        ASSERT_TRUE(gate.WaitForStarted(3));
+
+        // All frames are in flight, and none of them waits for processing, so the new frame is dropped.
+        Submit(4);
+
+        gate.ReleaseAll();
+        ASSERT_TRUE(WaitForImages(3));
+        EXPECT_EQ(GetReceivedFrames(), AZStd::vector<int32_t>({ 1, 2, 3 }));
+        EXPECT_LE(gate.GetMaxActiveCount(), ROS2::CameraPostProcessingPipeline::MaxParallelFrames);
+        const AZStd::vector<int32_t> startedFrames = gate.GetStartedFrames();
+        EXPECT_EQ(AZStd::find(startedFrames.begin(), startedFrames.end(), 4), startedFrames.end());
+    }
+
+    TEST_F(CameraPostProcessingPipelineSubmitTest, FramesWithSameStampGetDifferentSeeds)
+    {
+        // Stamps repeat while the simulation is paused, and each frame still gets its own seed.
+        SeedRecordingPostProcessing handler(m_entityId);
+        Submit(1);
+        ASSERT_TRUE(WaitForImages(1));
+        Submit(1);
+        ASSERT_TRUE(WaitForImages(2));
+
+        const AZStd::vector<AZ::u64> seeds = handler.GetSeeds();
+        ASSERT_EQ(seeds.size(), 2u);
+        EXPECT_NE(seeds[0], seeds[1]);
+    }
+} // namespace UnitTest
@@ -0,0 +1,153 @@
+/*
+ * Copyright (c) Contributors to the Open 3D Engine Project.
+ * For complete copyright and license terms please see the LICENSE at the root of this distribution.
+ *
+ * SPDX-License-Identifier: Apache-2.0 OR MIT
+ *
+ */
+
+#if defined(HAVE_BENCHMARK)
+
+#include <AzCore/Casting/numeric_cast.h>
+#include <AzTest/AzTest.h>
+#include <benchmark/benchmark.h>
+#include <cmath>
+#include <random>
+
+#include <Camera/CameraImageNoise.h>
+#include <Camera/CameraLensDistortion.h>
+#include <Camera/CameraUtilities.h>
+
+namespace Benchmark
+{
+    //! Distortion of a typical wide angle lens.
+    static const ROS2::LensDistortionCoefficients BenchmarkDistortion{ -0.28f, 0.07f, 0.0f, 0.0005f, -0.0003f };
+
+    static AZStd::vector<uint8_t> CreateImage(AZ::u32 width, AZ::u32 height)
+    {
+        AZStd::vector<uint8_t> image(size_t{ width } * height * 4);
+        for (size_t i = 0; i < image.size(); ++i)
+        {
+            image[i] = static_cast<uint8_t>(i * 7 + i / 4096);
+        }
+        return image;
+    }
+
+    //! Per-pixel path, the way a remap without precomputed maps works: the distortion model is inverted for each pixel of each
+    //! frame, channels are interpolated in floating point and noise samples come from a standard library distribution.
+    static void BM_SensorEffectsNaive(benchmark::State& state)
+    {
+        const AZ::u32 width = aznumeric_cast<AZ::u32>(state.range(0));
+        const AZ::u32 height = aznumeric_cast<AZ::u32>(state.range(1));
+        const AZ::Matrix3x3 intrinsics = ROS2::CameraUtils::MakeCameraIntrinsics(width, height, 90.0f);
+        const float fx = intrinsics.GetElement(0, 0);
+        const float fy = intrinsics.GetElement(1, 1);
+        const float cx = intrinsics.GetElement(0, 2);
+        const float cy = intrinsics.GetElement(1, 2);
+        const auto source = CreateImage(width, height);
+        AZStd::vector<uint8_t> target(source.size());
+        std::mt19937 generator(42);
+        std::normal_distribution<float> distribution(0.0f, 3.0f);
+
+        for ([[maybe_unused]] auto _ : state)
+        {
+            for (AZ::u32 y = 0; y < height; ++y)
+            {
+                for (AZ::u32 x = 0; x < width; ++x)
+                {
+                    const AZ::Vector2 point =
+                        ROS2::LensDistortionMap::UndistortPoint(AZ::Vector2((x - cx) / fx, (y - cy) / fy), BenchmarkDistortion);
+                    const float sourceX = point.GetX() * fx + cx;
+                    const float sourceY = point.GetY() * fy + cy;
+                    uint8_t* pixel = target.data() + (size_t{ y } * width + x) * 4;
+                    if (!(sourceX >= 0.0f && sourceY >= 0.0f && sourceX <= width - 1.0f && sourceY <= height - 1.0f))
+                    {
+                        AZStd::fill(pixel, pixel + 4, uint8_t{ 0 });
+                        continue;
+                    }
+                    const AZ::u32 left = AZStd::min(static_cast<AZ::u32>(sourceX), width - 2);
+                    const AZ::u32 top = AZStd::min(static_cast<AZ::u32>(sourceY), height - 2);
+                    const float weightX = sourceX - left;
+                    const float weightY = sourceY - top;
+                    const uint8_t* topLeft = source.data() + (size_t{ top } * width + left) * 4;
+                    const uint8_t* bottomLeft = topLeft + size_t{ width } * 4;
+                    for (size_t channel = 0; channel < 4; ++channel)
+                    {
+                        const float upper = topLeft[channel] * (1.0f - weightX) + topLeft[channel + 4] * weightX;
+                        const float lower = bottomLeft[channel] * (1.0f - weightX) + bottomLeft[channel + 4] * weightX;
+                        float value = upper * (1.0f - weightY) + lower * weightY;
+                        if (channel < 3)
+                        {
+                            value += distribution(generator);
+                        }
+                        pixel[channel] = static_cast<uint8_t>(AZStd::clamp(value + 0.5f, 0.0f, 255.0f));
+                    }
+                }
+            }
+            benchmark::DoNotOptimize(target.data());
+        }
+        state.SetBytesProcessed(state.iterations() * source.size());
+    }
+
+    //! Built-in path: precomputed remap map with packed RGBA8 interpolation, followed by table-driven noise.
+    static void BM_SensorEffectsRemap(benchmark::State& state)
+    {
+        const AZ::u32 width = aznumeric_cast<AZ::u32>(state.range(0));
+        const AZ::u32 height = aznumeric_cast<AZ::u32>(state.range(1));
+        const ROS2::LensDistortionMap map(
+            width, height, ROS2::CameraUtils::MakeCameraIntrinsics(width, height, 90.0f), BenchmarkDistortion);
+        const ROS2::ImageNoise noise({ 3.0f, 0.0f, 0.0f });
+        const auto source = CreateImage(width, height);
+        AZStd::vector<uint8_t> target(source.size());
+        AZ::u64 frame = 0;
+
+        for ([[maybe_unused]] auto _ : state)
+        {
+            map.RemapRgba8(source.data(), size_t{ width } * 4, target.data(), size_t{ width } * 4, 0, height);
+            noise.ApplyRgba8(target.data(), size_t{ width } * 4, width, 0, height, ++frame);
+            benchmark::DoNotOptimize(target.data());
+        }
+        state.SetBytesProcessed(state.iterations() * source.size());
+    }
+
+    //! Built-in path for depth: nearest sample remap and noise growing with distance.
+    static void BM_SensorEffectsRemapDepth(benchmark::State& state)
+    {
+        const AZ::u32 width = aznumeric_cast<AZ::u32>(state.range(0));
+        const AZ::u32 height = aznumeric_cast<AZ::u32>(state.range(1));
+        const ROS2::LensDistortionMap map(
+            width, height, ROS2::CameraUtils::MakeCameraIntrinsics(width, height, 90.0f), BenchmarkDistortion);
+        const ROS2::ImageNoise noise({ 0.0f, 0.0f, 0.005f });
+        const AZStd::vector<float> source(size_t{ width } * height, 3.0f);
+        AZStd::vector<float> target(source.size());
+        AZ::u64 frame = 0;
+
+        for ([[maybe_unused]] auto _ : state)
+        {
+            const auto* sourceData = reinterpret_cast<const uint8_t*>(source.data());
+            auto* targetData = reinterpret_cast<uint8_t*>(target.data());
+            map.RemapDepth(sourceData, size_t{ width } * sizeof(float), targetData, size_t{ width } * sizeof(float), 0, height);
+            noise.ApplyDepth(targetData, size_t{ width } * sizeof(float), width, 0, height, ++frame);
+            benchmark::DoNotOptimize(target.data());
+        }
+        state.SetBytesProcessed(state.iterations() * source.size() * sizeof(float));
+    }
+
+    BENCHMARK(BM_SensorEffectsNaive)
+        ->ArgNames({ "width", "height" })
+        ->Args({ 640, 480 })
+        ->Args({ 1920, 1080 })
+        ->Unit(benchmark::kMillisecond);
+    BENCHMARK(BM_SensorEffectsRemap)
+        ->ArgNames({ "width", "height" })
+        ->Args({ 640, 480 })
+        ->Args({ 1920, 1080 })
+        ->Unit(benchmark::kMillisecond);
+    BENCHMARK(BM_SensorEffectsRemapDepth)
+        ->ArgNames({ "width", "height" })
+        ->Args({ 640, 480 })
+        ->Args({ 1920, 1080 })
+        ->Unit(benchmark::kMillisecond);
+} // namespace Benchmark
+
+#endif // HAVE_BENCHMARK
@@ -0,0 +1,225 @@
+/*
+ * Copyright (c) Contributors to the Open 3D Engine Project.
+ * For complete copyright and license terms please see the LICENSE at the root of this distribution.
+ *
+ * SPDX-License-Identifier: Apache-2.0 OR MIT
+ *
+ */
+
+#include <AzCore/UnitTest/TestTypes.h>
+#include <AzTest/AzTest.h>
+#include <cmath>
+#include <limits>
+
+#include <Camera/CameraImageNoise.h>
+#include <Camera/CameraLensDistortion.h>
+#include <Camera/CameraSensorEffects.h>
+#include <Camera/CameraUtilities.h>
+
+namespace UnitTest
+{
+    class CameraSensorEffectsTest : public LeakDetectionFixture
+    {
+    public:
+        static constexpr AZ::u32 Width = 160;
+        static constexpr AZ::u32 Height = 120;
+
+        static AZ::Matrix3x3 GetIntrinsics()
+        {
+            return ROS2::CameraUtils::MakeCameraIntrinsics(Width, Height, 90.0f);
+        }
+
+        //! Color gradient along both axes, which makes sampled positions visible in the image.
+        static AZStd::vector<uint8_t> CreateGradient()
+        {
+            AZStd::vector<uint8_t> image(size_t{ Width } * Height * 4);
+            for (AZ::u32 y = 0; y < Height; ++y)
+            {
+                for (AZ::u32 x = 0; x < Width; ++x)
+                {
+                    uint8_t* pixel = image.data() + (size_t{ y } * Width + x) * 4;
+                    pixel[0] = static_cast<uint8_t>(x * 255 / Width);
+                    pixel[1] = static_cast<uint8_t>(y * 255 / Height);
+                    pixel[2] = 100;
+                    pixel[3] = 255;
+                }
+            }
+            return image;
+        }
+
+        static float GetStdDev(const AZStd::vector<float>& values, float& mean)
+        {
+            double sum = 0.0;
+            double sumOfSquares = 0.0;
+            for (const float value : values)
+            {
+                sum += value;
+                sumOfSquares += value * value;
+            }
+            mean = static_cast<float>(sum / values.size());
+            return static_cast<float>(std::sqrt(sumOfSquares / values.size() - double{ mean } * mean));
+        }
+    };
+
+    TEST_F(CameraSensorEffectsTest, UndistortionInvertsDistortion)
+    {
+        const ROS2::LensDistortionCoefficients coefficients{ -0.3f, 0.1f, 0.0f, 0.001f, -0.002f };
+        for (float x = -0.9f; x <= 0.9f; x += 0.1f)
+        {
+            for (float y = -0.7f; y <= 0.7f; y += 0.1f)
+            {
+                const AZ::Vector2 point(x, y);
+                const AZ::Vector2 undistorted = ROS2::LensDistortionMap::UndistortPoint(point, coefficients);
+                const AZ::Vector2 distorted = ROS2::LensDistortionMap::DistortPoint(undistorted, coefficients);
+                EXPECT_NEAR(distorted.GetX(), x, 1e-5f);
+                EXPECT_NEAR(distorted.GetY(), y, 1e-5f);
+            }
+        }
+    }
+
+    TEST_F(CameraSensorEffectsTest, ZeroDistortionKeepsImages)
+    {
+        const ROS2::LensDistortionMap map(Width, Height, GetIntrinsics(), {});
+        const auto source = CreateGradient();
+        AZStd::vector<uint8_t> target(source.size());
+        map.RemapRgba8(source.data(), Width * 4, target.data(), Width * 4, 0, Height);
+        EXPECT_EQ(source, target);
+
+        AZStd::vector<float> depth(size_t{ Width } * Height);
+        for (size_t i = 0; i < depth.size(); ++i)
+        {
+            depth[i] = 1.0f + i * 0.001f;
+        }
+        AZStd::vector<float> depthTarget(depth.size());
+        map.RemapDepth(
+            reinterpret_cast<const uint8_t*>(depth.data()),
+            Width * sizeof(float),
+            reinterpret_cast<uint8_t*>(depthTarget.data()),
+            Width * sizeof(float),
+            0,
+            Height);
+        EXPECT_EQ(depth, depthTarget);
+    }
+
+    TEST_F(CameraSensorEffectsTest, BarrelDistortionKeepsCenterAndBlanksCorners)
+    {
+        const ROS2::LensDistortionMap map(Width, Height, GetIntrinsics(), { -0.3f, 0.0f, 0.0f, 0.0f, 0.0f });
+        const auto source = CreateGradient();
+        AZStd::vector<uint8_t> target(source.size());
+        map.RemapRgba8(source.data(), Width * 4, target.data(), Width * 4, 0, Height);
+
+        // Barrel distortion compresses the image towards the principal point, so corners see beyond the rendered image.
+        const size_t center = (size_t{ Height / 2 } * Width + Width / 2) * 4;
+        EXPECT_NEAR(target[center], source[center], 1);
+        EXPECT_NEAR(target[center + 1], source[center + 1], 1);
+        EXPECT_EQ(target[3], 0);
+
+        AZStd::vector<float> depth(size_t{ Width } * Height, 2.0f);
+        AZStd::vector<float> depthTarget(depth.size());
+        map.RemapDepth(
+            reinterpret_cast<const uint8_t*>(depth.data()),
+            Width * sizeof(float),
+            reinterpret_cast<uint8_t*>(depthTarget.data()),
+            Width * sizeof(float),
+            0,
+            Height);
+        EXPECT_TRUE(std::isnan(depthTarget.front()));
+        EXPECT_EQ(depthTarget[center / 4], 2.0f);
+    }
+
+    TEST_F(CameraSensorEffectsTest, ColorNoiseHasConfiguredDeviationAndKeepsAlpha)
+    {
+        const ROS2::ImageNoise noise({ 5.0f, 0.0f, 0.0f });
+        AZStd::vector<uint8_t> image(size_t{ Width } * Height * 4, 128);
+        noise.ApplyRgba8(image.data(), Width * 4, Width, 0, Height, 42);
+
+        AZStd::vector<float> values;
+        for (size_t i = 0; i < image.size(); ++i)
+        {
+            if (i % 4 == 3)
+            {
+                EXPECT_EQ(image[i], 128);
+                continue;
+            }
+            values.push_back(image[i]);
+        }
+        float mean = 0.0f;
+        EXPECT_NEAR(GetStdDev(values, mean), 5.0f, 0.2f);
+        EXPECT_NEAR(mean, 128.0f, 0.2f);
+    }
+
+    TEST_F(CameraSensorEffectsTest, NoiseDoesNotDependOnTiles)
+    {
+        const ROS2::ImageNoise noise({ 3.0f, 0.5f, 0.0f });
+        AZStd::vector<uint8_t> whole = CreateGradient();
+        AZStd::vector<uint8_t> tiled = whole;
+        noise.ApplyRgba8(whole.data(), Width * 4, Width, 0, Height, 7);
+        noise.ApplyRgba8(tiled.data(), Width * 4, Width, 0, 37, 7);
+        noise.ApplyRgba8(tiled.data(), Width * 4, Width, 37, Height, 7);
+        EXPECT_EQ(whole, tiled);
+    }
+
+    TEST_F(CameraSensorEffectsTest, DepthNoiseGrowsWithSquareOfDistance)
+    {
+        const ROS2::ImageNoise noise({ 0.0f, 0.0f, 0.01f });
+        AZStd::vector<float> depth(size_t{ Width } * Height, 2.0f);
+        depth[0] = std::numeric_limits<float>::quiet_NaN();
+        noise.ApplyDepth(reinterpret_cast<uint8_t*>(depth.data()), Width * sizeof(float), Width, 0, Height, 7);
+        EXPECT_TRUE(std::isnan(depth[0]));
+
+        depth.erase(depth.begin());
+        float mean = 0.0f;
+        EXPECT_NEAR(GetStdDev(depth, mean), 0.04f, 0.002f);
+        EXPECT_NEAR(mean, 2.0f, 0.002f);
+    }
+
+    TEST_F(CameraSensorEffectsTest, WholeImageMatchesTiles)
+    {
+        ROS2::CameraSensorConfiguration configuration;
+        configuration.m_width = Width;
+        configuration.m_height = Height;
+        configuration.m_distortionK1 = -0.2f;
+        configuration.m_colorNoiseStdDev = 2.0f;
+        ASSERT_TRUE(ROS2::CameraSensorEffects::HasEffects(configuration));
+
+        sensor_msgs::msg::Image image;
+        image.encoding = "rgba8";
+        image.width = Width;
+        image.height = Height;
+        image.step = Width * 4;
+        const auto gradient = CreateGradient();
+        image.data.assign(gradient.begin(), gradient.end());
+
+        // Whole images are seeded by the number of the frame, which is 1 for the first one.
+        ROS2::CameraSensorEffects tiledEffects(configuration, GetIntrinsics());
+        sensor_msgs::msg::Image target = image;
+        tiledEffects.ApplyPostProcessingToTile(image, target, 0, Height / 2, 1);
+        tiledEffects.ApplyPostProcessingToTile(image, target, Height / 2, Height, 1);
+
+        ROS2::CameraSensorEffects effects(configuration, GetIntrinsics());
+        effects.ApplyPostProcessing(image);
+        EXPECT_EQ(image.data, target.data);
+    }
+
+    TEST_F(CameraSensorEffectsTest, FramesWithSameStampGetDifferentNoise)
+    {
+        ROS2::CameraSensorConfiguration configuration;
+        configuration.m_width = Width;
+        configuration.m_height = Height;
+        configuration.m_colorNoiseStdDev = 8.0f;
+        ROS2::CameraSensorEffects effects(configuration, GetIntrinsics());
+
+        // Stamps repeat while the simulation is paused.
+        sensor_msgs::msg::Image image;
+        image.encoding = "rgba8";
+        image.width = Width;
+        image.height = Height;
+        image.step = Width * 4;
+        const auto gradient = CreateGradient();
+        image.data.assign(gradient.begin(), gradient.end());
+        sensor_msgs::msg::Image nextImage = image;
+        effects.ApplyPostProcessing(image);
+        effects.ApplyPostProcessing(nextImage);
+        EXPECT_NE(image.data, nextImage.data);
+    }
+} // namespace UnitTest
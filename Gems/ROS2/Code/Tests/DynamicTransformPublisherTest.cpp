@@ -0,0 +1,198 @@
+/*
+ * Copyright (c) Contributors to the Open 3D Engine Project.
+ * For complete copyright and license terms please see the LICENSE at the root of this distribution.
+ *
+ * SPDX-License-Identifier: Apache-2.0 OR MIT
+ *
+ */
+
+#include <AzCore/Component/ComponentApplication.h>
+#include <AzCore/Component/Entity.h>
+#include <AzCore/UnitTest/TestTypes.h>
+#include <AzCore/std/chrono/chrono.h>
+#include <AzCore/std/parallel/thread.h>
+#include <AzCore/std/smart_ptr/unique_ptr.h>
+#include <AzFramework/Components/TransformComponent.h>
+#include <AzTest/AzTest.h>
+
+#include <Frame/DynamicTransformPublisher.h>
+#include <rclcpp/rclcpp.hpp>
+#include <tf2_ros/qos.hpp>
+
+namespace UnitTest
+{
+    class DynamicTransformPublisherTest : public LeakDetectionFixture
+    {
+    public:
+        void SetUp() override
+        {
+            LeakDetectionFixture::SetUp();
+            AZ::ComponentApplication::StartupParameters startupParameters;
+            startupParameters.m_loadSettingsRegistry = false;
+            m_application = AZStd::make_unique<AZ::ComponentApplication>();
+            m_application->Create(AZ::ComponentApplication::Descriptor(), startupParameters);
+            m_application->RegisterComponentDescriptor(AzFramework::TransformComponent::CreateDescriptor());
+
+            if (!rclcpp::ok())
+            {
+                rclcpp::init(0, nullptr);
+            }
+            m_node = std::make_shared<rclcpp::Node>("dynamic_transform_publisher_test");
+            m_publisher = AZStd::make_unique<ROS2::DynamicTransformPublisher>(m_node);
+            m_subscription = m_node->create_subscription<tf2_msgs::msg::TFMessage>(
+                "/tf",
+                tf2_ros::DynamicListenerQoS(),
+                [this](const tf2_msgs::msg::TFMessage& message)
+                {
+                    m_lastMessage = message;
+                    ++m_messageCount;
+                });
+        }
+
+        void TearDown() override
+        {
+            m_subscription.reset();
+            m_publisher.reset();
+            m_node.reset();
+            m_application->Destroy();
+            m_application.reset();
+            LeakDetectionFixture::TearDown();
+        }
+
+        static AZStd::unique_ptr<AZ::Entity> CreateEntity(AZ::EntityId entityId, const AZ::Vector3& translation)
+        {
+            auto entity = AZStd::make_unique<AZ::Entity>(entityId, "Entity");
+            entity->CreateComponent<AzFramework::TransformComponent>();
+            entity->Init();
+            entity->Activate();
+            AZ::TransformBus::Event(entityId, &AZ::TransformBus::Events::SetWorldTranslation, translation);
+            return entity;
+        }
+
+        //! Publishes the registered frames and waits until the message is received.
+        bool PublishAndReceive(int32_t seconds)
+        {
+            const auto deadline = AZStd::chrono::steady_clock::now() + AZStd::chrono::seconds(5);
+            while (m_subscription->get_publisher_count() == 0)
+            {
+                if (AZStd::chrono::steady_clock::now() > deadline)
+                {
+                    return false;
+                }
+                AZStd::this_thread::sleep_for(AZStd::chrono::milliseconds(1));
+            }
+
+            builtin_interfaces::msg::Time timestamp;
+            timestamp.sec = seconds;
+            const size_t messageCount = m_messageCount;
+            m_publisher->Publish(timestamp);
+            while (m_messageCount == messageCount)
+            {
+                if (AZStd::chrono::steady_clock::now() > deadline)
+                {
+                    return false;
+                }
+                rclcpp::spin_some(m_node);
+            }
+            return true;
+        }
+
+        AZStd::unique_ptr<AZ::ComponentApplication> m_application;
+        std::shared_ptr<rclcpp::Node> m_node;
+        AZStd::unique_ptr<ROS2::DynamicTransformPublisher> m_publisher;
+        rclcpp::Subscription<tf2_msgs::msg::TFMessage>::SharedPtr m_subscription;
+        tf2_msgs::msg::TFMessage m_lastMessage;
+        size_t m_messageCount = 0;
+    };
+
+    TEST_F(DynamicTransformPublisherTest, TransformIsRelativeToParentFrame)
+    {
+        auto parent = CreateEntity(AZ::Entity::MakeId(), AZ::Vector3(1.0f, 0.0f, 0.0f));
+        auto child = CreateEntity(AZ::Entity::MakeId(), AZ::Vector3(3.0f, 0.0f, 0.0f));
+        m_publisher->RegisterFrame(child->GetId(), parent->GetId(), "parent", "child");
+
+        ASSERT_TRUE(PublishAndReceive(1));
+        ASSERT_EQ(m_lastMessage.transforms.size(), 1u);
+        EXPECT_EQ(m_lastMessage.transforms[0].header.frame_id, "parent");
+        EXPECT_EQ(m_lastMessage.transforms[0].child_frame_id, "child");
+        EXPECT_DOUBLE_EQ(m_lastMessage.transforms[0].transform.translation.x, 2.0);
+
+        m_publisher->UnregisterFrame(child->GetId());
+        EXPECT_EQ(m_publisher->GetFrameCount(), 0u);
+    }
+
+    TEST_F(DynamicTransformPublisherTest, ParentTransformIsLookedUpAgainWhenParentIsRecreated)
+    {
+        const AZ::EntityId parentId = AZ::Entity::MakeId();
+        auto parent = CreateEntity(parentId, AZ::Vector3(1.0f, 0.0f, 0.0f));
+        auto child = CreateEntity(AZ::Entity::MakeId(), AZ::Vector3(3.0f, 0.0f, 0.0f));
+        m_publisher->RegisterFrame(child->GetId(), parentId, "parent", "child");
+        ASSERT_TRUE(PublishAndReceive(1));
+
+        // The parent has no frame of its own, so nothing unregisters when it is deleted. The last known transform of the
+        // parent is used until it is back, instead of its deleted component.
+        parent.reset();
+        ASSERT_TRUE(PublishAndReceive(2));
+        ASSERT_EQ(m_lastMessage.transforms.size(), 1u);
+        EXPECT_DOUBLE_EQ(m_lastMessage.transforms[0].transform.translation.x, 2.0);
+
+        parent = CreateEntity(parentId, AZ::Vector3(2.0f, 0.0f, 0.0f));
+        ASSERT_TRUE(PublishAndReceive(3));
+        ASSERT_EQ(m_lastMessage.transforms.size(), 1u);
+        EXPECT_DOUBLE_EQ(m_lastMessage.transforms[0].transform.translation.x, 1.0);
+
+        m_publisher->UnregisterFrame(child->GetId());
+    }
+
+    TEST_F(DynamicTransformPublisherTest, QueuedTransformsOfSkippedTicksAreReplaced)
+    {
+        ROS2::DynamicTransformPublisher::Configuration configuration;
+        configuration.m_publishRate = 0.5;
+        m_publisher = AZStd::make_unique<ROS2::DynamicTransformPublisher>(m_node, configuration);
+
+        geometry_msgs::msg::TransformStamped transform;
+        transform.header.frame_id = "odom";
+        transform.child_frame_id = "base_link";
+        m_publisher->QueueTransform(transform);
+        ASSERT_TRUE(PublishAndReceive(1));
+
+        // Queued on every tick, while the rate skips publication until two seconds passed.
+        builtin_interfaces::msg::Time skippedTimestamp;
+        skippedTimestamp.sec = 1;
+        for (double x = 1.0; x <= 3.0; x += 1.0)
+        {
+            transform.transform.translation.x = x;
+            m_publisher->QueueTransform(transform);
+            skippedTimestamp.nanosec += 250000000;
+            m_publisher->Publish(skippedTimestamp);
+        }
+        ASSERT_TRUE(PublishAndReceive(3));
+        ASSERT_EQ(m_lastMessage.transforms.size(), 1u);
+        EXPECT_DOUBLE_EQ(m_lastMessage.transforms[0].transform.translation.x, 3.0);
+    }
+
+    TEST_F(DynamicTransformPublisherTest, QueuedTransformsOfDifferentFramesAreKept)
+    {
+        geometry_msgs::msg::TransformStamped transform;
+        transform.header.frame_id = "odom";
+        for (const char* childFrameId : { "base_link", "wheel", "base_link" })
+        {
+            transform.child_frame_id = childFrameId;
+            transform.transform.translation.x += 1.0;
+            m_publisher->QueueTransform(transform);
+        }
+        ASSERT_TRUE(PublishAndReceive(1));
+        ASSERT_EQ(m_lastMessage.transforms.size(), 2u);
+        EXPECT_EQ(m_lastMessage.transforms[0].child_frame_id, "base_link");
+        EXPECT_DOUBLE_EQ(m_lastMessage.transforms[0].transform.translation.x, 3.0);
+        EXPECT_EQ(m_lastMessage.transforms[1].child_frame_id, "wheel");
+        EXPECT_DOUBLE_EQ(m_lastMessage.transforms[1].transform.translation.x, 2.0);
+
+        // Slots of frames are kept, but only frames queued again are published.
+        transform.child_frame_id = "wheel";
+        m_publisher->QueueTransform(transform);
+        ASSERT_TRUE(PublishAndReceive(2));
+        ASSERT_EQ(m_lastMessage.transforms.size(), 1u);
+        EXPECT_EQ(m_lastMessage.transforms[0].child_frame_id, "wheel");
+    }
+} // namespace UnitTest
@@ -0,0 +1,84 @@
+/*
+ * Copyright (c) Contributors to the Open 3D Engine Project.
+ * For complete copyright and license terms please see the LICENSE at the root of this distribution.
+ *
+ * SPDX-License-Identifier: Apache-2.0 OR MIT
+ *
+ */
+
+#if defined(HAVE_BENCHMARK)
+
+#include <AzCore/Casting/numeric_cast.h>
+#include <AzTest/AzTest.h>
+#include <benchmark/benchmark.h>
+#include <cmath>
+#include <cstring>
+
+#include <Camera/CompressedImagePublisher.h>
+
+namespace Benchmark
+{
+    using Format = ROS2::CameraSensorConfiguration::CompressedImageFormat;
+
+    //! Builds a synthetic frame with smooth gradients and fine texture, which compresses roughly like a rendered scene.
+    //! Depth frames hold distances of a tilted plane in meters.
+    static sensor_msgs::msg::Image CreateFrame(AZ::u32 width, AZ::u32 height, bool depth)
+    {
+        sensor_msgs::msg::Image image;
+        image.width = width;
+        image.height = height;
+        image.encoding = depth ? "32FC1" : "rgba8";
+        image.step = width * 4;
+        image.data.resize(size_t{ image.step } * height);
+        for (AZ::u32 y = 0; y < height; ++y)
+        {
+            for (AZ::u32 x = 0; x < width; ++x)
+            {
+                uint8_t* pixel = image.data.data() + size_t{ y } * image.step + size_t{ x } * 4;
+                if (depth)
+                {
+                    const float distance = 1.0f + 10.0f * y / height + 0.05f * std::sin(x * 0.05f);
+                    std::memcpy(pixel, &distance, sizeof(distance));
+                    continue;
+                }
+                pixel[0] = static_cast<uint8_t>(x * 255 / width);
+                pixel[1] = static_cast<uint8_t>(y * 255 / height);
+                pixel[2] = static_cast<uint8_t>(128 + 64 * std::sin(x * 0.1f) * std::cos(y * 0.07f) + ((x * 7 + y * 13) % 9));
+                pixel[3] = 255;
+            }
+        }
+        return image;
+    }
+
+    //! Encodes frames of a camera channel the way the compressed image jobs do.
+    //! Reports throughput in raw bytes and the ratio of raw to compressed size.
+    static void BM_EncodeImage(benchmark::State& state)
+    {
+        const auto format = static_cast<Format>(state.range(2));
+        const bool depth = state.range(3) != 0;
+        const auto image = CreateFrame(aznumeric_cast<AZ::u32>(state.range(0)), aznumeric_cast<AZ::u32>(state.range(1)), depth);
+        ROS2::CompressedImagePublisher::Settings settings;
+        settings.m_format = format;
+        ROS2::ImageEncoder encoder;
+        sensor_msgs::msg::CompressedImage message;
+        for ([[maybe_unused]] auto _ : state)
+        {
+            ROS2::CompressedImagePublisher::Encode(image, settings, encoder, message);
+            benchmark::DoNotOptimize(message.data.data());
+        }
+        state.SetBytesProcessed(state.iterations() * image.data.size());
+        state.counters["compression_ratio"] =
+            benchmark::Counter(aznumeric_cast<double>(image.data.size()) / aznumeric_cast<double>(message.data.size()));
+    }
+
+    // 1080p color frames as JPEG (quality 90), PNG (level 1) and QOI, and 1080p depth frames in the compressed depth format.
+    BENCHMARK(BM_EncodeImage)
+        ->ArgNames({ "width", "height", "format", "depth" })
+        ->Args({ 1920, 1080, static_cast<int>(Format::Jpeg), 0 })
+        ->Args({ 1920, 1080, static_cast<int>(Format::Png), 0 })
+        ->Args({ 1920, 1080, static_cast<int>(Format::Qoi), 0 })
+        ->Args({ 1920, 1080, static_cast<int>(Format::Png), 1 })
+        ->Unit(benchmark::kMillisecond);
+} // namespace Benchmark
+
+#endif // HAVE_BENCHMARK
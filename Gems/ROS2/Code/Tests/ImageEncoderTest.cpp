@@ -0,0 +1,567 @@
+/*
+ * Copyright (c) Contributors to the Open 3D Engine Project.
+ * For complete copyright and license terms please see the LICENSE at the root of this distribution.
+ *
+ * SPDX-License-Identifier: Apache-2.0 OR MIT
+ *
+ */
+
+#include <AzCore/Compression/compression.h>
+#include <AzCore/UnitTest/TestTypes.h>
+#include <AzCore/std/algorithm.h>
+#include <AzCore/std/containers/unordered_map.h>
+#include <AzCore/std/containers/vector.h>
+#include <AzTest/AzTest.h>
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+#include <Camera/CompressedImagePublisher.h>
+#include <Camera/ImageEncoder.h>
+
+namespace UnitTest
+{
+    class ImageEncoderTest : public LeakDetectionFixture
+    {
+    public:
+        static sensor_msgs::msg::Image CreateImage(const char* encoding, AZ::u32 width, AZ::u32 height, AZ::u32 pixelSize)
+        {
+            sensor_msgs::msg::Image image;
+            image.encoding = encoding;
+            image.width = width;
+            image.height = height;
+            image.step = width * pixelSize;
+            image.data.resize(size_t{ image.step } * height);
+            for (size_t i = 0; i < image.data.size(); ++i)
+            {
+                image.data[i] = static_cast<uint8_t>(i * 31);
+            }
+            return image;
+        }
+
+        //! Builds an RGBA8 image with bands of gradients, noise, a flat color and two alternating colors, so that its QOI
+        //! encoding uses every kind of chunk.
+        static sensor_msgs::msg::Image CreateBandedImage(AZ::u32 width)
+        {
+            sensor_msgs::msg::Image image = CreateImage("rgba8", width, 16, 4);
+            for (AZ::u32 y = 0; y < image.height; ++y)
+            {
+                for (AZ::u32 x = 0; x < image.width; ++x)
+                {
+                    uint8_t* pixel = image.data.data() + size_t{ y } * image.step + size_t{ x } * 4;
+                    const AZ::u32 band = y / 4;
+                    if (band == 0)
+                    {
+                        pixel[0] = static_cast<uint8_t>(x);
+                        pixel[1] = static_cast<uint8_t>(x * 3);
+                        pixel[2] = static_cast<uint8_t>(x * 5);
+                        pixel[3] = 255;
+                    }
+                    else if (band == 2)
+                    {
+                        AZStd::fill(pixel, pixel + 4, uint8_t{ 200 });
+                    }
+                    else if (band == 3)
+                    {
+                        AZStd::fill(pixel, pixel + 4, uint8_t{ x % 2 == 0 ? 10 : 240 });
+                    }
+                }
+            }
+            return image;
+        }
+
+        static AZ::u32 ReadU32BigEndian(const std::vector<uint8_t>& data, size_t offset)
+        {
+            return AZ::u32{ data[offset] } << 24 | AZ::u32{ data[offset + 1] } << 16 | AZ::u32{ data[offset + 2] } << 8 | data[offset + 3];
+        }
+
+        //! Decodes the pixels of a PNG with 8-bit or 16-bit samples, by inflating its image data and reversing the filters of
+        //! its rows. 16-bit samples stay big-endian.
+        //! @param pngStart Offset of the PNG in the data.
+        //! @return Tightly packed rows of the image, or an empty vector if the PNG could not be decoded.
+        static std::vector<uint8_t> DecodePng(const std::vector<uint8_t>& data, size_t pngStart = 0)
+        {
+            static constexpr AZ::u32 ChannelCounts[] = { 1, 0, 3, 0, 2, 0, 4 };
+            if (data.size() < pngStart + 33 || data[pngStart + 1] != 'P' || data[pngStart + 2] != 'N' || data[pngStart + 3] != 'G')
+            {
+                return {};
+            }
+            const AZ::u32 width = ReadU32BigEndian(data, pngStart + 16);
+            const AZ::u32 height = ReadU32BigEndian(data, pngStart + 20);
+            const size_t pixelSize = size_t{ ChannelCounts[data[pngStart + 25] % 7] } * data[pngStart + 24] / 8;
+            const size_t rowSize = width * pixelSize;
+
+            std::vector<uint8_t> compressed;
+            for (size_t chunk = pngStart + 8; chunk + 12 <= data.size();)
+            {
+                const AZ::u32 length = ReadU32BigEndian(data, chunk);
+                if (std::memcmp(data.data() + chunk + 4, "IDAT", 4) == 0)
+                {
+                    compressed.insert(compressed.end(), data.begin() + chunk + 8, data.begin() + chunk + 8 + length);
+                }
+                chunk += 12 + size_t{ length };
+            }
+
+            std::vector<uint8_t> filtered((rowSize + 1) * height);
+            unsigned int filteredSize = static_cast<unsigned int>(filtered.size());
+            AZ::ZLib zlib;
+            zlib.StartDecompressor();
+            zlib.Decompress(compressed.data(), static_cast<unsigned int>(compressed.size()), filtered.data(), filteredSize);
+            zlib.StopDecompressor();
+
+            std::vector<uint8_t> rows(rowSize * height);
+            for (size_t y = 0; y < height; ++y)
+            {
+                const uint8_t* source = filtered.data() + y * (rowSize + 1);
+                uint8_t* row = rows.data() + y * rowSize;
+                const uint8_t* previousRow = y > 0 ? row - rowSize : nullptr;
+                for (size_t i = 0; i < rowSize; ++i)
+                {
+                    const int a = i >= pixelSize ? row[i - pixelSize] : 0;
+                    const int b = previousRow ? previousRow[i] : 0;
+                    const int c = previousRow && i >= pixelSize ? previousRow[i - pixelSize] : 0;
+                    int prediction = 0;
+                    switch (source[0])
+                    {
+                    case 0:
+                        break;
+                    case 1:
+                        prediction = a;
+                        break;
+                    case 2:
+                        prediction = b;
+                        break;
+                    case 3:
+                        prediction = (a + b) / 2;
+                        break;
+                    case 4:
+                        {
+                            const int p = a + b - c;
+                            const int pa = AZStd::abs(p - a);
+                            const int pb = AZStd::abs(p - b);
+                            const int pc = AZStd::abs(p - c);
+                            prediction = pa <= pb && pa <= pc ? a : (pb <= pc ? b : c);
+                        }
+                        break;
+                    default:
+                        return {};
+                    }
+                    row[i] = static_cast<uint8_t>(source[1 + i] + prediction);
+                }
+            }
+            return rows;
+        }
+
+        //! Decodes a QOI image, following the specification at https://qoiformat.org.
+        //! @return Tightly packed rows of the image, with the channels of its header.
+        static std::vector<uint8_t> DecodeQoi(const std::vector<uint8_t>& data)
+        {
+            const size_t pixelCount = size_t{ ReadU32BigEndian(data, 4) } * ReadU32BigEndian(data, 8);
+            const AZ::u32 channelCount = data[12];
+            std::vector<uint8_t> pixels;
+            uint8_t index[64][4] = {};
+            uint8_t pixel[4] = { 0, 0, 0, 255 };
+            size_t offset = 14;
+            int run = 0;
+            while (pixels.size() < pixelCount * channelCount && offset < data.size())
+            {
+                if (run > 0)
+                {
+                    --run;
+                }
+                else
+                {
+                    const uint8_t tag = data[offset++];
+                    if (tag == 0xFE)
+                    {
+                        AZStd::copy(data.begin() + offset, data.begin() + offset + 3, pixel);
+                        offset += 3;
+                    }
+                    else if (tag == 0xFF)
+                    {
+                        AZStd::copy(data.begin() + offset, data.begin() + offset + 4, pixel);
+                        offset += 4;
+                    }
+                    else if ((tag & 0xC0) == 0x00)
+                    {
+                        AZStd::copy(index[tag], index[tag] + 4, pixel);
+                    }
+                    else if ((tag & 0xC0) == 0x40)
+                    {
+                        pixel[0] = static_cast<uint8_t>(pixel[0] + ((tag >> 4) & 3) - 2);
+                        pixel[1] = static_cast<uint8_t>(pixel[1] + ((tag >> 2) & 3) - 2);
+                        pixel[2] = static_cast<uint8_t>(pixel[2] + (tag & 3) - 2);
+                    }
+                    else if ((tag & 0xC0) == 0x80)
+                    {
+                        const uint8_t differences = data[offset++];
+                        const int dg = (tag & 0x3F) - 32;
+                        pixel[0] = static_cast<uint8_t>(pixel[0] + dg - 8 + (differences >> 4));
+                        pixel[1] = static_cast<uint8_t>(pixel[1] + dg);
+                        pixel[2] = static_cast<uint8_t>(pixel[2] + dg - 8 + (differences & 0x0F));
+                    }
+                    else
+                    {
+                        run = tag & 0x3F;
+                    }
+                    const size_t hash = (pixel[0] * 3 + pixel[1] * 5 + pixel[2] * 7 + pixel[3] * 11) % 64;
+                    AZStd::copy(pixel, pixel + 4, index[hash]);
+                }
+                pixels.insert(pixels.end(), pixel, pixel + channelCount);
+            }
+            return pixels;
+        }
+
+        //! Checks that a baseline JPEG of an image decodes: walks its segments, then decodes the Huffman coded blocks of all
+        //! MCUs of the image, which must end right before the end of image marker. Coefficients are not dequantized.
+        static bool IsDecodableJpeg(const std::vector<uint8_t>& data, AZ::u32 width, AZ::u32 height, AZ::u32 componentCount)
+        {
+            struct Component
+            {
+                uint8_t m_id;
+                AZ::u32 m_horizontalSampling;
+                AZ::u32 m_verticalSampling;
+                AZ::u32 m_dcTable = 0;
+                AZ::u32 m_acTable = 0;
+            };
+            // Symbols of Huffman codes by table class and id, keyed by code length and code.
+            AZStd::unordered_map<AZ::u32, uint8_t> huffmanTables[2][4];
+            AZStd::vector<Component> components;
+
+            if (data.size() < 4 || data[0] != 0xFF || data[1] != 0xD8)
+            {
+                return false;
+            }
+            size_t offset = 2;
+            for (bool isScanStarted = false; !isScanStarted;)
+            {
+                if (offset + 4 > data.size() || data[offset] != 0xFF)
+                {
+                    return false;
+                }
+                const uint8_t marker = data[offset + 1];
+                const size_t segment = offset + 4;
+                offset += 2 + (size_t{ data[offset + 2] } << 8 | data[offset + 3]);
+                if (offset > data.size())
+                {
+                    return false;
+                }
+                if (marker == 0xC0)
+                {
+                    if (data[segment] != 8 || (AZ::u32{ data[segment + 1] } << 8 | data[segment + 2]) != height ||
+                        (AZ::u32{ data[segment + 3] } << 8 | data[segment + 4]) != width || data[segment + 5] != componentCount)
+                    {
+                        return false;
+                    }
+                    for (AZ::u32 i = 0; i < componentCount; ++i)
+                    {
+                        const uint8_t* component = data.data() + segment + 6 + 3 * i;
+                        components.push_back({ component[0], AZ::u32{ component[1] } >> 4, AZ::u32{ component[1] } & 0x0F });
+                    }
+                }
+                else if (marker == 0xC4)
+                {
+                    for (size_t table = segment; table < offset;)
+                    {
+                        auto& codes = huffmanTables[(data[table] >> 4) & 1][data[table] & 3];
+                        size_t symbol = table + 17;
+                        AZ::u32 code = 0;
+                        for (AZ::u32 length = 1; length <= 16; ++length)
+                        {
+                            for (AZ::u32 i = 0; i < data[table + length]; ++i)
+                            {
+                                codes[length << 16 | code++] = data[symbol++];
+                            }
+                            code <<= 1;
+                        }
+                        table = symbol;
+                    }
+                }
+                else if (marker == 0xDA)
+                {
+                    for (AZ::u32 i = 0; i < data[segment]; ++i)
+                    {
+                        for (Component& component : components)
+                        {
+                            if (component.m_id == data[segment + 1 + 2 * i])
+                            {
+                                component.m_dcTable = data[segment + 2 + 2 * i] >> 4;
+                                component.m_acTable = data[segment + 2 + 2 * i] & 3;
+                            }
+                        }
+                    }
+                    isScanStarted = true;
+                }
+                else if (marker >= 0xC1 && marker <= 0xCF && marker != 0xC8 && marker != 0xCC)
+                {
+                    return false; // Not a baseline JPEG.
+                }
+            }
+            if (components.size() != componentCount)
+            {
+                return false;
+            }
+
+            // Entropy coded data, in which 0xFF bytes are followed by a stuffed zero byte.
+            AZ::u32 bitBuffer = 0;
+            AZ::u32 bitCount = 0;
+            auto readBits = [&](AZ::u32 count, bool& isValid)
+            {
+                for (AZ::u32 i = 0; i < count; ++i)
+                {
+                    if (bitCount == 0)
+                    {
+                        if (offset >= data.size() || (data[offset] == 0xFF && (offset + 1 >= data.size() || data[offset + 1] != 0)))
+                        {
+                            isValid = false;
+                            return;
+                        }
+                        bitBuffer = data[offset];
+                        offset += data[offset] == 0xFF ? 2 : 1;
+                        bitCount = 8;
+                    }
+                    --bitCount;
+                }
+            };
+            auto decodeSymbol = [&](const AZStd::unordered_map<AZ::u32, uint8_t>& codes, bool& isValid) -> int
+            {
+                AZ::u32 code = 0;
+                for (AZ::u32 length = 1; length <= 16 && isValid; ++length)
+                {
+                    readBits(1, isValid);
+                    code = code << 1 | ((bitBuffer >> bitCount) & 1);
+                    if (auto it = codes.find(length << 16 | code); it != codes.end())
+                    {
+                        return it->second;
+                    }
+                }
+                isValid = false;
+                return 0;
+            };
+
+            AZ::u32 maxHorizontalSampling = 1;
+            AZ::u32 maxVerticalSampling = 1;
+            for (const Component& component : components)
+            {
+                maxHorizontalSampling = AZStd::max(maxHorizontalSampling, component.m_horizontalSampling);
+                maxVerticalSampling = AZStd::max(maxVerticalSampling, component.m_verticalSampling);
+            }
+            const AZ::u32 mcuWidth = 8 * maxHorizontalSampling;
+            const AZ::u32 mcuHeight = 8 * maxVerticalSampling;
+            const AZ::u32 mcuCount = ((width + mcuWidth - 1) / mcuWidth) * ((height + mcuHeight - 1) / mcuHeight);
+            bool isValid = true;
+            for (AZ::u32 mcu = 0; mcu < mcuCount && isValid; ++mcu)
+            {
+                for (const Component& component : components)
+                {
+                    for (AZ::u32 block = 0; block < component.m_horizontalSampling * component.m_verticalSampling && isValid; ++block)
+                    {
+                        readBits(decodeSymbol(huffmanTables[0][component.m_dcTable], isValid), isValid);
+                        for (AZ::u32 coefficient = 1; coefficient < 64 && isValid;)
+                        {
+                            const int symbol = decodeSymbol(huffmanTables[1][component.m_acTable], isValid);
+                            if (symbol == 0)
+                            {
+                                break; // End of block.
+                            }
+                            coefficient += (symbol >> 4) + 1;
+                            readBits(symbol & 0x0F, isValid);
+                            isValid = isValid && coefficient <= 64;
+                        }
+                    }
+                }
+            }
+            // The last byte is padded with ones.
+            return isValid && offset + 2 == data.size() && data[offset] == 0xFF && data[offset + 1] == 0xD9;
+        }
+
+        ROS2::ImageEncoder m_encoder;
+        std::vector<uint8_t> m_output;
+    };
+
+    TEST_F(ImageEncoderTest, JpegHasStartAndEndMarkers)
+    {
+        // Sizes which are not multiples of the MCU size exercise edge padding.
+        const auto image = CreateImage("rgba8", 37, 21, 4);
+        const ROS2::ImageView view{ image.data.data(), image.width, image.height, image.step, 4, 1 };
+        ASSERT_TRUE(m_encoder.EncodeJpeg(view, 90, m_output));
+        ASSERT_GT(m_output.size(), 4);
+        EXPECT_EQ(m_output[0], 0xFF);
+        EXPECT_EQ(m_output[1], 0xD8);
+        EXPECT_EQ(m_output[m_output.size() - 2], 0xFF);
+        EXPECT_EQ(m_output[m_output.size() - 1], 0xD9);
+    }
+
+    TEST_F(ImageEncoderTest, JpegRejectsSixteenBitImages)
+    {
+        const auto image = CreateImage("mono16", 8, 8, 2);
+        const ROS2::ImageView view{ image.data.data(), image.width, image.height, image.step, 1, 2 };
+        EXPECT_FALSE(m_encoder.EncodeJpeg(view, 90, m_output));
+    }
+
+    TEST_F(ImageEncoderTest, PngHeaderDescribesImage)
+    {
+        const auto image = CreateImage("mono16", 13, 7, 2);
+        const ROS2::ImageView view{ image.data.data(), image.width, image.height, image.step, 1, 2 };
+        ASSERT_TRUE(m_encoder.EncodePng(view, 1, m_output));
+        ASSERT_GT(m_output.size(), 33);
+        const uint8_t signature[] = { 0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n' };
+        EXPECT_TRUE(AZStd::equal(signature, signature + 8, m_output.begin()));
+        EXPECT_EQ(ReadU32BigEndian(m_output, 16), 13);
+        EXPECT_EQ(ReadU32BigEndian(m_output, 20), 7);
+        EXPECT_EQ(m_output[24], 16); // Bit depth.
+        EXPECT_EQ(m_output[25], 0); // Grayscale.
+    }
+
+    TEST_F(ImageEncoderTest, QoiEncodesRunsOfEqualPixels)
+    {
+        sensor_msgs::msg::Image image = CreateImage("rgba8", 100, 1, 4);
+        AZStd::fill(image.data.begin(), image.data.end(), uint8_t{ 7 });
+        const ROS2::ImageView view{ image.data.data(), image.width, image.height, image.step, 4, 1 };
+        ASSERT_TRUE(m_encoder.EncodeQoi(view, m_output));
+
+        // Header, a full pixel, runs of 62 and 37 pixels, and the end marker.
+        ASSERT_EQ(m_output.size(), 14 + 5 + 2 + 8);
+        EXPECT_EQ(ReadU32BigEndian(m_output, 0), 0x716F6966); // "qoif"
+        EXPECT_EQ(m_output[19], 0xC0 | 61);
+        EXPECT_EQ(m_output[20], 0xC0 | 36);
+        EXPECT_EQ(m_output.back(), 1);
+    }
+
+    TEST_F(ImageEncoderTest, JpegDecodes)
+    {
+        const auto color = CreateBandedImage(37);
+        const ROS2::ImageView colorView{ color.data.data(), color.width, color.height, color.step, 4, 1 };
+        ASSERT_TRUE(m_encoder.EncodeJpeg(colorView, 90, m_output));
+        EXPECT_TRUE(IsDecodableJpeg(m_output, color.width, color.height, 3));
+
+        const auto gray = CreateImage("mono8", 21, 13, 1);
+        const ROS2::ImageView grayView{ gray.data.data(), gray.width, gray.height, gray.step, 1, 1 };
+        ASSERT_TRUE(m_encoder.EncodeJpeg(grayView, 50, m_output));
+        EXPECT_TRUE(IsDecodableJpeg(m_output, gray.width, gray.height, 1));
+    }
+
+    TEST_F(ImageEncoderTest, PngRoundTripsColorImage)
+    {
+        // The rows of the view are longer than the image, as for regions of a larger image.
+        const auto image = CreateBandedImage(40);
+        const ROS2::ImageView view{ image.data.data(), 30, image.height, image.step, 4, 1 };
+        ASSERT_TRUE(m_encoder.EncodePng(view, 6, m_output));
+
+        const std::vector<uint8_t> pixels = DecodePng(m_output);
+        ASSERT_EQ(pixels.size(), size_t{ 30 } * 4 * image.height);
+        for (AZ::u32 y = 0; y < image.height; ++y)
+        {
+            const auto row = image.data.begin() + size_t{ y } * image.step;
+            EXPECT_TRUE(AZStd::equal(row, row + 30 * 4, pixels.begin() + size_t{ y } * 30 * 4)) << "Row " << y;
+        }
+    }
+
+    TEST_F(ImageEncoderTest, PngRoundTripsSixteenBitImage)
+    {
+        const auto image = CreateImage("mono16", 13, 7, 2);
+        const ROS2::ImageView view{ image.data.data(), image.width, image.height, image.step, 1, 2 };
+        ASSERT_TRUE(m_encoder.EncodePng(view, 1, m_output));
+
+        // PNG stores samples big-endian.
+        const std::vector<uint8_t> pixels = DecodePng(m_output);
+        ASSERT_EQ(pixels.size(), image.data.size());
+        for (size_t i = 0; i < pixels.size(); ++i)
+        {
+            EXPECT_EQ(pixels[i], image.data[i ^ 1]) << "Byte " << i;
+        }
+    }
+
+    TEST_F(ImageEncoderTest, QoiRoundTripsImage)
+    {
+        auto image = CreateBandedImage(70);
+        const ROS2::ImageView view{ image.data.data(), image.width, image.height, image.step, 4, 1 };
+        ASSERT_TRUE(m_encoder.EncodeQoi(view, m_output));
+        EXPECT_EQ(DecodeQoi(m_output), std::vector<uint8_t>(image.data.begin(), image.data.end()));
+
+        // Three channel images leave alpha out.
+        std::vector<uint8_t> rgb;
+        for (size_t i = 0; i < image.data.size(); ++i)
+        {
+            if (i % 4 != 3)
+            {
+                rgb.push_back(image.data[i]);
+            }
+        }
+        const ROS2::ImageView rgbView{ rgb.data(), image.width, image.height, image.width * 3, 3, 1 };
+        ASSERT_TRUE(m_encoder.EncodeQoi(rgbView, m_output));
+        EXPECT_EQ(DecodeQoi(m_output), rgb);
+    }
+
+    TEST_F(ImageEncoderTest, DepthIsEncodedInCompressedDepthFormat)
+    {
+        const float depths[] = { 0.5f, 1.0f, 2.5f, 7.0f, 9.9f, 0.0f, -1.0f, 12.0f, std::numeric_limits<float>::quiet_NaN() };
+        sensor_msgs::msg::Image image = CreateImage("32FC1", 3, 3, 4);
+        std::memcpy(image.data.data(), depths, sizeof(depths));
+
+        ROS2::CompressedImagePublisher::Settings settings;
+        settings.m_format = ROS2::CameraSensorConfiguration::CompressedImageFormat::Png;
+        settings.m_maxDepth = 10.0f;
+        sensor_msgs::msg::CompressedImage message;
+        ASSERT_TRUE(ROS2::CompressedImagePublisher::Encode(image, settings, m_encoder, message));
+        EXPECT_EQ(message.format, "32FC1; compressedDepth png");
+
+        // Header of the compressed depth transport: format of inverse depth, then its quantization parameters.
+        ASSERT_GT(message.data.size(), 12u);
+        AZ::s32 format;
+        float quantization[2];
+        std::memcpy(&format, message.data.data(), sizeof(format));
+        std::memcpy(quantization, message.data.data() + sizeof(format), sizeof(quantization));
+        EXPECT_EQ(format, 0);
+
+        const std::vector<uint8_t> pixels = DecodePng(message.data, 12);
+        ASSERT_EQ(pixels.size(), AZStd::size(depths) * 2);
+        for (size_t i = 0; i < AZStd::size(depths); ++i)
+        {
+            const AZ::u32 value = AZ::u32{ pixels[2 * i] } << 8 | pixels[2 * i + 1];
+            if (!(depths[i] > 0.0f && depths[i] < settings.m_maxDepth))
+            {
+                EXPECT_EQ(value, 0) << "Depth " << depths[i];
+                continue;
+            }
+            // A step of the quantized inverse depth spans about depth^2 / quantizationA meters.
+            const float depth = quantization[0] / (value - quantization[1]);
+            EXPECT_NEAR(depth, depths[i], 2.0f * depths[i] * depths[i] / quantization[0]) << "Depth " << depths[i];
+        }
+    }
+
+    TEST_F(ImageEncoderTest, LosslessDepthKeepsFloatsExactly)
+    {
+        const float depths[] = { 0.5f, 1.0f, 2.5f, 7.0f, 9.9f, 0.0f, -1.0f, 12.0f, std::numeric_limits<float>::infinity() };
+        sensor_msgs::msg::Image image = CreateImage("32FC1", 3, 3, 4);
+        std::memcpy(image.data.data(), depths, sizeof(depths));
+        const std::vector<uint8_t> source(image.data.begin(), image.data.end());
+
+        ROS2::CompressedImagePublisher::Settings settings;
+        settings.m_format = ROS2::CameraSensorConfiguration::CompressedImageFormat::Png;
+        settings.m_maxDepth = 10.0f;
+        settings.m_isLosslessDepth = true;
+        sensor_msgs::msg::CompressedImage message;
+        ASSERT_TRUE(ROS2::CompressedImagePublisher::Encode(image, settings, m_encoder, message));
+        EXPECT_EQ(message.format, "32FC1; png compressed rgba8");
+        EXPECT_EQ(DecodePng(message.data), source);
+
+        settings.m_format = ROS2::CameraSensorConfiguration::CompressedImageFormat::Qoi;
+        ASSERT_TRUE(ROS2::CompressedImagePublisher::Encode(image, settings, m_encoder, message));
+        EXPECT_EQ(message.format, "32FC1; qoi compressed rgba8");
+        EXPECT_EQ(DecodeQoi(message.data), source);
+
+        // JPEG would lose the bytes of the floats, so lossless depth falls back to PNG.
+        settings.m_format = ROS2::CameraSensorConfiguration::CompressedImageFormat::Jpeg;
+        ASSERT_TRUE(ROS2::CompressedImagePublisher::Encode(image, settings, m_encoder, message));
+        EXPECT_EQ(message.format, "32FC1; png compressed rgba8");
+        EXPECT_EQ(DecodePng(message.data), source);
+    }
+
+    TEST_F(ImageEncoderTest, UnsupportedEncodingIsRejected)
+    {
+        const auto image = CreateImage("32FC4", 4, 4, 16);
+        sensor_msgs::msg::CompressedImage message;
+        EXPECT_FALSE(ROS2::CompressedImagePublisher::Encode(image, ROS2::CompressedImagePublisher::Settings(), m_encoder, message));
+    }
+} // namespace UnitTest
@@ -0,0 +1,70 @@
+/*
+ * Copyright (c) Contributors to the Open 3D Engine Project.
+ * For complete copyright and license terms please see the LICENSE at the root of this distribution.
+ *
+ * SPDX-License-Identifier: Apache-2.0 OR MIT
+ *
+ */
+
+#if defined(HAVE_BENCHMARK)
+
+#include <AzCore/Casting/numeric_cast.h>
+#include <AzCore/Math/Transform.h>
+#include <AzTest/AzTest.h>
+#include <benchmark/benchmark.h>
+
+#include <Lidar/LidarTemplateUtils.h>
+
+namespace Benchmark
+{
+    //! Builds the rotations of a custom 3D lidar with the given number of layers and increments.
+    static AZStd::vector<AZ::Vector3> CreateRayRotations(int64_t layers, int64_t increments)
+    {
+        auto lidarTemplate = ROS2::LidarTemplateUtils::GetTemplate(ROS2::LidarTemplate::LidarModel::Custom3DLidar);
+        lidarTemplate.m_layers = aznumeric_cast<unsigned int>(layers);
+        lidarTemplate.m_numberOfIncrements = aznumeric_cast<unsigned int>(increments);
+        return ROS2::LidarTemplateUtils::PopulateRayRotations(lidarTemplate);
+    }
+
+    static AZ::Transform CreateLidarTransform()
+    {
+        return AZ::Transform::CreateFromQuaternionAndTranslation(
+            AZ::Quaternion::CreateFromEulerRadiansZYX(AZ::Vector3(0.1f, -0.2f, 0.7f)), AZ::Vector3(1.0f, 2.0f, 1.5f));
+    }
+
+    //! Per-scan direction computation with a quaternion built from Euler angles for every ray (array of structures).
+    static void BM_RayDirectionsQuaternionAoS(benchmark::State& state)
+    {
+        const auto rotations = CreateRayRotations(state.range(0), state.range(1));
+        const AZ::Transform lidarTransform = CreateLidarTransform();
+        AZStd::vector<AZ::Vector3> directions;
+        for ([[maybe_unused]] auto _ : state)
+        {
+            ROS2::LidarTemplateUtils::RotationsToDirections(rotations, lidarTransform, directions);
+            benchmark::DoNotOptimize(directions.data());
+        }
+        state.SetItemsProcessed(state.iterations() * rotations.size());
+    }
+
+    //! Per-scan direction computation rotating a precomputed table of local directions (structure of arrays).
+    static void BM_RayDirectionsTableSoA(benchmark::State& state)
+    {
+        const auto rotations = CreateRayRotations(state.range(0), state.range(1));
+        const AZ::Transform lidarTransform = CreateLidarTransform();
+        ROS2::LidarTemplateUtils::RayDirectionTable localDirections;
+        ROS2::LidarTemplateUtils::RotationsToLocalDirections(rotations, localDirections);
+        ROS2::LidarTemplateUtils::RayDirectionTable directions;
+        for ([[maybe_unused]] auto _ : state)
+        {
+            ROS2::LidarTemplateUtils::RotateDirections(localDirections, lidarTransform.GetRotation(), directions);
+            benchmark::DoNotOptimize(directions.m_x.data());
+        }
+        state.SetItemsProcessed(state.iterations() * rotations.size());
+    }
+
+    // 2k, 32k and 131k rays (layers x increments).
+    BENCHMARK(BM_RayDirectionsQuaternionAoS)->ArgNames({ "layers", "increments" })->Args({ 16, 128 })->Args({ 32, 1024 })->Args({ 64, 2048 });
+    BENCHMARK(BM_RayDirectionsTableSoA)->ArgNames({ "layers", "increments" })->Args({ 16, 128 })->Args({ 32, 1024 })->Args({ 64, 2048 });
+} // namespace Benchmark
+
+#endif // HAVE_BENCHMARK
@@ -0,0 +1,45 @@
+/*
+ * Copyright (c) Contributors to the Open 3D Engine Project.
+ * For complete copyright and license terms please see the LICENSE at the root of this distribution.
+ *
+ * SPDX-License-Identifier: Apache-2.0 OR MIT
+ *
+ */
+
+#include <AzCore/UnitTest/TestTypes.h>
+#include <AzTest/AzTest.h>
+
+#include <Lidar/LidarTemplateUtils.h>
+
+namespace UnitTest
+{
+
+    class LidarTemplateUtilsTest : public LeakDetectionFixture
+    {
+    };
+
+    TEST_F(LidarTemplateUtilsTest, RotatedDirectionTableMatchesQuaternionDirections)
+    {
+        auto lidarTemplate = ROS2::LidarTemplateUtils::GetTemplate(ROS2::LidarTemplate::LidarModel::Velodyne_HDL_32E);
+        lidarTemplate.m_numberOfIncrements = 63; // number of rays not divisible by the SIMD width
+        const auto rotations = ROS2::LidarTemplateUtils::PopulateRayRotations(lidarTemplate);
+        const AZ::Transform lidarTransform = AZ::Transform::CreateFromQuaternionAndTranslation(
+            AZ::Quaternion::CreateFromEulerRadiansZYX(AZ::Vector3(0.3f, -0.5f, 2.0f)), AZ::Vector3(4.0f, -2.0f, 1.0f));
+
+        const auto goldDirections = ROS2::LidarTemplateUtils::RotationsToDirections(rotations, lidarTransform);
+
+        ROS2::LidarTemplateUtils::RayDirectionTable localDirections;
+        ROS2::LidarTemplateUtils::RotationsToLocalDirections(rotations, localDirections);
+        ROS2::LidarTemplateUtils::RayDirectionTable directions;
+        ROS2::LidarTemplateUtils::RotateDirections(localDirections, lidarTransform.GetRotation(), directions);
+
+        ASSERT_EQ(directions.Size(), goldDirections.size());
+        for (size_t i = 0; i < goldDirections.size(); ++i)
+        {
+            const AZ::Vector3 direction = directions.GetDirection(i);
+            EXPECT_NEAR(direction.GetX(), goldDirections[i].GetX(), 1e-5f);
+            EXPECT_NEAR(direction.GetY(), goldDirections[i].GetY(), 1e-5f);
+            EXPECT_NEAR(direction.GetZ(), goldDirections[i].GetZ(), 1e-5f);
+        }
+    }
+} // namespace UnitTest
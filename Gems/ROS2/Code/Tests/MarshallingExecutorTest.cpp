@@ -0,0 +1,136 @@
+/*
+ * Copyright (c) Contributors to the Open 3D Engine Project.
+ * For complete copyright and license terms please see the LICENSE at the root of this distribution.
+ *
+ * SPDX-License-Identifier: Apache-2.0 OR MIT
+ *
+ */
+
+#include <AzCore/UnitTest/TestTypes.h>
+#include <AzCore/std/chrono/chrono.h>
+#include <AzCore/std/parallel/thread.h>
+#include <AzCore/std/smart_ptr/unique_ptr.h>
+#include <AzTest/AzTest.h>
+
+#include <Communication/MarshallingExecutor.h>
+#include <rclcpp/rclcpp.hpp>
+#include <std_msgs/msg/string.hpp>
+
+namespace UnitTest
+{
+    class MarshallingExecutorTest : public LeakDetectionFixture
+    {
+    public:
+        static constexpr const char* Topic = "marshalling_executor_test";
+
+        void SetUp() override
+        {
+            LeakDetectionFixture::SetUp();
+            if (!rclcpp::ok())
+            {
+                rclcpp::init(0, nullptr);
+            }
+            m_node = std::make_shared<rclcpp::Node>("marshalling_executor_test");
+            m_executor = AZStd::make_unique<ROS2::MarshallingExecutor>(ROS2::MarshallingExecutor::Mode::GameThread);
+            m_executor->add_node(m_node);
+            m_executor->Start();
+            m_publisher = m_node->create_publisher<std_msgs::msg::String>(Topic, 10);
+            m_subscription = m_node->create_subscription<std_msgs::msg::String>(
+                Topic,
+                10,
+                [this](const std_msgs::msg::String&)
+                {
+                    ++m_handledCount;
+                });
+        }
+
+        void TearDown() override
+        {
+            m_subscription.reset();
+            m_publisher.reset();
+            m_executor->Stop();
+            m_executor->remove_node(m_node);
+            m_executor.reset();
+            m_node.reset();
+            LeakDetectionFixture::TearDown();
+        }
+
+        //! Publishes a message and waits until the executor thread has taken it and queued callbacks of all subscriptions.
+        bool PublishAndWaitForPendingCallback(size_t subscriptionCount = 1)
+        {
+            const auto deadline = AZStd::chrono::steady_clock::now() + AZStd::chrono::seconds(5);
+            while (m_publisher->get_subscription_count() < subscriptionCount)
+            {
+                if (AZStd::chrono::steady_clock::now() > deadline)
+                {
+                    return false;
+                }
+                AZStd::this_thread::sleep_for(AZStd::chrono::milliseconds(1));
+            }
+
+            m_publisher->publish(std_msgs::msg::String());
+            while (m_executor->GetPendingCallbackCount() < subscriptionCount)
+            {
+                if (AZStd::chrono::steady_clock::now() > deadline)
+                {
+                    return false;
+                }
+                AZStd::this_thread::sleep_for(AZStd::chrono::milliseconds(1));
+            }
+            return true;
+        }
+
+        std::shared_ptr<rclcpp::Node> m_node;
+        AZStd::unique_ptr<ROS2::MarshallingExecutor> m_executor;
+        rclcpp::Publisher<std_msgs::msg::String>::SharedPtr m_publisher;
+        rclcpp::Subscription<std_msgs::msg::String>::SharedPtr m_subscription;
+        int m_handledCount = 0;
+    };
+
+    TEST_F(MarshallingExecutorTest, PendingCallbackIsHandledOnGameThread)
+    {
+        ASSERT_TRUE(PublishAndWaitForPendingCallback());
+        EXPECT_EQ(m_handledCount, 0);
+        m_executor->ExecutePendingCallbacks();
+        EXPECT_EQ(m_handledCount, 1);
+        EXPECT_EQ(m_executor->GetPendingCallbackCount(), 0);
+    }
+
+    TEST_F(MarshallingExecutorTest, PendingCallbackOfDestroyedSubscriptionIsDropped)
+    {
+        ASSERT_TRUE(PublishAndWaitForPendingCallback());
+
+        // The owner of the subscription goes away between taking the message and the next frame.
+        m_subscription.reset();
+        m_executor->ExecutePendingCallbacks();
+        EXPECT_EQ(m_handledCount, 0);
+        EXPECT_EQ(m_executor->GetPendingCallbackCount(), 0);
+    }
+
+    TEST_F(MarshallingExecutorTest, PendingCallbacksOfRemovedNodeAreDropped)
+    {
+        // A composed node subscribing to the same topic, whose callbacks must not run once it is removed and destroyed.
+        int composedHandledCount = 0;
+        auto composedNode = std::make_shared<rclcpp::Node>("marshalling_executor_test_composed");
+        auto composedSubscription = composedNode->create_subscription<std_msgs::msg::String>(
+            Topic,
+            10,
+            [&composedHandledCount](const std_msgs::msg::String&)
+            {
+                ++composedHandledCount;
+            });
+        m_executor->add_node(composedNode);
+        ASSERT_TRUE(PublishAndWaitForPendingCallback(2));
+
+        m_executor->remove_node(composedNode);
+        EXPECT_EQ(m_executor->GetPendingCallbackCount(), 1);
+        composedSubscription.reset();
+        composedNode.reset();
+
+        // Callbacks of the remaining node are still handled.
+        m_executor->ExecutePendingCallbacks();
+        EXPECT_EQ(m_handledCount, 1);
+        EXPECT_EQ(composedHandledCount, 0);
+        EXPECT_EQ(m_executor->GetPendingCallbackCount(), 0);
+    }
+} // namespace UnitTest
@@ -0,0 +1,66 @@
+/*
+ * Copyright (c) Contributors to the Open 3D Engine Project.
+ * For complete copyright and license terms please see the LICENSE at the root of this distribution.
+ *
+ * SPDX-License-Identifier: Apache-2.0 OR MIT
+ *
+ */
+
+#include <AzCore/Math/Random.h>
+#include <AzCore/UnitTest/TestTypes.h>
+#include <AzTest/AzTest.h>
+
+#include <ROS2/Utilities/P2QuantileEstimator.h>
+
+namespace UnitTest
+{
+    class P2QuantileEstimatorTest : public LeakDetectionFixture
+    {
+    };
+
+    TEST_F(P2QuantileEstimatorTest, ExactForFewObservations)
+    {
+        ROS2::P2QuantileEstimator median(0.5);
+        EXPECT_EQ(median.GetEstimate(), 0.0);
+
+        median.Add(3.0);
+        median.Add(1.0);
+        median.Add(2.0);
+        EXPECT_EQ(median.GetCount(), 3);
+        EXPECT_EQ(median.GetEstimate(), 2.0);
+
+        median.Reset();
+        EXPECT_EQ(median.GetCount(), 0);
+        EXPECT_EQ(median.GetEstimate(), 0.0);
+    }
+
+    TEST_F(P2QuantileEstimatorTest, EstimatesQuantilesOfUniformDistribution)
+    {
+        ROS2::P2QuantileEstimator median(0.5);
+        ROS2::P2QuantileEstimator percentile95(0.95);
+        ROS2::P2QuantileEstimator percentile99(0.99);
+
+        AZ::SimpleLcgRandom random(1234);
+        for (int i = 0; i < 100000; ++i)
+        {
+            const double value = random.GetRandomFloat();
+            median.Add(value);
+            percentile95.Add(value);
+            percentile99.Add(value);
+        }
+
+        EXPECT_NEAR(median.GetEstimate(), 0.5, 0.01);
+        EXPECT_NEAR(percentile95.GetEstimate(), 0.95, 0.01);
+        EXPECT_NEAR(percentile99.GetEstimate(), 0.99, 0.01);
+    }
+
+    TEST_F(P2QuantileEstimatorTest, FollowsOrderedInput)
+    {
+        ROS2::P2QuantileEstimator median(0.5);
+        for (int i = 1; i <= 1001; ++i)
+        {
+            median.Add(static_cast<double>(i));
+        }
+        EXPECT_NEAR(median.GetEstimate(), 501.0, 5.0);
+    }
+} // namespace UnitTest
@@ -0,0 +1,153 @@
+/*
+ * Copyright (c) Contributors to the Open 3D Engine Project.
+ * For complete copyright and license terms please see the LICENSE at the root of this distribution.
+ *
+ * SPDX-License-Identifier: Apache-2.0 OR MIT
+ *
+ */
+
+#include <AzCore/UnitTest/TestTypes.h>
+#include <AzCore/std/chrono/chrono.h>
+#include <AzCore/std/parallel/atomic.h>
+#include <AzCore/std/parallel/thread.h>
+#include <AzCore/std/smart_ptr/unique_ptr.h>
+#include <AzTest/AzTest.h>
+
+#include <Communication/ParallelExecutor.h>
+#include <rclcpp/rclcpp.hpp>
+#include <std_msgs/msg/string.hpp>
+
+namespace UnitTest
+{
+    class ParallelExecutorTest : public LeakDetectionFixture
+    {
+    public:
+        static constexpr const char* Topic = "parallel_executor_test";
+
+        void SetUp() override
+        {
+            LeakDetectionFixture::SetUp();
+            if (!rclcpp::ok())
+            {
+                rclcpp::init(0, nullptr);
+            }
+            m_node = std::make_shared<rclcpp::Node>("parallel_executor_test");
+            m_executor = AZStd::make_unique<ROS2::ParallelExecutor>(2);
+            m_executor->add_node(m_node);
+            m_publisher = m_node->create_publisher<std_msgs::msg::String>(Topic, 10);
+        }
+
+        void TearDown() override
+        {
+            m_subscription.reset();
+            m_publisher.reset();
+            m_executor->Stop();
+            m_executor->remove_node(m_node);
+            m_executor.reset();
+            m_node.reset();
+            LeakDetectionFixture::TearDown();
+        }
+
+        //! Waits until a condition holds, for up to five seconds.
+        template<class ConditionT>
+        static bool WaitFor(ConditionT condition)
+        {
+            const auto deadline = AZStd::chrono::steady_clock::now() + AZStd::chrono::seconds(5);
+            while (!condition())
+            {
+                if (AZStd::chrono::steady_clock::now() > deadline)
+                {
+                    return false;
+                }
+                AZStd::this_thread::sleep_for(AZStd::chrono::milliseconds(1));
+            }
+            return true;
+        }
+
+        bool PublishOnceSubscribed()
+        {
+            const bool isSubscribed = WaitFor(
+                [this]()
+                {
+                    return m_publisher->get_subscription_count() > 0;
+                });
+            m_publisher->publish(std_msgs::msg::String());
+            return isSubscribed;
+        }
+
+        std::shared_ptr<rclcpp::Node> m_node;
+        AZStd::unique_ptr<ROS2::ParallelExecutor> m_executor;
+        rclcpp::Publisher<std_msgs::msg::String>::SharedPtr m_publisher;
+        rclcpp::Subscription<std_msgs::msg::String>::SharedPtr m_subscription;
+    };
+
+    TEST_F(ParallelExecutorTest, StopsRightAfterStart)
+    {
+        // Spinning has started once Start returns, so that cancelling is not lost.
+        m_executor->Start();
+        m_executor->Stop();
+        m_executor->Start();
+        m_executor->Stop();
+    }
+
+    TEST_F(ParallelExecutorTest, WaitsForRunningCallback)
+    {
+        AZStd::atomic_bool isCallbackRunning{ false };
+        AZStd::atomic_bool isCallbackReleased{ false };
+        m_subscription = m_node->create_subscription<std_msgs::msg::String>(
+            Topic,
+            10,
+            [&](const std_msgs::msg::String&)
+            {
+                isCallbackRunning = true;
+                WaitFor(
+                    [&]()
+                    {
+                        return isCallbackReleased.load();
+                    });
+            });
+        m_executor->Start();
+        ASSERT_TRUE(PublishOnceSubscribed());
+        ASSERT_TRUE(WaitFor(
+            [&]()
+            {
+                return isCallbackRunning.load();
+            }));
+
+        // The owner of the subscription goes away while its callback runs.
+        m_subscription.reset();
+        AZStd::atomic_bool isWaitDone{ false };
+        AZStd::thread waitingThread(
+            [&]()
+            {
+                m_executor->WaitForRunningCallbacks();
+                isWaitDone = true;
+            });
+        AZStd::this_thread::sleep_for(AZStd::chrono::milliseconds(50));
+        EXPECT_FALSE(isWaitDone);
+
+        isCallbackReleased = true;
+        waitingThread.join();
+        EXPECT_TRUE(isWaitDone);
+    }
+
+    TEST_F(ParallelExecutorTest, CallbackDoesNotWaitForItself)
+    {
+        AZStd::atomic_bool isWaitDone{ false };
+        m_subscription = m_node->create_subscription<std_msgs::msg::String>(
+            Topic,
+            10,
+            [&](const std_msgs::msg::String&)
+            {
+                m_executor->WaitForRunningCallbacks();
+                isWaitDone = true;
+            });
+        m_executor->Start();
+        ASSERT_TRUE(PublishOnceSubscribed());
+        EXPECT_TRUE(WaitFor(
+            [&]()
+            {
+                return isWaitDone.load();
+            }));
+    }
+} // namespace UnitTest
@@ -0,0 +1,177 @@
+/*
+ * Copyright (c) Contributors to the Open 3D Engine Project.
+ * For complete copyright and license terms please see the LICENSE at the root of this distribution.
+ *
+ * SPDX-License-Identifier: Apache-2.0 OR MIT
+ *
+ */
+
+#if defined(HAVE_BENCHMARK)
+
+#include <AzCore/std/chrono/chrono.h>
+#include <AzCore/std/parallel/atomic.h>
+#include <AzCore/std/parallel/thread.h>
+#include <AzCore/std/smart_ptr/unique_ptr.h>
+#include <AzTest/AzTest.h>
+#include <benchmark/benchmark.h>
+
+#include <Communication/MarshallingExecutor.h>
+#include <Communication/RobotNodes.h>
+#include <nav_msgs/msg/odometry.hpp>
+#include <rclcpp/rclcpp.hpp>
+#include <sensor_msgs/msg/joint_state.hpp>
+#include <vector>
+
+namespace Benchmark
+{
+    //! Fleet of robots which publish odometry and joint states, with a subscription to both topics on the simulator side for each
+    //! robot, the way in-simulator consumers such as controllers take them. The executor handles callbacks in Background mode,
+    //! either of the central node alone, or of one node per robot spun by the robot executor pool.
+    class Fleet
+    {
+    public:
+        static constexpr size_t JointCount = 6;
+
+        Fleet(size_t robotCount, AZStd::chrono::microseconds callbackWork, bool useRobotNodes)
+            : m_callbackWork(callbackWork)
+        {
+            if (!rclcpp::ok())
+            {
+                rclcpp::init(0, nullptr);
+            }
+
+            m_executor = AZStd::make_unique<ROS2::MarshallingExecutor>(ROS2::MarshallingExecutor::Mode::Background);
+            m_centralNode = std::make_shared<rclcpp::Node>("o3de_ros2_node");
+            m_executor->add_node(m_centralNode);
+            m_executor->Start();
+            if (useRobotNodes)
+            {
+                m_robotNodes = AZStd::make_unique<ROS2::RobotNodes>(*m_executor, 0);
+            }
+
+            m_jointStateMessage.name.resize(JointCount, "joint");
+            m_jointStateMessage.position.resize(JointCount, 0.0);
+            m_jointStateMessage.velocity.resize(JointCount, 0.0);
+            m_jointStateMessage.effort.resize(JointCount, 0.0);
+
+            for (size_t robot = 0; robot < robotCount; ++robot)
+            {
+                const AZStd::string ns = AZStd::string::format("robot%zu", robot);
+                auto node = m_robotNodes ? m_robotNodes->GetNode(ns) : m_centralNode;
+                const std::string odometryTopic = (ns + "/odom").c_str();
+                const std::string jointStatesTopic = (ns + "/joint_states").c_str();
+
+                m_odometryPublishers.push_back(node->create_publisher<nav_msgs::msg::Odometry>(odometryTopic, 10));
+                m_jointStatePublishers.push_back(node->create_publisher<sensor_msgs::msg::JointState>(jointStatesTopic, 10));
+                m_subscriptions.push_back(node->create_subscription<nav_msgs::msg::Odometry>(
+                    odometryTopic,
+                    10,
+                    [this](const nav_msgs::msg::Odometry&)
+                    {
+                        OnMessage();
+                    }));
+                m_subscriptions.push_back(node->create_subscription<sensor_msgs::msg::JointState>(
+                    jointStatesTopic,
+                    10,
+                    [this](const sensor_msgs::msg::JointState&)
+                    {
+                        OnMessage();
+                    }));
+            }
+            WaitForDiscovery();
+        }
+
+        ~Fleet()
+        {
+            m_subscriptions.clear();
+            m_odometryPublishers.clear();
+            m_jointStatePublishers.clear();
+            m_robotNodes.reset();
+            m_executor->Stop();
+            m_executor->remove_node(m_centralNode);
+        }
+
+        //! Publishes one message of each robot on both topics and waits until all of them are handled.
+        void PublishAndWait()
+        {
+            m_handledCount.store(0);
+            for (size_t robot = 0; robot < m_odometryPublishers.size(); ++robot)
+            {
+                m_odometryPublishers[robot]->publish(m_odometryMessage);
+                m_jointStatePublishers[robot]->publish(m_jointStateMessage);
+            }
+            while (m_handledCount.load() < GetMessageCount())
+            {
+                AZStd::this_thread::yield();
+            }
+        }
+
+        size_t GetMessageCount() const
+        {
+            return m_odometryPublishers.size() + m_jointStatePublishers.size();
+        }
+
+    private:
+        void WaitForDiscovery() const
+        {
+            for (size_t robot = 0; robot < m_odometryPublishers.size(); ++robot)
+            {
+                while (m_odometryPublishers[robot]->get_subscription_count() == 0 ||
+                       m_jointStatePublishers[robot]->get_subscription_count() == 0)
+                {
+                    AZStd::this_thread::sleep_for(AZStd::chrono::milliseconds(1));
+                }
+            }
+        }
+
+        //! Stands in for the work of a consumer, e.g. a controller integrating odometry.
+        void OnMessage()
+        {
+            const auto end = AZStd::chrono::steady_clock::now() + m_callbackWork;
+            while (AZStd::chrono::steady_clock::now() < end)
+            {
+            }
+            ++m_handledCount;
+        }
+
+        AZStd::chrono::microseconds m_callbackWork;
+        AZStd::unique_ptr<ROS2::MarshallingExecutor> m_executor;
+        std::shared_ptr<rclcpp::Node> m_centralNode;
+        AZStd::unique_ptr<ROS2::RobotNodes> m_robotNodes;
+
+        nav_msgs::msg::Odometry m_odometryMessage;
+        sensor_msgs::msg::JointState m_jointStateMessage;
+        std::vector<rclcpp::Publisher<nav_msgs::msg::Odometry>::SharedPtr> m_odometryPublishers;
+        std::vector<rclcpp::Publisher<sensor_msgs::msg::JointState>::SharedPtr> m_jointStatePublishers;
+        std::vector<rclcpp::SubscriptionBase::SharedPtr> m_subscriptions;
+        AZStd::atomic<size_t> m_handledCount{ 0 };
+    };
+
+    static void RunFleet(benchmark::State& state, bool useRobotNodes)
+    {
+        Fleet fleet(state.range(0), AZStd::chrono::microseconds(state.range(1)), useRobotNodes);
+        for ([[maybe_unused]] auto _ : state)
+        {
+            fleet.PublishAndWait();
+        }
+        state.SetItemsProcessed(state.iterations() * fleet.GetMessageCount());
+    }
+
+    //! All publishers and subscriptions on the central node, handled by the single executor thread.
+    static void BM_FleetSingleNode(benchmark::State& state)
+    {
+        RunFleet(state, false);
+    }
+
+    //! A node per robot, with callbacks of different robots handled in parallel by the robot executor pool.
+    static void BM_FleetRobotNodes(benchmark::State& state)
+    {
+        RunFleet(state, true);
+    }
+
+    // 50 robots, with callbacks doing no work and 50 microseconds of work.
+    BENCHMARK(BM_FleetSingleNode)->ArgNames({ "robots", "work_us" })->Args({ 50, 0 })->Args({ 50, 50 })->UseRealTime();
+    BENCHMARK(BM_FleetRobotNodes)->ArgNames({ "robots", "work_us" })->Args({ 50, 0 })->Args({ 50, 50 })->UseRealTime();
+} // namespace Benchmark
+
+#endif // HAVE_BENCHMARK
@@ -0,0 +1,114 @@
+/*
+ * Copyright (c) Contributors to the Open 3D Engine Project.
+ * For complete copyright and license terms please see the LICENSE at the root of this distribution.
+ *
+ * SPDX-License-Identifier: Apache-2.0 OR MIT
+ *
+ */
+
+#include <AzCore/UnitTest/TestTypes.h>
+#include <AzTest/AzTest.h>
+
+#include <ROS2/Sensor/Events/PhysicsBasedSource.h>
+#include <ROS2/Sensor/Events/TickBasedSource.h>
+#include <Sensor/Events/SensorPhaseScheduler.h>
+
+namespace UnitTest
+{
+    class SensorPhaseSchedulerTest : public LeakDetectionFixture
+    {
+    };
+
+    TEST_F(SensorPhaseSchedulerTest, SpreadsSensorsOfSamePeriodEvenly)
+    {
+        const AZ::TypeId sourceType = azrtti_typeid<ROS2::PhysicsBasedSource>();
+        ROS2::SensorPhaseScheduler scheduler;
+
+        // Two sensors are placed half a period apart.
+        const auto first = scheduler.AcquirePhase(sourceType, 10);
+        const auto second = scheduler.AcquirePhase(sourceType, 10);
+        EXPECT_EQ(scheduler.GetPhase(first), 0);
+        EXPECT_EQ(scheduler.GetPhase(second), 5);
+
+        for (int i = 0; i < 8; ++i)
+        {
+            scheduler.AcquirePhase(sourceType, 10);
+        }
+        for (AZ::u32 phase = 0; phase < 10; ++phase)
+        {
+            EXPECT_EQ(scheduler.GetPhaseLoad(sourceType, 10, phase), 1.0f);
+        }
+
+        // A released phase is the first to be taken again.
+        scheduler.ReleasePhase(second);
+        EXPECT_EQ(scheduler.GetPhaseLoad(sourceType, 10, 5), 0.0f);
+        EXPECT_EQ(scheduler.GetPhase(scheduler.AcquirePhase(sourceType, 10)), 5);
+    }
+
+    TEST_F(SensorPhaseSchedulerTest, GroupsBySourceAndPeriod)
+    {
+        ROS2::SensorPhaseScheduler scheduler;
+        const auto tickBased = scheduler.AcquirePhase(azrtti_typeid<ROS2::TickBasedSource>(), 4);
+        const auto physicsBased = scheduler.AcquirePhase(azrtti_typeid<ROS2::PhysicsBasedSource>(), 4);
+        const auto otherPeriod = scheduler.AcquirePhase(azrtti_typeid<ROS2::PhysicsBasedSource>(), 6);
+        EXPECT_EQ(scheduler.GetPhase(tickBased), 0);
+        EXPECT_EQ(scheduler.GetPhase(physicsBased), 0);
+        EXPECT_EQ(scheduler.GetPhase(otherPeriod), 0);
+
+        // Ticks of sources without a counter cannot be scheduled.
+        EXPECT_EQ(scheduler.AcquirePhase(AZ::TypeId::CreateNull(), 4), ROS2::SensorPhaseSchedulerRequests::InvalidPhaseHandle);
+    }
+
+    TEST_F(SensorPhaseSchedulerTest, DelaysUntilPhase)
+    {
+        const AZ::TypeId sourceType = azrtti_typeid<ROS2::TickBasedSource>();
+        ROS2::SensorPhaseScheduler scheduler;
+        scheduler.AcquirePhase(sourceType, 4);
+        const auto handle = scheduler.AcquirePhase(sourceType, 4);
+        ASSERT_EQ(scheduler.GetPhase(handle), 2);
+
+        scheduler.AdvanceTick(sourceType);
+        EXPECT_EQ(scheduler.GetPhaseDelay(handle), 1);
+        scheduler.AdvanceTick(sourceType);
+        EXPECT_EQ(scheduler.GetPhaseDelay(handle), 0);
+        scheduler.AdvanceTick(sourceType);
+        EXPECT_EQ(scheduler.GetPhaseDelay(handle), 3);
+
+        // Ticks of other sources do not move the phase.
+        scheduler.AdvanceTick(azrtti_typeid<ROS2::PhysicsBasedSource>());
+        EXPECT_EQ(scheduler.GetPhaseDelay(handle), 3);
+    }
+
+    TEST_F(SensorPhaseSchedulerTest, RebalancesByMeasuredCost)
+    {
+        const AZ::TypeId sourceType = azrtti_typeid<ROS2::PhysicsBasedSource>();
+        ROS2::SensorPhaseScheduler scheduler(true);
+
+        // Four sensors in two phases, of which the two expensive ones share a phase.
+        const ROS2::SensorPhaseSchedulerRequests::PhaseHandle handles[] = {
+            scheduler.AcquirePhase(sourceType, 2),
+            scheduler.AcquirePhase(sourceType, 2),
+            scheduler.AcquirePhase(sourceType, 2),
+            scheduler.AcquirePhase(sourceType, 2),
+        };
+        ASSERT_EQ(scheduler.GetPhase(handles[0]), scheduler.GetPhase(handles[2]));
+        for (int i = 0; i < 100; ++i)
+        {
+            scheduler.ReportCost(handles[0], 10e-3f);
+            scheduler.ReportCost(handles[1], 1e-3f);
+            scheduler.ReportCost(handles[2], 10e-3f);
+            scheduler.ReportCost(handles[3], 1e-3f);
+        }
+        EXPECT_NEAR(scheduler.GetPhaseLoad(sourceType, 2, scheduler.GetPhase(handles[0])), 20e-3f, 1e-4f);
+
+        scheduler.Rebalance();
+        EXPECT_NE(scheduler.GetPhase(handles[0]), scheduler.GetPhase(handles[2]));
+        EXPECT_NEAR(scheduler.GetPhaseLoad(sourceType, 2, 0), 11e-3f, 1e-4f);
+        EXPECT_NEAR(scheduler.GetPhaseLoad(sourceType, 2, 1), 11e-3f, 1e-4f);
+
+        // Balanced phases are left alone.
+        const AZ::u32 phase = scheduler.GetPhase(handles[0]);
+        scheduler.Rebalance();
+        EXPECT_EQ(scheduler.GetPhase(handles[0]), phase);
+    }
+} // namespace UnitTest
@@ -0,0 +1,112 @@
+/*
+ * Copyright (c) Contributors to the Open 3D Engine Project.
+ * For complete copyright and license terms please see the LICENSE at the root of this distribution.
+ *
+ * SPDX-License-Identifier: Apache-2.0 OR MIT
+ *
+ */
+
+#include <AzCore/UnitTest/TestTypes.h>
+#include <AzTest/AzTest.h>
+
+#include <ROS2/Sensor/SensorProfiler.h>
+#include <sensor_msgs/msg/image.hpp>
+#include <sensor_msgs/msg/laser_scan.hpp>
+
+namespace UnitTest
+{
+    class SensorProfileTest : public LeakDetectionFixture
+    {
+    };
+
+    TEST_F(SensorProfileTest, AggregatesCallbackDurations)
+    {
+        ROS2::SensorProfile profile("lidar");
+        const auto start = ROS2::SensorProfile::Clock::now();
+        for (int i = 1; i <= 100; ++i)
+        {
+            profile.RecordCallback(ROS2::SensorCallbackType::Adapted, start, start + AZStd::chrono::milliseconds(i));
+        }
+        profile.RecordCallback(ROS2::SensorCallbackType::Source, start, start + AZStd::chrono::milliseconds(2));
+        profile.RecordPublishedBytes(1000);
+        profile.RecordPublishedBytes(24);
+
+        const ROS2::SensorStatistics statistics = profile.GetStatistics();
+        EXPECT_EQ(statistics.m_sensorName, "lidar");
+        EXPECT_EQ(statistics.m_publishedBytes, 1024);
+
+        const auto& adapted = statistics.m_callbacks[static_cast<size_t>(ROS2::SensorCallbackType::Adapted)];
+        EXPECT_EQ(adapted.m_callCount, 100);
+        EXPECT_NEAR(adapted.m_meanDuration, 50.5, 1e-6);
+        EXPECT_NEAR(adapted.m_maxDuration, 100.0, 1e-6);
+        EXPECT_NEAR(adapted.m_99thPercentileDuration, 99.0, 2.0);
+
+        const auto& source = statistics.m_callbacks[static_cast<size_t>(ROS2::SensorCallbackType::Source)];
+        EXPECT_EQ(source.m_callCount, 1);
+        EXPECT_NEAR(source.m_maxDuration, 2.0, 1e-6);
+    }
+
+    TEST_F(SensorProfileTest, RecordsSerializedSizeOfMessages)
+    {
+        ROS2::SensorProfile profile("lidar_2d");
+        sensor_msgs::msg::LaserScan message;
+        message.ranges.resize(1000);
+        message.intensities.resize(1000);
+        profile.RecordPublishedMessage(message);
+
+        // Sequences are serialized element by element, so the size includes the ranges and intensities, unlike sizeof.
+        const AZ::u64 publishedBytes = profile.GetStatistics().m_publishedBytes;
+        EXPECT_GE(publishedBytes, 2000 * sizeof(float));
+        EXPECT_LT(publishedBytes, 2000 * sizeof(float) + 256);
+    }
+
+    TEST_F(SensorProfileTest, RecordsDataBufferSizeOfLargeMessages)
+    {
+        ROS2::SensorProfile profile("camera");
+        sensor_msgs::msg::Image message;
+        message.encoding = "rgba8";
+        message.data.resize(640 * 480 * 4);
+        profile.RecordPublishedMessage(message);
+        EXPECT_EQ(profile.GetStatistics().m_publishedBytes, 640 * 480 * 4);
+    }
+
+    TEST_F(SensorProfileTest, ScopeRecordsOnlyWithProfile)
+    {
+        ROS2::SensorProfile profile("imu");
+        {
+            ROS2::SensorProfileScope scope(&profile, ROS2::SensorCallbackType::Source);
+        }
+        {
+            ROS2::SensorProfileScope scope(nullptr, ROS2::SensorCallbackType::Source);
+        }
+        EXPECT_EQ(profile.GetStatistics().m_callbacks[static_cast<size_t>(ROS2::SensorCallbackType::Source)].m_callCount, 1);
+    }
+
+    TEST_F(SensorProfileTest, KeepsMostRecentTraceEvents)
+    {
+        ROS2::SensorProfile profile("camera");
+        const auto epoch = ROS2::SensorProfile::Clock::now();
+        const size_t callbackCount = ROS2::SensorProfile::TraceEventCapacity + 10;
+        for (size_t i = 0; i < callbackCount; ++i)
+        {
+            const auto start = epoch + AZStd::chrono::microseconds(10 * i);
+            profile.RecordCallback(ROS2::SensorCallbackType::Adapted, start, start + AZStd::chrono::microseconds(5));
+        }
+
+        AZStd::string traceEvents;
+        profile.AppendTraceEvents(traceEvents, epoch, 3);
+
+        size_t eventCount = 0;
+        for (size_t position = traceEvents.find("\"ph\":\"X\""); position != AZStd::string::npos;
+             position = traceEvents.find("\"ph\":\"X\"", position + 1))
+        {
+            ++eventCount;
+        }
+        EXPECT_EQ(eventCount, ROS2::SensorProfile::TraceEventCapacity);
+        EXPECT_NE(traceEvents.find(R"("args":{"name":"camera"})"), AZStd::string::npos);
+        EXPECT_NE(traceEvents.find(R"("tid":3)"), AZStd::string::npos);
+        // The ten oldest events were overwritten, so the first one kept starts at 100 us.
+        EXPECT_NE(traceEvents.find(R"("ts":100.000,"dur":5.000)"), AZStd::string::npos);
+        EXPECT_EQ(traceEvents.find(R"("ts":90.000,)"), AZStd::string::npos);
+    }
+} // namespace UnitTest
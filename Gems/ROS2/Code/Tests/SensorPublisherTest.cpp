@@ -0,0 +1,151 @@
+/*
+ * Copyright (c) Contributors to the Open 3D Engine Project.
+ * For complete copyright and license terms please see the LICENSE at the root of this distribution.
+ *
+ * SPDX-License-Identifier: Apache-2.0 OR MIT
+ *
+ */
+
+#include <AzCore/UnitTest/TestTypes.h>
+#include <AzCore/std/chrono/chrono.h>
+#include <AzTest/AzTest.h>
+
+#include <ROS2/Sensor/SensorPublisher.h>
+#include <rclcpp/rclcpp.hpp>
+#include <sensor_msgs/msg/point_cloud2.hpp>
+
+namespace UnitTest
+{
+    class SensorPublisherTest : public LeakDetectionFixture
+    {
+    public:
+        using PointCloud = sensor_msgs::msg::PointCloud2;
+
+        static constexpr const char* Topic = "sensor_publisher_test";
+        static constexpr size_t PointCloudSize = 4096;
+
+        void SetUp() override
+        {
+            LeakDetectionFixture::SetUp();
+            if (!rclcpp::ok())
+            {
+                rclcpp::init(0, nullptr);
+            }
+            // Without a sensor publishing thread, sensor publishers publish in place.
+            m_node = std::make_shared<rclcpp::Node>("sensor_publisher_test", rclcpp::NodeOptions().use_intra_process_comms(true));
+            m_publisher = AZStd::make_unique<ROS2::SensorPublisher<PointCloud>>(m_node->create_publisher<PointCloud>(Topic, 10), 1);
+            m_subscription = m_node->create_subscription<PointCloud>(
+                Topic,
+                10,
+                [this](PointCloud::UniquePtr message)
+                {
+                    m_receivedSize = message->data.size();
+                    m_receivedBuffer = message->data.data();
+                });
+        }
+
+        void TearDown() override
+        {
+            m_subscription.reset();
+            m_publisher.reset();
+            m_node.reset();
+            LeakDetectionFixture::TearDown();
+        }
+
+        //! Waits until the intra-process subscription received a message.
+        bool WaitForMessage()
+        {
+            const auto deadline = AZStd::chrono::steady_clock::now() + AZStd::chrono::seconds(5);
+            while (m_receivedSize == 0)
+            {
+                if (AZStd::chrono::steady_clock::now() > deadline)
+                {
+                    return false;
+                }
+                rclcpp::spin_some(m_node);
+            }
+            return true;
+        }
+
+        std::shared_ptr<rclcpp::Node> m_node;
+        AZStd::unique_ptr<ROS2::SensorPublisher<PointCloud>> m_publisher;
+        rclcpp::Subscription<PointCloud>::SharedPtr m_subscription;
+        size_t m_receivedSize = 0;
+        const void* m_receivedBuffer = nullptr;
+    };
+
+    TEST_F(SensorPublisherTest, LargeMessageIsMovedToIntraProcessSubscription)
+    {
+        PointCloud* message = m_publisher->AcquireMessage();
+        ASSERT_NE(message, nullptr);
+        message->header.frame_id = "lidar";
+        message->data.resize(PointCloudSize);
+        const void* buffer = message->data.data();
+        m_publisher->Submit(message);
+
+        ASSERT_TRUE(WaitForMessage());
+        EXPECT_EQ(m_receivedSize, PointCloudSize);
+        EXPECT_EQ(m_receivedBuffer, buffer);
+
+        // The pool holds a single message, which is replaced by one reserving as much data as the moved message.
+        PointCloud* replacementMessage = m_publisher->AcquireMessage();
+        ASSERT_NE(replacementMessage, nullptr);
+        EXPECT_TRUE(replacementMessage->data.empty());
+        EXPECT_GE(replacementMessage->data.capacity(), PointCloudSize);
+        replacementMessage->data.resize(PointCloudSize);
+        m_publisher->Submit(replacementMessage);
+
+        const ROS2::SensorPublisherStatistics statistics = m_publisher->GetStatistics();
+        EXPECT_EQ(statistics.m_publishedCount, 2u);
+        EXPECT_EQ(statistics.m_droppedCount, 0u);
+    }
+
+    TEST_F(SensorPublisherTest, PooledMessageKeepsBuffersWithoutIntraProcessSubscription)
+    {
+        m_subscription.reset();
+        PointCloud* message = m_publisher->AcquireMessage();
+        ASSERT_NE(message, nullptr);
+        message->header.frame_id = "lidar";
+        message->data.resize(PointCloudSize);
+        const void* buffer = message->data.data();
+        m_publisher->Submit(message);
+
+        // Published by reference, the message comes back to the pool with its contents.
+        PointCloud* reusedMessage = m_publisher->AcquireMessage();
+        ASSERT_EQ(reusedMessage, message);
+        EXPECT_EQ(reusedMessage->header.frame_id, "lidar");
+        EXPECT_EQ(reusedMessage->data.data(), buffer);
+        m_publisher->Submit(reusedMessage);
+        EXPECT_EQ(m_publisher->GetStatistics().m_publishedCount, 2u);
+    }
+
+    TEST_F(SensorPublisherTest, DropsMessagesWhenPoolIsExhausted)
+    {
+        // Without the publishing thread, messages return to the pool on Submit, so only unsubmitted messages exhaust it.
+        PointCloud* message = m_publisher->AcquireMessage();
+        ASSERT_NE(message, nullptr);
+        EXPECT_EQ(m_publisher->AcquireMessage(), nullptr);
+        EXPECT_EQ(m_publisher->GetStatistics().m_droppedCount, 1u);
+        m_publisher->Submit(message);
+        EXPECT_NE(m_publisher->AcquireMessage(), nullptr);
+    }
+
+    TEST_F(SensorPublisherTest, RecordsPublishedMessagesInSensorProfile)
+    {
+        auto profile = AZStd::make_shared<ROS2::SensorProfile>("lidar");
+        m_publisher->SetSensorProfile(profile);
+        PointCloud* message = m_publisher->AcquireMessage();
+        ASSERT_NE(message, nullptr);
+        message->data.resize(PointCloudSize);
+        m_publisher->Submit(message);
+
+        // Point clouds record the size of their data buffer only.
+        EXPECT_EQ(profile->GetStatistics().m_publishedBytes, PointCloudSize);
+
+        m_publisher->SetSensorProfile(nullptr);
+        message = m_publisher->AcquireMessage();
+        ASSERT_NE(message, nullptr);
+        m_publisher->Submit(message);
+        EXPECT_EQ(profile->GetStatistics().m_publishedBytes, PointCloudSize);
+    }
+} // namespace UnitTest
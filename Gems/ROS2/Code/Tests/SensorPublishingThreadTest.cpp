@@ -0,0 +1,80 @@
+/*
+ * Copyright (c) Contributors to the Open 3D Engine Project.
+ * For complete copyright and license terms please see the LICENSE at the root of this distribution.
+ *
+ * SPDX-License-Identifier: Apache-2.0 OR MIT
+ *
+ */
+
+#include <AzCore/UnitTest/TestTypes.h>
+#include <AzCore/std/parallel/thread.h>
+#include <AzTest/AzTest.h>
+#include <Sensor/SensorPublishingThread.h>
+
+namespace UnitTest
+{
+    //! Channel which counts pending messages instead of publishing them.
+    class CountingChannel : public ROS2::SensorPublicationChannel
+    {
+    public:
+        void Queue()
+        {
+            ++m_pendingCount;
+        }
+
+        void PublishPending() override
+        {
+            m_publishedCount += m_pendingCount.exchange(0);
+        }
+
+        ROS2::SensorPublisherStatistics GetStatistics() const override
+        {
+            ROS2::SensorPublisherStatistics statistics;
+            statistics.m_topicName = "counting";
+            statistics.m_publishedCount = m_publishedCount;
+            return statistics;
+        }
+
+        AZStd::atomic<AZ::u64> m_pendingCount{ 0 };
+        AZStd::atomic<AZ::u64> m_publishedCount{ 0 };
+    };
+
+    class SensorPublishingThreadTest : public LeakDetectionFixture
+    {
+    };
+
+    TEST_F(SensorPublishingThreadTest, PublishesPendingMessagesOfRegisteredChannels)
+    {
+        ROS2::SensorPublishingThread publishingThread;
+        CountingChannel registered;
+        CountingChannel unregistered;
+        publishingThread.RegisterChannel(&registered);
+
+        constexpr AZ::u64 MessageCount = 1000;
+        for (AZ::u64 i = 0; i < MessageCount; ++i)
+        {
+            registered.Queue();
+            unregistered.Queue();
+            publishingThread.NotifyPending();
+        }
+
+        for (int attempt = 0; attempt < 1000 && registered.m_publishedCount < MessageCount; ++attempt)
+        {
+            AZStd::this_thread::sleep_for(AZStd::chrono::milliseconds(1));
+        }
+        EXPECT_EQ(registered.m_publishedCount, MessageCount);
+        EXPECT_EQ(unregistered.m_publishedCount, 0);
+
+        const auto statistics = publishingThread.GetStatistics();
+        ASSERT_EQ(statistics.size(), 1);
+        EXPECT_EQ(statistics[0].m_publishedCount, MessageCount);
+
+        // Once unregistered, the channel is not used by the thread anymore.
+        publishingThread.UnregisterChannel(&registered);
+        registered.Queue();
+        publishingThread.NotifyPending();
+        AZStd::this_thread::sleep_for(AZStd::chrono::milliseconds(10));
+        EXPECT_EQ(registered.m_publishedCount, MessageCount);
+        EXPECT_TRUE(publishingThread.GetStatistics().empty());
+    }
+} // namespace UnitTest
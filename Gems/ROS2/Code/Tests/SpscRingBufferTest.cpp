@@ -0,0 +1,70 @@
+/*
+ * Copyright (c) Contributors to the Open 3D Engine Project.
+ * For complete copyright and license terms please see the LICENSE at the root of this distribution.
+ *
+ * SPDX-License-Identifier: Apache-2.0 OR MIT
+ *
+ */
+
+#include <AzCore/UnitTest/TestTypes.h>
+#include <AzCore/std/parallel/thread.h>
+#include <AzTest/AzTest.h>
+
+#include <ROS2/Utilities/SpscRingBuffer.h>
+
+namespace UnitTest
+{
+    class SpscRingBufferTest : public LeakDetectionFixture
+    {
+    };
+
+    TEST_F(SpscRingBufferTest, PushFailsWhenFull)
+    {
+        ROS2::SpscRingBuffer<int> buffer(2);
+        EXPECT_TRUE(buffer.Push(1));
+        EXPECT_TRUE(buffer.Push(2));
+        EXPECT_FALSE(buffer.Push(3));
+        EXPECT_EQ(buffer.Size(), 2);
+
+        int value = 0;
+        EXPECT_TRUE(buffer.Pop(value));
+        EXPECT_EQ(value, 1);
+        EXPECT_TRUE(buffer.Push(3));
+        EXPECT_TRUE(buffer.Pop(value));
+        EXPECT_EQ(value, 2);
+        EXPECT_TRUE(buffer.Pop(value));
+        EXPECT_EQ(value, 3);
+        EXPECT_FALSE(buffer.Pop(value));
+    }
+
+    TEST_F(SpscRingBufferTest, KeepsOrderAcrossThreads)
+    {
+        constexpr int ElementCount = 100000;
+        ROS2::SpscRingBuffer<int> buffer(16);
+
+        AZStd::thread producer(
+            [&buffer]()
+            {
+                for (int i = 0; i < ElementCount; ++i)
+                {
+                    while (!buffer.Push(i))
+                    {
+                        AZStd::this_thread::yield();
+                    }
+                }
+            });
+
+        int expected = 0;
+        while (expected < ElementCount)
+        {
+            int value = -1;
+            if (buffer.Pop(value))
+            {
+                ASSERT_EQ(value, expected);
+                ++expected;
+            }
+        }
+        producer.join();
+        EXPECT_EQ(buffer.Size(), 0);
+    }
+} // namespace UnitTest
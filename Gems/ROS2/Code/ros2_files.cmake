@@ -9,7 +9,15 @@ set(FILES
         ../Assets/Passes/PipelineROSColor.pass
         ../Assets/Passes/PipelineROSDepth.pass
         ../Assets/Passes/ROSPassTemplates.azasset
+        Source/Camera/CameraAtlas.cpp
+        Source/Camera/CameraAtlas.h
         Source/Camera/CameraConstants.h
+        Source/Camera/CameraImageNoise.cpp
+        Source/Camera/CameraImageNoise.h
+        Source/Camera/CameraLensDistortion.cpp
+        Source/Camera/CameraLensDistortion.h
+        Source/Camera/CameraPostProcessingPipeline.cpp
+        Source/Camera/CameraPostProcessingPipeline.h
         Source/Camera/CameraPublishers.cpp
         Source/Camera/CameraPublishers.h
         Source/Camera/CameraSensor.cpp
@@ -18,17 +26,35 @@ set(FILES
         Source/Camera/CameraSensorDescription.h
         Source/Camera/CameraSensorConfiguration.cpp
         Source/Camera/CameraSensorConfiguration.h
+        Source/Camera/CameraSensorEffects.cpp
+        Source/Camera/CameraSensorEffects.h
         Source/Camera/ROS2CameraSensorComponent.cpp
         Source/Camera/ROS2CameraSensorComponent.h
         Source/Camera/CameraUtilities.cpp
         Source/Camera/CameraUtilities.h
+        Source/Camera/CompressedImagePublisher.cpp
+        Source/Camera/CompressedImagePublisher.h
+        Source/Camera/ImageEncoder.cpp
+        Source/Camera/ImageEncoder.h
+        Source/Clock/LockstepSimulation.cpp
+        Source/Clock/LockstepSimulation.h
         Source/Clock/PhysicallyStableClock.cpp
         Source/Clock/SimulationClock.cpp
+        Source/Communication/MarshallingExecutor.cpp
+        Source/Communication/MarshallingExecutor.h
+        Source/Communication/NodeComposition.cpp
+        Source/Communication/NodeComposition.h
+        Source/Communication/ParallelExecutor.cpp
+        Source/Communication/ParallelExecutor.h
+        Source/Communication/RobotNodes.cpp
+        Source/Communication/RobotNodes.h
         Source/Communication/QoS.cpp
         Source/Communication/PublisherConfiguration.cpp
         Source/Communication/TopicConfiguration.cpp
         Source/ContactSensor/ROS2ContactSensorComponent.cpp
         Source/ContactSensor/ROS2ContactSensorComponent.h
+        Source/Frame/DynamicTransformPublisher.cpp
+        Source/Frame/DynamicTransformPublisher.h
         Source/Frame/NamespaceConfiguration.cpp
         Source/Frame/ROS2FrameComponent.cpp
         Source/Frame/ROS2Transform.cpp
@@ -50,10 +76,14 @@ set(FILES
         Source/Imu/ImuSensorConfiguration.h
         Source/Imu/ROS2ImuSensorComponent.cpp
         Source/Imu/ROS2ImuSensorComponent.h
+        Source/Lidar/LidarPointCloudUtils.cpp
+        Source/Lidar/LidarPointCloudUtils.h
         Source/Lidar/LidarRaycaster.cpp
         Source/Lidar/LidarRaycaster.h
         Source/Lidar/LidarRegistrarSystemComponent.cpp
         Source/Lidar/LidarRegistrarSystemComponent.h
+        Source/Lidar/LidarScanScheduler.cpp
+        Source/Lidar/LidarScanScheduler.h
         Source/Lidar/LidarSensorConfiguration.cpp
         Source/Lidar/LidarSensorConfiguration.h
         Source/Lidar/LidarSystem.cpp
@@ -111,8 +141,15 @@ set(FILES
         Source/ROS2SystemComponent.cpp
         Source/ROS2SystemComponent.h
         Source/Sensor/Events/PhysicsBasedSource.cpp
+        Source/Sensor/Events/SensorPhaseScheduler.cpp
+        Source/Sensor/Events/SensorPhaseScheduler.h
         Source/Sensor/Events/TickBasedSource.cpp
         Source/Sensor/SensorConfiguration.cpp
+        Source/Sensor/SensorProfile.cpp
+        Source/Sensor/SensorProfilerRegistry.cpp
+        Source/Sensor/SensorProfilerRegistry.h
+        Source/Sensor/SensorPublishingThread.cpp
+        Source/Sensor/SensorPublishingThread.h
         Source/SimulationUtils/FollowingCameraConfiguration.cpp
         Source/SimulationUtils/FollowingCameraConfiguration.h
         Source/SimulationUtils/FollowingCameraComponent.cpp
@@ -34,12 +34,17 @@ set(FILES
         Include/ROS2/ROS2GemUtilities.h
         Include/ROS2/Sensor/Events/EventSourceAdapter.h
         Include/ROS2/Sensor/Events/SensorEventSource.h
+        Include/ROS2/Sensor/Events/SensorPhaseSchedulerBus.h
         Include/ROS2/Sensor/Events/PhysicsBasedSource.h
         Include/ROS2/Sensor/Events/TickBasedSource.h
         Include/ROS2/Sensor/ROS2SensorComponentBase.h
         Include/ROS2/Sensor/SensorConfiguration.h
+        Include/ROS2/Sensor/SensorProfiler.h
+        Include/ROS2/Sensor/SensorPublisher.h
         Include/ROS2/Spawner/SpawnerBus.h
         Include/ROS2/Utilities/Controllers/PidConfiguration.h
+        Include/ROS2/Utilities/P2QuantileEstimator.h
+        Include/ROS2/Utilities/SpscRingBuffer.h
         Include/ROS2/Utilities/ROS2Conversions.h
         Include/ROS2/Utilities/ROS2Names.h
         Include/ROS2/VehicleDynamics/VehicleInputControlBus.h
@@ -6,4 +6,22 @@
 set(FILES
     Tests/ROS2Test.cpp
     Tests/GNSSTest.cpp
+    Tests/LidarTemplateUtilsTest.cpp
+    Tests/SpscRingBufferTest.cpp
+    Tests/P2QuantileEstimatorTest.cpp
+    Tests/SensorProfileTest.cpp
+    Tests/SensorPhaseSchedulerTest.cpp
+    Tests/SensorPublishingThreadTest.cpp
+    Tests/SensorPublisherTest.cpp
+    Tests/ImageEncoderTest.cpp
+    Tests/CameraPostProcessingPipelineTest.cpp
+    Tests/CameraSensorEffectsTest.cpp
+    Tests/CameraAtlasTest.cpp
+    Tests/MarshallingExecutorTest.cpp
+    Tests/ParallelExecutorTest.cpp
+    Tests/DynamicTransformPublisherTest.cpp
+    Tests/LidarTemplateUtilsBenchmarks.cpp
+    Tests/RobotNodesBenchmarks.cpp
+    Tests/ImageEncoderBenchmarks.cpp
+    Tests/CameraSensorEffectsBenchmarks.cpp
 )